@@ -0,0 +1,298 @@
+#include "Header.h"				// Header file
+#include "BlockCache.h"			// BlockCache file
+
+// Compiler Directive
+using namespace std;
+
+
+/*
+ * Contructor for BlockCache
+ *
+ */
+BlockCache::BlockCache(int numBlocks){
+	capacity = numBlocks;
+	numHits = 0;
+	numMisses = 0;
+	numEvictions = 0;
+}
+
+BlockCache::~BlockCache(){
+}
+
+
+/*
+ * Looks up a block for a read
+ *	On a hit the block's position in the eviction policy is updated.
+ *	On a miss the block is read into the cache, evicting another
+ *	block if the cache is full.
+ *
+ * Input:
+ *		block - Block being read
+ *
+ * Returns:
+ *		true on a cache hit
+ */
+bool BlockCache::access(int block){
+	if (contains(block)){
+		numHits++;
+		touch(block);
+		return true;
+	}
+	numMisses++;
+	insert(block);
+	return false;
+}
+
+
+/*
+ * Places a written block in the cache
+ *	Writes are not counted as hits or misses.
+ *
+ * Input:
+ *		block - Block being written
+ *
+ */
+void BlockCache::store(int block){
+	if (contains(block)){
+		touch(block);
+	} else {
+		insert(block);
+	}
+}
+
+
+/*
+ * Getter methods for the cache capacity and statistics
+ *
+ */
+int BlockCache::getCapacity(){
+	return capacity;
+}
+
+long BlockCache::getHits(){
+	return numHits;
+}
+
+long BlockCache::getMisses(){
+	return numMisses;
+}
+
+long BlockCache::getEvictions(){
+	return numEvictions;
+}
+
+
+
+
+/*
+ * Least recently used (LRU) cache
+ *	Blocks are kept in order of their last use and the least
+ *	recently used block is evicted.
+ *
+ */
+LRUCache::LRUCache(int numBlocks) : BlockCache(numBlocks){
+}
+
+std::string LRUCache::getName(){
+	return "LRU";
+}
+
+bool LRUCache::contains(int block){
+	return blockPosition.count(block) > 0;
+}
+
+void LRUCache::touch(int block){
+	// Move the block to the front of the list
+	recencyList.splice(recencyList.begin(), recencyList, blockPosition[block]);
+}
+
+void LRUCache::insert(int block){
+	if (recencyList.size() >= capacity){
+		// Cache full, evict the least recently used block
+		blockPosition.erase(recencyList.back());
+		recencyList.pop_back();
+		numEvictions++;
+	}
+	recencyList.push_front(block);
+	blockPosition[block] = recencyList.begin();
+}
+
+void LRUCache::invalidate(int block){
+	if (contains(block)){
+		recencyList.erase(blockPosition[block]);
+		blockPosition.erase(block);
+	}
+}
+
+
+
+
+/*
+ * CLOCK (second chance) cache
+ *	Frames are arranged in a circle with a reference bit each. The
+ *	clock hand clears reference bits until it finds a frame that has
+ *	not been referenced since the last sweep, and evicts that frame.
+ *
+ */
+ClockCache::ClockCache(int numBlocks) : BlockCache(numBlocks){
+	frameBlock.assign(numBlocks, -1);
+	referenceBit.assign(numBlocks, false);
+	clockHand = 0;
+}
+
+std::string ClockCache::getName(){
+	return "CLOCK";
+}
+
+bool ClockCache::contains(int block){
+	return blockFrame.count(block) > 0;
+}
+
+void ClockCache::touch(int block){
+	referenceBit[blockFrame[block]] = true;
+}
+
+void ClockCache::insert(int block){
+	// Sweep until an empty frame or a frame without its reference bit is found
+	while (frameBlock[clockHand] != -1 && referenceBit[clockHand]){
+		referenceBit[clockHand] = false;
+		clockHand = (clockHand+1) % capacity;
+	}
+	if (frameBlock[clockHand] != -1){
+		// Evict the block in the frame
+		blockFrame.erase(frameBlock[clockHand]);
+		numEvictions++;
+	}
+	frameBlock[clockHand] = block;
+	referenceBit[clockHand] = true;
+	blockFrame[block] = clockHand;
+	clockHand = (clockHand+1) % capacity;
+}
+
+void ClockCache::invalidate(int block){
+	if (contains(block)){
+		frameBlock[blockFrame[block]] = -1;
+		referenceBit[blockFrame[block]] = false;
+		blockFrame.erase(block);
+	}
+}
+
+
+
+
+/*
+ * Adaptive replacement cache (ARC)
+ *	Resident blocks are split between T1 (seen once) and T2 (seen
+ *	again while resident or remembered). Ghost lists B1 and B2 remember
+ *	blocks recently evicted from T1 and T2, and hits on them move the
+ *	target size of T1 towards recency or frequency.
+ *
+ */
+ARCCache::ARCCache(int numBlocks) : BlockCache(numBlocks){
+	recentTarget = 0;
+}
+
+std::string ARCCache::getName(){
+	return "ARC";
+}
+
+std::list<int>* ARCCache::getList(int listNumber){
+	switch (listNumber){
+		case (1): {
+			return &recentList;
+		}
+		case (2): {
+			return &frequentList;
+		}
+		case (3): {
+			return &recentGhostList;
+		}
+		default: {
+			return &frequentGhostList;
+		}
+	}
+}
+
+void ARCCache::moveToFront(int block, int listNumber){
+	// Remove the block from its current list, then add it to the front of the new list
+	removeBlock(block);
+	getList(listNumber)->push_front(block);
+	blockPosition[block] = std::pair<int, std::list<int>::iterator>(listNumber, getList(listNumber)->begin());
+}
+
+void ARCCache::removeBlock(int block){
+	if (blockPosition.count(block) > 0){
+		getList(blockPosition[block].first)->erase(blockPosition[block].second);
+		blockPosition.erase(block);
+	}
+}
+
+bool ARCCache::contains(int block){
+	return blockPosition.count(block) > 0 && blockPosition[block].first <= 2;
+}
+
+void ARCCache::touch(int block){
+	// A resident block seen again becomes frequent
+	moveToFront(block, 2);
+}
+
+/*
+ * Evicts one resident block into its ghost list
+ *	T1 is evicted when it is larger than its target size, otherwise T2.
+ */
+void ARCCache::replace(bool inFrequentGhost){
+	if (recentList.size() > 0 && (frequentList.empty() || recentList.size() > recentTarget || (inFrequentGhost && recentList.size() == recentTarget))){
+		moveToFront(recentList.back(), 3);
+	} else {
+		moveToFront(frequentList.back(), 4);
+	}
+	numEvictions++;
+}
+
+void ARCCache::insert(int block){
+	int listNumber = 0;
+	if (blockPosition.count(block) > 0){
+		listNumber = blockPosition[block].first;
+	}
+	if (listNumber == 3){
+		// Ghost hit in B1, favour recency
+		recentTarget = min(capacity, recentTarget + max((int)(frequentGhostList.size() / recentGhostList.size()), 1));
+		if (recentList.size() + frequentList.size() >= capacity){
+			replace(false);
+		}
+		moveToFront(block, 2);
+	} else if (listNumber == 4){
+		// Ghost hit in B2, favour frequency
+		recentTarget = max(0, recentTarget - max((int)(recentGhostList.size() / frequentGhostList.size()), 1));
+		if (recentList.size() + frequentList.size() >= capacity){
+			replace(true);
+		}
+		moveToFront(block, 2);
+	} else {
+		// Block not remembered at all
+		if (recentList.size() + recentGhostList.size() == capacity){
+			if (recentList.size() < capacity){
+				removeBlock(recentGhostList.back());
+				if (recentList.size() + frequentList.size() >= capacity){
+					replace(false);
+				}
+			} else {
+				// B1 is empty, evict from T1 without remembering the block
+				removeBlock(recentList.back());
+				numEvictions++;
+			}
+		} else if (recentList.size() + frequentList.size() + recentGhostList.size() + frequentGhostList.size() >= capacity){
+			if (recentList.size() + frequentList.size() + recentGhostList.size() + frequentGhostList.size() == 2*capacity){
+				removeBlock(frequentGhostList.back());
+			}
+			if (recentList.size() + frequentList.size() >= capacity){
+				replace(false);
+			}
+		}
+		moveToFront(block, 1);
+	}
+}
+
+void ARCCache::invalidate(int block){
+	removeBlock(block);
+}
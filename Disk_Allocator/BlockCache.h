@@ -0,0 +1,95 @@
+// BlockCache.h
+#ifndef BLOCKCACHE_H
+#define BLOCKCACHE_H
+#pragma once
+
+// Simulated time of serving a block from the cache (us)
+#define cacheHitTime 1.0
+
+/*
+ * Base class for the block (buffer) cache
+ *	The cache tracks which disk blocks are resident in memory. The
+ *	data itself stays in the disk data region (write-through), so a
+ *	cache only decides hits, misses and evictions. Derived classes
+ *	implement the eviction policy.
+ */
+class BlockCache{
+protected:
+	int capacity;			// Capacity of the cache in blocks
+	long numHits;			// Number of read hits
+	long numMisses;			// Number of read misses
+	long numEvictions;		// Number of blocks evicted to make space
+public:
+	// Constructors/Destructors
+	BlockCache(int numBlocks);
+	virtual ~BlockCache();
+
+	// Policy specific methods
+	virtual std::string getName() = 0;
+	virtual bool contains(int block) = 0;
+	virtual void touch(int block) = 0;
+	virtual void insert(int block) = 0;
+	virtual void invalidate(int block) = 0;
+
+	// General methods
+	bool access(int block);
+	void store(int block);
+	int getCapacity();
+	long getHits();
+	long getMisses();
+	long getEvictions();
+};
+
+
+// Least recently used
+class LRUCache : public BlockCache{
+	std::list<int> recencyList;										// Most recently used block at the front
+	std::unordered_map<int, std::list<int>::iterator> blockPosition;
+public:
+	LRUCache(int numBlocks);
+	std::string getName();
+	bool contains(int block);
+	void touch(int block);
+	void insert(int block);
+	void invalidate(int block);
+};
+
+
+// CLOCK (second chance)
+class ClockCache : public BlockCache{
+	vector<int> frameBlock;							// Block held by each frame (-1 if empty)
+	vector<bool> referenceBit;						// Reference bit of each frame
+	std::unordered_map<int, int> blockFrame;		// Frame holding each block
+	int clockHand;
+public:
+	ClockCache(int numBlocks);
+	std::string getName();
+	bool contains(int block);
+	void touch(int block);
+	void insert(int block);
+	void invalidate(int block);
+};
+
+
+// Adaptive replacement cache
+class ARCCache : public BlockCache{
+	std::list<int> recentList;				// T1 - Blocks seen once recently
+	std::list<int> frequentList;			// T2 - Blocks seen at least twice recently
+	std::list<int> recentGhostList;			// B1 - Blocks recently evicted from T1
+	std::list<int> frequentGhostList;		// B2 - Blocks recently evicted from T2
+	std::unordered_map<int, std::pair<int, std::list<int>::iterator> > blockPosition;	// List (1-4) and position of each block
+	int recentTarget;						// p - Target size of T1
+	void moveToFront(int block, int listNumber);
+	void removeBlock(int block);
+	void replace(bool inFrequentGhost);
+	std::list<int>* getList(int listNumber);
+public:
+	ARCCache(int numBlocks);
+	std::string getName();
+	bool contains(int block);
+	void touch(int block);
+	void insert(int block);
+	void invalidate(int block);
+};
+
+#endif
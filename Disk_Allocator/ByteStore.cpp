@@ -0,0 +1,208 @@
+#include "Header.h"				// Header file
+#include "ByteStore.h"			// ByteStore file
+
+// Compiler Directive
+using namespace std;
+
+
+/*
+ * Contructor for ByteStore
+ *	The slab is taken once, aligned to a device page, and cleared.
+ *	A block holds the same number of entries as in int mode, so each
+ *	entry covers an equal share of the block's payload.
+ *
+ * Input:
+ *		numBlocks - Blocks of the disk (block 0 is the superblock)
+ *		entriesPerBlock - Entries in a block
+ *		payloadBytes - Bytes in a block
+ *
+ */
+ByteStore::ByteStore(int numBlocks, int entriesPerBlock, int payloadBytes){
+	blockSize = entriesPerBlock;
+	blockBytes = payloadBytes;
+	entryBytes = payloadBytes / entriesPerBlock;
+	// Block 0 holds the VCB and directory structure and has no payload
+	slabBytes = (size_t)(numBlocks-1) * blockBytes;
+	slab = (uint8_t*)std::pmr::new_delete_resource()->allocate(slabBytes, byteSlabAlignment);
+	std::fill(slab, slab+slabBytes, 0);
+	numWrites = 0;
+	bytesWritten = 0;
+	writeTime = 0;
+	numReads = 0;
+	bytesRead = 0;
+	readTime = 0;
+}
+
+ByteStore::~ByteStore(){
+	// Destructor, give the slab back
+	std::pmr::new_delete_resource()->deallocate(slab, slabBytes, byteSlabAlignment);
+}
+
+
+/*
+ * Locates the payload of an entry
+ *
+ * Input:
+ *		dataAddr - Position of the entry in disk data
+ *
+ * Returns:
+ *		Pointer to the first byte the entry covers
+ */
+uint8_t* ByteStore::getEntry(int dataAddr){
+	return slab + (size_t)(dataAddr / blockSize) * blockBytes + (size_t)(dataAddr % blockSize) * entryBytes;
+}
+
+
+/*
+ * Writes the payload of an entry
+ *
+ * Input:
+ *		dataAddr - Position of the entry in disk data
+ *		bytes - Bytes of the entry (at most entryBytes)
+ *
+ * Returns:
+ *		Number of bytes written
+ */
+int ByteStore::writeEntry(int dataAddr, std::span<const uint8_t> bytes){
+	std::memcpy(getEntry(dataAddr), bytes.data(), bytes.size());
+	return bytes.size();
+}
+
+
+/*
+ * Moves the payloads of a run of blocks
+ *	Follows the entries when the defragmenter or the segment cleaner
+ *	relocates blocks. The runs may overlap.
+ *
+ * Input:
+ *		fromBlock - First block of the run to move
+ *		toBlock - First block of the destination run
+ *		numBlocks - Length of the run in blocks
+ *
+ * Returns:
+ *		Number of bytes moved
+ */
+int ByteStore::moveBlocks(int fromBlock, int toBlock, int numBlocks){
+	std::memmove(slab + (size_t)(toBlock-1) * blockBytes, slab + (size_t)(fromBlock-1) * blockBytes, (size_t)numBlocks * blockBytes);
+	return numBlocks * blockBytes;
+}
+
+
+/*
+ * Adds the bytes of an entry to a list of views
+ *	Bytes that continue the last view in the slab extend it, so the
+ *	entries of a run of blocks come back as one view when the entries
+ *	fill their blocks exactly.
+ *
+ * Input:
+ *		views - Views of the bytes read so far
+ *		dataAddr - Position of the entry in disk data
+ *		firstByte - First byte of the entry to view
+ *		numBytes - Number of bytes to view
+ *
+ * Returns:
+ *		Number of views
+ */
+int ByteStore::addView(vector<std::span<const uint8_t> > &views, int dataAddr, int firstByte, int numBytes){
+	const uint8_t* start = getEntry(dataAddr) + firstByte;
+	if (!views.empty() && views.back().data() + views.back().size() == start){
+		// Continues the last view
+		views.back() = std::span<const uint8_t>(views.back().data(), views.back().size() + numBytes);
+	} else {
+		views.push_back(std::span<const uint8_t>(start, numBytes));
+	}
+	return views.size();
+}
+
+
+/*
+ * Adds an operation to the throughput figures
+ *
+ * Input:
+ *		numBytes - Bytes moved by the operation
+ *		deviceTime - Simulated device time of the operation (us)
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int ByteStore::recordWrite(long numBytes, double deviceTime){
+	numWrites++;
+	bytesWritten += numBytes;
+	writeTime += deviceTime;
+	return 1;
+}
+
+int ByteStore::recordRead(long numBytes, double deviceTime){
+	numReads++;
+	bytesRead += numBytes;
+	readTime += deviceTime;
+	return 1;
+}
+
+
+/*
+ * Getter methods for the payload layout
+ *
+ */
+int ByteStore::getBlockBytes(){
+	return blockBytes;
+}
+
+int ByteStore::getEntryBytes(){
+	return entryBytes;
+}
+
+size_t ByteStore::getSlabBytes(){
+	return slabBytes;
+}
+
+
+/*
+ * Prints the throughput of the byte operations
+ *	Bytes per second are taken over the simulated device time, so the
+ *	figures of the allocation methods can be compared.
+ *
+ * Input:
+ *		method - Allocation method of the disk
+ *
+ * Output:
+ *		Bytes moved, simulated time and throughput of writes and reads
+ */
+void ByteStore::printStats(int method){
+	streamsize defaultPrecision = cout.precision();
+	cout << fixed << setprecision(1);
+	cout << "Byte mode (allocation method " << method << ", " << blockBytes << "-byte blocks of " << blockSize << " entries of " << entryBytes << " bytes)" << endl;
+	cout << "\t> Slab: " << slabBytes << " bytes, aligned to " << byteSlabAlignment << endl;
+	cout << "\t> Writes: " << numWrites << ", " << bytesWritten << " bytes in " << writeTime << " us";
+	if (writeTime > 0){
+		cout << " (" << bytesWritten / writeTime << " MB/s)";
+	}
+	cout << endl << "\t> Reads: " << numReads << ", " << bytesRead << " bytes in " << readTime << " us";
+	if (readTime > 0){
+		cout << " (" << bytesRead / readTime << " MB/s)";
+	}
+	cout << endl << endl;
+	cout.unsetf(ios::floatfield);
+	cout.precision(defaultPrecision);
+}
+
+
+/*
+ * Checksum of the bytes in a list of views (32-bit FNV-1a)
+ *	Lets a trace check that the bytes read back are the bytes written.
+ *
+ * Input:
+ *		views - Views of the bytes
+ *
+ * Returns:
+ *		Checksum of the bytes in order
+ */
+unsigned int ByteStore::checksum(vector<std::span<const uint8_t> > &views){
+	unsigned int hash = 2166136261u;
+	for (int i=0;i<views.size();i++){
+		for (int j=0;j<views[i].size();j++){
+			hash = (hash ^ views[i][j]) * 16777619u;
+		}
+	}
+	return hash;
+}
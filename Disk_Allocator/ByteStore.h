@@ -0,0 +1,60 @@
+// ByteStore.h
+#ifndef BYTESTORE_H
+#define BYTESTORE_H
+#pragma once
+
+// Payload sizes of a block in byte mode (bytes, powers of 2)
+#define byteBlockMinBytes 512
+#define byteBlockMaxBytes 65536
+// Alignment of the byte slab (a page of the device)
+#define byteSlabAlignment 4096
+
+/*
+ * Byte payloads of the disk blocks
+ *	In byte mode every block holds blockBytes real bytes instead of
+ *	blockSize ints. The bytes of all blocks are kept in one aligned
+ *	slab, block b at (b-1)*blockBytes, so the slab is an image of the
+ *	disk. Each entry of a block covers entryBytes of the block's
+ *	payload and its data holds the number of those bytes in use, so
+ *	the allocation methods place a byte file like any other file.
+ *	Reads return read-only views into the slab and copy nothing.
+ */
+class ByteStore{
+	// Private variables for ByteStore
+	uint8_t* slab;				// Bytes of every block
+	size_t slabBytes;			// Size of the slab
+	int blockSize;				// Entries in a block
+	int blockBytes;				// Bytes in a block
+	int entryBytes;				// Bytes covered by an entry
+	long numWrites;				// Byte files written
+	long bytesWritten;			// Bytes written by all writes
+	double writeTime;			// Simulated device time of all writes (us)
+	long numReads;				// Byte reads
+	long bytesRead;				// Bytes read by all reads
+	double readTime;			// Simulated device time of all reads (us)
+public:
+	// Constructors/Destructors
+	ByteStore(int numBlocks, int entriesPerBlock, int payloadBytes);
+	~ByteStore();
+
+	// Slab methods
+	uint8_t* getEntry(int dataAddr);
+	int writeEntry(int dataAddr, std::span<const uint8_t> bytes);
+	int moveBlocks(int fromBlock, int toBlock, int numBlocks);
+	int addView(vector<std::span<const uint8_t> > &views, int dataAddr, int firstByte, int numBytes);
+
+	// Throughput methods
+	int recordWrite(long numBytes, double deviceTime);
+	int recordRead(long numBytes, double deviceTime);
+
+	// Getter methods
+	int getBlockBytes();
+	int getEntryBytes();
+	size_t getSlabBytes();
+
+	// Printing methods
+	void printStats(int method);
+	static unsigned int checksum(vector<std::span<const uint8_t> > &views);
+};
+
+#endif
@@ -0,0 +1,234 @@
+#include "Header.h"				// Header file
+#include "VirtualDisk.h"		// VirtualDisk file
+#include "DeviceModel.h"		// DeviceModel file
+#include "Defragmenter.h"		// Defragmenter file
+#include "RequestScheduler.h"	// RequestScheduler file
+#include "IoRing.h"				// IoRing file
+#include "StripedVolume.h"		// StripedVolume file
+#include "InstructionFile.h"	// InstructionFile file
+#include "ClientExecutor.h"		// ClientExecutor file
+
+// Compiler Directive
+using namespace std;
+
+
+/*
+ * Contructor for ClientExecutor
+ *
+ */
+ClientExecutor::ClientExecutor(VirtualDisk* disk, int policyType){
+	currentDisk = disk;
+	policy = policyType;
+	lastClient = -1;
+	clock = 0;
+	numSwitches = 0;
+}
+
+ClientExecutor::~ClientExecutor(){
+	// Destroy the coroutines before the instructions they use
+	tasks.clear();
+	for (int i=0;i<clients.size();i++){
+		delete clients[i].instructions;
+	}
+}
+
+
+/*
+ * Loads an instruction file as a new client
+ *
+ * Input:
+ *		fileName - Instruction file of the client
+ *		weight - Share of the client (weighted) or requests per ms (timestamp)
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if the file cannot be read
+ */
+int ClientExecutor::addClient(std::string fileName, int weight){
+	if (weight < 1){
+		cerr << "Error: Weight of client " << fileName << " has to be at least 1." << endl;
+		return 0;
+	}
+	InstructionFile* instructions = new InstructionFile(currentDisk, fileName);
+	if (!instructions->hasNextInstruction()){
+		cerr << "Error: No instructions found for client " << fileName << "." << endl;
+		delete instructions;
+		return 0;
+	}
+	Client newClient;
+	newClient.fileName = fileName;
+	newClient.instructions = instructions;
+	newClient.weight = weight;
+	newClient.readyTime = 0;
+	newClient.currentWeight = 0;
+	newClient.numOps = 0;
+	newClient.serviceTime = 0;
+	clients.push_back(newClient);
+	tasks.push_back(runClient(instructions));
+	return 1;
+}
+
+
+/*
+ * Coroutine body of a client
+ *	Suspends before every instruction until the executor picks the
+ *	client.
+ *
+ * Input:
+ *		instructions - Parsed instructions of the client
+ *
+ */
+ClientTask ClientExecutor::runClient(InstructionFile* instructions){
+	while (instructions->hasNextInstruction()){
+		// Wait for the client's turn
+		co_await std::suspend_always{};
+		instructions->executeNextInstruction();
+	}
+}
+
+
+/*
+ * Picks the client to run next according to the policy
+ *
+ * Returns:
+ *		Client number ('-1' if every client has finished)
+ */
+int ClientExecutor::pickClient(){
+	int picked = -1;
+	switch (policy){
+		case (clientRoundRobin): {
+			// Next unfinished client after the last one picked
+			for (int i=1;i<=clients.size();i++){
+				int client = (lastClient + i) % clients.size();
+				if (!tasks[client].handle.done()){
+					picked = client;
+					break;
+				}
+			}
+			break;
+		}
+		case (clientWeighted): {
+			// Smooth weighted round-robin - every client gains its weight and the leader pays the total
+			int totalWeight = 0;
+			for (int i=0;i<clients.size();i++){
+				if (!tasks[i].handle.done()){
+					clients[i].currentWeight += clients[i].weight;
+					totalWeight += clients[i].weight;
+					if (picked == -1 || clients[i].currentWeight > clients[picked].currentWeight){
+						picked = i;
+					}
+				}
+			}
+			if (picked != -1){
+				clients[picked].currentWeight -= totalWeight;
+			}
+			break;
+		}
+		case (clientTimestamp): {
+			// Earliest issued instruction
+			for (int i=0;i<clients.size();i++){
+				if (!tasks[i].handle.done() && (picked == -1 || clients[i].readyTime < clients[picked].readyTime)){
+					picked = i;
+				}
+			}
+			break;
+		}
+	}
+	lastClient = picked;
+	return picked;
+}
+
+
+/*
+ * Runs every client to the end
+ *	Each pick resumes one client coroutine for one instruction. The
+ *	device time the instruction uses keeps the disk busy, and the
+ *	client's next instruction is issued on completion (round-robin and
+ *	weighted) or at the client's rate (timestamp).
+ *
+ * Returns:
+ *		Number of instructions run
+ */
+int ClientExecutor::run(){
+	int numRun = 0;
+	int client = pickClient();
+	while (client != -1){
+		DeviceModel* device = currentDisk->getDeviceModel();
+		double startBusyTime = device->getBusyTime();
+		// Idle until the instruction is issued
+		clock = max(clock, clients[client].readyTime);
+		tasks[client].handle.resume();
+		numSwitches++;
+		// A new device model starts its busy time from 0
+		double serviceTime = currentDisk->getDeviceModel() == device ? device->getBusyTime() - startBusyTime : currentDisk->getDeviceModel()->getBusyTime();
+		clock += serviceTime;
+		clients[client].serviceTime += serviceTime;
+		clients[client].latencies.push_back(clock - clients[client].readyTime);
+		clients[client].numOps++;
+		if (policy == clientTimestamp){
+			// Open loop - the next instruction is issued at the client's rate
+			clients[client].readyTime += 1000.00 / clients[client].weight;
+		} else {
+			// Closed loop - the next instruction is issued when this one completes
+			clients[client].readyTime = clock;
+		}
+		numRun++;
+		client = pickClient();
+	}
+	return numRun;
+}
+
+
+/*
+ * Getter method for the name of the policy
+ *
+ * Returns:
+ *		Name of the interleaving policy
+ */
+std::string ClientExecutor::getName(){
+	switch (policy){
+		case (clientRoundRobin): return "Round-robin";
+		case (clientWeighted): return "Weighted";
+		case (clientTimestamp): return "Timestamp";
+	}
+	return "None";
+}
+
+
+/*
+ * Prints the statistics of every client
+ *	Fairness is Jain's index over the device time every client used
+ *	per unit of weight, '1' when the disk is shared in proportion to
+ *	the weights.
+ *
+ * Output:
+ *		Instructions, mean and p99 latency and device time of every client
+ *		Jain's fairness index
+ */
+void ClientExecutor::printStats(){
+	streamsize defaultPrecision = cout.precision();
+	double shareSum = 0;
+	double shareSquareSum = 0;
+	cout << "Multi-client executor (" << getName() << ", " << clients.size() << " client(s), " << numSwitches << " switch(es))" << endl;
+	cout << fixed << setprecision(1);
+	for (int i=0;i<clients.size();i++){
+		vector<double> sortedLatencies = clients[i].latencies;
+		sort(sortedLatencies.begin(), sortedLatencies.end());
+		double totalLatency = 0;
+		for (int j=0;j<sortedLatencies.size();j++){
+			totalLatency += sortedLatencies[j];
+		}
+		int p99 = max((int)ceil(sortedLatencies.size() * 0.99) - 1, 0);
+		cout << "\t> Client " << i+1 << " (" << clients[i].fileName << ", weight " << clients[i].weight << "): ";
+		cout << clients[i].numOps << " instruction(s), mean latency " << totalLatency / max((int)sortedLatencies.size(), 1) << " us, ";
+		cout << "p99 latency " << (sortedLatencies.empty() ? 0 : sortedLatencies[p99]) << " us, device time " << clients[i].serviceTime << " us" << endl;
+		double share = clients[i].serviceTime / clients[i].weight;
+		shareSum += share;
+		shareSquareSum += share * share;
+	}
+	cout << "\t> Total simulated time: " << clock << " us" << endl;
+	cout << setprecision(3) << "\t> Jain's fairness index: " << (shareSquareSum > 0 ? shareSum * shareSum / (clients.size() * shareSquareSum) : 1.00) << endl;
+	cout << endl;
+	cout.unsetf(ios::floatfield);
+	cout.precision(defaultPrecision);
+}
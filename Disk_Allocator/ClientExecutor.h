@@ -0,0 +1,84 @@
+// ClientExecutor.h
+#ifndef CLIENTEXECUTOR_H
+#define CLIENTEXECUTOR_H
+#pragma once
+
+// Client interleaving policies
+#define clientRoundRobin 1
+#define clientWeighted 2
+#define clientTimestamp 3
+
+/*
+ * Coroutine of one client
+ *	The coroutine runs up to its first instruction and suspends. Every
+ *	resume runs one instruction and suspends before the next one, or
+ *	finishes after the last one. Switching clients is a coroutine
+ *	resume, so no threads or stacks are involved.
+ */
+struct ClientTask{
+	struct promise_type{
+		ClientTask get_return_object(){ return ClientTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+		std::suspend_never initial_suspend(){ return {}; }
+		std::suspend_always final_suspend() noexcept { return {}; }
+		void return_void(){}
+		void unhandled_exception(){ std::terminate(); }
+	};
+	std::coroutine_handle<promise_type> handle;
+	ClientTask(std::coroutine_handle<promise_type> h) : handle(h){}
+	ClientTask(ClientTask &&other) : handle(other.handle){ other.handle = NULL; }
+	ClientTask(const ClientTask&) = delete;
+	~ClientTask(){ if (handle){ handle.destroy(); } }
+};
+
+// Per-client state and statistics
+typedef struct Client {
+	std::string fileName;		// Instruction file of the client
+	InstructionFile* instructions;	// Parsed instructions of the client
+	int weight;					// Share (weighted) or requests per ms (timestamp)
+	double readyTime;			// Time the client's next instruction is issued (us)
+	int currentWeight;			// Smooth weighted round-robin counter
+	long numOps;				// Instructions completed
+	double serviceTime;			// Device time used by the client (us)
+	vector<double> latencies;	// Latency of every instruction (us)
+} Client;
+
+/*
+ * Multi-client trace interleaver
+ *	Several instruction files run as independent clients against one
+ *	virtual disk. The policy decides which client runs its next
+ *	instruction:
+ *		Round-robin - one instruction per client in turn
+ *		Weighted - smooth weighted round-robin by client weight
+ *		Timestamp - clients issue instructions at a fixed rate and the
+ *			earliest issued instruction runs first
+ *	In round-robin and weighted modes every client keeps one
+ *	instruction outstanding and issues the next when the previous one
+ *	completes. An instruction's latency runs from its issue to its
+ *	completion on the simulated device clock.
+ */
+class ClientExecutor{
+	// Private variables for ClientExecutor
+	VirtualDisk* currentDisk;
+	int policy;
+	vector<Client> clients;
+	vector<ClientTask> tasks;
+	int lastClient;				// Client picked last (round-robin)
+	double clock;				// Simulated time (us)
+	long numSwitches;			// Coroutine resumes
+	ClientTask runClient(InstructionFile* instructions);
+	int pickClient();
+public:
+	// Constructors/Destructors
+	ClientExecutor(VirtualDisk* disk, int policyType);
+	~ClientExecutor();
+
+	// General methods
+	int addClient(std::string fileName, int weight);
+	int run();
+	std::string getName();
+
+	// Printing methods
+	void printStats();
+};
+
+#endif
@@ -0,0 +1,442 @@
+#include "Header.h"				// Header file
+#include "DataKernels.h"		// DataKernels file
+
+// Compiler Directive
+using namespace std;
+
+#ifdef x86Kernels
+// Versions for an instruction set above the compiler's default
+#define targetSSE2 __attribute__((target("sse2")))
+#define targetAVX2 __attribute__((target("avx2")))
+#endif
+
+
+/*
+ * Instruction set of the kernels
+ *	The processor is checked once at start up.
+ *
+ */
+int DataKernels::compactTable[256][8];
+int DataKernels::supportedLevel = DataKernels::detectLevel();
+int DataKernels::level = DataKernels::supportedLevel;
+
+
+/*
+ * Finds the best instruction set of the processor
+ *	Also builds the lane table used by the AVX2 compaction.
+ *
+ * Returns:
+ *		kernelAVX2, kernelSSE2 or kernelScalar
+ */
+int DataKernels::detectLevel(){
+	for (int mask=0;mask<256;mask++){
+		// Lanes of the set bits first, in lane order
+		int numLanes = 0;
+		for (int lane=0;lane<8;lane++){
+			if (mask & (1 << lane)){
+				compactTable[mask][numLanes++] = lane;
+			}
+		}
+		while (numLanes < 8){
+			compactTable[mask][numLanes++] = 0;
+		}
+	}
+#ifdef x86Kernels
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")){
+		return kernelAVX2;
+	}
+	if (__builtin_cpu_supports("sse2")){
+		return kernelSSE2;
+	}
+#endif
+	return kernelScalar;
+}
+
+
+/*
+ * Sets the empty sentinel (-1) as the data of a range of entries
+ *	The index, block and length of the entries are left as they are.
+ *
+ * Input:
+ *		entries - First entry of the range
+ *		numEntries - Number of entries
+ *
+ * Returns:
+ *		Number of entries cleared
+ */
+int DataKernels::fillEmpty(Data* entries, int numEntries){
+	switch (level){
+		case (kernelAVX2): {
+			return fillEmptyAVX2(entries, numEntries);
+		}
+		case (kernelSSE2): {
+			return fillEmptySSE2(entries, numEntries);
+		}
+	}
+	return fillEmptyScalar(entries, numEntries);
+}
+
+
+/*
+ * Counts the entries of a range holding data (not -1)
+ *
+ * Input:
+ *		entries - First entry of the range
+ *		numEntries - Number of entries
+ *
+ * Returns:
+ *		Number of entries holding data
+ */
+int DataKernels::countData(Data* entries, int numEntries){
+	switch (level){
+		case (kernelAVX2): {
+			return countDataAVX2(entries, numEntries);
+		}
+		case (kernelSSE2): {
+			return countDataSSE2(entries, numEntries);
+		}
+	}
+	return countDataScalar(entries, numEntries);
+}
+
+
+/*
+ * Copies the data of the entries holding data out of a range
+ *	The values keep the order of their entries.
+ *
+ * Input:
+ *		entries - First entry of the range
+ *		numEntries - Number of entries
+ *
+ * Output:
+ *		values - Data of the entries holding data (room for numEntries + 8 values)
+ *
+ * Returns:
+ *		Number of values copied
+ */
+int DataKernels::compactData(Data* entries, int numEntries, int* values){
+	switch (level){
+		case (kernelAVX2): {
+			return compactDataAVX2(entries, numEntries, values);
+		}
+		case (kernelSSE2): {
+			return compactDataSSE2(entries, numEntries, values);
+		}
+	}
+	return compactDataScalar(entries, numEntries, values);
+}
+
+
+/*
+ * Finds the first run of free blocks in the free space bit map
+ *	The bit map is turned into masks of 32 blocks, and the runs of set
+ *	bits are walked a whole run at a time. A run may continue from one
+ *	mask into the next. No block past the end of the bit map is read.
+ *
+ * Input:
+ *		bitMap - Free space bit map (1 - free, 0 - used)
+ *		numBlocks - Number of blocks in the bit map
+ *		runLength - Number of free blocks needed in a row
+ *
+ * Returns:
+ *		First block of the run
+ *		'-1' if there is no such run
+ */
+int DataKernels::findFreeRun(int* bitMap, int numBlocks, int runLength){
+	int runStart = -1;
+	int runFound = 0;
+	for (int firstBlock=0;firstBlock<numBlocks;firstBlock+=32){
+		unsigned int freeMask;
+		switch (level){
+			case (kernelAVX2): {
+				freeMask = freeBitsAVX2(bitMap, numBlocks, firstBlock);
+				break;
+			}
+			case (kernelSSE2): {
+				freeMask = freeBitsSSE2(bitMap, numBlocks, firstBlock);
+				break;
+			}
+			default: {
+				freeMask = freeBitsScalar(bitMap, numBlocks, firstBlock);
+			}
+		}
+		int maskBlocks = min(32, numBlocks-firstBlock);
+		int position = 0;
+		while (position < maskBlocks){
+			if (runFound == 0){
+				// Skip the used blocks before the next run
+				unsigned int remaining = freeMask >> position;
+				if (remaining == 0){
+					break;
+				}
+				position += std::countr_zero(remaining);
+				runStart = firstBlock + position;
+			}
+			// Length of the free blocks from here
+			int freeBlocks = min(std::countr_one(freeMask >> position), maskBlocks-position);
+			runFound += freeBlocks;
+			position += freeBlocks;
+			if (runFound >= runLength){
+				return runStart;
+			}
+			if (position < maskBlocks){
+				// The run ends at a used block
+				runFound = 0;
+			}
+		}
+	}
+	return -1;
+}
+
+
+/*
+ * Scalar versions of the kernels
+ *	One entry or block at a time.
+ *
+ */
+int DataKernels::fillEmptyScalar(Data* entries, int numEntries){
+	for (int i=0;i<numEntries;i++){
+		entries[i].data = -1;
+	}
+	return numEntries;
+}
+
+int DataKernels::countDataScalar(Data* entries, int numEntries){
+	int numData = 0;
+	for (int i=0;i<numEntries;i++){
+		numData += entries[i].data != -1;
+	}
+	return numData;
+}
+
+int DataKernels::compactDataScalar(Data* entries, int numEntries, int* values){
+	int numValues = 0;
+	for (int i=0;i<numEntries;i++){
+		if (entries[i].data != -1){
+			values[numValues++] = entries[i].data;
+		}
+	}
+	return numValues;
+}
+
+unsigned int DataKernels::freeBitsScalar(int* bitMap, int numBlocks, int firstBlock){
+	unsigned int freeMask = 0;
+	for (int i=0;i<32 && firstBlock+i<numBlocks;i++){
+		freeMask |= (unsigned int)(bitMap[firstBlock+i] == 1) << i;
+	}
+	return freeMask;
+}
+
+
+#ifdef x86Kernels
+/*
+ * SSE2 versions of the kernels
+ *	The data of 4 entries is gathered into one register by unpacking
+ *	the upper halves of the entries.
+ *
+ */
+targetSSE2 int DataKernels::fillEmptySSE2(Data* entries, int numEntries){
+	// All ones (-1) in the data lane of an entry
+	__m128i emptyData = _mm_set_epi32(0, -1, 0, 0);
+	for (int i=0;i<numEntries;i++){
+		__m128i entry = _mm_loadu_si128((__m128i*)(entries+i));
+		_mm_storeu_si128((__m128i*)(entries+i), _mm_or_si128(entry, emptyData));
+	}
+	return numEntries;
+}
+
+targetSSE2 static inline __m128i gatherDataSSE2(Data* entries){
+	// (data, length) of entries 0 and 1, then of entries 2 and 3
+	__m128i upper01 = _mm_unpackhi_epi32(_mm_loadu_si128((__m128i*)entries), _mm_loadu_si128((__m128i*)(entries+1)));
+	__m128i upper23 = _mm_unpackhi_epi32(_mm_loadu_si128((__m128i*)(entries+2)), _mm_loadu_si128((__m128i*)(entries+3)));
+	// Data of entries 0 to 3
+	return _mm_unpacklo_epi64(upper01, upper23);
+}
+
+targetSSE2 int DataKernels::countDataSSE2(Data* entries, int numEntries){
+	__m128i empty = _mm_set1_epi32(-1);
+	int numData = 0;
+	int i = 0;
+	for (;i+4<=numEntries;i+=4){
+		int emptyMask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(gatherDataSSE2(entries+i), empty)));
+		numData += 4 - std::popcount((unsigned int)emptyMask);
+	}
+	return numData + countDataScalar(entries+i, numEntries-i);
+}
+
+targetSSE2 int DataKernels::compactDataSSE2(Data* entries, int numEntries, int* values){
+	__m128i empty = _mm_set1_epi32(-1);
+	int numValues = 0;
+	int i = 0;
+	for (;i+4<=numEntries;i+=4){
+		__m128i data = gatherDataSSE2(entries+i);
+		int emptyMask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(data, empty)));
+		if (emptyMask == 0){
+			// No empty entry, copy all 4
+			_mm_storeu_si128((__m128i*)(values+numValues), data);
+			numValues += 4;
+		} else if (emptyMask != 15){
+			int lanes[4];
+			_mm_storeu_si128((__m128i*)lanes, data);
+			for (int lane=0;lane<4;lane++){
+				if (!(emptyMask & (1 << lane))){
+					values[numValues++] = lanes[lane];
+				}
+			}
+		}
+	}
+	return numValues + compactDataScalar(entries+i, numEntries-i, values+numValues);
+}
+
+targetSSE2 unsigned int DataKernels::freeBitsSSE2(int* bitMap, int numBlocks, int firstBlock){
+	__m128i freeBlock = _mm_set1_epi32(1);
+	unsigned int freeMask = 0;
+	int i = 0;
+	for (;i<32 && firstBlock+i+4<=numBlocks;i+=4){
+		__m128i blocks = _mm_loadu_si128((__m128i*)(bitMap+firstBlock+i));
+		freeMask |= (unsigned int)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(blocks, freeBlock))) << i;
+	}
+	if (i < 32 && firstBlock+i < numBlocks){
+		// Blocks left at the end of the bit map
+		freeMask |= freeBitsScalar(bitMap, min(numBlocks, firstBlock+32), firstBlock+i) << i;
+	}
+	return freeMask;
+}
+
+
+/*
+ * AVX2 versions of the kernels
+ *	A register holds 2 entries. The data of 8 entries is gathered into
+ *	one register in the order 0 2 4 6 1 3 5 7 and put back in entry
+ *	order with a lane permutation.
+ *
+ */
+targetAVX2 int DataKernels::fillEmptyAVX2(Data* entries, int numEntries){
+	// All ones (-1) in the data lanes of both entries
+	__m256i emptyData = _mm256_set_epi32(0, -1, 0, 0, 0, -1, 0, 0);
+	int i = 0;
+	for (;i+2<=numEntries;i+=2){
+		__m256i entryPair = _mm256_loadu_si256((__m256i*)(entries+i));
+		_mm256_storeu_si256((__m256i*)(entries+i), _mm256_or_si256(entryPair, emptyData));
+	}
+	return i + fillEmptyScalar(entries+i, numEntries-i);
+}
+
+targetAVX2 static inline __m256i gatherDataAVX2(Data* entries){
+	__m256i upper = _mm256_unpackhi_epi32(_mm256_loadu_si256((__m256i*)entries), _mm256_loadu_si256((__m256i*)(entries+2)));
+	__m256i upperNext = _mm256_unpackhi_epi32(_mm256_loadu_si256((__m256i*)(entries+4)), _mm256_loadu_si256((__m256i*)(entries+6)));
+	// Data of entries 0 2 4 6 | 1 3 5 7, put back in entry order
+	return _mm256_permutevar8x32_epi32(_mm256_unpacklo_epi64(upper, upperNext), _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+}
+
+targetAVX2 int DataKernels::countDataAVX2(Data* entries, int numEntries){
+	__m256i empty = _mm256_set1_epi32(-1);
+	int numData = 0;
+	int i = 0;
+	for (;i+8<=numEntries;i+=8){
+		int emptyMask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(gatherDataAVX2(entries+i), empty)));
+		numData += 8 - std::popcount((unsigned int)emptyMask);
+	}
+	return numData + countDataScalar(entries+i, numEntries-i);
+}
+
+targetAVX2 int DataKernels::compactDataAVX2(Data* entries, int numEntries, int* values){
+	__m256i empty = _mm256_set1_epi32(-1);
+	int numValues = 0;
+	int i = 0;
+	for (;i+8<=numEntries;i+=8){
+		__m256i data = gatherDataAVX2(entries+i);
+		int keepMask = ~_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(data, empty))) & 255;
+		// Move the kept lanes to the front and store all 8
+		__m256i lanes = _mm256_loadu_si256((__m256i*)compactTable[keepMask]);
+		_mm256_storeu_si256((__m256i*)(values+numValues), _mm256_permutevar8x32_epi32(data, lanes));
+		numValues += std::popcount((unsigned int)keepMask);
+	}
+	return numValues + compactDataScalar(entries+i, numEntries-i, values+numValues);
+}
+
+targetAVX2 unsigned int DataKernels::freeBitsAVX2(int* bitMap, int numBlocks, int firstBlock){
+	__m256i freeBlock = _mm256_set1_epi32(1);
+	unsigned int freeMask = 0;
+	int i = 0;
+	for (;i<32 && firstBlock+i+8<=numBlocks;i+=8){
+		__m256i blocks = _mm256_loadu_si256((__m256i*)(bitMap+firstBlock+i));
+		freeMask |= (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(blocks, freeBlock))) << i;
+	}
+	if (i < 32 && firstBlock+i < numBlocks){
+		// Blocks left at the end of the bit map
+		freeMask |= freeBitsScalar(bitMap, min(numBlocks, firstBlock+32), firstBlock+i) << i;
+	}
+	return freeMask;
+}
+#else
+/*
+ * Processors without SSE2/AVX2 use the scalar versions
+ *
+ */
+int DataKernels::fillEmptySSE2(Data* entries, int numEntries){
+	return fillEmptyScalar(entries, numEntries);
+}
+
+int DataKernels::countDataSSE2(Data* entries, int numEntries){
+	return countDataScalar(entries, numEntries);
+}
+
+int DataKernels::compactDataSSE2(Data* entries, int numEntries, int* values){
+	return compactDataScalar(entries, numEntries, values);
+}
+
+unsigned int DataKernels::freeBitsSSE2(int* bitMap, int numBlocks, int firstBlock){
+	return freeBitsScalar(bitMap, numBlocks, firstBlock);
+}
+
+int DataKernels::fillEmptyAVX2(Data* entries, int numEntries){
+	return fillEmptyScalar(entries, numEntries);
+}
+
+int DataKernels::countDataAVX2(Data* entries, int numEntries){
+	return countDataScalar(entries, numEntries);
+}
+
+int DataKernels::compactDataAVX2(Data* entries, int numEntries, int* values){
+	return compactDataScalar(entries, numEntries, values);
+}
+
+unsigned int DataKernels::freeBitsAVX2(int* bitMap, int numBlocks, int firstBlock){
+	return freeBitsScalar(bitMap, numBlocks, firstBlock);
+}
+#endif
+
+
+/*
+ * Lowers (or raises) the instruction set of the kernels
+ *	The instruction set is capped at the best one the processor
+ *	supports.
+ *
+ * Input:
+ *		newLevel - kernelScalar, kernelSSE2 or kernelAVX2
+ *
+ * Returns:
+ *		Instruction set now in use
+ */
+int DataKernels::setLevel(int newLevel){
+	level = max(kernelScalar, min(newLevel, supportedLevel));
+	return level;
+}
+
+int DataKernels::getLevel(){
+	return level;
+}
+
+std::string DataKernels::getName(){
+	switch (level){
+		case (kernelAVX2): {
+			return "AVX2";
+		}
+		case (kernelSSE2): {
+			return "SSE2";
+		}
+	}
+	return "scalar";
+}
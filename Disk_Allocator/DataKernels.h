@@ -0,0 +1,52 @@
+// DataKernels.h
+#ifndef DATAKERNELS_H
+#define DATAKERNELS_H
+#pragma once
+
+// Instruction sets of the data kernels
+#define kernelScalar 0
+#define kernelSSE2 1
+#define kernelAVX2 2
+
+/*
+ * Bulk kernels over the disk data and the free space bit map
+ *	An entry of the disk data is 4 ints (index, block, data, length), so
+ *	one SSE2 register holds one entry and one AVX2 register holds two.
+ *	Every kernel has a scalar, an SSE2 and an AVX2 version. The best
+ *	version the processor supports is picked at start up, and can be
+ *	lowered to compare them.
+ */
+class DataKernels{
+	static int level;						// Instruction set in use
+	static int supportedLevel;				// Best instruction set of the processor
+	static int compactTable[256][8];		// Lanes to keep for every mask of 8 non-empty entries (AVX2)
+	static int detectLevel();
+	// Scalar versions
+	static int fillEmptyScalar(Data* entries, int numEntries);
+	static int countDataScalar(Data* entries, int numEntries);
+	static int compactDataScalar(Data* entries, int numEntries, int* values);
+	static unsigned int freeBitsScalar(int* bitMap, int numBlocks, int firstBlock);
+	// SSE2 versions
+	static int fillEmptySSE2(Data* entries, int numEntries);
+	static int countDataSSE2(Data* entries, int numEntries);
+	static int compactDataSSE2(Data* entries, int numEntries, int* values);
+	static unsigned int freeBitsSSE2(int* bitMap, int numBlocks, int firstBlock);
+	// AVX2 versions
+	static int fillEmptyAVX2(Data* entries, int numEntries);
+	static int countDataAVX2(Data* entries, int numEntries);
+	static int compactDataAVX2(Data* entries, int numEntries, int* values);
+	static unsigned int freeBitsAVX2(int* bitMap, int numBlocks, int firstBlock);
+public:
+	// Kernels
+	static int fillEmpty(Data* entries, int numEntries);
+	static int countData(Data* entries, int numEntries);
+	static int compactData(Data* entries, int numEntries, int* values);
+	static int findFreeRun(int* bitMap, int numBlocks, int runLength);
+
+	// Instruction set methods
+	static int setLevel(int newLevel);
+	static int getLevel();
+	static std::string getName();
+};
+
+#endif
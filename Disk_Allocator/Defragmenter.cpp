@@ -0,0 +1,449 @@
+#include "Header.h"				// Header file
+#include "VirtualDisk.h"
+#include "Defragmenter.h"		// Defragmenter file
+#include "SegmentLog.h"
+#include "ByteStore.h"
+#include "WriteBuffer.h"
+
+// Compiler Directive
+using namespace std;
+
+
+/*
+ * Contructor for Defragmenter
+ *	The defragmenter starts disabled (budget of 0 blocks)
+ *	until a budget is set with setBudget().
+ *
+ */
+Defragmenter::Defragmenter(VirtualDisk* disk){
+	currentDisk = disk;
+	blockBudget = 0;
+}
+
+
+/*
+ * Sets the relocation budget of each defragmentation step
+ *
+ * Input:
+ *		numBlocks - Maximum number of blocks relocated per step, 0 or less disables the defragmenter
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *
+ */
+int Defragmenter::setBudget(int numBlocks){
+	if (numBlocks > 0){
+		blockBudget = numBlocks;
+		currentDisk->getOut() << "Incremental defragmenter enabled with a budget of " << blockBudget << " block(s) per instruction." << endl << endl;
+	} else {
+		blockBudget = 0;
+		currentDisk->getOut() << "Incremental defragmenter disabled." << endl << endl;
+	}
+	return 1;
+}
+
+
+/*
+ * Getter method for the relocation budget
+ *
+ * Returns:
+ *		Maximum number of blocks relocated per step
+ *
+ */
+int Defragmenter::getBudget(){
+	return blockBudget;
+}
+
+
+/*
+ * Runs one incremental defragmentation step
+ *	This method relocates at most blockBudget blocks using the
+ *	pass matching the disk's allocation method. A relocation unit
+ *	(a contiguous file or a method 4 extent) is never split, so units
+ *	larger than the budget are left in place and no single step
+ *	moves more than blockBudget blocks.
+ *
+ * Returns:
+ *		Number of blocks relocated
+ *
+ */
+int Defragmenter::runStep(){
+	int blocksMoved = 0;
+	// Defragmenter disabled
+	if (blockBudget <= 0){
+		return 0;
+	}
+	// Reset the access time and simulated device time of the step
+	currentDisk->beginOperation();
+	switch (currentDisk->getAllocationMethod()){
+		case (1): {
+			// Allocation method 1 - Contiguous
+			blocksMoved = compactContiguous(blockBudget);
+			break;
+		}
+		case (2): {
+			// Allocation method 2 - Linked
+			blocksMoved = relinkLinked(blockBudget);
+			break;
+		}
+		case (3): {
+			// Allocation method 3 - Indexed
+			blocksMoved = regroupIndexed(blockBudget);
+			break;
+		}
+		case (4): {
+			// Allocation method 4 - Contiguous Indexed
+			blocksMoved = mergeExtents(blockBudget);
+			break;
+		}
+		case (5): {
+			// Allocation method 5 - Log-structured, clean segments in the background
+			blocksMoved = max(currentDisk->getLog()->makeSpace(0, blockBudget), 0);
+			break;
+		}
+	}
+	if (blocksMoved > 0){
+		currentDisk->getOut() << "Defragmentation step relocated " << blocksMoved << " block(s)." << endl;
+		currentDisk->printAccessTime();
+	}
+	return blocksMoved;
+}
+
+
+/*
+ * Contiguous compaction pass
+ *	Files are visited in order of their start block. A file is moved
+ *	to the lowest free run that can hold it (which may overlap its
+ *	current position) if that run starts before the file does. Repeated
+ *	steps slide every file towards the start of the disk, gathering the
+ *	free space into one run at the end.
+ *
+ * Input:
+ *		budget - Maximum number of blocks to relocate
+ *
+ * Returns:
+ *		Number of blocks relocated
+ */
+int Defragmenter::compactContiguous(int budget){
+	iNode* dir = currentDisk->getDir();
+	int blocksMoved = 0;
+	int targetBlock = 0;
+	vector<iNode*> files;
+	// Collect every used inode in the directory structure
+	for (int i=0; i < currentDisk->getDirSize(); i++){
+		if (dir[i].FileIdentifier != -1){
+			files.push_back(&dir[i]);
+		}
+		// Increment access time and charge the read to the device (Accessed memory)
+		currentDisk->accessBlock(0);
+	}
+	// Order files by their start block
+	std::sort(files.begin(), files.end(), [](iNode* a, iNode* b){ return a->StartBlock < b->StartBlock; });
+	for (int i=0; i < files.size(); i++){
+		// Skip files that do not fit in the remaining budget
+		if (files[i]->Length > budget - blocksMoved){
+			continue;
+		}
+		// Release the file's own blocks so that a free run overlapping it can be found
+		currentDisk->updateFreeSpace(files[i]->StartBlock, files[i]->Length, 1, true);
+		targetBlock = currentDisk->requestBlocks(files[i]->Length);
+		if (targetBlock != -1 && targetBlock < files[i]->StartBlock){
+			currentDisk->getOut() << "Defragmenter moved file " << files[i]->FileIdentifier << " from block " << files[i]->StartBlock << " to block " << targetBlock << endl;
+			// Copy the file down and mark the new run as used
+			moveBlocks(files[i]->StartBlock, targetBlock, files[i]->Length);
+			currentDisk->updateFreeSpace(targetBlock, files[i]->Length, 0);
+			discardFreed(files[i]->StartBlock, files[i]->Length);
+			blocksMoved += files[i]->Length;
+			// Update the file's inode in the directory structure
+			currentDisk->updateINode(files[i], files[i]->FileIdentifier, targetBlock, files[i]->Length);
+			// Increment access time and charge the write to the device (Accessed memory)
+			currentDisk->accessBlock(0, true);
+		} else {
+			// No lower position available, mark the file's blocks as used again
+			currentDisk->updateFreeSpace(files[i]->StartBlock, files[i]->Length, 0);
+		}
+	}
+	return blocksMoved;
+}
+
+
+/*
+ * Linked relinking pass
+ *	Each chain is walked from its head block. Whenever the next block
+ *	in the chain is not physically adjacent and the adjacent block is
+ *	free, the next block is moved there and the pointer in the current
+ *	block is relinked, so chains become sequential over time.
+ *
+ * Input:
+ *		budget - Maximum number of blocks to relocate
+ *
+ * Returns:
+ *		Number of blocks relocated
+ */
+int Defragmenter::relinkLinked(int budget){
+	iNode* dir = currentDisk->getDir();
+	Data* diskData = currentDisk->getData();
+	int blockSize = currentDisk->getBlockSize();
+	int blocksMoved = 0;
+	int currentBlock = 0;
+	int nextBlock = 0;
+	int pointerAddr = 0;
+	for (int i=0; i < currentDisk->getDirSize() && blocksMoved < budget; i++){
+		// Increment access time and charge the read to the device (Accessed memory)
+		currentDisk->accessBlock(0);
+		if (dir[i].FileIdentifier == -1){
+			continue;
+		}
+		currentBlock = dir[i].StartBlock;
+		// Walk the chain until the last block of the file
+		while (currentBlock != dir[i].LastBlock && blocksMoved < budget){
+			// Position of the next block pointer (last entry of the block)
+			pointerAddr = (currentBlock*blockSize) - blockSize + (blockSize-1);
+			nextBlock = diskData[pointerAddr].data;
+			// Increment access time and charge the read to the device (Accessed memory)
+			currentDisk->accessBlock(currentBlock);
+			if (nextBlock != currentBlock+1 && currentBlock+1 < currentDisk->getVCB()->totalBlockNum && currentDisk->isFreeBlock(currentBlock+1)){
+				currentDisk->getOut() << "Defragmenter relinked file " << dir[i].FileIdentifier << " block " << nextBlock << " to block " << currentBlock+1 << endl;
+				// Move the next block beside the current block and relink the pointer
+				moveBlocks(nextBlock, currentBlock+1, 1);
+				currentDisk->updateFreeSpace(currentBlock+1, 1, 0);
+				currentDisk->updateFreeSpace(nextBlock, 1, 1);
+				// Write the entry and charge the write to the device (Accessed memory)
+				currentDisk->writeEntry(pointerAddr, currentBlock+1);
+				if (nextBlock == dir[i].LastBlock){
+					// Moved the tail of the chain, update the file's inode
+					currentDisk->updateINode(&dir[i], dir[i].FileIdentifier, dir[i].StartBlock, currentBlock+1);
+					// Increment access time and charge the write to the device (Accessed memory)
+					currentDisk->accessBlock(0, true);
+				}
+				nextBlock = currentBlock+1;
+				blocksMoved++;
+			}
+			currentBlock = nextBlock;
+		}
+	}
+	return blocksMoved;
+}
+
+
+/*
+ * Indexed regrouping pass
+ *	The data blocks listed in each index block are moved so that they
+ *	follow the index block (and each other) whenever the adjacent block
+ *	is free, and the index block entries are updated accordingly.
+ *
+ * Input:
+ *		budget - Maximum number of blocks to relocate
+ *
+ * Returns:
+ *		Number of blocks relocated
+ */
+int Defragmenter::regroupIndexed(int budget){
+	iNode* dir = currentDisk->getDir();
+	Data* diskData = currentDisk->getData();
+	int blockSize = currentDisk->getBlockSize();
+	int blocksMoved = 0;
+	int indexBlockStartingAddr = 0;
+	int previousBlock = 0;
+	int entryBlock = 0;
+	for (int i=0; i < currentDisk->getDirSize() && blocksMoved < budget; i++){
+		// Increment access time and charge the read to the device (Accessed memory)
+		currentDisk->accessBlock(0);
+		if (dir[i].FileIdentifier == -1){
+			continue;
+		}
+		// Calculate direct position of index block in disk data
+		indexBlockStartingAddr = (dir[i].Index*blockSize) - blockSize;
+		previousBlock = dir[i].Index;
+		for (int j=0; j < blockSize && blocksMoved < budget; j++){
+			entryBlock = diskData[indexBlockStartingAddr+j].data;
+			// Increment access time and charge the read to the device (Accessed memory)
+			currentDisk->accessBlock(dir[i].Index);
+			if (entryBlock == -1){
+				break;
+			}
+			if (entryBlock != previousBlock+1 && previousBlock+1 < currentDisk->getVCB()->totalBlockNum && currentDisk->isFreeBlock(previousBlock+1)){
+				currentDisk->getOut() << "Defragmenter moved file " << dir[i].FileIdentifier << " block " << entryBlock << " to block " << previousBlock+1 << endl;
+				// Move the data block beside the previous block and update the index block entry
+				moveBlocks(entryBlock, previousBlock+1, 1);
+				currentDisk->updateFreeSpace(previousBlock+1, 1, 0);
+				currentDisk->updateFreeSpace(entryBlock, 1, 1);
+				// Write the entry and charge the write to the device (Accessed memory)
+				currentDisk->writeEntry(indexBlockStartingAddr+j, previousBlock+1);
+				entryBlock = previousBlock+1;
+				blocksMoved++;
+			}
+			previousBlock = entryBlock;
+		}
+	}
+	return blocksMoved;
+}
+
+
+/*
+ * Contiguous indexed extent merging pass
+ *	Neighbouring extents in an index block are merged into one entry.
+ *	Extents that already touch are merged without moving data; otherwise
+ *	the later extent is moved to the free run right after the earlier
+ *	one (when it fits in the budget) and then merged.
+ *
+ * Input:
+ *		budget - Maximum number of blocks to relocate
+ *
+ * Returns:
+ *		Number of blocks relocated
+ */
+int Defragmenter::mergeExtents(int budget){
+	iNode* dir = currentDisk->getDir();
+	Data* diskData = currentDisk->getData();
+	int blockSize = currentDisk->getBlockSize();
+	int totalBlockNum = currentDisk->getVCB()->totalBlockNum;
+	int blocksMoved = 0;
+	int indexBlockStartingAddr = 0;
+	int previousEnd = 0;
+	int extentBlock = 0;
+	int extentLength = 0;
+	bool merge = false;
+	for (int i=0; i < currentDisk->getDirSize() && blocksMoved < budget; i++){
+		// Increment access time and charge the read to the device (Accessed memory)
+		currentDisk->accessBlock(0);
+		if (dir[i].FileIdentifier == -1){
+			continue;
+		}
+		// Calculate direct position of index block in disk data
+		indexBlockStartingAddr = (dir[i].Index*blockSize) - blockSize;
+		int j = 1;
+		while (j < blockSize && diskData[indexBlockStartingAddr+j].data != -1){
+			previousEnd = diskData[indexBlockStartingAddr+j-1].data + diskData[indexBlockStartingAddr+j-1].length;
+			extentBlock = diskData[indexBlockStartingAddr+j].data;
+			extentLength = diskData[indexBlockStartingAddr+j].length;
+			// Increment access time and charge the reads to the device (Accessed memory)
+			currentDisk->accessBlock(dir[i].Index);
+			currentDisk->accessBlock(dir[i].Index);
+			merge = false;
+			if (extentBlock == previousEnd){
+				// Extents already touch, merge without moving data
+				merge = true;
+			} else if (extentLength <= budget - blocksMoved && previousEnd + extentLength <= totalBlockNum){
+				// Release the extent's own blocks so that an overlapping run can be checked
+				currentDisk->updateFreeSpace(extentBlock, extentLength, 1, true);
+				if (isFreeRun(previousEnd, extentLength)){
+					currentDisk->getOut() << "Defragmenter moved file " << dir[i].FileIdentifier << " extent at block " << extentBlock << " to block " << previousEnd << endl;
+					moveBlocks(extentBlock, previousEnd, extentLength);
+					currentDisk->updateFreeSpace(previousEnd, extentLength, 0);
+					discardFreed(extentBlock, extentLength);
+					blocksMoved += extentLength;
+					merge = true;
+				} else {
+					// Run after the previous extent is in use, mark the extent as used again
+					currentDisk->updateFreeSpace(extentBlock, extentLength, 0);
+				}
+			}
+			if (merge){
+				currentDisk->getOut() << "Defragmenter merged file " << dir[i].FileIdentifier << " extents at block " << diskData[indexBlockStartingAddr+j-1].data << endl;
+				// Grow the previous extent and shift the remaining index entries up
+				currentDisk->writeExtent(indexBlockStartingAddr+j-1, diskData[indexBlockStartingAddr+j-1].data, diskData[indexBlockStartingAddr+j-1].length+extentLength, false);
+				for (int k=j; k < blockSize-1; k++){
+					// Write the entry and charge the write to the device (Accessed memory)
+					currentDisk->writeExtent(indexBlockStartingAddr+k, diskData[indexBlockStartingAddr+k+1].data, diskData[indexBlockStartingAddr+k+1].length);
+				}
+				// Clear the last entry of the index block
+				currentDisk->writeExtent(indexBlockStartingAddr+blockSize-1, -1, -1);
+				// The file now has one extent less
+				pair<int,int> fileRecord = currentDisk->getFSStats()->fileExtents[dir[i].FileIdentifier];
+				currentDisk->recordFileStats(dir[i].FileIdentifier, fileRecord.first-1, fileRecord.second);
+			} else {
+				j++;
+			}
+		}
+	}
+	return blocksMoved;
+}
+
+
+/*
+ * Moves a run of blocks to a new position
+ *	The entries are buffered first, so the source and destination
+ *	runs may overlap. Source entries that are not overwritten are
+ *	set to -1 (unused). The free space bit map is not updated.
+ *
+ * Input:
+ *		fromBlock - First block of the run to move
+ *		toBlock - First block of the destination run
+ *		numBlocks - Length of the run in blocks
+ *
+ * Returns:
+ *		Number of entries moved
+ */
+int Defragmenter::moveBlocks(int fromBlock, int toBlock, int numBlocks){
+	Data* diskData = currentDisk->getData();
+	int blockSize = currentDisk->getBlockSize();
+	int fromAddr = (fromBlock*blockSize) - blockSize;
+	int toAddr = (toBlock*blockSize) - blockSize;
+	int numEntries = numBlocks*blockSize;
+	vector<Data> buffer(diskData+fromAddr, diskData+fromAddr+numEntries);
+	for (int i=0; i < numEntries; i++){
+		// Read the source entry and set it to -1 (unused)
+		currentDisk->writeExtent(fromAddr+i, -1, -1, false);
+		// Increment access time and charge the read to the device (Accessed memory)
+		currentDisk->accessBlock(fromBlock+i/blockSize);
+	}
+	for (int i=0; i < numEntries; i++){
+		// Write the entry to the destination block
+		currentDisk->writeExtent(toAddr+i, buffer[i].data, buffer[i].length);
+	}
+	if (currentDisk->getByteStore()){
+		// The bytes of the entries move with them
+		currentDisk->getByteStore()->moveBlocks(fromBlock, toBlock, numBlocks);
+	}
+	return numEntries;
+}
+
+
+/*
+ * Drops the buffered writes of the blocks a move left free
+ *	A run released with a temporary free keeps its buffered writes.
+ *	Once the run has moved, the blocks of it the destination does not
+ *	cover are free and never need to be written.
+ *
+ * Input:
+ *		startBlock - First block of the run moved
+ *		numBlocks - Length of the run in blocks
+ *
+ * Returns:
+ *		Number of blocks dropped from the write buffer
+ */
+int Defragmenter::discardFreed(int startBlock, int numBlocks){
+	WriteBuffer* writeBuffer = currentDisk->getWriteBuffer();
+	int numDiscarded = 0;
+	if (!writeBuffer){
+		return 0;
+	}
+	for (int i=startBlock; i < startBlock+numBlocks; i++){
+		if (currentDisk->isFreeBlock(i) && writeBuffer->isDirty(i)){
+			writeBuffer->discard(i);
+			numDiscarded++;
+		}
+	}
+	return numDiscarded;
+}
+
+
+/*
+ * Checks the free block map for a free run
+ *
+ * Input:
+ *		startBlock - First block of the run
+ *		numBlocks - Length of the run in blocks
+ *
+ * Returns:
+ *		true if every block of the run is free
+ */
+bool Defragmenter::isFreeRun(int startBlock, int numBlocks){
+	for (int i=startBlock; i < startBlock+numBlocks; i++){
+		if (i >= currentDisk->getVCB()->totalBlockNum || !currentDisk->isFreeBlock(i)){
+			return false;
+		}
+	}
+	return true;
+}
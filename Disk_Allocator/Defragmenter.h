@@ -0,0 +1,29 @@
+// Defragmenter.h
+#ifndef DEFRAGMENTER_H
+#define DEFRAGMENTER_H
+#pragma once
+
+class Defragmenter{
+	// Private variables for Defragmenter
+	VirtualDisk* currentDisk;
+	int blockBudget;
+public:
+	// Function declarations/prototypes
+	Defragmenter(VirtualDisk* disk);
+	int setBudget(int numBlocks);
+	int getBudget();
+	int runStep();
+
+	// Per allocation method relocation passes
+	int compactContiguous(int budget);
+	int relinkLinked(int budget);
+	int regroupIndexed(int budget);
+	int mergeExtents(int budget);
+
+	// Utility methods
+	int moveBlocks(int fromBlock, int toBlock, int numBlocks);
+	bool isFreeRun(int startBlock, int numBlocks);
+	int discardFreed(int startBlock, int numBlocks);
+};
+
+#endif
@@ -0,0 +1,212 @@
+#include "Header.h"				// Header file
+#include "DeviceModel.h"		// DeviceModel file
+
+// Compiler Directive
+using namespace std;
+
+
+/*
+ * Contructor for DeviceModel
+ *	The head starts parked at block 0 (superblock).
+ *
+ */
+DeviceModel::DeviceModel(int totalBlocks){
+	numBlocks = totalBlocks;
+	headBlock = 0;
+	numRequests = 0;
+	headMovement = 0;
+	busyTime = 0;
+}
+
+DeviceModel::~DeviceModel(){
+}
+
+
+/*
+ * Charges one access to the device
+ *	If the access continues from the previous access (same block or
+ *	the next block) it is streamed and only the transfer is charged.
+ *	Otherwise a new device request is positioned at the block first.
+ *
+ * Input:
+ *		block - Block being accessed
+ *		numBytes - Number of bytes transferred
+ *		write - true for a write, false for a read
+ *
+ * Returns:
+ *		Simulated time of the access in microseconds
+ */
+double DeviceModel::access(int block, int numBytes, bool write){
+	double accessTime = 0;
+	if (block != headBlock && block != headBlock+1){
+		// Non-sequential access, position the device at the block
+		accessTime += positionTime(block, write);
+		numRequests++;
+	}
+	headMovement += abs(block - headBlock);
+	headBlock = block;
+	accessTime += transferTime(numBytes, write);
+	busyTime += accessTime;
+	return accessTime;
+}
+
+
+/*
+ * Positions the device at a block without transferring data
+ *
+ * Input:
+ *		block - Block to move the head to
+ *
+ * Returns:
+ *		Simulated time of the positioning in microseconds
+ */
+double DeviceModel::seek(int block){
+	double seekTime = positionTime(block, false);
+	numRequests++;
+	headMovement += abs(block - headBlock);
+	headBlock = block;
+	busyTime += seekTime;
+	return seekTime;
+}
+
+
+/*
+ * Getter method for the head position
+ *
+ * Returns:
+ *		Block of the last access
+ *
+ */
+int DeviceModel::getHeadBlock(){
+	return headBlock;
+}
+
+
+/*
+ * Getter method for the number of device requests
+ *
+ * Returns:
+ *		Number of positioned (non-sequential) accesses
+ *
+ */
+long DeviceModel::getNumRequests(){
+	return numRequests;
+}
+
+
+/*
+ * Getter method for the head movement
+ *
+ * Returns:
+ *		Total number of blocks travelled by the head
+ *
+ */
+long DeviceModel::getHeadMovement(){
+	return headMovement;
+}
+
+
+/*
+ * Getter method for the busy time
+ *
+ * Returns:
+ *		Total simulated time of all accesses in microseconds
+ *
+ */
+double DeviceModel::getBusyTime(){
+	return busyTime;
+}
+
+
+
+
+/*
+ * Hard disk drive (7200 RPM, 150 MB/s media rate)
+ *	Seek time grows with the square root of the seek distance, from
+ *	the track-to-track time up to the full stroke time across the
+ *	whole virtual disk. Every positioned access also waits on average
+ *	half a revolution for the sector to rotate under the head.
+ *
+ */
+HDDModel::HDDModel(int totalBlocks) : DeviceModel(totalBlocks){
+}
+
+std::string HDDModel::getName(){
+	return "HDD";
+}
+
+double HDDModel::positionTime(int block, bool write){
+	double trackToTrack = 800;		// Track to track seek (us)
+	double fullStroke = 15000;		// Full stroke seek (us)
+	double halfRotation = 4167;		// Half a revolution at 7200 RPM (us)
+	double seekTime = 0;
+	int distance = abs(block - headBlock);
+	if (distance > 0){
+		seekTime = trackToTrack + (fullStroke - trackToTrack) * sqrt(distance*1.00 / max(numBlocks-1, 1));
+	}
+	return seekTime + halfRotation;
+}
+
+double HDDModel::transferTime(int numBytes, bool write){
+	// 150 MB/s = 150 bytes per microsecond
+	return numBytes / 150.00;
+}
+
+
+
+
+/*
+ * SATA solid state drive (550 MB/s interface)
+ *	No mechanical positioning, each request pays the flash read or
+ *	program latency plus the SATA command overhead.
+ *
+ */
+SATASSDModel::SATASSDModel(int totalBlocks) : DeviceModel(totalBlocks){
+}
+
+std::string SATASSDModel::getName(){
+	return "SATA SSD";
+}
+
+double SATASSDModel::positionTime(int block, bool write){
+	if (write){
+		// Write request latency (us)
+		return 60;
+	}
+	// Read request latency (us)
+	return 90;
+}
+
+double SATASSDModel::transferTime(int numBytes, bool write){
+	// 550 MB/s = 550 bytes per microsecond
+	return numBytes / 550.00;
+}
+
+
+
+
+/*
+ * NVMe solid state drive (3500 MB/s interface)
+ *	No mechanical positioning and a much shorter command path than SATA.
+ *
+ */
+NVMeModel::NVMeModel(int totalBlocks) : DeviceModel(totalBlocks){
+}
+
+std::string NVMeModel::getName(){
+	return "NVMe";
+}
+
+double NVMeModel::positionTime(int block, bool write){
+	if (write){
+		// Write request latency (us)
+		return 15;
+	}
+	// Read request latency (us)
+	return 20;
+}
+
+double NVMeModel::transferTime(int numBytes, bool write){
+	// 3500 MB/s = 3500 bytes per microsecond
+	return numBytes / 3500.00;
+}
@@ -0,0 +1,72 @@
+// DeviceModel.h
+#ifndef DEVICEMODEL_H
+#define DEVICEMODEL_H
+#pragma once
+
+// Size of a virtual disk block on the simulated device (bytes)
+#define deviceBlockBytes 4096
+
+/*
+ * Base class for simulated storage devices
+ *	A device charges a positioning cost whenever an access does not
+ *	continue from the previously accessed block (the same block or the
+ *	next one), plus a transfer cost for the bytes moved. Derived classes
+ *	supply both costs in microseconds.
+ */
+class DeviceModel{
+protected:
+	int numBlocks;			// Number of blocks on the device
+	int headBlock;			// Block of the last access (head position)
+	long numRequests;		// Number of device requests (positioned accesses)
+	long headMovement;		// Total blocks travelled by the head
+	double busyTime;		// Total simulated time of all accesses (us)
+public:
+	// Constructors/Destructors
+	DeviceModel(int totalBlocks);
+	virtual ~DeviceModel();
+
+	// Device specific costs
+	virtual std::string getName() = 0;
+	virtual double positionTime(int block, bool write) = 0;
+	virtual double transferTime(int numBytes, bool write) = 0;
+
+	// General methods
+	double access(int block, int numBytes, bool write);
+	double seek(int block);
+	int getHeadBlock();
+	long getNumRequests();
+	long getHeadMovement();
+	double getBusyTime();
+};
+
+
+// Hard disk drive - seek distance + rotational latency + media transfer
+class HDDModel : public DeviceModel{
+public:
+	HDDModel(int totalBlocks);
+	std::string getName();
+	double positionTime(int block, bool write);
+	double transferTime(int numBytes, bool write);
+};
+
+
+// SATA solid state drive - command latency + SATA transfer
+class SATASSDModel : public DeviceModel{
+public:
+	SATASSDModel(int totalBlocks);
+	std::string getName();
+	double positionTime(int block, bool write);
+	double transferTime(int numBytes, bool write);
+};
+
+
+// NVMe solid state drive - command latency + PCIe transfer
+class NVMeModel : public DeviceModel{
+public:
+	NVMeModel(int totalBlocks);
+	std::string getName();
+	double positionTime(int block, bool write);
+	double transferTime(int numBytes, bool write);
+};
+
+#endif
@@ -0,0 +1,653 @@
+#include "Header.h"				// Header file
+#include "VirtualDisk.h"
+#include "DirectoryTree.h"		// DirectoryTree file
+
+// Compiler Directive
+using namespace std;
+
+
+/*
+ * Contructor for DirectoryTree
+ *	The tree starts empty, without any metadata block.
+ *
+ * Input:
+ *		disk - Disk the metadata blocks are taken from (NULL for a tree off the disk)
+ *		keysPerNode - Most keys in a node (entries in a metadata block)
+ *
+ */
+DirectoryTree::DirectoryTree(VirtualDisk* disk, int keysPerNode){
+	currentDisk = disk;
+	maxKeys = max(keysPerNode, directoryMinNodeKeys);
+	minKeys = maxKeys / 2;
+	root = -1;
+	height = 0;
+	numFiles = 0;
+}
+
+
+/*
+ * Creates a node in a new metadata block
+ *	insert checks that there are enough free blocks for every node it
+ *	may create before it changes the tree.
+ *
+ * Input:
+ *		leaf - Whether the node is a leaf
+ *
+ * Returns:
+ *		Number of the node
+ *		'-1' if no block is free
+ */
+int DirectoryTree::newNode(bool leaf){
+	int block = -1;
+	if (currentDisk){
+		// Take a free block and mark it as used
+		block = currentDisk->requestBlocks(1);
+		if (block == -1){
+			return -1;
+		}
+		currentDisk->updateFreeSpace(block, 1, 0);
+	}
+	int node;
+	if (!freeNodes.empty()){
+		// Reuse a node merged away earlier
+		node = freeNodes.back();
+		freeNodes.pop_back();
+	} else {
+		node = nodes.size();
+		nodes.push_back(DirectoryNode());
+	}
+	nodes[node].leaf = leaf;
+	nodes[node].block = block;
+	nodes[node].keys.clear();
+	nodes[node].children.clear();
+	nodes[node].next = -1;
+	if (block != -1){
+		blockNodes[block] = node;
+	}
+	writeNode(node);
+	return node;
+}
+
+
+/*
+ * Removes a node from the tree and frees its metadata block
+ *
+ * Input:
+ *		node - Node to free
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int DirectoryTree::freeNode(int node){
+	if (nodes[node].block != -1){
+		blockNodes.erase(nodes[node].block);
+		currentDisk->updateFreeSpace(nodes[node].block, 1, 1);
+		// The block is not written back once freed
+		lastWrites.erase(std::remove(lastWrites.begin(), lastWrites.end(), nodes[node].block), lastWrites.end());
+	}
+	nodes[node].keys.clear();
+	nodes[node].children.clear();
+	freeNodes.push_back(node);
+	return 1;
+}
+
+
+/*
+ * Records the metadata block of a changed node
+ *	The disk charges the write of every block recorded by the operation.
+ *
+ * Input:
+ *		node - Node changed
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int DirectoryTree::writeNode(int node){
+	int block = nodes[node].block;
+	if (block != -1 && std::find(lastWrites.begin(), lastWrites.end(), block) == lastWrites.end()){
+		lastWrites.push_back(block);
+	}
+	return 1;
+}
+
+
+/*
+ * Walks from the root to the leaf that holds a file name
+ *	The metadata block of every node visited is recorded as read.
+ *
+ * Input:
+ *		fileName - File name to look for
+ *
+ * Returns:
+ *		Leaf node
+ *		'-1' if the directory is empty
+ */
+int DirectoryTree::findLeaf(int64_t fileName){
+	int node = root;
+	lastPath.clear();
+	while (node != -1){
+		if (nodes[node].block != -1){
+			lastPath.push_back(nodes[node].block);
+		}
+		if (nodes[node].leaf){
+			return node;
+		}
+		// Follow the child whose range holds the file name
+		int i = std::upper_bound(nodes[node].keys.begin(), nodes[node].keys.end(), fileName) - nodes[node].keys.begin();
+		node = nodes[node].children[i];
+	}
+	return -1;
+}
+
+
+/*
+ * Looks up the inode of a file
+ *
+ * Input:
+ *		fileName - File name to look for
+ *
+ * Returns:
+ *		Pointer to the inode
+ *		NULL if the file is not in the directory
+ */
+iNode* DirectoryTree::find(int64_t fileName){
+	int leaf = findLeaf(fileName);
+	if (leaf == -1){
+		return NULL;
+	}
+	vector<int64_t> &keys = nodes[leaf].keys;
+	int pos = std::lower_bound(keys.begin(), keys.end(), fileName) - keys.begin();
+	if (pos < keys.size() && keys[pos] == fileName){
+		return &slots[nodes[leaf].children[pos]];
+	}
+	return NULL;
+}
+
+
+/*
+ * Adds a file to the directory
+ *	The file gets an inode holding only its file name, the add kernel
+ *	fills in the rest. A full node is split into a new node, and the
+ *	first key of the new node (or the middle key of a full internal
+ *	node) moves up to the parent. When the root splits the tree grows
+ *	by a level.
+ *
+ * Input:
+ *		fileName - File to add
+ *
+ * Returns:
+ *		Pointer to the new inode
+ *		NULL if the file exists or there are not enough free blocks for the nodes
+ */
+iNode* DirectoryTree::insert(int64_t fileName){
+	lastWrites.clear();
+	if (find(fileName)){
+		return NULL;
+	}
+	// A split may create a node on every level and a new root
+	if (currentDisk && currentDisk->getVCB()->numFreeBlock < height+1){
+		return NULL;
+	}
+	int slot;
+	if (!freeSlots.empty()){
+		// Reuse the inode of a deleted file
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+	} else {
+		slot = slots.size();
+		slots.push_back(iNode());
+	}
+	slots[slot].FileIdentifier = fileName;
+	slots[slot].StartBlock = -1;
+	slots[slot].LastBlock = -1;
+	slots[slot].Length = -1;
+	slots[slot].Index = -1;
+	if (root == -1){
+		// First file, the root is a leaf
+		root = newNode(true);
+		height = 1;
+	}
+	int64_t upKey = 0;
+	int newChild = -1;
+	if (insertInto(root, fileName, slot, upKey, newChild)){
+		// The root was split, add a level above it
+		int newRoot = newNode(false);
+		nodes[newRoot].keys.push_back(upKey);
+		nodes[newRoot].children.push_back(root);
+		nodes[newRoot].children.push_back(newChild);
+		root = newRoot;
+		height++;
+	}
+	numFiles++;
+	return &slots[slot];
+}
+
+
+/*
+ * Inserts a key into the subtree of a node
+ *
+ * Input:
+ *		node - Root of the subtree
+ *		fileName - Key to insert
+ *		slot - Inode slot of the key
+ *
+ * Output:
+ *		upKey - Key to add to the parent if the node was split
+ *		newChild - Node split off to the right
+ *
+ * Returns:
+ *		'1' if the node was split
+ *		'0' otherwise
+ */
+int DirectoryTree::insertInto(int node, int64_t fileName, int slot, int64_t &upKey, int &newChild){
+	if (nodes[node].leaf){
+		// Insert the key and its inode in order
+		int pos = std::lower_bound(nodes[node].keys.begin(), nodes[node].keys.end(), fileName) - nodes[node].keys.begin();
+		nodes[node].keys.insert(nodes[node].keys.begin()+pos, fileName);
+		nodes[node].children.insert(nodes[node].children.begin()+pos, slot);
+		writeNode(node);
+		if (nodes[node].keys.size() <= maxKeys){
+			return 0;
+		}
+		// Move the upper half of the leaf into a new leaf after it
+		int right = newNode(true);
+		int half = nodes[node].keys.size() / 2;
+		nodes[right].keys.assign(nodes[node].keys.begin()+half, nodes[node].keys.end());
+		nodes[right].children.assign(nodes[node].children.begin()+half, nodes[node].children.end());
+		nodes[node].keys.resize(half);
+		nodes[node].children.resize(half);
+		nodes[right].next = nodes[node].next;
+		nodes[node].next = right;
+		upKey = nodes[right].keys[0];
+		newChild = right;
+		return 1;
+	}
+	int i = std::upper_bound(nodes[node].keys.begin(), nodes[node].keys.end(), fileName) - nodes[node].keys.begin();
+	if (!insertInto(nodes[node].children[i], fileName, slot, upKey, newChild)){
+		return 0;
+	}
+	// The child was split, add the new child after it
+	nodes[node].keys.insert(nodes[node].keys.begin()+i, upKey);
+	nodes[node].children.insert(nodes[node].children.begin()+i+1, newChild);
+	writeNode(node);
+	if (nodes[node].keys.size() <= maxKeys){
+		return 0;
+	}
+	// Move the keys above the middle key into a new node, the middle key moves up
+	int right = newNode(false);
+	int mid = nodes[node].keys.size() / 2;
+	upKey = nodes[node].keys[mid];
+	nodes[right].keys.assign(nodes[node].keys.begin()+mid+1, nodes[node].keys.end());
+	nodes[right].children.assign(nodes[node].children.begin()+mid+1, nodes[node].children.end());
+	nodes[node].keys.resize(mid);
+	nodes[node].children.resize(mid+1);
+	newChild = right;
+	return 1;
+}
+
+
+/*
+ * Removes a file from the directory
+ *	A node left with too few keys borrows one from a sibling, or is
+ *	merged with it when the sibling has none to spare. When the root
+ *	is left with a single child the tree shrinks by a level.
+ *
+ * Input:
+ *		fileName - File to remove
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if the file is not in the directory
+ */
+int DirectoryTree::erase(int64_t fileName){
+	lastWrites.clear();
+	iNode* entry = find(fileName);
+	if (!entry){
+		return 0;
+	}
+	int slot = entry - slots.data();
+	eraseFrom(root, fileName);
+	if (!nodes[root].leaf && nodes[root].keys.empty()){
+		// The root has one child left, which becomes the root
+		int oldRoot = root;
+		root = nodes[root].children[0];
+		freeNode(oldRoot);
+		height--;
+	} else if (nodes[root].leaf && nodes[root].keys.empty()){
+		// Last file removed
+		freeNode(root);
+		root = -1;
+		height = 0;
+	}
+	slots[slot].FileIdentifier = -1;
+	freeSlots.push_back(slot);
+	numFiles--;
+	return 1;
+}
+
+
+/*
+ * Removes a key from the subtree of a node
+ *
+ * Input:
+ *		node - Root of the subtree
+ *		fileName - Key to remove
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int DirectoryTree::eraseFrom(int node, int64_t fileName){
+	if (nodes[node].leaf){
+		int pos = std::lower_bound(nodes[node].keys.begin(), nodes[node].keys.end(), fileName) - nodes[node].keys.begin();
+		nodes[node].keys.erase(nodes[node].keys.begin()+pos);
+		nodes[node].children.erase(nodes[node].children.begin()+pos);
+		writeNode(node);
+		return 1;
+	}
+	int i = std::upper_bound(nodes[node].keys.begin(), nodes[node].keys.end(), fileName) - nodes[node].keys.begin();
+	int child = nodes[node].children[i];
+	eraseFrom(child, fileName);
+	if (nodes[child].keys.size() < minKeys){
+		rebalance(node, i);
+	}
+	return 1;
+}
+
+
+/*
+ * Refills a child left with too few keys
+ *
+ * Input:
+ *		node - Parent node
+ *		childIndex - Position of the child in the parent
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int DirectoryTree::rebalance(int node, int childIndex){
+	int child = nodes[node].children[childIndex];
+	int left = childIndex > 0 ? nodes[node].children[childIndex-1] : -1;
+	int right = childIndex+1 < nodes[node].children.size() ? nodes[node].children[childIndex+1] : -1;
+	if (left != -1 && nodes[left].keys.size() > minKeys){
+		// Borrow the last key of the left sibling
+		if (nodes[child].leaf){
+			nodes[child].keys.insert(nodes[child].keys.begin(), nodes[left].keys.back());
+			nodes[child].children.insert(nodes[child].children.begin(), nodes[left].children.back());
+			nodes[node].keys[childIndex-1] = nodes[child].keys[0];
+		} else {
+			// The separator moves down and the sibling's last key moves up
+			nodes[child].keys.insert(nodes[child].keys.begin(), nodes[node].keys[childIndex-1]);
+			nodes[child].children.insert(nodes[child].children.begin(), nodes[left].children.back());
+			nodes[node].keys[childIndex-1] = nodes[left].keys.back();
+		}
+		nodes[left].keys.pop_back();
+		nodes[left].children.pop_back();
+		writeNode(left);
+		writeNode(child);
+		writeNode(node);
+		return 1;
+	}
+	if (right != -1 && nodes[right].keys.size() > minKeys){
+		// Borrow the first key of the right sibling
+		if (nodes[child].leaf){
+			nodes[child].keys.push_back(nodes[right].keys.front());
+			nodes[child].children.push_back(nodes[right].children.front());
+			nodes[node].keys[childIndex] = nodes[right].keys[1];
+		} else {
+			// The separator moves down and the sibling's first key moves up
+			nodes[child].keys.push_back(nodes[node].keys[childIndex]);
+			nodes[child].children.push_back(nodes[right].children.front());
+			nodes[node].keys[childIndex] = nodes[right].keys.front();
+		}
+		nodes[right].keys.erase(nodes[right].keys.begin());
+		nodes[right].children.erase(nodes[right].children.begin());
+		writeNode(right);
+		writeNode(child);
+		writeNode(node);
+		return 1;
+	}
+	// Neither sibling can spare a key, merge the child with one of them
+	int keyIndex = left != -1 ? childIndex-1 : childIndex;
+	int into = left != -1 ? left : child;
+	int from = left != -1 ? child : right;
+	if (nodes[into].leaf){
+		nodes[into].next = nodes[from].next;
+	} else {
+		// The separator moves down between the two halves
+		nodes[into].keys.push_back(nodes[node].keys[keyIndex]);
+	}
+	nodes[into].keys.insert(nodes[into].keys.end(), nodes[from].keys.begin(), nodes[from].keys.end());
+	nodes[into].children.insert(nodes[into].children.end(), nodes[from].children.begin(), nodes[from].children.end());
+	nodes[node].keys.erase(nodes[node].keys.begin()+keyIndex);
+	nodes[node].children.erase(nodes[node].children.begin()+keyIndex+1);
+	writeNode(into);
+	writeNode(node);
+	freeNode(from);
+	return 1;
+}
+
+
+/*
+ * Lists the files in a range of file names, in order
+ *	The leaf of the first file name is found from the root, then the
+ *	leaves are walked through their links.
+ *
+ * Input:
+ *		fromName - First file name of the range
+ *		toName - Last file name of the range
+ *
+ * Output:
+ *		files - Inodes of the files in the range
+ *
+ * Returns:
+ *		Number of files listed
+ */
+int DirectoryTree::scan(int64_t fromName, int64_t toName, vector<iNode*> &files){
+	int leaf = findLeaf(fromName);
+	if (leaf == -1){
+		return 0;
+	}
+	int pos = std::lower_bound(nodes[leaf].keys.begin(), nodes[leaf].keys.end(), fromName) - nodes[leaf].keys.begin();
+	int numListed = 0;
+	while (leaf != -1){
+		for (;pos < nodes[leaf].keys.size();pos++){
+			if (nodes[leaf].keys[pos] > toName){
+				return numListed;
+			}
+			files.push_back(&slots[nodes[leaf].children[pos]]);
+			numListed++;
+		}
+		// Continue in the next leaf
+		leaf = nodes[leaf].next;
+		pos = 0;
+		if (leaf != -1 && nodes[leaf].block != -1){
+			lastPath.push_back(nodes[leaf].block);
+		}
+	}
+	return numListed;
+}
+
+
+/*
+ * Getter methods for the inode slots
+ *	Free slots have a file identifier of -1, like the free entries of
+ *	the inode array. The pointer changes when a slot is added.
+ *
+ */
+iNode* DirectoryTree::getSlots(){
+	return slots.data();
+}
+
+int DirectoryTree::getNumSlots(){
+	return slots.size();
+}
+
+
+/*
+ * Getter methods for the shape of the tree
+ *
+ */
+long DirectoryTree::getNumFiles(){
+	return numFiles;
+}
+
+int DirectoryTree::getHeight(){
+	return height;
+}
+
+int DirectoryTree::getNumNodes(){
+	return nodes.size() - freeNodes.size();
+}
+
+int DirectoryTree::getRootBlock(){
+	return root == -1 ? -1 : nodes[root].block;
+}
+
+
+/*
+ * Getter methods for the metadata blocks read and written by the last operation
+ *
+ */
+vector<int> &DirectoryTree::getLastPath(){
+	return lastPath;
+}
+
+vector<int> &DirectoryTree::getLastWrites(){
+	return lastWrites;
+}
+
+
+/*
+ * Checks if a block holds a node of the tree
+ *
+ * Input:
+ *		block - Block number
+ *
+ * Returns:
+ *		true if the block is a metadata block of the tree
+ */
+bool DirectoryTree::isNodeBlock(int block){
+	return blockNodes.count(block) > 0;
+}
+
+
+/*
+ * Getter method for a key stored in a metadata block
+ *
+ * Input:
+ *		block - Metadata block
+ *		entry - Entry of the block
+ *
+ * Returns:
+ *		Key in the entry
+ *		'-1' if the entry is unused
+ */
+int64_t DirectoryTree::getNodeKey(int block, int entry){
+	DirectoryNode &node = nodes[blockNodes[block]];
+	return entry < node.keys.size() ? node.keys[entry] : -1;
+}
+
+
+/*
+ * Prints the metadata blocks used by the tree
+ *
+ * Output:
+ *		Number of files, levels and nodes, and the metadata blocks
+ */
+void DirectoryTree::printUsage(){
+	cout << "Directory tree: " << numFiles << " file(s), " << height << " level(s), " << getNumNodes() << " node(s) in metadata block(s) [";
+	for (map<int, int>::iterator it = blockNodes.begin(); it != blockNodes.end(); it++){
+		if (it != blockNodes.begin()){
+			cout << " ";
+		}
+		cout << it->first;
+		if (nodes[it->second].block == getRootBlock()){
+			cout << "*";
+		}
+	}
+	cout << "] (* root)" << endl;
+}
+
+
+/*
+ * Compares the tree with the inode array on a large directory
+ *	Adds the given number of files in random order to a tree off the
+ *	disk, then times lookups of every file, a range scan, and deleting
+ *	half of the files. Lookups in an inode array of the same files
+ *	(the linear search of checkINode) are timed for comparison.
+ *
+ * Input:
+ *		numFiles - Number of files in the directory
+ *
+ */
+void DirectoryTree::benchmark(int numFiles){
+	std::mt19937 generator(1007);
+	vector<int> fileNames(numFiles);
+	for (int i=0;i<numFiles;i++){
+		fileNames[i] = i+1;
+	}
+	std::shuffle(fileNames.begin(), fileNames.end(), generator);
+	DirectoryTree tree(NULL, directoryBenchNodeKeys);
+	cout << "Directory comparison (" << numFiles << " files, " << directoryBenchNodeKeys << " keys per node)" << endl;
+	streamsize defaultPrecision = cout.precision();
+	cout << fixed << setprecision(3);
+	// Insert every file
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (int i=0;i<numFiles;i++){
+		tree.insert(fileNames[i]);
+	}
+	double insertTime = chrono::duration<double, micro>(chrono::steady_clock::now()-start).count() / numFiles;
+	cout << "\t> insert: " << insertTime << " us per file, " << tree.getHeight() << " level(s), " << tree.getNumNodes() << " node(s)" << endl;
+	// Look up every file in another order
+	std::shuffle(fileNames.begin(), fileNames.end(), generator);
+	long numFound = 0;
+	start = chrono::steady_clock::now();
+	for (int i=0;i<numFiles;i++){
+		numFound += tree.find(fileNames[i]) != NULL;
+	}
+	double lookupTime = chrono::duration<double, micro>(chrono::steady_clock::now()-start).count() / numFiles;
+	cout << "\t> lookup: " << lookupTime << " us per file" << (numFound == numFiles ? "" : " (files missing)") << endl;
+	// List a range of files from the middle of the directory
+	vector<iNode*> listed;
+	int fromName = numFiles/2;
+	start = chrono::steady_clock::now();
+	tree.scan(fromName, fromName+999, listed);
+	double scanTime = chrono::duration<double, micro>(chrono::steady_clock::now()-start).count();
+	bool scanValid = listed.size() == min(1000, numFiles-fromName+1);
+	for (int i=0;i<listed.size();i++){
+		scanValid = scanValid && listed[i]->FileIdentifier == fromName+i;
+	}
+	cout << "\t> range scan: " << listed.size() << " file(s) in " << scanTime << " us" << (scanValid ? "" : " (results differ)") << endl;
+	// Delete half of the files, the other half must still be found
+	start = chrono::steady_clock::now();
+	for (int i=0;i<numFiles/2;i++){
+		tree.erase(fileNames[i]);
+	}
+	double deleteTime = chrono::duration<double, micro>(chrono::steady_clock::now()-start).count() / max(numFiles/2, 1);
+	bool deleteValid = tree.getNumFiles() == numFiles-numFiles/2;
+	for (int i=0;i<numFiles;i++){
+		deleteValid = deleteValid && (tree.find(fileNames[i]) != NULL) == (i >= numFiles/2);
+	}
+	cout << "\t> delete: " << deleteTime << " us per file, " << tree.getHeight() << " level(s), " << tree.getNumNodes() << " node(s) left" << (deleteValid ? "" : " (results differ)") << endl;
+	// Linear search of an inode array holding the same files
+	vector<iNode> inodeArray(numFiles);
+	for (int i=0;i<numFiles;i++){
+		inodeArray[i].FileIdentifier = fileNames[i];
+	}
+	int numQueries = 20;
+	numFound = 0;
+	start = chrono::steady_clock::now();
+	for (int j=0;j<numQueries;j++){
+		int64_t fileName = fileNames[(long)numFiles*j/numQueries];
+		for (int i=0;i<numFiles;i++){
+			if (inodeArray[i].FileIdentifier == fileName){
+				numFound++;
+				break;
+			}
+		}
+	}
+	double arrayTime = chrono::duration<double, micro>(chrono::steady_clock::now()-start).count() / numQueries;
+	cout << "\t> inode array lookup: " << arrayTime << " us per file" << (numFound == numQueries ? "" : " (files missing)") << endl << endl;
+	cout.unsetf(ios::floatfield);
+	cout.precision(defaultPrecision);
+}
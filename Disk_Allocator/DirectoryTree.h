@@ -0,0 +1,88 @@
+// DirectoryTree.h
+#ifndef DIRECTORYTREE_H
+#define DIRECTORYTREE_H
+#pragma once
+
+// Fewest keys a node holds before it splits (a node needs room to split into two)
+#define directoryMinNodeKeys 3
+// Keys in a node of the benchmark tree (a 4 KiB metadata block of 64-byte entries)
+#define directoryBenchNodeKeys 64
+
+class VirtualDisk;
+
+/*
+ * Node of the directory tree
+ *	An internal node has one more child than keys, and child i holds
+ *	the file names from key i-1 up to (not including) key i. A leaf
+ *	holds the inode of every key and is linked to the next leaf, so a
+ *	range of file names is listed by walking the leaves.
+ */
+typedef struct DirectoryNode {
+	bool leaf;					// Whether the node is a leaf
+	int block;					// Metadata block holding the node ('-1' for a tree off the disk)
+	vector<int64_t> keys;		// File names in order
+	vector<int> children;		// Internal: child nodes. Leaf: inode slot of every key
+	int next;					// Leaf: next leaf in file name order ('-1' for the last leaf)
+} DirectoryNode;
+
+/*
+ * B+-tree directory
+ *	Replaces the inode array in the superblock, which holds at most
+ *	blockSize-1 files. Every node is stored in a metadata block of its
+ *	own, taken from the free space when the node is created and given
+ *	back when it is merged away, and holds up to one key per entry of
+ *	the block. Lookup, insert and delete visit one node per level, so
+ *	they are O(log n). The inodes themselves are kept in a slot array
+ *	that the leaves point into, so an inode does not move when its
+ *	leaf splits or merges.
+ */
+class DirectoryTree{
+	// Private variables for DirectoryTree
+	VirtualDisk* currentDisk;		// Disk the metadata blocks are taken from (NULL for a tree off the disk)
+	int maxKeys;					// Most keys in a node
+	int minKeys;					// Fewest keys in a node other than the root
+	int root;						// Root node ('-1' when the directory is empty)
+	int height;						// Levels of nodes
+	long numFiles;					// Files in the directory
+	vector<DirectoryNode> nodes;	// Nodes of the tree (freed nodes are reused)
+	vector<int> freeNodes;			// Nodes not in the tree
+	map<int, int> blockNodes;		// Metadata block -> node
+	vector<iNode> slots;			// Inodes of the files
+	vector<int> freeSlots;			// Slots not holding a file
+	vector<int> lastPath;			// Metadata blocks read by the last operation
+	vector<int> lastWrites;			// Metadata blocks written by the last operation
+	int newNode(bool leaf);
+	int freeNode(int node);
+	int writeNode(int node);
+	int findLeaf(int64_t fileName);
+	int insertInto(int node, int64_t fileName, int slot, int64_t &upKey, int &newChild);
+	int eraseFrom(int node, int64_t fileName);
+	int rebalance(int node, int childIndex);
+public:
+	// Constructors/Destructors
+	DirectoryTree(VirtualDisk* disk, int keysPerNode);
+
+	// Directory methods
+	iNode* find(int64_t fileName);
+	iNode* insert(int64_t fileName);
+	int erase(int64_t fileName);
+	int scan(int64_t fromName, int64_t toName, vector<iNode*> &files);
+
+	// Getter methods
+	iNode* getSlots();
+	int getNumSlots();
+	long getNumFiles();
+	int getHeight();
+	int getNumNodes();
+	int getRootBlock();
+	vector<int> &getLastPath();
+	vector<int> &getLastWrites();
+	bool isNodeBlock(int block);
+	int64_t getNodeKey(int block, int entry);
+
+	// Printing methods
+	void printUsage();
+	static void benchmark(int numFiles);
+};
+
+#endif
@@ -0,0 +1,222 @@
+#include "Header.h"				// Header file
+#include "VirtualDisk.h"
+#include "DiskTracer.h"			// DiskTracer file
+
+// Compiler Directive
+using namespace std;
+
+#ifdef diskTrace
+
+
+/*
+ * Contructor for DiskTracer
+ *	The timeline starts when the tracer is first used, with recording on.
+ *
+ */
+DiskTracer::DiskTracer(){
+	startTime = std::chrono::steady_clock::now();
+	enabled = true;
+}
+
+DiskTracer::~DiskTracer(){
+	// Destructor, free the buffers of every thread
+	for (int i=0;i<buffers.size();i++){
+		delete buffers[i];
+	}
+}
+
+
+/*
+ * Getter method for the tracer of the process
+ *
+ * Returns:
+ *		Pointer to the tracer
+ */
+DiskTracer* DiskTracer::getTracer(){
+	static DiskTracer tracer;
+	return &tracer;
+}
+
+
+/*
+ * Finds the buffer of the calling thread
+ *	A thread gets a buffer, and a track of the timeline, the first time
+ *	it records a span. The tracer owns the buffers, so the spans of a
+ *	thread outlive it.
+ *
+ * Returns:
+ *		Pointer to the buffer of the thread
+ */
+TraceBuffer* DiskTracer::getThreadBuffer(){
+	thread_local TraceBuffer* threadBuffer = NULL;
+	if (!threadBuffer){
+		std::lock_guard<std::mutex> lock(bufferMutex);
+		threadBuffer = new TraceBuffer;
+		threadBuffer->threadId = buffers.size()+1;
+		threadBuffer->events.reserve(traceBufferEvents);
+		buffers.push_back(threadBuffer);
+	}
+	return threadBuffer;
+}
+
+
+/*
+ * Turns the recording of spans on or off
+ *	Spans already open when recording is turned off are still recorded.
+ *
+ * Input:
+ *		recording - true to record spans
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int DiskTracer::setEnabled(bool recording){
+	enabled = recording;
+	return 1;
+}
+
+bool DiskTracer::isEnabled(){
+	return enabled;
+}
+
+
+/*
+ * Finds the current time of the timeline
+ *
+ * Returns:
+ *		Time since the tracer started (ns)
+ */
+int64_t DiskTracer::getTime(){
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+
+/*
+ * Records a closed span in the buffer of the calling thread
+ *
+ * Input:
+ *		event - Span to record (moved into the buffer)
+ *
+ * Returns:
+ *		Number of spans in the thread's buffer
+ */
+int DiskTracer::record(TraceEvent &event){
+	TraceBuffer* threadBuffer = getThreadBuffer();
+	threadBuffer->events.push_back(std::move(event));
+	return threadBuffer->events.size();
+}
+
+
+/*
+ * Writes the timeline to the trace file
+ *	The whole file is built in memory and written at once. Spans are
+ *	complete events ("ph":"X") with times in microseconds, so the
+ *	viewer nests them by time on the track of their thread.
+ *
+ * Output:
+ *		Number of spans written and the trace file
+ *
+ * Returns:
+ *		Number of spans written
+ *		'-1' if the trace file could not be written
+ */
+int DiskTracer::writeTrace(){
+	std::lock_guard<std::mutex> lock(bufferMutex);
+	std::string trace = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+	char eventText[256];
+	int numEvents = 0;
+	for (int i=0;i<buffers.size();i++){
+		// Name the track of the thread
+		snprintf(eventText, sizeof(eventText), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s %d\"}}", i == 0 ? "" : ",", buffers[i]->threadId, i == 0 ? "main" : "thread", buffers[i]->threadId);
+		trace += eventText;
+		vector<TraceEvent> &events = buffers[i]->events;
+		for (int j=0;j<events.size();j++){
+			trace += ",{\"name\":\"";
+			// Escape the characters JSON does not allow in a string
+			for (int k=0;k<events[j].name.size();k++){
+				if (events[j].name[k] == '"' || events[j].name[k] == '\\'){
+					trace += '\\';
+				}
+				trace += events[j].name[k];
+			}
+			snprintf(eventText, sizeof(eventText), "\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{", buffers[i]->threadId, events[j].start / 1000.0, events[j].duration / 1000.0);
+			trace += eventText;
+			for (int k=0;k<events[j].numArgs;k++){
+				snprintf(eventText, sizeof(eventText), "%s\"%s\":%lld", k == 0 ? "" : ",", events[j].argNames[k], (long long)events[j].argValues[k]);
+				trace += eventText;
+			}
+			trace += "}}";
+			numEvents++;
+		}
+	}
+	trace += "]}\n";
+	ofstream traceFile(traceFileName, ios::binary);
+	traceFile.write(trace.data(), trace.size());
+	if (!traceFile){
+		cerr << "Error: Unable to write the trace file " << traceFileName << "." << endl << endl;
+		return -1;
+	}
+	cout << "Timeline of " << numEvents << " span(s) on " << buffers.size() << " thread(s) written to " << traceFileName << "." << endl << endl;
+	return numEvents;
+}
+
+
+/*
+ * Contructor for TraceScope
+ *	Opens a span if the tracer is recording.
+ *
+ * Input:
+ *		name - Name of the span
+ *		disk - Disk to count the accesses and blocks of the span on (NULL for none)
+ *
+ */
+TraceScope::TraceScope(const std::string &name, VirtualDisk* disk){
+	recording = DiskTracer::getTracer()->isEnabled();
+	if (!recording){
+		return;
+	}
+	currentDisk = disk;
+	event.name = name;
+	event.numArgs = 0;
+	if (currentDisk){
+		startAccesses = currentDisk->getTraceAccesses();
+		startBlocks = currentDisk->getTraceBlocks();
+	}
+	event.start = DiskTracer::getTracer()->getTime();
+}
+
+TraceScope::~TraceScope(){
+	if (!recording){
+		return;
+	}
+	// Span closed, record it with the accesses and blocks of its phase
+	event.duration = DiskTracer::getTracer()->getTime() - event.start;
+	if (currentDisk){
+		addArg("accesses", currentDisk->getTraceAccesses() - startAccesses);
+		addArg("blocks", currentDisk->getTraceBlocks() - startBlocks);
+	}
+	DiskTracer::getTracer()->record(event);
+}
+
+
+/*
+ * Adds an argument to the span
+ *	Arguments past the last one a span holds are dropped.
+ *
+ * Input:
+ *		argName - Name of the argument
+ *		value - Value of the argument
+ *
+ * Returns:
+ *		Number of arguments of the span
+ */
+int TraceScope::addArg(const char* argName, int64_t value){
+	if (recording && event.numArgs < traceMaxArgs){
+		event.argNames[event.numArgs] = argName;
+		event.argValues[event.numArgs] = value;
+		event.numArgs++;
+	}
+	return recording ? event.numArgs : 0;
+}
+
+#endif
@@ -0,0 +1,96 @@
+// DiskTracer.h
+#ifndef DISKTRACER_H
+#define DISKTRACER_H
+#pragma once
+
+// The timeline tracer is only built with -DdiskTrace, otherwise the
+// spans below compile to nothing
+#ifdef diskTrace
+
+// File the timeline is written to (Chrome trace-event JSON, opens in Perfetto or chrome://tracing)
+#define traceFileName "diskTrace.json"
+// Most arguments of a span
+#define traceMaxArgs 4
+// Events a thread buffers before its buffer grows
+#define traceBufferEvents 4096
+
+class VirtualDisk;
+
+// One complete span of the timeline
+typedef struct TraceEvent {
+	std::string name;						// Name of the span (instruction or disk phase)
+	int64_t start;							// Start of the span since the tracer started (ns)
+	int64_t duration;						// Length of the span (ns)
+	int numArgs;							// Arguments in use
+	const char* argNames[traceMaxArgs];		// Names of the arguments
+	int64_t argValues[traceMaxArgs];		// Values of the arguments
+} TraceEvent;
+
+// Events of one thread
+typedef struct TraceBuffer {
+	int threadId;							// Track of the thread in the timeline
+	vector<TraceEvent> events;				// Spans the thread closed, in closing order
+} TraceBuffer;
+
+/*
+ * Timeline tracer (Chrome trace-event format)
+ *	Records nested spans of the instructions and of the main phases of
+ *	the disk operations. Every thread appends the spans it closes to a
+ *	buffer of its own, so recording takes no lock. The buffers are kept
+ *	in memory and written to the trace file in bulk once the run ends.
+ *	One tracer serves the whole process, so the spans of the clients,
+ *	the asynchronous ring's workers and the members of a striped volume
+ *	share one timeline.
+ */
+class DiskTracer{
+	// Private variables for DiskTracer
+	std::chrono::steady_clock::time_point startTime;	// Time 0 of the timeline
+	std::atomic<bool> enabled;							// Whether spans are recorded
+	std::mutex bufferMutex;								// Guards the list of buffers
+	vector<TraceBuffer*> buffers;						// Buffer of every thread that recorded a span
+	DiskTracer();
+	~DiskTracer();
+	TraceBuffer* getThreadBuffer();
+public:
+	static DiskTracer* getTracer();
+
+	// General methods
+	int setEnabled(bool recording);
+	bool isEnabled();
+	int64_t getTime();
+	int record(TraceEvent &event);
+
+	// Printing methods
+	int writeTrace();
+};
+
+/*
+ * Span of the timeline
+ *	Made at the start of an instruction or phase and recorded when it
+ *	goes out of scope, so spans opened inside it nest under it. A span
+ *	of a disk also records the accesses to memory and the blocks its
+ *	phase touched.
+ */
+class TraceScope{
+	VirtualDisk* currentDisk;		// Disk the span counts accesses on (NULL for none)
+	bool recording;					// Whether the tracer was recording when the span opened
+	long startAccesses;				// Accesses of the disk when the span opened
+	long startBlocks;				// Blocks touched on the disk when the span opened
+	TraceEvent event;
+public:
+	TraceScope(const std::string &name, VirtualDisk* disk);
+	~TraceScope();
+	int addArg(const char* argName, int64_t value);
+};
+
+#define traceScope(name, disk) TraceScope traceSpan(name, disk)
+#define traceArg(argName, value) traceSpan.addArg(argName, value)
+
+#else
+
+#define traceScope(name, disk)
+#define traceArg(argName, value)
+
+#endif
+
+#endif
@@ -1,62 +1,100 @@
-#ifndef HEADER_H
-#define HEADER_H
-#pragma once
-
-// Preprocessor Directives
-#include <iostream> 	// IO Streams
-#include <iomanip>		// Output Formatting (set width)
-#include <string> 		// String & array
-#include <sstream> 		// String Streams
-#include <fstream> 		// File Streams
-#include <locale>		// std::locale, std::tolower
-#include <climits>		// C limits
-#include <stdbool.h> 	// Boolean 
-#include <math.h> 		// Math
-#include <algorithm>	// Algorithms
-#include <queue>		// Queues
-#include <vector>		// Vectors
-#include <map>			// Maps
-
-// Compiler Directive
-using namespace std;
-
-
-/*
- * Global Variables
- */
-// Forward declaration of MAX_ELEMENTS - Declared in Main.cpp
-extern const int MAX_ELEMENTS;
-
-/*
- *
- * Data Structures
- *
- */
-// STRUCT FOR VOLUME CONTROL BLOCK {SUPERBLOCK FOR UNIX FILE SYSTEM | MASTER FILE TABLE FOR NEW TECHNOLOGY FILE SYSTEM (NTFS USED BY WINDOWS)}
-typedef struct VCB {
-	int totalBlockNum;				// Total number of blocks
-	int numFreeBlock;				// Number of free blocks
-	int blockSize;					// Block size
-	vector<int> FreeBlockBitMap;	// Free Block Bit map array
-	int allocationMethod;			// Allocation method of volume (1 - Contiguous, 2 - Linked, 3 - Indexed, 4 - Contiguous Indexed)
-} VCB; 
-
-
-// STRUCT FOR INODE
-typedef struct iNode {
-	int FileIdentifier; // File Identifier/File name [Series of integer range from 100, 200, 300..9900]
-	int StartBlock;		// Start block
-	int LastBlock;		// Last block
-	int Length;			// Number of blocks including start block
-	int Index;			// Index block
-} iNode; 
-
-// STRUCT FOR DATA
-typedef struct {
-	int index;
-	int block;
-	int data;
-	int length;
-} Data;
-
-#endif
+#ifndef HEADER_H
+#define HEADER_H
+#pragma once
+
+// Preprocessor Directives
+#include <iostream> 	// IO Streams
+#include <iomanip>		// Output Formatting (set width)
+#include <string> 		// String & array
+#include <sstream> 		// String Streams
+#include <fstream> 		// File Streams
+#include <locale>		// std::locale, std::tolower
+#include <climits>		// C limits
+#include <stdbool.h> 	// Boolean 
+#include <math.h> 		// Math
+#include <algorithm>	// Algorithms
+#include <queue>		// Queues
+#include <vector>		// Vectors
+#include <map>			// Maps
+#include <set>			// Sets
+#include <list>			// Lists
+#include <unordered_map>	// Hash maps
+#include <span>			// Spans
+#include <deque>			// Double-ended queues
+#include <thread>		// Threads
+#include <mutex>			// Mutexes
+#include <condition_variable>	// Condition variables
+#include <chrono>		// Clocks
+#include <coroutine>		// Coroutines
+#include <memory_resource>	// Polymorphic memory resources
+#include <bit>			// Bit counting
+#include <cstdint>		// Fixed width integers
+#include <cstring>		// Memory copies
+#include <random>		// Random number generators
+#include <atomic>		// Atomic flags
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>	// SSE2/AVX2 intrinsics
+#define x86Kernels
+#endif
+
+// Compiler Directive
+using namespace std;
+
+
+/*
+ * Global Variables
+ */
+// Forward declaration of MAX_ELEMENTS - Declared in Main.cpp
+extern const int MAX_ELEMENTS;
+
+/*
+ *
+ * Data Structures
+ *
+ */
+// STRUCT FOR VOLUME CONTROL BLOCK {SUPERBLOCK FOR UNIX FILE SYSTEM | MASTER FILE TABLE FOR NEW TECHNOLOGY FILE SYSTEM (NTFS USED BY WINDOWS)}
+typedef struct VCB {
+	int totalBlockNum;				// Total number of blocks
+	int numFreeBlock;				// Number of free blocks
+	int blockSize;					// Block size
+	vector<int> FreeBlockBitMap;	// Free Block Bit map array
+	int allocationMethod;			// Allocation method of volume (1 - Contiguous, 2 - Linked, 3 - Indexed, 4 - Contiguous Indexed, 5 - Log-structured)
+} VCB; 
+
+
+// STRUCT FOR INODE (an allocation method uses one field of each pair)
+typedef struct iNode {
+	int64_t FileIdentifier; // File Identifier/File name (64-bit, [100, 200, 300..9900] in the old instruction format)
+	union {
+		int StartBlock;		// Start block (contiguous, linked)
+		int Index;			// Index block (indexed, contiguous indexed, log-structured)
+	};
+	union {
+		int Length;			// Number of blocks including start block (contiguous)
+		int LastBlock;		// Last block (linked)
+	};
+} iNode; 
+
+// STRUCT FOR FREE SPACE STATISTICS (Maintained incrementally by VirtualDisk::updateFreeSpace)
+typedef struct FSStats {
+	int largestFreeExtent;					// Length of the largest run of free blocks
+	int numFreeExtents;						// Number of runs of free blocks
+	vector<int> freeExtentHistogram;		// Number of free runs of each length (index = run length in blocks)
+	vector<int> freeRunEnd;					// Last block of the free run starting at a block (valid at run start only)
+	vector<int> freeRunStart;				// First block of the free run ending at a block (valid at run end only)
+	int numFiles;							// Number of files on the disk
+	int numFileExtents;						// Total extents of all files (chain blocks for linked, index entries for indexed)
+	int unusedEntries;						// Total unused entries in the last blocks of all files (internal fragmentation)
+	map<int64_t, pair<int,int> > fileExtents;	// Extents and unused entries of each file
+} FSStats;
+
+
+// STRUCT FOR DATA
+typedef struct {
+	int index;
+	int block;
+	int data;
+	int length;
+} Data;
+
+#endif
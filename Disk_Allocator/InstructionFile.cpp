@@ -1,402 +1,1677 @@
-#include "Header.h"				// Header file
-#include "VirtualDisk.h"
-#include "InstructionFile.h"	// InstructionFile file
-
-// Compiler Directive
-using namespace std;
-
-
-/*
- * Contructor for InstructionFile
- *
- */
-InstructionFile::InstructionFile(VirtualDisk* disk){
-	currentDisk = disk;
-	cout << endl << "An instruction file in comma-delimited format is required for this program to execute accordingly." << endl;
-	setupFile();
-}
-
-
-/*
- * Initiates setup of Instruction File
- *	This method asks the user to input a file (comma delimited)
- *	then calls the openFile method to open the file. The file
- *	contents will be processed and tokenized into the class 
- *	variable userInstructions.
- *
- * Returns:
- *		'1' when completed successfully
- *		
- */
-
-int InstructionFile::setupFile(){
-	// Get user to input a file to be read
-	getUserFileName();
-	// Open the file
-	openFile();
-	// Process the contents within the file
-	processFileContents();
-	// Close the file
-	closeFile();
-  	return 1;
-}
-
-
-
-/*
- * Gets user input for file name
- *	This method asks the user to input the file name of
- * 	the instructions. The file name is validated to be
- *	greater than length of 5 characters (x.csv), then
- *	saves the file name to fileName.
- *	
- * Input:
- *		Via cin 
- *
- * Returns:
- *		'1' when completed successfully
- *
- */
-int InstructionFile::getUserFileName(){
-	// Prompt user to enter a file
-	cout << "Please enter the full file name (e.g sample.csv): ";
-	bool valid = false;
-	while (!valid){
-		// Save user input to fileName
-		cin >> fileName;
-		if (fileName.length() < 5){
-			// If fileName length is less than 5 (.txt), getUserFileName() again.
-			cout << "Please enter a valid file name which includes the file extension. (e.g. sample.csv)" << endl;
-			cout << "Please enter the full file name: ";
-		} else {
-			// Valid file name, exit method.
-			valid = true;
-			return 1;
-		}
-	}
-}
-
-
-/*
- * Open file stream from file
- *	This method uses the inputFileStream to open
- *	the file specified in the variable fileName.
- *	
- * Returns:
- *		'1' if stream is opened successfully
- *		'0' if error is encountered
- *	
- */
-
-int InstructionFile::openFile(){
-	// Declare new input file stream
-	// Open file
-	inputFileStream.open(fileName);
-	// Verify if file is opened successfully
-	if (inputFileStream.is_open()){
-		return 1;
-	} else {
-		// Print error, exit method
-		std::cerr << "Error opening file, please try again." << endl;
-		return 0;
-	}
-}	
-
-/*
- * Process File Contents
- *	This method reads in the file content from the stream
- * 	line by line and calls the split() method for each line. 
- *	The set of tokens are then added to userInstructions.
- *
- * Returns:
- *		'1' when completed successfully
- *
- */
-
-int InstructionFile::processFileContents(){
-	std::string newLine;
-    std::queue<string> tokenSet;
-	// Read each line of the file
-	while (std::getline(inputFileStream, newLine)){
-		// Strip newline of white spaces
-		newLine.erase(std::remove(newLine.begin(), newLine.end(), ' '), newLine.end());
-		// Call split method on every line, save returned tokens to tokenSet
-		tokenSet = split(newLine);
-		// Add the tokenSet into userInstructions
-		userInstructions.push(tokenSet);
-	}
-	return 1;
-}
-
-
-/*
- * Split string by delimiter
- *	Default delimiter of ','
- *
- * Input:
- *		inputString - Text string to be processed
- *		delimiter - Character delimiter to split tokens, default delimiter is comma
- *
- * Returns:
- *		Vector of strings
- */
-
-std::queue<string> InstructionFile::split(std::string &inputString, char delimiter){
-	std::queue<std::string> commandTokens;
-	std::string token;
-	std::istringstream tempTokenStream(inputString);
-	int intToken;
-	while (std::getline(tempTokenStream, token, delimiter)){
-		// If token length is greater than 0 (meaning not blank)
-		if (token.length() > 0){
-			if(commandTokens.size() >= 1){
-				// Check data entries
-				// Check if string's ending character is \r
-				if (token[token.size()-1] == '\r'){
-					// Remove the trailing \r character
-					token = token.substr(0, token.size()-1);
-					// If the token is not empty after cleaning
-					if (token.size()){
-						// Convert to int to check
-						intToken = std::atoi(token.c_str());
-						if(intToken !=0){
-							// Valid int
-							// Add the token to commandTokens
-							commandTokens.push(std::to_string(intToken));							
-						} else {
-							// Invalid int
-							// Clear queue and return
-							std::queue<string> empty;
-							std::swap(commandTokens, empty);
-							return commandTokens;
-						}
-					}
-				} else {
-					// Convert to int to check
-					intToken = std::atoi(token.c_str());
-					if(intToken !=0){
-						// Valid int
-						// Add the token to commandTokens
-						commandTokens.push(std::to_string(intToken));						
-					} else {
-						// Invalid int
-						// Clear queue and return
-						std::queue<string> empty;
-						std::swap(commandTokens, empty);
-						return commandTokens;
-					}
-				}
-			} else {
-				// Instruction entries
-				// Check if string's ending character is \r
-				if (token[token.size()-1] == '\r'){
-					// Remove the trailing \r character
-					token = token.substr(0, token.size()-1);
-					// If the token is not empty after cleaning
-					if (token.size()){
-						// Add the token to commandTokens
-						commandTokens.push(token);						
-					}
-				} else {
-					commandTokens.push(token);
-				}
-			}
-
-		}
-	}
-   	// If commandTokens has only 1 element (Delimiter not present, no splitting occured)
-	if (commandTokens.size() == 1) {
-		// Print warning to console
-		cerr << "[WARNING] Delimiting character/File data not found. Program may not work as intended." << endl;
-	}
-   return commandTokens;
-}
-
-
-/*
- * Close file stream
- *	This method closes the file stream.
- *	
- */
-void InstructionFile::closeFile(){
-	// If thre is an open file stream
-	if (inputFileStream.is_open()){
-		// Close stream
-		inputFileStream.close();
-	}
-}	
-
-
-/*
- * Executes next instruction
- *	This method calls the doCommand method to
- *	parse and execute the command.
- *	
- */
-void InstructionFile::executeNextInstruction(){
-	if (!userInstructions.empty()){
-		// Identify and execute respective instruction method
-		doCommand(userInstructions.front());
-		// Remove (dequeue) the instruction from the queue
-		userInstructions.pop();
-	} else {
-		// No instructions in the queue, print error
-		cerr << "No instructions found." << endl;
-	}
-}
-
-/*
- * Executes all instructions
- *	This method loops through each set of instructions in
- *	userInstructions and calls the doCommand method to
- *	parse and execute the command.
- *	
- */
-void InstructionFile::executeAllInstructions(){
-	// Check that the queue is not empty
-	if (!userInstructions.empty()){
-		// Queue not empty, process every element in the queue
-		while (!userInstructions.empty()){
-			// Identify and execute respective instruction method
-			doCommand(userInstructions.front());
-			// Remove (dequeue) the instruction from the queue
-			userInstructions.pop();
-		}
-	} else {
-		// No instructions in the queue, print error
-		cerr << "No instructions found." << endl;
-	}
-	// Print disk map after executing 
-	currentDisk->printDiskMap();
-}
-
-
-
-/*
- * Instruction parser
- *	This method reads in the entire line of instruction in the vector
- *	and calls first index (instruction token) with the makeLowercase() method. 
- *	It then matches the instruction with a pre-determined set of commands and
- *	calls the respective function.
- *
- * Input:
- *   instruction - Vector of tokenized/split line of instruction
- *
- * Returns:
- *		'1' when completed successfully
- *		'0' if commmand is unrecognised
- */
-
-int InstructionFile::doCommand(std::queue<string> &instruction) {
-    // Make the instruction token lowercase
-	makeLowercase(instruction.front());
-	/* determine which instruction was given and execute the appropriate function */
-	if (instruction.front() == "add"){
-		// Remove (dequeue) command from the queue
-		instruction.pop();
-		// Call the doAdd method with the instruction
-		doAdd(instruction);
-	} else if (instruction.front() == "read"){
-		// Remove (dequeue) command from the queue
-		instruction.pop();
-		// Call the doRead method with the instruction
-		doRead(instruction);
-	} else if (instruction.front() == "delete"){
-		// Remove (dequeue) command from the queue
-		instruction.pop();
-		// Call the doDelete method with the instruction
-		doDelete(instruction);
-	} else {
-		// Unrecognised instruction, print error and exit method
-		cout << "Error: Unrecognised instruction/invalid file found." << endl << endl;
-		return 0;
-	}
-	return 1;	
-}
-
-
-/*
- * Make string lowercase
- *	Note: This will overwrite the original data as part of normalisation
- *
- * Input:
- *		inputString - Text string to be processed
- *
- * Returns:
-  *		'1' when completed successfully
- */
-
-int InstructionFile::makeLowercase(std::string &inputString){
-	// For each character in the string
-	for (int i=0; i<inputString.length(); i++){
-		// Replace the character with the lowercase version
-		inputString[i] = std::tolower(inputString[i]);
-	}
-	return 1;
-}
-
-
-/*
- * Execute add command
- *
- * Input:
- *		Instruction - current set of instruction to be processed
- *
- */
-void InstructionFile::doAdd(std::queue<string> &instruction){
-	// Convert file name to int
-	int fileName = stoi(instruction.front());
-	// If file name is not empty and file name is valid and there is data in the instruction
-	if (fileName && fileName % 100 == 0 && instruction.size() > 1 && fileName > 0 && fileName < 10000){
-		// Remove the file name from the instruction queue
-		instruction.pop();
-		// Call the addFile method in VirtualDisk
-		currentDisk->addFile(fileName,instruction);
-	} else {
-		// Print error message
-		cerr << "Error: Adding of file " << instruction.front() << " failed due to invalid file name/file data." << endl << endl;
-	}
-
-}
-
-
-/*
- * Execute read command
- *
- * Input:
- *		Instruction - current set of instruction to be processed
- *
- */
-void InstructionFile::doRead(std::queue<string> &instruction){
-	// Convert file name to int
-	int fileName = stoi(instruction.front());
-	// If file name is not empty
-	if (fileName){
-		// Call the readFile method in VirtualDisk
-		currentDisk->readFile(fileName);	
-	} else {
-		// Print error message
-		cerr << "Error: Reading of file " << instruction.front() << " failed due to invalid file name." << endl;
-	}
-}
-
-
-/*
- * Execute delete command
- *
- * Input:
- *		Instruction - current set of instruction to be processed
- *
- */
-void InstructionFile::doDelete(std::queue<string> &instruction){
-	// Convert file name to int
-	int fileName = stoi(instruction.front());
-	// If file name is not empty and file name is valid
-	if (fileName && fileName % 100 == 0){
-		// Call deleteFile method in VirtualDisk
-		currentDisk->deleteFile(fileName);	
-	} else {
-		// Print error message
-		cerr << "Error: Deletion of file " << instruction.front() << " failed due to invalid file name." << endl;
-	}
-}
+#include "Header.h"				// Header file
+#include "VirtualDisk.h"
+#include "Defragmenter.h"
+#include "DeviceModel.h"
+#include "BlockCache.h"
+#include "ReadAhead.h"
+#include "WriteBuffer.h"
+#include "RequestScheduler.h"
+#include "IoRing.h"
+#include "StripedVolume.h"
+#include "DataKernels.h"
+#include "RoaringBitmap.h"
+#include "DirectoryTree.h"
+#include "ByteStore.h"
+#include "OperationMetrics.h"
+#include "DiskTracer.h"
+#include "OperationLog.h"
+#include "InstructionFile.h"	// InstructionFile file
+
+// Compiler Directive
+using namespace std;
+
+
+/*
+ * Contructor for InstructionFile
+ *
+ */
+InstructionFile::InstructionFile(VirtualDisk* disk) : diskDefragmenter(disk), requestScheduler(disk){
+	currentDisk = disk;
+	asyncRing = NULL;
+	asyncTag = 0;
+	stripedVolume = NULL;
+	cout << endl << "An instruction file in comma-delimited format is required for this program to execute accordingly." << endl;
+	setupFile();
+}
+
+/*
+ * Contructor for InstructionFile with a given instruction file
+ *	Used for clients of the multi-client executor, the file name is
+ *	not asked for.
+ *
+ */
+InstructionFile::InstructionFile(VirtualDisk* disk, std::string instructionFileName) : diskDefragmenter(disk), requestScheduler(disk){
+	currentDisk = disk;
+	asyncRing = NULL;
+	asyncTag = 0;
+	stripedVolume = NULL;
+	fileName = instructionFileName;
+	// Open the file, process its contents and close it
+	if (openFile()){
+		processFileContents();
+		closeFile();
+	}
+}
+
+/*
+ * Contructor for InstructionFile with given instructions
+ *	Used to replay the instructions of an operation log, no file is
+ *	read.
+ *
+ */
+InstructionFile::InstructionFile(VirtualDisk* disk, std::queue<queue<string> > &instructions) : diskDefragmenter(disk), requestScheduler(disk){
+	currentDisk = disk;
+	asyncRing = NULL;
+	asyncTag = 0;
+	stripedVolume = NULL;
+	userInstructions = instructions;
+	if (currentDisk->getOperationLog()){
+		// Record the instructions in file order
+		for (int i=0;i<instructions.size();i++){
+			currentDisk->getOperationLog()->recordInstruction(instructions.front());
+			instructions.push(instructions.front());
+			instructions.pop();
+		}
+	}
+}
+
+InstructionFile::~InstructionFile(){
+	// Destructor, stop the asynchronous ring's workers and free the striped volume
+	delete asyncRing;
+	delete stripedVolume;
+}
+
+
+/*
+ * Initiates setup of Instruction File
+ *	This method asks the user to input a file (comma delimited)
+ *	then calls the openFile method to open the file. The file
+ *	contents will be processed and tokenized into the class 
+ *	variable userInstructions.
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		
+ */
+
+int InstructionFile::setupFile(){
+	// Get user to input a file to be read
+	getUserFileName();
+	// Open the file
+	openFile();
+	// Process the contents within the file
+	processFileContents();
+	// Close the file
+	closeFile();
+  	return 1;
+}
+
+
+
+/*
+ * Gets user input for file name
+ *	This method asks the user to input the file name of
+ * 	the instructions. The file name is validated to be
+ *	greater than length of 5 characters (x.csv), then
+ *	saves the file name to fileName.
+ *	
+ * Input:
+ *		Via cin 
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *
+ */
+int InstructionFile::getUserFileName(){
+	// Prompt user to enter a file
+	cout << "Please enter the full file name (e.g sample.csv): ";
+	bool valid = false;
+	while (!valid){
+		// Save user input to fileName
+		cin >> fileName;
+		if (fileName.length() < 5){
+			// If fileName length is less than 5 (.txt), getUserFileName() again.
+			cout << "Please enter a valid file name which includes the file extension. (e.g. sample.csv)" << endl;
+			cout << "Please enter the full file name: ";
+		} else {
+			// Valid file name, exit method.
+			valid = true;
+			return 1;
+		}
+	}
+}
+
+
+/*
+ * Open file stream from file
+ *	This method uses the inputFileStream to open
+ *	the file specified in the variable fileName.
+ *	
+ * Returns:
+ *		'1' if stream is opened successfully
+ *		'0' if error is encountered
+ *	
+ */
+
+int InstructionFile::openFile(){
+	// Declare new input file stream
+	// Open file
+	inputFileStream.open(fileName);
+	// Verify if file is opened successfully
+	if (inputFileStream.is_open()){
+		return 1;
+	} else {
+		// Print error, exit method
+		std::cerr << "Error opening file, please try again." << endl;
+		return 0;
+	}
+}	
+
+/*
+ * Process File Contents
+ *	This method reads in the file content from the stream
+ * 	line by line and calls the split() method for each line. 
+ *	The set of tokens are then added to userInstructions, and
+ *	recorded in file order when the disk has an operation log.
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *
+ */
+
+int InstructionFile::processFileContents(){
+	std::string newLine;
+    std::queue<string> tokenSet;
+	// Read each line of the file
+	while (std::getline(inputFileStream, newLine)){
+		// Strip newline of white spaces
+		newLine.erase(std::remove(newLine.begin(), newLine.end(), ' '), newLine.end());
+		// Call split method on every line, save returned tokens to tokenSet
+		tokenSet = split(newLine);
+		if (currentDisk->getOperationLog()){
+			// Record the instruction as it is loaded, so running it copies nothing
+			currentDisk->getOperationLog()->recordInstruction(tokenSet);
+		}
+		// Add the tokenSet into userInstructions
+		userInstructions.push(tokenSet);
+	}
+	return 1;
+}
+
+
+/*
+ * Split string by delimiter
+ *	Default delimiter of ','
+ *	Data tokens have to be integers, and apart from the 64-bit file
+ *	names, offsets and byte counts, they have to fit an int. A line
+ *	with any other data token is returned empty.
+ *
+ * Input:
+ *		inputString - Text string to be processed
+ *		delimiter - Character delimiter to split tokens, default delimiter is comma
+ *
+ * Returns:
+ *		Vector of strings
+ */
+
+std::queue<string> InstructionFile::split(std::string &inputString, char delimiter){
+	std::queue<std::string> commandTokens;
+	std::string token;
+	std::istringstream tempTokenStream(inputString);
+	long long intToken;
+	char* tokenEnd;
+	int wideTokens = 0;
+	while (std::getline(tempTokenStream, token, delimiter)){
+		// If token length is greater than 0 (meaning not blank)
+		if (token.length() > 0){
+			if(commandTokens.size() >= 1){
+				// Check data entries
+				// Check if string's ending character is \r
+				if (token[token.size()-1] == '\r'){
+					// Remove the trailing \r character
+					token = token.substr(0, token.size()-1);
+					// If the token is not empty after cleaning
+					if (token.size()){
+						// Convert to int to check
+						intToken = std::strtoll(token.c_str(), &tokenEnd, 10);
+						if(tokenEnd != token.c_str() && (commandTokens.size() <= wideTokens || (intToken >= INT_MIN && intToken <= INT_MAX))){
+							// Valid int
+							// Add the token to commandTokens
+							commandTokens.push(std::to_string(intToken));							
+						} else {
+							// Invalid int
+							// Clear queue and return
+							std::queue<string> empty;
+							std::swap(commandTokens, empty);
+							return commandTokens;
+						}
+					}
+				} else {
+					// Convert to int to check
+					intToken = std::strtoll(token.c_str(), &tokenEnd, 10);
+					if(tokenEnd != token.c_str() && (commandTokens.size() <= wideTokens || (intToken >= INT_MIN && intToken <= INT_MAX))){
+						// Valid int
+						// Add the token to commandTokens
+						commandTokens.push(std::to_string(intToken));						
+					} else {
+						// Invalid int
+						// Clear queue and return
+						std::queue<string> empty;
+						std::swap(commandTokens, empty);
+						return commandTokens;
+					}
+				}
+			} else {
+				// Instruction entries
+				// Check if string's ending character is \r
+				if (token[token.size()-1] == '\r'){
+					// Remove the trailing \r character
+					token = token.substr(0, token.size()-1);
+					// If the token is not empty after cleaning
+					if (token.size()){
+						// Add the token to commandTokens
+						commandTokens.push(token);						
+					}
+				} else {
+					commandTokens.push(token);
+				}
+				// File names, offsets and byte counts may exceed an int, any other data has to fit one
+				wideTokens = getWideTokens(token);
+			}
+
+		}
+	}
+   	// If commandTokens has only 1 element (Delimiter not present, no splitting occured) and the instruction requires data
+	if (commandTokens.size() == 1 && !isStandaloneInstruction(commandTokens.front())) {
+		// Print warning to console
+		cerr << "[WARNING] Delimiting character/File data not found. Program may not work as intended." << endl;
+	}
+   return commandTokens;
+}
+
+
+/*
+ * Close file stream
+ *	This method closes the file stream.
+ *	
+ */
+void InstructionFile::closeFile(){
+	// If thre is an open file stream
+	if (inputFileStream.is_open()){
+		// Close stream
+		inputFileStream.close();
+	}
+}	
+
+
+/*
+ * Executes next instruction
+ *	This method calls the doCommand method to
+ *	parse and execute the command.
+ *	
+ */
+void InstructionFile::executeNextInstruction(){
+	if (!userInstructions.empty()){
+		// Identify and execute respective instruction method
+		doCommand(userInstructions.front());
+		// Remove (dequeue) the instruction from the queue
+		userInstructions.pop();
+	} else {
+		// No instructions in the queue, print error
+		cerr << "No instructions found." << endl;
+	}
+}
+
+/*
+ * Checks for instructions left to execute
+ *
+ * Returns:
+ *		true if the instruction queue is not empty
+ */
+bool InstructionFile::hasNextInstruction(){
+	return !userInstructions.empty();
+}
+
+/*
+ * Executes all instructions
+ *	This method loops through each set of instructions in
+ *	userInstructions and calls the doCommand method to
+ *	parse and execute the command.
+ *	
+ */
+void InstructionFile::executeAllInstructions(){
+	// Check that the queue is not empty
+	if (!userInstructions.empty()){
+		// Queue not empty, process every element in the queue
+		while (!userInstructions.empty()){
+			// Identify and execute (or queue for the request scheduler) respective instruction method
+			scheduleCommand(userInstructions.front());
+			// Remove (dequeue) the instruction from the queue
+			userInstructions.pop();
+		}
+	} else {
+		// No instructions in the queue, print error
+		cerr << "No instructions found." << endl;
+	}
+	if (asyncRing){
+		// Wait for the operations still in flight and report the ring
+		drainAsync();
+		asyncRing->printStats();
+	}
+	if (requestScheduler.isEnabled()){
+		// Serve the requests still queued and report the scheduler
+		drainRequests();
+		requestScheduler.printStats();
+	}
+	if (stripedVolume){
+		// Report the striped volume
+		stripedVolume->printStats();
+	}
+	// Write out any buffered writes
+	currentDisk->flushWriteBack();
+#ifdef diskMetrics
+	// Export the operation metrics of the run
+	currentDisk->getMetrics()->exportMetrics();
+#endif
+#ifdef diskTrace
+	// Write the timeline of the run
+	DiskTracer::getTracer()->writeTrace();
+#endif
+	if (currentDisk->getOperationLog()){
+		// Write out the rest of the operation log
+		currentDisk->getOperationLog()->finish();
+	}
+	// Print disk map after executing 
+	currentDisk->printDiskMap();
+}
+
+
+
+/*
+ * Instruction parser
+ *	This method reads in the entire line of instruction in the vector
+ *	and calls first index (instruction token) with the makeLowercase() method. 
+ *	It then matches the instruction with a pre-determined set of commands and
+ *	calls the respective function.
+ *
+ * Input:
+ *   instruction - Vector of tokenized/split line of instruction
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if commmand is unrecognised
+ */
+
+int InstructionFile::doCommand(std::queue<string> &instruction) {
+	if (instruction.empty()){
+		// Line rejected by the parser, print error and exit method
+		cout << "Error: Unrecognised instruction/invalid file found." << endl << endl;
+		return 0;
+	}
+    // Make the instruction token lowercase
+	makeLowercase(instruction.front());
+	// Remove (dequeue) command from the queue
+	string command = std::move(instruction.front());
+	instruction.pop();
+	return runCommand(command, instruction);
+}
+
+
+/*
+ * Runs a command with its arguments
+ *	Matches the command with a pre-determined set of commands and
+ *	calls the respective function with the arguments. Requests of the
+ *	scheduler come here directly, their command already taken off the
+ *	tokens when they were queued.
+ *
+ * Input:
+ *		command - Lowercase instruction token
+ *		instruction - Arguments of the instruction
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if commmand is unrecognised
+ */
+int InstructionFile::runCommand(const string &command, std::queue<string> &instruction){
+	// Trace the instruction and the disk phases it runs (no-op without -DdiskTrace)
+	traceScope(command, currentDisk);
+	/* determine which instruction was given and execute the appropriate function */
+	if (command == "add"){
+		// Call the doAdd method with the instruction
+		doAdd(instruction);
+	} else if (command == "append"){
+		// Call the doAppend method with the instruction
+		doAppend(instruction);
+	} else if (command == "read"){
+		// Call the doRead method with the instruction
+		doRead(instruction);
+	} else if (command == "delete"){
+		// Call the doDelete method with the instruction
+		doDelete(instruction);
+	} else if (command == "defrag"){
+		// Call the doDefrag method with the instruction
+		doDefrag(instruction);
+	} else if (command == "stats"){
+		// Call the doStats method
+		doStats();
+	} else if (command == "device"){
+		// Call the doDevice method with the instruction
+		doDevice(instruction);
+	} else if (command == "cache"){
+		// Call the doCache method with the instruction
+		doCache(instruction);
+	} else if (command == "readahead"){
+		// Call the doReadAhead method with the instruction
+		doReadAhead(instruction);
+	} else if (command == "writeback"){
+		// Call the doWriteBack method with the instruction
+		doWriteBack(instruction);
+	} else if (command == "sync"){
+		// Call the doSync method
+		doSync();
+	} else if (command == "snapshot"){
+		// Call the doSnapshot method
+		doSnapshot();
+	} else if (command == "rollback"){
+		// Call the doRollback method with the instruction
+		doRollback(instruction);
+	} else if (command == "diff"){
+		// Call the doDiff method with the instruction
+		doDiff(instruction);
+	} else if (command == "schedule"){
+		// Call the doSchedule method with the instruction
+		doSchedule(instruction);
+	} else if (command == "async"){
+		// Call the doAsync method with the instruction
+		doAsync(instruction);
+	} else if (command == "stripe"){
+		// Call the doStripe method with the instruction
+		doStripe(instruction);
+	} else if (command == "simd"){
+		// Call the doSimd method with the instruction
+		doSimd(instruction);
+	} else if (command == "lazydelete"){
+		// Call the doLazyDelete method with the instruction
+		doLazyDelete(instruction);
+	} else if (command == "freemap"){
+		// Call the doFreeMap method with the instruction
+		doFreeMap(instruction);
+	} else if (command == "freemapbench"){
+		// Call the doFreeMapBench method with the instruction
+		doFreeMapBench(instruction);
+	} else if (command == "directory"){
+		// Call the doDirectory method with the instruction
+		doDirectory(instruction);
+	} else if (command == "dirbench"){
+		// Call the doDirBench method with the instruction
+		doDirBench(instruction);
+	} else if (command == "list"){
+		// Call the doList method with the instruction
+		doList(instruction);
+	} else if (command == "bytemode"){
+		// Call the doByteMode method with the instruction
+		doByteMode(instruction);
+	} else if (command == "addbytes"){
+		// Call the doAddBytes method with the instruction
+		doAddBytes(instruction);
+	} else if (command == "readbytes"){
+		// Call the doReadBytes method with the instruction
+		doReadBytes(instruction);
+	} else if (command == "metrics"){
+		// Call the doMetrics method with the instruction
+		doMetrics(instruction);
+	} else if (command == "trace"){
+		// Call the doTrace method with the instruction
+		doTrace(instruction);
+	} else {
+		// Unrecognised instruction, print error and exit method
+		cout << "Error: Unrecognised instruction/invalid file found." << endl << endl;
+		return 0;
+	}
+	// Run one bounded step of the incremental defragmenter (no-op when disabled)
+	diskDefragmenter.runStep();
+	// Flush the write-back buffer if a threshold was reached (no-op in write-through mode)
+	currentDisk->checkWriteBack();
+	return 1;	
+}
+
+
+/*
+ * Request scheduling stage
+ *	When a scheduling policy is set, file instructions (add, append,
+ *	read and delete) are queued as requests instead of being executed
+ *	in file order. The requests that the disk can start before the new
+ *	request arrives are served first. Any other instruction waits until
+ *	the queue is empty, so it sees the same disk as in file order.
+ *	When an asynchronous ring is set, file instructions are submitted
+ *	to the ring instead. A striped volume runs its members in parallel
+ *	itself, so with a volume every instruction runs in file order.
+ *
+ * Input:
+ *   instruction - Vector of tokenized/split line of instruction
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if commmand is unrecognised
+ */
+int InstructionFile::scheduleCommand(std::queue<string> &instruction){
+	if ((!requestScheduler.isEnabled() && !asyncRing) || stripedVolume){
+		return doCommand(instruction);
+	}
+	bool fileInstruction = false;
+	if (instruction.size() > 1){
+		// Make the instruction token lowercase
+		makeLowercase(instruction.front());
+		fileInstruction = instruction.front() == "add" || instruction.front() == "append" || instruction.front() == "read" || instruction.front() == "delete";
+	}
+	if (!fileInstruction){
+		drainAsync();
+		drainRequests();
+		return doCommand(instruction);
+	}
+	// Remove (dequeue) command from the queue, the arguments move on without being copied
+	string command = std::move(instruction.front());
+	instruction.pop();
+	if (asyncRing){
+		// Submit the operation to the asynchronous ring
+		return submitAsync(command, instruction);
+	}
+	double arrivalTime = requestScheduler.getNextArrival();
+	// Serve the requests the disk can start before this one arrives
+	while (requestScheduler.isReady(arrivalTime)){
+		dispatchRequest();
+	}
+	// Queue the request with the file it targets
+	int64_t fileName = stoll(instruction.front());
+	int64_t fileOffset = 0;
+	if (command == "read" && instruction.size() != 2 && instruction.size() != 3){
+		// Offset reads of the old format target the main file
+		decodeFileName(fileName, fileOffset);
+	}
+	requestScheduler.submit(command, instruction, fileName);
+	return 1;
+}
+
+
+/*
+ * Serves the request picked by the scheduling policy
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if commmand is unrecognised
+ */
+int InstructionFile::dispatchRequest(){
+	ScheduledRequest &request = requestScheduler.nextRequest();
+	int result = runCommand(request.command, request.arguments);
+	requestScheduler.completeRequest();
+	return result;
+}
+
+
+/*
+ * Serves every queued request
+ *
+ * Returns:
+ *		Number of requests served
+ */
+int InstructionFile::drainRequests(){
+	int numServed = 0;
+	while (requestScheduler.hasPending()){
+		dispatchRequest();
+		numServed++;
+	}
+	return numServed;
+}
+
+
+/*
+ * Submits a file instruction to the asynchronous ring
+ *	Operations are collected into a batch that is pushed into the
+ *	submission queue once it fills the free slots of the ring. When
+ *	the ring is full, completions are reaped to make room. Instructions
+ *	with an invalid file name run synchronously to report the error.
+ *	The argument tokens move into the submission.
+ *
+ * Input:
+ *		command - Lowercase instruction token (add, append, read or delete)
+ *		arguments - File name and the rest of the instruction
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int InstructionFile::submitAsync(const string &command, std::queue<string> &arguments){
+	IoSubmission submission;
+	submission.fileName = stoll(arguments.front());
+	if (command == "add"){
+		submission.opcode = ioOpAdd;
+	} else if (command == "append"){
+		submission.opcode = ioOpAppend;
+	} else if (command == "read"){
+		submission.opcode = ioOpRead;
+	} else {
+		submission.opcode = ioOpDelete;
+	}
+	// Take the file name off, the arguments of the operation follow it
+	string nameToken = std::move(arguments.front());
+	arguments.pop();
+	bool legacyRead = submission.opcode == ioOpRead && arguments.size() != 1 && arguments.size() != 2;
+	int64_t fileOffset = 0;
+	if (legacyRead){
+		// Offset read of the old format, the offset is passed separately ('0' for the whole file)
+		if (asyncNames.count(submission.fileName) > 0){
+			// An operation in flight may add or delete a file of this exact name, let it finish first
+			drainAsync();
+		}
+		// The name is looked up in the directory, which the workers may be changing
+		std::lock_guard<std::mutex> lock(asyncRing->getDiskMutex());
+		decodeFileName(submission.fileName, fileOffset);
+	}
+	if (submission.fileName <= 0 || ((submission.opcode == ioOpAdd || submission.opcode == ioOpAppend) && currentDisk->getByteStore()) || (submission.opcode == ioOpRead && !legacyRead && stoll(arguments.front()) < 0) || ((submission.opcode == ioOpAdd || submission.opcode == ioOpAppend) && arguments.empty())){
+		// Invalid file name/file data, report it in order
+		drainAsync();
+		// Put the file name back in front of its arguments
+		std::queue<string> instruction;
+		instruction.push(std::move(nameToken));
+		while (!arguments.empty()){
+			instruction.push(std::move(arguments.front()));
+			arguments.pop();
+		}
+		return runCommand(command, instruction);
+	}
+	if (legacyRead){
+		while (!arguments.empty()){
+			arguments.pop();
+		}
+		arguments.push(std::to_string(fileOffset));
+	}
+	if (submission.opcode != ioOpRead && hasLegacyOffset(submission.fileName)){
+		asyncNames.insert(submission.fileName);
+	}
+	// The tokens move into the submission
+	submission.arguments.swap(arguments);
+	submission.userData = asyncTag++;
+	asyncBatch.push_back(std::move(submission));
+	if (asyncBatch.size() >= asyncRing->getFreeSlots()){
+		while (!asyncBatch.empty()){
+			// Push the batch, reaping completions while the ring is full
+			int numAccepted = asyncRing->submit(asyncBatch);
+			asyncBatch.erase(asyncBatch.begin(), asyncBatch.begin() + numAccepted);
+			if (!asyncBatch.empty()){
+				reapAsync(1);
+			}
+		}
+	}
+	return 1;
+}
+
+
+/*
+ * Reaps completions from the asynchronous ring
+ *	Every completion runs one step of the incremental defragmenter,
+ *	as an instruction run in file order does.
+ *
+ * Input:
+ *		minCompletions - Completions to wait for
+ *
+ * Returns:
+ *		Number of completions reaped
+ */
+int InstructionFile::reapAsync(int minCompletions){
+	vector<IoCompletion> completions;
+	asyncRing->reap(minCompletions, completions);
+	for (int i=0;i<completions.size();i++){
+		// The workers may still be running operations, hold the disk
+		std::lock_guard<std::mutex> lock(asyncRing->getDiskMutex());
+		diskDefragmenter.runStep();
+	}
+	return completions.size();
+}
+
+
+/*
+ * Submits the remaining batch and waits for every operation in flight
+ *
+ * Returns:
+ *		Number of completions reaped
+ */
+int InstructionFile::drainAsync(){
+	int numReaped = 0;
+	if (!asyncRing){
+		return 0;
+	}
+	while (!asyncBatch.empty()){
+		int numAccepted = asyncRing->submit(asyncBatch);
+		asyncBatch.erase(asyncBatch.begin(), asyncBatch.begin() + numAccepted);
+		if (!asyncBatch.empty()){
+			numReaped += reapAsync(1);
+		}
+	}
+	while (asyncRing->getInFlight() > 0){
+		numReaped += reapAsync(asyncRing->getInFlight());
+	}
+	asyncNames.clear();
+	return numReaped;
+}
+
+
+/*
+ * Make string lowercase
+ *	Note: This will overwrite the original data as part of normalisation
+ *
+ * Input:
+ *		inputString - Text string to be processed
+ *
+ * Returns:
+  *		'1' when completed successfully
+ */
+
+int InstructionFile::makeLowercase(std::string &inputString){
+	// For each character in the string
+	for (int i=0; i<inputString.length(); i++){
+		// Replace the character with the lowercase version
+		inputString[i] = std::tolower(inputString[i]);
+	}
+	return 1;
+}
+
+
+/*
+ * Number of 64-bit data tokens of an instruction
+ *	File names, file offsets and byte counts are 64-bit, they lead
+ *	the data of the instructions that take them.
+ *
+ * Input:
+ *		inputString - Instruction token
+ *
+ * Returns:
+ *		Number of leading data tokens that may exceed an int
+ */
+int InstructionFile::getWideTokens(std::string inputString){
+	// Compare the lowercase version of the instruction
+	makeLowercase(inputString);
+	if (inputString == "add" || inputString == "append" || inputString == "delete"){
+		// File name (the file data are ints)
+		return 1;
+	} else if (inputString == "list" || inputString == "addbytes"){
+		// Range of file names, or file name and number of bytes
+		return 2;
+	} else if (inputString == "read" || inputString == "readbytes"){
+		// File name, offset and count
+		return 3;
+	}
+	return 0;
+}
+
+
+/*
+ * Check for instructions without data
+ *	Instructions such as 'stats' are given on their own and
+ *	are not followed by a delimiter and file data.
+ *
+ * Input:
+ *		inputString - Instruction token
+ *
+ * Returns:
+ *		true if the instruction does not take any data
+ */
+bool InstructionFile::isStandaloneInstruction(std::string inputString){
+	// Compare the lowercase version of the instruction
+	makeLowercase(inputString);
+	return inputString == "stats" || inputString == "sync" || inputString == "snapshot" || inputString == "list";
+}
+
+
+/*
+ * Checks whether a name is in the offset range of the old format
+ *
+ * Input:
+ *		fileName - Name given in the instruction
+ *
+ * Returns:
+ *		true if the name is below 10000 and not a multiple of 100
+ */
+bool InstructionFile::hasLegacyOffset(int64_t fileName){
+	return fileName > 0 && fileName < legacyNameLimit && fileName % legacyOffsetBase != 0;
+}
+
+
+/*
+ * Decodes a file name of the old instruction format
+ *	Old traces name files with multiples of 100 below 10000, and read
+ *	the entry at an offset by adding it to the name (201 is entry 1 of
+ *	file 200). A name in that range with an offset is split into the
+ *	file name and the offset, unless a file of that exact name exists
+ *	(added with the new format). Any other name is kept whole.
+ *
+ * Input:
+ *		fileName - Name given in the instruction, set to the file name
+ *		fileOffset - Set to the offset ('0' for the whole file)
+ *
+ * Returns:
+ *		'1' if the name held an offset
+ *		'0' if the name is kept whole
+ */
+int InstructionFile::decodeFileName(int64_t &fileName, int64_t &fileOffset){
+	fileOffset = 0;
+	if (!hasLegacyOffset(fileName)){
+		return 0;
+	}
+	if (stripedVolume ? stripedVolume->hasFile(fileName) : currentDisk->checkINode(fileName) != NULL){
+		// A file of this exact name exists
+		return 0;
+	}
+	fileOffset = fileName % legacyOffsetBase;
+	fileName -= fileOffset;
+	return 1;
+}
+
+
+/*
+ * Execute add command
+ *
+ * Input:
+ *		Instruction - current set of instruction to be processed
+ *
+ */
+void InstructionFile::doAdd(std::queue<string> &instruction){
+	// Convert file name to int
+	int64_t fileName = stoll(instruction.front());
+	if (currentDisk->getByteStore() && !stripedVolume){
+		// Files of a disk in byte mode hold bytes
+		cerr << "Error: Adding of file " << fileName << " failed as the disk is in byte mode (use addbytes)." << endl << endl;
+		return;
+	}
+	// If file name is valid and there is data in the instruction
+	if (fileName > 0 && instruction.size() > 1){
+		// Remove the file name from the instruction queue
+		instruction.pop();
+		if (stripedVolume){
+			// Call the addFile method in StripedVolume
+			stripedVolume->addFile(fileName,instruction);
+		} else {
+			// Call the addFile method in VirtualDisk (recorded when an operation log is set)
+			OperationLog::run(currentDisk, metricOpAdd, fileName, [&]{ return currentDisk->addFile(fileName,instruction); });
+		}
+	} else {
+		// Print error message
+		cerr << "Error: Adding of file " << instruction.front() << " failed due to invalid file name/file data." << endl << endl;
+	}
+
+}
+
+
+/*
+ * Execute read command
+ *	A file name alone reads the whole file, or the entry at the offset
+ *	for a name of the old format. A file name with an offset reads the
+ *	entry at the offset ('0' for the whole file), and a file name with
+ *	an offset and count reads a range of the file.
+ *
+ * Input:
+ *		Instruction - current set of instruction to be processed
+ *
+ */
+void InstructionFile::doRead(std::queue<string> &instruction){
+	// Convert file name to int
+	int64_t fileName = stoll(instruction.front());
+	int64_t fileOffset = 0;
+	if (instruction.size() == 3){
+		// Range read - file name, offset and count
+		instruction.pop();
+		fileOffset = stoll(instruction.front());
+		instruction.pop();
+		int64_t count = stoll(instruction.front());
+		if (stripedVolume){
+			// Print error message
+			cerr << "Error: Reading of file " << fileName << " failed as the striped volume does not support range reads." << endl;
+		} else if (fileName > 0 && fileOffset > 0 && count > 0){
+			// Call the readFileRange method in VirtualDisk (recorded when an operation log is set)
+			OperationLog::run(currentDisk, metricOpReadOffset, fileName, [&]{ return currentDisk->readFileRange(fileName, fileOffset, count); });
+		} else {
+			// Print error message
+			cerr << "Error: Reading of file " << fileName << " failed due to invalid file name/range." << endl;
+		}
+		return;
+	}
+	if (instruction.size() == 2){
+		// Offset read - file name and offset
+		instruction.pop();
+		fileOffset = stoll(instruction.front());
+	} else {
+		// Take the offset out of a name of the old format
+		decodeFileName(fileName, fileOffset);
+	}
+	if (fileName > 0 && fileOffset >= 0 && stripedVolume){
+		// Call the readFile method in StripedVolume
+		stripedVolume->readFile(fileName, fileOffset);
+	} else if (fileName > 0 && fileOffset >= 0){
+		// Call the readFile method in VirtualDisk (recorded when an operation log is set)
+		OperationLog::run(currentDisk, fileOffset > 0 ? metricOpReadOffset : metricOpRead, fileName, [&]{ return currentDisk->readFile(fileName, fileOffset); });
+	} else {
+		// Print error message
+		cerr << "Error: Reading of file " << fileName << " failed due to invalid file name/offset." << endl;
+	}
+}
+
+
+/*
+ * Execute delete command
+ *
+ * Input:
+ *		Instruction - current set of instruction to be processed
+ *
+ */
+void InstructionFile::doDelete(std::queue<string> &instruction){
+	// Convert file name to int
+	int64_t fileName = stoll(instruction.front());
+	// If file name is valid
+	if (fileName > 0 && stripedVolume){
+		// Call deleteFile method in StripedVolume
+		stripedVolume->deleteFile(fileName);
+	} else if (fileName > 0){
+		// Call deleteFile method in VirtualDisk (recorded when an operation log is set)
+		OperationLog::run(currentDisk, metricOpDelete, fileName, [&]{ return currentDisk->deleteFile(fileName); });
+	} else {
+		// Print error message
+		cerr << "Error: Deletion of file " << instruction.front() << " failed due to invalid file name." << endl;
+	}
+}
+
+
+/*
+ * Execute defrag command
+ *	Sets the number of blocks the incremental defragmenter
+ *	may relocate after every instruction.
+ *
+ * Input:
+ *		Instruction - current set of instruction to be processed
+ *
+ */
+void InstructionFile::doDefrag(std::queue<string> &instruction){
+	if (instruction.size() > 0){
+		// Convert budget to int and pass it to the defragmenter
+		diskDefragmenter.setBudget(stoi(instruction.front()));
+	} else {
+		// Print error message
+		cerr << "Error: Defragmenter budget not specified." << endl << endl;
+	}
+}
+
+
+/*
+ * Execute stats command
+ *	Prints the free space statistics of the virtual disk and the use
+ *	of its operation arena.
+ *
+ */
+void InstructionFile::doStats(){
+	currentDisk->printFSStats();
+	// Report the memory used by the operations' temporary containers
+	currentDisk->printArenaStats();
+	if (currentDisk->isLazyDelete()){
+		// Report the blocks left behind by lazy deletes
+		currentDisk->printLazyDeleteStats();
+	}
+	if (currentDisk->getFreeMap()){
+		// Report the compressed free block map and its searches
+		currentDisk->printFreeMapStats();
+	}
+	if (currentDisk->getDirTree()){
+		// Report the metadata blocks of the directory tree
+		currentDisk->getDirTree()->printUsage();
+	}
+	if (currentDisk->getByteStore()){
+		// Report the throughput of the byte files
+		currentDisk->getByteStore()->printStats(currentDisk->getAllocationMethod());
+	}
+	// Report the requests scheduled so far
+	requestScheduler.printStats();
+	if (asyncRing){
+		// Report the asynchronous operations so far
+		asyncRing->printStats();
+	}
+}
+
+
+/*
+ * Execute device command
+ *	Selects the simulated device that file operations are charged to
+ *	(1 - HDD, 2 - SATA SSD, 3 - NVMe).
+ *
+ * Input:
+ *		Instruction - current set of instruction to be processed
+ *
+ */
+void InstructionFile::doDevice(std::queue<string> &instruction){
+	if (instruction.size() > 0 && currentDisk->setDeviceModel(stoi(instruction.front()))){
+		cout << "Simulated device set to " << currentDisk->getDeviceModel()->getName() << "." << endl << endl;
+	} else {
+		// Print error message
+		cerr << "Error: Device model not specified or unrecognised." << endl << endl;
+	}
+}
+
+
+/*
+ * Execute cache command
+ *	Sets up the block cache with an eviction policy
+ *	(1 - LRU, 2 - CLOCK, 3 - ARC) and a capacity in blocks.
+ *
+ * Input:
+ *		Instruction - current set of instruction to be processed
+ *
+ */
+void InstructionFile::doCache(std::queue<string> &instruction){
+	if (instruction.size() < 2){
+		// Print error message
+		cerr << "Error: Cache policy and capacity not specified." << endl << endl;
+		return;
+	}
+	int policyType = stoi(instruction.front());
+	instruction.pop();
+	if (currentDisk->setBlockCache(policyType, stoi(instruction.front()))){
+		if (currentDisk->getBlockCache()){
+			cout << "Block cache set to " << currentDisk->getBlockCache()->getName() << " with " << currentDisk->getBlockCache()->getCapacity() << " blocks." << endl << endl;
+		} else {
+			cout << "Block cache disabled." << endl << endl;
+		}
+	}
+}
+
+
+/*
+ * Execute readahead command
+ *	Sets the largest window of the sequential read-ahead in blocks.
+ *	Read-ahead prefetches into the block cache, so a cache has to be
+ *	set up first.
+ *
+ * Input:
+ *		Instruction - current set of instruction to be processed
+ *
+ */
+void InstructionFile::doReadAhead(std::queue<string> &instruction){
+	if (instruction.size() == 0){
+		// Print error message
+		cerr << "Error: Read-ahead window not specified." << endl << endl;
+		return;
+	}
+	if (currentDisk->setReadAhead(stoi(instruction.front()))){
+		if (currentDisk->getReadAhead()){
+			cout << "Read-ahead set with a window of up to " << currentDisk->getReadAhead()->getMaxWindow() << " blocks." << endl << endl;
+		} else {
+			cout << "Read-ahead disabled." << endl << endl;
+		}
+	}
+}
+
+
+/*
+ * Execute writeback command
+ *	Switches to write-back mode with a size threshold in dirty blocks
+ *	and an optional time threshold in operations (default 8). A size
+ *	threshold below 1 switches back to write-through mode.
+ *
+ * Input:
+ *		Instruction - current set of instruction to be processed
+ *
+ */
+void InstructionFile::doWriteBack(std::queue<string> &instruction){
+	if (instruction.size() == 0){
+		// Print error message
+		cerr << "Error: Write-back size threshold not specified." << endl << endl;
+		return;
+	}
+	int maxDirtyBlocks = stoi(instruction.front());
+	instruction.pop();
+	int maxAge = 8;
+	if (instruction.size() > 0){
+		maxAge = stoi(instruction.front());
+	}
+	if (currentDisk->setWriteBack(maxDirtyBlocks, maxAge)){
+		if (currentDisk->getWriteBuffer()){
+			cout << "Write-back set to flush at " << currentDisk->getWriteBuffer()->getMaxDirtyBlocks() << " dirty blocks or after " << currentDisk->getWriteBuffer()->getMaxAge() << " operations." << endl << endl;
+		} else {
+			cout << "Write-back disabled." << endl << endl;
+		}
+	}
+}
+
+
+/*
+ * Execute sync command
+ *	Flushes the write-back buffer to the device.
+ *
+ */
+void InstructionFile::doSync(){
+	if (!currentDisk->flushWriteBack()){
+		cout << "Sync: no dirty blocks to write." << endl << endl;
+	}
+}
+
+
+/*
+ * Execute snapshot command
+ *	Takes a copy-on-write snapshot of the disk.
+ *
+ */
+void InstructionFile::doSnapshot(){
+	int snapshotId = currentDisk->takeSnapshot();
+	if (snapshotId){
+		cout << "Snapshot " << snapshotId << " taken." << endl << endl;
+	}
+}
+
+
+/*
+ * Execute rollback command
+ *	Rolls the disk back to a snapshot, dropping the snapshots taken
+ *	after it.
+ *
+ * Input:
+ *		Instruction - current set of instruction to be processed
+ *
+ */
+void InstructionFile::doRollback(std::queue<string> &instruction){
+	if (instruction.size() > 0){
+		currentDisk->rollbackSnapshot(stoi(instruction.front()));
+	} else {
+		// Print error message
+		cerr << "Error: Snapshot to roll back to not specified." << endl << endl;
+	}
+}
+
+
+/*
+ * Execute diff command
+ *	Compares a snapshot with a newer snapshot, or with the current
+ *	disk if only one snapshot is given.
+ *
+ * Input:
+ *		Instruction - current set of instruction to be processed
+ *
+ */
+void InstructionFile::doDiff(std::queue<string> &instruction){
+	if (instruction.size() == 0){
+		// Print error message
+		cerr << "Error: Snapshot to compare not specified." << endl << endl;
+		return;
+	}
+	int fromId = stoi(instruction.front());
+	instruction.pop();
+	int toId = -1;
+	if (instruction.size() > 0){
+		toId = stoi(instruction.front());
+	}
+	currentDisk->diffSnapshots(fromId, toId);
+}
+
+/*
+ * Execute append command
+ *
+ * Input:
+ *		Instruction - current set of instruction to be processed
+ *
+ */
+void InstructionFile::doAppend(std::queue<string> &instruction){
+	// Convert file name to int
+	int64_t fileName = stoll(instruction.front());
+	if (stripedVolume){
+		// Files of the striped volume are written whole
+		cerr << "Error: Appending to file " << fileName << " failed as the striped volume does not support appends." << endl << endl;
+		return;
+	}
+	if (currentDisk->getByteStore()){
+		// Files of a disk in byte mode hold bytes
+		cerr << "Error: Appending to file " << fileName << " failed as the disk is in byte mode." << endl << endl;
+		return;
+	}
+	// If file name is valid and there is data in the instruction
+	if (fileName > 0 && instruction.size() > 1){
+		// Remove the file name from the instruction queue
+		instruction.pop();
+		// Call the appendFile method in VirtualDisk (recorded when an operation log is set)
+		OperationLog::run(currentDisk, metricOpAppend, fileName, [&]{ return currentDisk->appendFile(fileName,instruction); });
+	} else {
+		// Print error message
+		cerr << "Error: Appending to file " << instruction.front() << " failed due to invalid file name/file data." << endl << endl;
+	}
+}
+
+
+/*
+ * Execute schedule command
+ *	Sets the request scheduling policy and the time between request
+ *	arrivals (all requests arrive at once if not given).
+ *
+ * Input:
+ *		Instruction - current set of instruction to be processed
+ *
+ */
+void InstructionFile::doSchedule(std::queue<string> &instruction){
+	if (instruction.size() == 0){
+		// Print error message
+		cerr << "Error: Scheduling policy not specified." << endl << endl;
+		return;
+	}
+	int policyType = stoi(instruction.front());
+	instruction.pop();
+	int interarrival = 0;
+	if (instruction.size() > 0){
+		interarrival = stoi(instruction.front());
+	}
+	if (requestScheduler.setPolicy(policyType, interarrival)){
+		cout << "Request scheduler set to " << requestScheduler.getName() << " with requests arriving every " << interarrival << " us." << endl << endl;
+	}
+}
+
+
+/*
+ * Execute async command
+ *	Replaces the asynchronous ring with one of the given queue depth
+ *	and number of workers (one if not given). Operations of the
+ *	previous ring have been completed before the instruction runs.
+ *
+ * Input:
+ *		Instruction - current set of instruction to be processed
+ *
+ */
+void InstructionFile::doAsync(std::queue<string> &instruction){
+	if (instruction.size() == 0){
+		// Print error message
+		cerr << "Error: Asynchronous queue depth not specified." << endl << endl;
+		return;
+	}
+	int depth = stoi(instruction.front());
+	instruction.pop();
+	int numWorkers = 1;
+	if (instruction.size() > 0){
+		numWorkers = stoi(instruction.front());
+	}
+	if (depth < 1 || numWorkers < 1){
+		cerr << "Error: Asynchronous queue depth and workers have to be at least 1." << endl << endl;
+		return;
+	}
+	if (asyncRing){
+		// Report and stop the previous ring
+		asyncRing->printStats();
+		delete asyncRing;
+	}
+	asyncRing = new IoRing(currentDisk, depth, numWorkers);
+	cout << "Asynchronous ring set with a queue depth of " << depth << " and " << numWorkers << " worker(s)." << endl << endl;
+}
+
+
+/*
+ * Execute stripe command
+ *	Sets up a striped volume of the given number of member disks and
+ *	stripe unit (one block if not given). The members use the allocation
+ *	method and block size of the main disk. From then on add, read and
+ *	delete instructions go to the volume instead of the main disk.
+ *
+ * Input:
+ *		Instruction - current set of instruction to be processed
+ *
+ */
+void InstructionFile::doStripe(std::queue<string> &instruction){
+	if (instruction.size() == 0){
+		// Print error message
+		cerr << "Error: Number of striped volume members not specified." << endl << endl;
+		return;
+	}
+	int numMembers = stoi(instruction.front());
+	instruction.pop();
+	int unitBlocks = 1;
+	if (instruction.size() > 0){
+		unitBlocks = stoi(instruction.front());
+	}
+	if (numMembers < 1 || unitBlocks < 1){
+		cerr << "Error: Striped volume members and stripe unit have to be at least 1." << endl << endl;
+		return;
+	}
+	if (stripedVolume){
+		// Report and free the previous volume
+		stripedVolume->printStats();
+		delete stripedVolume;
+	}
+	stripedVolume = new StripedVolume(numMembers, unitBlocks, currentDisk->getAllocationMethod(), currentDisk->getBlockSize());
+	cout << "Striped volume set with " << numMembers << " member(s) and a stripe unit of " << unitBlocks << " block(s)." << endl << endl;
+}
+
+
+/*
+ * Execute simd command
+ *	Sets the instruction set of the data kernels (1 - scalar, 2 - SSE2,
+ *	3 - AVX2), to compare them on the same trace. The instruction set is
+ *	capped at the best one the processor supports.
+ *
+ * Input:
+ *		Instruction - current set of instruction to be processed
+ *
+ */
+void InstructionFile::doSimd(std::queue<string> &instruction){
+	if (instruction.size() == 0){
+		// Print error message
+		cerr << "Error: Data kernel instruction set not specified." << endl << endl;
+		return;
+	}
+	int levelType = stoi(instruction.front());
+	if (levelType < 1 || levelType > 3){
+		cerr << "Error: Data kernel instruction set has to be 1 (scalar), 2 (SSE2) or 3 (AVX2)." << endl << endl;
+		return;
+	}
+	DataKernels::setLevel(levelType-1);
+	cout << "Data kernels set to " << DataKernels::getName() << "." << endl << endl;
+}
+
+
+/*
+ * Execute lazydelete command
+ *	A value of 1 or more makes deletes lazy: only the blocks are freed
+ *	and their entries are cleared when the blocks are reused. A value
+ *	below 1 switches back to clearing every entry on delete.
+ *
+ * Input:
+ *		Instruction - current set of instruction to be processed
+ *
+ */
+void InstructionFile::doLazyDelete(std::queue<string> &instruction){
+	if (instruction.size() == 0){
+		// Print error message
+		cerr << "Error: Lazy deletion mode not specified." << endl << endl;
+		return;
+	}
+	currentDisk->setLazyDelete(stoi(instruction.front()) >= 1);
+	if (currentDisk->isLazyDelete()){
+		cout << "Lazy deletion enabled." << endl << endl;
+	} else {
+		cout << "Lazy deletion disabled." << endl << endl;
+	}
+}
+
+
+/*
+ * Execute freemap command
+ *	Selects the free block map that blocks are requested from
+ *	(1 - Dense bit map, 2 - Compressed roaring map, which replaces
+ *	the bit map). The freemapbench instruction compares the two.
+ *
+ * Input:
+ *		Instruction - current set of instruction to be processed
+ *
+ */
+void InstructionFile::doFreeMap(std::queue<string> &instruction){
+	if (instruction.size() == 0){
+		// Print error message
+		cerr << "Error: Free space map not specified." << endl << endl;
+		return;
+	}
+	if (currentDisk->setFreeMap(stoi(instruction.front()))){
+		if (currentDisk->getFreeMap()){
+			cout << "Free space map set to compressed." << endl << endl;
+		} else {
+			cout << "Free space map set to dense." << endl << endl;
+		}
+	}
+}
+
+
+/*
+ * Execute freemapbench command
+ *	Compares the dense and compressed free block maps on a volume of
+ *	the given number of blocks, far larger than the virtual disk.
+ *
+ * Input:
+ *		Instruction - current set of instruction to be processed
+ *
+ */
+void InstructionFile::doFreeMapBench(std::queue<string> &instruction){
+	if (instruction.size() == 0 || stoi(instruction.front()) < 1){
+		// Print error message
+		cerr << "Error: Number of volume blocks not specified." << endl << endl;
+		return;
+	}
+	RoaringBitmap::compareDense(stoi(instruction.front()));
+}
+
+
+/*
+ * Execute directory command
+ *	Selects the directory structure (1 - Inode array in the superblock,
+ *	2 - B+-tree in metadata blocks). Has to be given before any file is
+ *	added.
+ *
+ * Input:
+ *		Instruction - current set of instruction to be processed
+ *
+ */
+void InstructionFile::doDirectory(std::queue<string> &instruction){
+	if (instruction.size() == 0){
+		// Print error message
+		cerr << "Error: Directory structure not specified." << endl << endl;
+		return;
+	}
+	if (currentDisk->setDirectory(stoi(instruction.front()))){
+		if (currentDisk->getDirTree()){
+			cout << "Directory set to B+-tree." << endl << endl;
+		} else {
+			cout << "Directory set to inode array." << endl << endl;
+		}
+	}
+}
+
+
+/*
+ * Execute dirbench command
+ *	Compares the directory tree with the inode array on a directory of
+ *	the given number of files, far more than the virtual disk holds.
+ *
+ * Input:
+ *		Instruction - current set of instruction to be processed
+ *
+ */
+void InstructionFile::doDirBench(std::queue<string> &instruction){
+	if (instruction.size() == 0 || stoi(instruction.front()) < 1){
+		// Print error message
+		cerr << "Error: Number of files not specified." << endl << endl;
+		return;
+	}
+	DirectoryTree::benchmark(stoi(instruction.front()));
+}
+
+
+/*
+ * Execute list command
+ *	Lists the files in a range of file names in order (every file when
+ *	no range is given, or from the first file name when only it is).
+ *
+ * Input:
+ *		Instruction - current set of instruction to be processed
+ *
+ */
+void InstructionFile::doList(std::queue<string> &instruction){
+	int64_t fromName = 1;
+	int64_t toName = INT64_MAX;
+	if (instruction.size() > 0){
+		fromName = stoll(instruction.front());
+		instruction.pop();
+	}
+	if (instruction.size() > 0){
+		toName = stoll(instruction.front());
+	}
+	currentDisk->listFiles(fromName, toName);
+}
+
+
+/*
+ * Execute bytemode command
+ *	Sets the bytes held by a block (a power of 2 from 512 to 65536, 0
+ *	for int entries). Has to be given before any file is added. Files
+ *	are then added and read with addbytes and readbytes.
+ *
+ * Input:
+ *		Instruction - current set of instruction to be processed
+ *
+ */
+void InstructionFile::doByteMode(std::queue<string> &instruction){
+	if (instruction.size() == 0){
+		// Print error message
+		cerr << "Error: Block size of byte mode not specified." << endl << endl;
+		return;
+	}
+	if (currentDisk->setByteMode(stoi(instruction.front()))){
+		if (currentDisk->getByteStore()){
+			cout << "Byte mode set to " << currentDisk->getByteStore()->getBlockBytes() << "-byte blocks (" << currentDisk->getByteStore()->getEntryBytes() << " bytes per entry)." << endl << endl;
+		} else {
+			cout << "Byte mode disabled." << endl << endl;
+		}
+	}
+}
+
+
+/*
+ * Execute addbytes command
+ *	Adds a file of the given number of bytes. A trace cannot hold the
+ *	bytes themselves, so they are generated from the file name and the
+ *	same file always holds the same bytes.
+ *
+ * Input:
+ *		Instruction - current set of instruction to be processed
+ *
+ */
+void InstructionFile::doAddBytes(std::queue<string> &instruction){
+	ByteStore* byteStore = currentDisk->getByteStore();
+	if (!byteStore){
+		// Print error message
+		cerr << "Error: Adding of bytes failed as byte mode is not set." << endl << endl;
+		return;
+	}
+	if (instruction.size() < 2){
+		// Print error message
+		cerr << "Error: File name/number of bytes not specified." << endl << endl;
+		return;
+	}
+	// Convert file name to int
+	int64_t fileName = stoll(instruction.front());
+	instruction.pop();
+	int64_t numBytes = stoll(instruction.front());
+	// A file holds at most the payload of the whole disk
+	if (fileName <= 0 || numBytes <= 0 || numBytes > (int64_t)currentDisk->getVCB()->totalBlockNum * byteStore->getBlockBytes()){
+		// Print error message
+		cerr << "Error: Adding of file " << fileName << " failed due to invalid file name/number of bytes." << endl << endl;
+		return;
+	}
+	vector<uint8_t> bytes(numBytes);
+	std::mt19937 generator(fileName);
+	for (int64_t i=0;i<numBytes;i++){
+		bytes[i] = generator() & 0xFF;
+	}
+	// Call the addBytes method in VirtualDisk (recorded when an operation log is set)
+	OperationLog::run(currentDisk, metricOpAdd, fileName, [&]{ return currentDisk->addBytes(fileName, bytes); });
+}
+
+
+/*
+ * Execute readbytes command
+ *	Reads a whole file of bytes, or the bytes from an offset (starting
+ *	from 0) and the number of bytes after it.
+ *
+ * Input:
+ *		Instruction - current set of instruction to be processed
+ *
+ */
+void InstructionFile::doReadBytes(std::queue<string> &instruction){
+	if (!currentDisk->getByteStore()){
+		// Print error message
+		cerr << "Error: Reading of bytes failed as byte mode is not set." << endl << endl;
+		return;
+	}
+	if (instruction.size() == 0){
+		// Print error message
+		cerr << "Error: File name not specified." << endl << endl;
+		return;
+	}
+	// Convert file name to int
+	int64_t fileName = stoll(instruction.front());
+	int64_t byteOffset = 0;
+	int64_t numBytes = 0;
+	instruction.pop();
+	if (instruction.size() > 0){
+		byteOffset = stoll(instruction.front());
+		instruction.pop();
+	}
+	if (instruction.size() > 0){
+		numBytes = stoll(instruction.front());
+	}
+	if (fileName > 0 && byteOffset >= 0 && numBytes >= 0){
+		// Call the readFileBytes method in VirtualDisk (recorded when an operation log is set)
+		OperationLog::run(currentDisk, byteOffset > 0 ? metricOpReadOffset : metricOpRead, fileName, [&]{ return currentDisk->readFileBytes(fileName, byteOffset, numBytes); });
+	} else {
+		// Print error message
+		cerr << "Error: Reading of file " << fileName << " failed due to invalid file name/range." << endl << endl;
+	}
+}
+
+
+/*
+ * Execute metrics command
+ *	Sets the format of the operation metrics (1 - JSON, 2 - CSV) and
+ *	the number of operations between exports (the metrics are only
+ *	exported at the end of the run if not given). The metrics are only
+ *	recorded in a build with -DdiskMetrics.
+ *
+ * Input:
+ *		Instruction - current set of instruction to be processed
+ *
+ */
+void InstructionFile::doMetrics(std::queue<string> &instruction){
+	if (instruction.size() == 0){
+		// Print error message
+		cerr << "Error: Metrics format not specified." << endl << endl;
+		return;
+	}
+#ifdef diskMetrics
+	int format = stoi(instruction.front());
+	instruction.pop();
+	long interval = 0;
+	if (instruction.size() > 0){
+		interval = stol(instruction.front());
+	}
+	if (currentDisk->getMetrics()->setExport(format, interval)){
+		cout << "Metrics exported as " << (format == metricsJSON ? "JSON" : "CSV");
+		if (interval > 0){
+			cout << " every " << interval << " operation(s) and";
+		}
+		cout << " at the end of the run." << endl << endl;
+	}
+#else
+	// Print error message
+	cerr << "Error: Operation metrics are not built in (compile with -DdiskMetrics)." << endl << endl;
+#endif
+}
+
+
+/*
+ * Execute trace command
+ *	Turns the recording of the timeline off ('0') or back on ('1').
+ *	Recording is on from the start of the run, and the timeline is
+ *	written to the trace file at the end of the run. The timeline is
+ *	only recorded in a build with -DdiskTrace.
+ *
+ * Input:
+ *		Instruction - current set of instruction to be processed
+ *
+ */
+void InstructionFile::doTrace(std::queue<string> &instruction){
+	if (instruction.size() == 0 || (instruction.front() != "0" && instruction.front() != "1")){
+		// Print error message
+		cerr << "Error: Trace recording has to be 0 (off) or 1 (on)." << endl << endl;
+		return;
+	}
+#ifdef diskTrace
+	DiskTracer::getTracer()->setEnabled(instruction.front() == "1");
+	cout << "Timeline recording " << (instruction.front() == "1" ? "resumed" : "paused") << "." << endl << endl;
+#else
+	// Print error message
+	cerr << "Error: Timeline tracing is not built in (compile with -DdiskTrace)." << endl << endl;
+#endif
+}
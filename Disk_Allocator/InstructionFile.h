@@ -1,36 +1,87 @@
-// InstructionFile.cpp
-#ifndef INSTRUCTIONFILE_CPP
-#define INSTRUCTIONFILE_CPP
-#pragma once
-
-// Compiler Directive
-using namespace std;
-
-
-class InstructionFile{
-	// Private variables for InstructionFile
-	VirtualDisk* currentDisk;
-	std::string fileName;
-	ifstream inputFileStream;
-	std::queue<queue<string> > userInstructions;
-public:
-	// Function declarations/prototypes
-	InstructionFile(VirtualDisk* disk);
-	int setupFile();
-	int getUserFileName();
-	int openFile();
-	void closeFile();
-	int processFileContents();
-	void executeNextInstruction();
-	void executeAllInstructions();
-	std::queue<string> split(std::string &inputString, char delimiter=',');
-	int doCommand(std::queue<string> &command);
-	int makeLowercase(std::string &inputString);
-	
-	void doAdd(std::queue<string> &command);
-	void doRead(std::queue<string> &command);
-	void doDelete(std::queue<string> &command);
-};
-
-
+// InstructionFile.cpp
+#ifndef INSTRUCTIONFILE_CPP
+#define INSTRUCTIONFILE_CPP
+#pragma once
+
+// Compiler Directive
+using namespace std;
+
+// Old instruction format: file names are multiples of 100 below 10000, and a read adds the offset to the name
+#define legacyNameLimit 10000
+#define legacyOffsetBase 100
+
+class InstructionFile{
+	// Private variables for InstructionFile
+	VirtualDisk* currentDisk;
+	Defragmenter diskDefragmenter;
+	RequestScheduler requestScheduler;
+	IoRing* asyncRing;
+	vector<IoSubmission> asyncBatch;
+	long asyncTag;
+	std::set<int64_t> asyncNames;		// Names in the old format's offset range that operations in flight add, append or delete
+	StripedVolume* stripedVolume;
+	std::string fileName;
+	ifstream inputFileStream;
+	std::queue<queue<string> > userInstructions;
+public:
+	// Function declarations/prototypes
+	InstructionFile(VirtualDisk* disk);
+	InstructionFile(VirtualDisk* disk, std::string instructionFileName);
+	InstructionFile(VirtualDisk* disk, std::queue<queue<string> > &instructions);
+	~InstructionFile();
+	int setupFile();
+	int getUserFileName();
+	int openFile();
+	void closeFile();
+	int processFileContents();
+	void executeNextInstruction();
+	bool hasNextInstruction();
+	void executeAllInstructions();
+	std::queue<string> split(std::string &inputString, char delimiter=',');
+	int doCommand(std::queue<string> &command);
+	int runCommand(const string &command, std::queue<string> &arguments);
+	int scheduleCommand(std::queue<string> &command);
+	int dispatchRequest();
+	int drainRequests();
+	int submitAsync(const string &command, std::queue<string> &arguments);
+	int reapAsync(int minCompletions);
+	int drainAsync();
+	int makeLowercase(std::string &inputString);
+	bool isStandaloneInstruction(std::string inputString);
+	int getWideTokens(std::string inputString);
+	bool hasLegacyOffset(int64_t fileName);
+	int decodeFileName(int64_t &fileName, int64_t &fileOffset);
+	
+	void doAdd(std::queue<string> &command);
+	void doAppend(std::queue<string> &command);
+	void doRead(std::queue<string> &command);
+	void doDelete(std::queue<string> &command);
+	void doDefrag(std::queue<string> &command);
+	void doStats();
+	void doDevice(std::queue<string> &command);
+	void doCache(std::queue<string> &command);
+	void doReadAhead(std::queue<string> &command);
+	void doWriteBack(std::queue<string> &command);
+	void doSync();
+	void doSnapshot();
+	void doRollback(std::queue<string> &command);
+	void doDiff(std::queue<string> &command);
+	void doSchedule(std::queue<string> &command);
+	void doAsync(std::queue<string> &command);
+	void doStripe(std::queue<string> &command);
+	void doSimd(std::queue<string> &command);
+	void doLazyDelete(std::queue<string> &command);
+	void doFreeMap(std::queue<string> &command);
+	void doFreeMapBench(std::queue<string> &command);
+	void doDirectory(std::queue<string> &command);
+	void doDirBench(std::queue<string> &command);
+	void doList(std::queue<string> &command);
+	void doByteMode(std::queue<string> &command);
+	void doAddBytes(std::queue<string> &command);
+	void doReadBytes(std::queue<string> &command);
+	void doMetrics(std::queue<string> &command);
+	void doTrace(std::queue<string> &command);
+};
+
+
 #endif
\ No newline at end of file
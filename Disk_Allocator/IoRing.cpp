@@ -0,0 +1,244 @@
+#include "Header.h"				// Header file
+#include "VirtualDisk.h"		// VirtualDisk file
+#include "OperationMetrics.h"
+#include "OperationLog.h"
+#include "IoRing.h"				// IoRing file
+
+// Compiler Directive
+using namespace std;
+
+
+/*
+ * Contructor for IoRing
+ *	Starts the worker pool.
+ *
+ */
+IoRing::IoRing(VirtualDisk* disk, int depth, int numWorkers){
+	currentDisk = disk;
+	queueDepth = depth;
+	numInFlight = 0;
+	stopping = false;
+	numCompleted = 0;
+	numOutOfOrder = 0;
+	lastUserData = -1;
+	inFlightSamples = 0;
+	numSubmitted = 0;
+	startTime = std::chrono::steady_clock::now();
+	for (int i=0;i<numWorkers;i++){
+		workers.push_back(std::thread(&IoRing::workerLoop, this));
+	}
+}
+
+IoRing::~IoRing(){
+	// Let the workers finish the queued submissions and exit
+	{
+		std::lock_guard<std::mutex> lock(ringMutex);
+		stopping = true;
+	}
+	submissionReady.notify_all();
+	for (int i=0;i<workers.size();i++){
+		workers[i].join();
+	}
+}
+
+
+/*
+ * Pushes a batch of operations into the submission queue
+ *	Only as many operations as there are free slots in the ring are
+ *	accepted, the caller resubmits the rest after reaping. Accepted
+ *	operations are moved out of the batch, the caller erases them.
+ *
+ * Input:
+ *		batch - Operation descriptors, in submission order
+ *
+ * Returns:
+ *		Number of operations accepted
+ */
+int IoRing::submit(vector<IoSubmission> &batch){
+	int numAccepted = 0;
+	{
+		std::lock_guard<std::mutex> lock(ringMutex);
+		while (numAccepted < batch.size() && numInFlight < queueDepth){
+			submissionQueue.push_back(std::move(batch[numAccepted]));
+			numInFlight++;
+			numSubmitted++;
+			inFlightSamples += numInFlight;
+			numAccepted++;
+		}
+	}
+	submissionReady.notify_all();
+	return numAccepted;
+}
+
+
+/*
+ * Reaps completions from the completion queue
+ *	Waits until at least the given number of completions is available
+ *	(or nothing is left in flight) and takes every completion posted.
+ *
+ * Input:
+ *		minCompletions - Completions to wait for
+ *		completions - Reaped completions are added to the end
+ *
+ * Returns:
+ *		Number of completions reaped
+ */
+int IoRing::reap(int minCompletions, vector<IoCompletion> &completions){
+	std::unique_lock<std::mutex> lock(ringMutex);
+	minCompletions = min(minCompletions, numInFlight);
+	completionReady.wait(lock, [&]{ return completionQueue.size() >= minCompletions; });
+	int numReaped = completionQueue.size();
+	while (!completionQueue.empty()){
+		IoCompletion completion = completionQueue.front();
+		completionQueue.pop_front();
+		if (completion.userData < lastUserData){
+			// An earlier submission completed after this one
+			numOutOfOrder++;
+		}
+		lastUserData = max(lastUserData, completion.userData);
+		completions.push_back(completion);
+		numInFlight--;
+		numCompleted++;
+	}
+	return numReaped;
+}
+
+
+/*
+ * Worker thread
+ *	Takes the first submission whose file has no operation running,
+ *	runs it under the disk mutex and posts its completion.
+ *
+ */
+void IoRing::workerLoop(){
+	while (true){
+		IoSubmission submission;
+		int64_t mainFileID;
+		{
+			std::unique_lock<std::mutex> lock(ringMutex);
+			std::deque<IoSubmission>::iterator next;
+			// Wait for a submission on a file that is not busy
+			submissionReady.wait(lock, [&]{
+				for (next = submissionQueue.begin(); next != submissionQueue.end(); next++){
+					if (busyFiles.count(next->fileName) == 0){
+						return true;
+					}
+				}
+				return stopping && submissionQueue.empty();
+			});
+			if (next == submissionQueue.end()){
+				// Stopping with nothing left to run
+				return;
+			}
+			submission = std::move(*next);
+			submissionQueue.erase(next);
+			mainFileID = submission.fileName;
+			busyFiles.insert(mainFileID);
+		}
+		IoCompletion completion;
+		completion.userData = submission.userData;
+		{
+			std::lock_guard<std::mutex> diskLock(diskMutex);
+			completion.result = runOperation(submission);
+			completion.accessTime = currentDisk->getAccessTime();
+			completion.deviceTime = currentDisk->getDeviceTime();
+			// Flush the write-back buffer if a threshold was reached (no-op in write-through mode)
+			currentDisk->checkWriteBack();
+		}
+		{
+			std::lock_guard<std::mutex> lock(ringMutex);
+			busyFiles.erase(mainFileID);
+			completionQueue.push_back(completion);
+		}
+		// Later submissions on the file may start now
+		submissionReady.notify_all();
+		completionReady.notify_all();
+	}
+}
+
+
+/*
+ * Runs one operation on the disk
+ *	The operation is recorded when the disk has an operation log.
+ *
+ * Input:
+ *		submission - Operation descriptor
+ *
+ * Returns:
+ *		Return value of the disk operation
+ */
+int IoRing::runOperation(IoSubmission &submission){
+	switch (submission.opcode){
+		case (ioOpAdd): {
+			return OperationLog::run(currentDisk, metricOpAdd, submission.fileName, [&]{ return currentDisk->addFile(submission.fileName, submission.arguments); });
+		}
+		case (ioOpAppend): {
+			return OperationLog::run(currentDisk, metricOpAppend, submission.fileName, [&]{ return currentDisk->appendFile(submission.fileName, submission.arguments); });
+		}
+		case (ioOpRead): {
+			if (submission.arguments.size() == 2){
+				// Range read - offset and count
+				int64_t fileOffset = stoll(submission.arguments.front());
+				submission.arguments.pop();
+				int64_t count = stoll(submission.arguments.front());
+				return OperationLog::run(currentDisk, metricOpReadOffset, submission.fileName, [&]{ return currentDisk->readFileRange(submission.fileName, fileOffset, count); });
+			}
+			int64_t fileOffset = stoll(submission.arguments.front());
+			return OperationLog::run(currentDisk, fileOffset > 0 ? metricOpReadOffset : metricOpRead, submission.fileName, [&]{ return currentDisk->readFile(submission.fileName, fileOffset); });
+		}
+		case (ioOpDelete): {
+			return OperationLog::run(currentDisk, metricOpDelete, submission.fileName, [&]{ return currentDisk->deleteFile(submission.fileName); });
+		}
+	}
+	return 0;
+}
+
+
+/*
+ * Getter methods for the ring occupancy
+ *
+ */
+int IoRing::getFreeSlots(){
+	std::lock_guard<std::mutex> lock(ringMutex);
+	return queueDepth - numInFlight;
+}
+
+int IoRing::getInFlight(){
+	std::lock_guard<std::mutex> lock(ringMutex);
+	return numInFlight;
+}
+
+
+/*
+ * Getter method for the disk mutex
+ *	Callers that use the disk while operations are in flight have to
+ *	hold it.
+ *
+ * Returns:
+ *		Mutex serialising operations on the disk
+ */
+std::mutex& IoRing::getDiskMutex(){
+	return diskMutex;
+}
+
+
+/*
+ * Prints the statistics of the ring
+ *
+ * Output:
+ *		Operations completed, completions out of submission order,
+ *		average operations in flight and wall clock throughput
+ */
+void IoRing::printStats(){
+	std::lock_guard<std::mutex> lock(ringMutex);
+	streamsize defaultPrecision = cout.precision();
+	double wallTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+	cout << "Asynchronous ring (depth " << queueDepth << ", " << workers.size() << " worker(s))" << endl;
+	cout << "\t> Operations completed: " << numCompleted << endl;
+	cout << "\t> Completed out of submission order: " << numOutOfOrder << endl;
+	cout << "\t> Average operations in flight: " << fixed << setprecision(2) << inFlightSamples * 1.00 / max(numSubmitted, 1L) << endl;
+	cout << "\t> Wall time: " << setprecision(1) << wallTime << " ms (" << numCompleted / max(wallTime / 1000, 0.001) << " operations/s)" << endl;
+	cout << endl;
+	cout.unsetf(ios::floatfield);
+	cout.precision(defaultPrecision);
+}
@@ -0,0 +1,76 @@
+// IoRing.h
+#ifndef IORING_H
+#define IORING_H
+#pragma once
+
+// Operation codes of a submission
+#define ioOpAdd 1
+#define ioOpAppend 2
+#define ioOpRead 3
+#define ioOpDelete 4
+
+// Operation descriptor in the submission queue
+typedef struct IoSubmission {
+	int opcode;						// Operation (ioOpAdd, ioOpAppend, ioOpRead, ioOpDelete)
+	int64_t fileName;				// File name
+	std::queue<string> arguments;	// File data, offset of a read ('0' for the whole file), or offset and count of a range read
+	long userData;					// Caller's tag, returned in the completion
+} IoSubmission;
+
+// Result in the completion queue
+typedef struct IoCompletion {
+	long userData;					// Tag of the submission
+	int result;						// Return value of the operation ('1' success, '0' failure)
+	int accessTime;					// Accesses to memory of the operation
+	double deviceTime;				// Simulated device time of the operation (us)
+} IoCompletion;
+
+/*
+ * Asynchronous submission/completion ring for VirtualDisk
+ *	Callers push batches of operation descriptors into the submission
+ *	queue and reap results from the completion queue, in the style of
+ *	io_uring. A pool of worker threads takes submissions and runs them
+ *	on the disk. The disk is not thread safe, so a worker holds the
+ *	disk mutex while an operation runs, but operations on different
+ *	files may be picked and completed in any order. Operations on the
+ *	same file always run in submission order.
+ */
+class IoRing{
+	// Private variables for IoRing
+	VirtualDisk* currentDisk;
+	int queueDepth;								// Most operations in flight (submitted, not reaped)
+	int numInFlight;							// Operations submitted and not reaped
+	std::deque<IoSubmission> submissionQueue;	// Submissions not started yet
+	std::deque<IoCompletion> completionQueue;	// Completions not reaped yet
+	std::set<int64_t> busyFiles;				// Files with an operation running
+	vector<std::thread> workers;				// Worker pool
+	std::mutex ringMutex;						// Guards the queues and counters
+	std::mutex diskMutex;						// Serialises operations on the disk
+	std::condition_variable submissionReady;	// Signalled when a submission can be started
+	std::condition_variable completionReady;	// Signalled when a completion is posted
+	bool stopping;								// Set when the workers have to exit
+	long numCompleted;							// Completions reaped
+	long numOutOfOrder;							// Completions reaped before an earlier submission
+	long lastUserData;							// Highest tag reaped so far
+	long inFlightSamples;						// Sum of the operations in flight at every submission
+	long numSubmitted;							// Operations submitted
+	std::chrono::steady_clock::time_point startTime;
+	void workerLoop();
+	int runOperation(IoSubmission &submission);
+public:
+	// Constructors/Destructors
+	IoRing(VirtualDisk* disk, int depth, int numWorkers);
+	~IoRing();
+
+	// Queue methods
+	int submit(vector<IoSubmission> &batch);
+	int reap(int minCompletions, vector<IoCompletion> &completions);
+	int getFreeSlots();
+	int getInFlight();
+	std::mutex& getDiskMutex();
+
+	// Printing methods
+	void printStats();
+};
+
+#endif
@@ -1,31 +1,121 @@
-/*
-// Compile and run program
-cls && g++ Main.cpp VirtualDisk.cpp InstructionFile.cpp -o Main && Main
-
-*/
-
-//Preprocessor directive
-#include "Header.h"
-#include "VirtualDisk.h"
-#include "InstructionFile.h"
-
-// Compiler Directive
-using namespace std;
-
-
-// Declare forward external variable linkage
-extern const int MAX_ELEMENTS = 128;
-
-
-/* Main function definition */
-int main(){	
-	// Create new instance of VirtualDisk
-	VirtualDisk newDisk;	
-	// Create new instance of InstructionFile
-	InstructionFile newInstructions(&newDisk);
-	// Execute all instructions in InstructionFile
-	newInstructions.executeAllInstructions();
-	
-	// End of Main function
-	return 0;
+/*
+// Compile and run program
+cls && g++ Main.cpp VirtualDisk.cpp InstructionFile.cpp Defragmenter.cpp DeviceModel.cpp BlockCache.cpp ReadAhead.cpp WriteBuffer.cpp SegmentLog.cpp Snapshot.cpp RequestScheduler.cpp IoRing.cpp ClientExecutor.cpp StripedVolume.cpp OperationArena.cpp DataKernels.cpp RoaringBitmap.cpp DirectoryTree.cpp ByteStore.cpp OperationMetrics.cpp DiskTracer.cpp OperationLog.cpp -std=c++20 -o Main && Main
+
+// Record latency histograms of the file operations (see the metrics instruction): add -DdiskMetrics to the g++ line above
+
+// Write a timeline of the instructions and disk phases to diskTrace.json (see the trace instruction): add -DdiskTrace to the g++ line above
+
+// Run instruction files as clients sharing the disk (policy rr, weighted or timestamp)
+Main -p weighted client1.csv:2 client2.csv:1
+
+// Record the instructions and the outcome of every file operation (without the disk's output), then replay the log (on this or another build) and compare
+Main -record run.log
+Main -replay run.log
+
+*/
+
+//Preprocessor directive
+#include "Header.h"
+#include "VirtualDisk.h"
+#include "Defragmenter.h"
+#include "RequestScheduler.h"
+#include "IoRing.h"
+#include "StripedVolume.h"
+#include "InstructionFile.h"
+#include "ClientExecutor.h"
+#include "OperationMetrics.h"
+#include "DiskTracer.h"
+#include "OperationLog.h"
+
+// Compiler Directive
+using namespace std;
+
+
+// Declare forward external variable linkage
+extern const int MAX_ELEMENTS = 128;
+
+
+/* Main function definition
+ *	Without arguments a single instruction file is asked for. Every
+ *	instruction file given as an argument runs as a client of the
+ *	multi-client executor instead:
+ *		Main [-p rr|weighted|timestamp] file[:weight] ...
+ *	A single instruction file can be recorded to an operation log, and
+ *	a log replayed to compare the outcomes (the disk prints nothing
+ *	while recording, so both runs are timed the same way):
+ *		Main -record log
+ *		Main -replay log
+ */
+int main(int argc, char* argv[]){	
+	if (argc == 3 && std::string(argv[1]) == "-replay"){
+		// Run the instructions of the log again and compare the outcomes
+		return OperationLog::replay(argv[2]) ? 0 : 1;
+	}
+	// Create new instance of VirtualDisk
+	VirtualDisk newDisk;	
+	if (argc == 3 && std::string(argv[1]) == "-record"){
+		// Record the instructions and file operations of the run
+		OperationLog* newLog = new OperationLog(argv[2], newDisk.getAllocationMethod(), newDisk.getBlockSize());
+		if (!newLog->isOpen()){
+			delete newLog;
+			return 1;
+		}
+		newDisk.setOperationLog(newLog);
+		// Discard the output of the disk, as a replay does, so the recorded
+		// wall times of the operations do not include the console
+		newDisk.setQuiet(true);
+		cout << "Recording to " << argv[2] << ", the output of the disk is discarded." << endl;
+	} else if (argc > 1){
+		// Multi-client mode, pick the interleaving policy
+		int policy = clientRoundRobin;
+		int firstClient = 1;
+		if (std::string(argv[1]) == "-p" && argc > 2){
+			std::string policyName = argv[2];
+			if (policyName == "weighted"){
+				policy = clientWeighted;
+			} else if (policyName == "timestamp"){
+				policy = clientTimestamp;
+			} else if (policyName != "rr"){
+				cerr << "Error: Unrecognised client policy " << policyName << "." << endl;
+				return 1;
+			}
+			firstClient = 3;
+		}
+		ClientExecutor newExecutor(&newDisk, policy);
+		for (int i=firstClient;i<argc;i++){
+			// Split the optional weight from the file name
+			std::string clientFile = argv[i];
+			int weight = 1;
+			size_t weightPos = clientFile.rfind(':');
+			if (weightPos != std::string::npos && weightPos+1 < clientFile.size() && clientFile.find_first_not_of("0123456789", weightPos+1) == std::string::npos && clientFile.size()-weightPos-1 < 10){
+				weight = stoi(clientFile.substr(weightPos+1));
+				clientFile = clientFile.substr(0, weightPos);
+			}
+			newExecutor.addClient(clientFile, weight);
+		}
+		// Interleave the clients until all of them have finished
+		newExecutor.run();
+		// Write out any buffered writes
+		newDisk.flushWriteBack();
+		newExecutor.printStats();
+#ifdef diskMetrics
+		// Export the operation metrics of the run
+		newDisk.getMetrics()->exportMetrics();
+#endif
+#ifdef diskTrace
+		// Write the timeline of the run
+		DiskTracer::getTracer()->writeTrace();
+#endif
+		// Print disk map after executing
+		newDisk.printDiskMap();
+		return 0;
+	}
+	// Create new instance of InstructionFile
+	InstructionFile newInstructions(&newDisk);
+	// Execute all instructions in InstructionFile
+	newInstructions.executeAllInstructions();
+	
+	// End of Main function
+	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include "Header.h"				// Header file
+#include "OperationArena.h"		// OperationArena file
+
+// Compiler Directive
+using namespace std;
+
+
+/*
+ * Contructor for OperationArena
+ *	Memory past the end of the buffer comes from the heap.
+ *
+ */
+OperationArena::OperationArena(int numBytes) : buffer(numBytes), overflow(std::pmr::new_delete_resource()){
+	offset = 0;
+	peakBytes = 0;
+	numResets = 0;
+	numOverflows = 0;
+}
+
+
+/*
+ * Allocates memory for a temporary container
+ *	The offset is rounded up to the alignment asked for. When the buffer
+ *	is full the memory is taken from the heap instead.
+ *
+ * Input:
+ *		numBytes - Bytes needed
+ *		alignment - Alignment of the memory (a power of 2)
+ *
+ * Returns:
+ *		Pointer to the memory
+ */
+void* OperationArena::do_allocate(size_t numBytes, size_t alignment){
+	size_t start = (offset + alignment-1) & ~(alignment-1);
+	if (start + numBytes > buffer.size()){
+		// Buffer full, go to the heap
+		numOverflows++;
+		return overflow.allocate(numBytes, alignment);
+	}
+	offset = start + numBytes;
+	peakBytes = max(peakBytes, offset);
+	return buffer.data() + start;
+}
+
+
+/*
+ * Frees memory of a temporary container
+ *	Single allocations are not freed, the whole arena is reset instead.
+ *
+ */
+void OperationArena::do_deallocate(void* pointer, size_t numBytes, size_t alignment){
+}
+
+
+/*
+ * Compares memory resources
+ *	Memory from one arena can only be freed by the same arena.
+ *
+ */
+bool OperationArena::do_is_equal(const std::pmr::memory_resource &other) const noexcept{
+	return this == &other;
+}
+
+
+/*
+ * Resets the arena for the next operation
+ *	The containers of the previous operation must be gone by now.
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int OperationArena::reset(){
+	offset = 0;
+	// Return the heap memory of the previous operation
+	overflow.release();
+	numResets++;
+	return 1;
+}
+
+
+/*
+ * Getter methods for the arena statistics
+ *
+ */
+size_t OperationArena::getCapacity(){
+	return buffer.size();
+}
+
+size_t OperationArena::getPeakBytes(){
+	return peakBytes;
+}
+
+long OperationArena::getResets(){
+	return numResets;
+}
+
+long OperationArena::getOverflows(){
+	return numOverflows;
+}
@@ -0,0 +1,41 @@
+// OperationArena.h
+#ifndef OPERATIONARENA_H
+#define OPERATIONARENA_H
+#pragma once
+
+// Size of the fixed buffer of an operation arena (bytes)
+#define opArenaBytes 16384
+
+/*
+ * Per-operation arena for temporary containers
+ *	Hands out memory from a fixed buffer by bumping an offset, and never
+ *	frees single allocations. The disk resets the arena when an operation
+ *	starts, so the index lists and block maps of one operation reuse the
+ *	same buffer instead of going to the heap. An operation that needs more
+ *	than the buffer holds takes the rest from the heap, which is counted
+ *	and returned on the next reset.
+ */
+class OperationArena : public std::pmr::memory_resource{
+	vector<char> buffer;								// Fixed buffer, allocated once
+	size_t offset;										// Bytes of the buffer in use
+	size_t peakBytes;									// Most bytes used by one operation
+	std::pmr::monotonic_buffer_resource overflow;		// Heap memory past the end of the buffer
+	long numResets;										// Operations that used the arena
+	long numOverflows;									// Allocations that did not fit in the buffer
+protected:
+	void* do_allocate(size_t numBytes, size_t alignment);
+	void do_deallocate(void* pointer, size_t numBytes, size_t alignment);
+	bool do_is_equal(const std::pmr::memory_resource &other) const noexcept;
+public:
+	// Constructors/Destructors
+	OperationArena(int numBytes);
+
+	// General methods
+	int reset();
+	size_t getCapacity();
+	size_t getPeakBytes();
+	long getResets();
+	long getOverflows();
+};
+
+#endif
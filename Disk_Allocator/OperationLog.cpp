@@ -0,0 +1,578 @@
+#include "Header.h"				// Header file
+#include "VirtualDisk.h"
+#include "Defragmenter.h"
+#include "RequestScheduler.h"
+#include "IoRing.h"
+#include "StripedVolume.h"
+#include "InstructionFile.h"
+#include "OperationMetrics.h"
+#include "OperationLog.h"		// OperationLog file
+
+// Compiler Directive
+using namespace std;
+
+// Names of the operation classes in the replay report
+const char* OperationLog::opNames[metricNumOps] = {"add", "append", "read", "read-offset", "delete"};
+
+
+/*
+ * Contructor for OperationLog
+ *	Writes the header of the log: the magic bytes, the version of the
+ *	format, and the allocation method and block size of the disk.
+ *
+ * Input:
+ *		fileName - File to write the log to ('' to keep the log in memory)
+ *		method - Allocation method of the disk (1-5)
+ *		blockSize - Entries in a block of the disk
+ *
+ */
+OperationLog::OperationLog(std::string fileName, int method, int blockSize){
+	logFileName = fileName;
+	numInstructions = 0;
+	numOperations = 0;
+	bytesWritten = 0;
+	if (!logFileName.empty()){
+		logFile.open(logFileName, ios::binary | ios::trunc);
+		if (!logFile.is_open()){
+			cerr << "Error: Unable to open the operation log " << logFileName << "." << endl << endl;
+		}
+		// The buffer is written out once it holds logFlushBytes, so it never has to grow past a record more
+		buffer.reserve(2*logFlushBytes);
+	}
+	buffer.insert(buffer.end(), operationLogMagic, operationLogMagic+4);
+	buffer.push_back(operationLogVersion);
+	putVarint(method);
+	putVarint(blockSize);
+}
+
+OperationLog::~OperationLog(){
+	// Destructor, write out the records still buffered
+	flush();
+}
+
+
+/*
+ * Appends an unsigned value to the buffer (LEB128, 7 bits a byte)
+ *
+ * Input:
+ *		value - Value to append
+ *
+ * Returns:
+ *		Number of bytes appended
+ */
+int OperationLog::putVarint(uint64_t value){
+	int numBytes = 1;
+	while (value >= 0x80){
+		// Low 7 bits, with the top bit set as more bytes follow
+		buffer.push_back((uint8_t)(value | 0x80));
+		value >>= 7;
+		numBytes++;
+	}
+	buffer.push_back((uint8_t)value);
+	return numBytes;
+}
+
+/*
+ * Appends a signed value to the buffer
+ *	Zigzag encoded (0, -1, 1, -2 ... become 0, 1, 2, 3 ...), so small
+ *	negative values stay short.
+ *
+ */
+int OperationLog::putSigned(int64_t value){
+	return putVarint(((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+/*
+ * Appends a token of an instruction to the buffer
+ *	A token that is a plain number is kept as its value, any other
+ *	token as its characters. The low bit of the first varint tells
+ *	which one follows.
+ *
+ * Input:
+ *		token - Token to append
+ *
+ * Returns:
+ *		Number of bytes appended
+ */
+int OperationLog::putToken(const std::string &token){
+	char* tokenEnd;
+	long long value = strtoll(token.c_str(), &tokenEnd, 10);
+	// Only values that print back as the same token, and keep a bit spare once zigzag encoded
+	if (!token.empty() && *tokenEnd == '\0' && to_string(value) == token && value > -((long long)1 << 61) && value < ((long long)1 << 61)){
+		uint64_t zigzag = ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+		return putVarint(zigzag << 1);
+	}
+	int numBytes = putVarint(((uint64_t)token.size() << 1) | 1);
+	buffer.insert(buffer.end(), token.begin(), token.end());
+	return numBytes + token.size();
+}
+
+
+/*
+ * Reads an unsigned value from a log (LEB128)
+ *
+ * Input:
+ *		bytes - Bytes of the log
+ *		pos - Position of the value, moved past it
+ *
+ * Output:
+ *		value - Value read
+ *
+ * Returns:
+ *		true if a whole value was read
+ */
+bool OperationLog::getVarint(vector<uint8_t> &bytes, size_t &pos, uint64_t &value){
+	value = 0;
+	for (int shift=0;shift<64;shift+=7){
+		if (pos >= bytes.size()){
+			return false;
+		}
+		uint8_t byte = bytes[pos++];
+		value |= (uint64_t)(byte & 0x7f) << shift;
+		if (!(byte & 0x80)){
+			return true;
+		}
+	}
+	return false;
+}
+
+bool OperationLog::getSigned(vector<uint8_t> &bytes, size_t &pos, int64_t &value){
+	uint64_t zigzag;
+	if (!getVarint(bytes, pos, zigzag)){
+		return false;
+	}
+	value = (int64_t)(zigzag >> 1) ^ -(int64_t)(zigzag & 1);
+	return true;
+}
+
+
+/*
+ * Records an instruction of the run
+ *	Instructions are recorded in file order as the instruction file is
+ *	loaded, so a replay runs them in the same order.
+ *
+ * Input:
+ *		instruction - Tokens of the instruction (a copy, the caller's queue is kept)
+ *
+ * Returns:
+ *		Number of instructions recorded
+ */
+int OperationLog::recordInstruction(std::queue<string> instruction){
+	std::lock_guard<std::mutex> lock(logMutex);
+	buffer.push_back(logRecordInstruction);
+	putVarint(instruction.size());
+	while (!instruction.empty()){
+		putToken(instruction.front());
+		instruction.pop();
+	}
+	numInstructions++;
+	if (buffer.size() >= logFlushBytes){
+		// Write the buffered records out in one go
+		writeBuffer();
+	}
+	return numInstructions;
+}
+
+
+/*
+ * Records the outcome of a file operation
+ *	The inode and the blocks of the file are read back from the disk
+ *	after the operation without charging any access, so recording does
+ *	not change the access count of the next operation. The list of
+ *	blocks is reused by every record.
+ *
+ * Input:
+ *		disk - Disk the operation ran on
+ *		opClass - Class of the operation
+ *		fileName - File operated on
+ *		result - Return value of the operation
+ *		wallTime - Wall-clock latency of the operation (ns)
+ *
+ * Returns:
+ *		Number of operations recorded
+ */
+int OperationLog::recordOperation(VirtualDisk* disk, int opClass, int64_t fileName, int result, int64_t wallTime){
+	std::lock_guard<std::mutex> lock(logMutex);
+	iNode* fileINode = disk->checkINode(fileName);
+	fileBlocks.clear();
+	if (fileINode){
+		disk->listFileBlocks(fileINode, fileBlocks);
+	}
+	buffer.push_back(logRecordOperation);
+	buffer.push_back((uint8_t)opClass);
+	putSigned(fileName);
+	putSigned(result);
+	putVarint(disk->getAccessTime());
+	putVarint(max(wallTime, (int64_t)0));
+	buffer.push_back(fileINode ? 1 : 0);
+	if (fileINode){
+		// Only the fields of the allocation method are kept, the others are never set ('-1')
+		int method = disk->getAllocationMethod();
+		putSigned(method == 1 || method == 2 ? fileINode->StartBlock : -1);
+		putSigned(method == 2 ? fileINode->LastBlock : -1);
+		putSigned(method == 1 ? fileINode->Length : -1);
+		putSigned(method >= 3 ? fileINode->Index : -1);
+		// Blocks as the difference to the block before, a run of blocks takes a byte a block
+		putVarint(fileBlocks.size());
+		int previousBlock = 0;
+		for (int i=0;i<fileBlocks.size();i++){
+			putSigned(fileBlocks[i] - previousBlock);
+			previousBlock = fileBlocks[i];
+		}
+	}
+	numOperations++;
+	if (buffer.size() >= logFlushBytes){
+		// Write the buffered records out in one go
+		writeBuffer();
+	}
+	return numOperations;
+}
+
+
+/*
+ * Writes the buffered records to the log file
+ *	A log kept in memory keeps its records. The caller of writeBuffer()
+ *	holds the log mutex.
+ *
+ * Returns:
+ *		Number of bytes written
+ */
+int OperationLog::writeBuffer(){
+	if (logFileName.empty() || !logFile.is_open()){
+		return 0;
+	}
+	int numBytes = buffer.size();
+	logFile.write((const char*)buffer.data(), buffer.size());
+	bytesWritten += buffer.size();
+	buffer.clear();
+	return numBytes;
+}
+
+int OperationLog::flush(){
+	std::lock_guard<std::mutex> lock(logMutex);
+	int numBytes = writeBuffer();
+	logFile.flush();
+	return numBytes;
+}
+
+
+/*
+ * Ends the recording of a run
+ *
+ * Output:
+ *		Instructions and operations recorded and the size of the log
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if the log could not be written
+ */
+int OperationLog::finish(){
+	flush();
+	if (logFileName.empty()){
+		return 1;
+	}
+	if (!logFile){
+		cerr << "Error: Unable to write the operation log " << logFileName << "." << endl << endl;
+		return 0;
+	}
+	cout << "Recorded " << numInstructions << " instruction(s) and " << numOperations << " operation(s) to " << logFileName << " (" << bytesWritten << " bytes)." << endl << endl;
+	return 1;
+}
+
+
+/*
+ * Getter method for the state of the log file
+ *
+ * Returns:
+ *		true if the log is kept in memory or its file is open
+ */
+bool OperationLog::isOpen(){
+	return logFileName.empty() || logFile.is_open();
+}
+
+
+/*
+ * Reads the records of a log
+ *
+ * Input:
+ *		bytes - Bytes of the log
+ *
+ * Output:
+ *		method - Allocation method of the disk recorded
+ *		blockSize - Block size of the disk recorded
+ *		instructions - Instructions in file order
+ *		records - Operations in the order they ran
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if the bytes are not a whole log of this version
+ */
+int OperationLog::decode(vector<uint8_t> &bytes, int &method, int &blockSize, std::queue<queue<string> > &instructions, vector<OperationRecord> &records){
+	uint64_t value;
+	int64_t signedValue;
+	if (bytes.size() < 5 || std::memcmp(bytes.data(), operationLogMagic, 4) != 0 || bytes[4] != operationLogVersion){
+		return 0;
+	}
+	size_t pos = 5;
+	if (!getVarint(bytes, pos, value)){
+		return 0;
+	}
+	method = value;
+	if (!getVarint(bytes, pos, value)){
+		return 0;
+	}
+	blockSize = value;
+	while (pos < bytes.size()){
+		uint8_t tag = bytes[pos++];
+		if (tag == logRecordInstruction){
+			uint64_t numTokens;
+			if (!getVarint(bytes, pos, numTokens)){
+				return 0;
+			}
+			queue<string> instruction;
+			for (uint64_t i=0;i<numTokens;i++){
+				if (!getVarint(bytes, pos, value)){
+					return 0;
+				}
+				if (value & 1){
+					// Characters of the token
+					size_t length = value >> 1;
+					if (length > bytes.size() - pos){
+						return 0;
+					}
+					instruction.push(std::string(bytes.begin()+pos, bytes.begin()+pos+length));
+					pos += length;
+				} else {
+					// Number, zigzag encoded
+					uint64_t zigzag = value >> 1;
+					instruction.push(to_string((int64_t)(zigzag >> 1) ^ -(int64_t)(zigzag & 1)));
+				}
+			}
+			instructions.push(instruction);
+		} else if (tag == logRecordOperation){
+			OperationRecord record;
+			if (pos >= bytes.size()){
+				return 0;
+			}
+			record.opClass = bytes[pos++];
+			if (record.opClass >= metricNumOps || !getSigned(bytes, pos, record.fileName) || !getSigned(bytes, pos, signedValue)){
+				return 0;
+			}
+			record.result = signedValue;
+			if (!getVarint(bytes, pos, value)){
+				return 0;
+			}
+			record.accessTime = value;
+			if (!getVarint(bytes, pos, value) || pos >= bytes.size()){
+				return 0;
+			}
+			record.wallTime = value;
+			record.hasINode = bytes[pos++] == 1;
+			if (record.hasINode){
+				int64_t fields[4];
+				for (int i=0;i<4;i++){
+					if (!getSigned(bytes, pos, fields[i])){
+						return 0;
+					}
+				}
+				record.fileINode.FileIdentifier = record.fileName;
+				// Only the fields of the method are set, the fields of every method share two slots
+				record.fileINode.StartBlock = method == 1 || method == 2 ? fields[0] : fields[3];
+				record.fileINode.Length = method == 2 ? fields[1] : fields[2];
+				uint64_t numBlocks;
+				if (!getVarint(bytes, pos, numBlocks) || numBlocks > bytes.size() - pos){
+					return 0;
+				}
+				int previousBlock = 0;
+				for (uint64_t i=0;i<numBlocks;i++){
+					if (!getSigned(bytes, pos, signedValue)){
+						return 0;
+					}
+					previousBlock += signedValue;
+					record.blocks.push_back(previousBlock);
+				}
+			}
+			records.push_back(record);
+		} else {
+			// Unknown record
+			return 0;
+		}
+	}
+	return 1;
+}
+
+
+/*
+ * Compares the outcome of an operation in two runs
+ *
+ * Input:
+ *		recorded - Outcome in the log
+ *		replayed - Outcome of the replay
+ *
+ * Output:
+ *		changes - Description of every change
+ *
+ * Returns:
+ *		true if the outcomes match (wall time is not compared)
+ */
+bool OperationLog::compareRecords(OperationRecord &recorded, OperationRecord &replayed, std::string &changes){
+	// Prints the blocks of a file, the first few only
+	auto blockList = [](OperationRecord &record){
+		if (!record.hasINode){
+			return std::string("none");
+		}
+		std::string list;
+		for (int i=0;i<record.blocks.size() && i<8;i++){
+			list += (i == 0 ? "B" : " B") + to_string(record.blocks[i]);
+		}
+		if (record.blocks.size() > 8){
+			list += " ... (" + to_string(record.blocks.size()) + " blocks)";
+		}
+		return list;
+	};
+	changes.clear();
+	if (recorded.opClass != replayed.opClass || recorded.fileName != replayed.fileName){
+		// The runs went different ways, nothing else compares
+		changes = std::string("operation ") + opNames[recorded.opClass] + " of file " + to_string(recorded.fileName) + " -> " + opNames[replayed.opClass] + " of file " + to_string(replayed.fileName);
+		return false;
+	}
+	if (recorded.result != replayed.result){
+		changes += "result " + to_string(recorded.result) + " -> " + to_string(replayed.result) + "; ";
+	}
+	bool sameINode = recorded.hasINode == replayed.hasINode;
+	if (sameINode && recorded.hasINode){
+		// Start block or index block, and length or last block
+		sameINode = recorded.fileINode.StartBlock == replayed.fileINode.StartBlock && recorded.fileINode.Length == replayed.fileINode.Length;
+	}
+	if (!sameINode || recorded.blocks != replayed.blocks){
+		changes += "placement " + blockList(recorded) + " -> " + blockList(replayed);
+		if (recorded.hasINode && replayed.hasINode){
+			changes += " (inode " + to_string(recorded.fileINode.StartBlock) + "," + to_string(recorded.fileINode.Length);
+			changes += " -> " + to_string(replayed.fileINode.StartBlock) + "," + to_string(replayed.fileINode.Length) + ")";
+		}
+		changes += "; ";
+	}
+	if (recorded.accessTime != replayed.accessTime){
+		changes += "accesses " + to_string(recorded.accessTime) + " -> " + to_string(replayed.accessTime) + "; ";
+	}
+	if (!changes.empty()){
+		// Drop the last separator
+		changes.resize(changes.size()-2);
+	}
+	return changes.empty();
+}
+
+
+/*
+ * Replays a log and compares the outcomes
+ *	The instructions of the log are run again on a new disk of the
+ *	recorded allocation method and block size, with their output
+ *	discarded, while a log in memory records the new outcomes. Every
+ *	operation is then compared with the one in the log in the order
+ *	they ran, and the wall time of every class of operation is
+ *	compared on average. The recorded run discards the output of its
+ *	disk too, so neither time includes the console. Operations of the
+ *	asynchronous ring may run in a different order in each run.
+ *
+ * Input:
+ *		fileName - File of the log
+ *
+ * Output:
+ *		Operations whose result, placement or access count changed, and
+ *		the wall time of every class in both runs
+ *
+ * Returns:
+ *		'1' if every operation had the same outcome
+ *		'0' if an outcome changed or the log could not be read
+ */
+int OperationLog::replay(std::string fileName){
+	ifstream logStream(fileName, ios::binary);
+	if (!logStream.is_open()){
+		cerr << "Error opening operation log " << fileName << "." << endl;
+		return 0;
+	}
+	// Read the whole log at once
+	vector<uint8_t> bytes((std::istreambuf_iterator<char>(logStream)), std::istreambuf_iterator<char>());
+	int method;
+	int blockSize;
+	std::queue<queue<string> > instructions;
+	vector<OperationRecord> recorded;
+	if (!decode(bytes, method, blockSize, instructions, recorded) || method < 1 || method > 5 || blockSize < 2 || blockSize > MAX_ELEMENTS){
+		cerr << "Error: " << fileName << " is not an operation log of this version." << endl;
+		return 0;
+	}
+	cout << "Replaying " << instructions.size() << " instruction(s) and " << recorded.size() << " operation(s) of " << fileName;
+	cout << " on allocation method " << method << " with block size " << blockSize << "." << endl;
+	// Run the instructions again on a new disk, recording to memory
+	VirtualDisk replayDisk(method, blockSize);
+	OperationLog* replayLog = new OperationLog("", method, blockSize);
+	replayDisk.setOperationLog(replayLog);
+	replayDisk.setQuiet(true);
+	DiscardBuffer discardBuffer;
+	std::streambuf* coutBuffer = cout.rdbuf(&discardBuffer);
+	std::streambuf* cerrBuffer = cerr.rdbuf(&discardBuffer);
+	{
+		InstructionFile replayInstructions(&replayDisk, instructions);
+		replayInstructions.executeAllInstructions();
+	}
+	// Put the output streams back
+	cout.rdbuf(coutBuffer);
+	cerr.rdbuf(cerrBuffer);
+	vector<OperationRecord> replayed;
+	std::queue<queue<string> > replayedInstructions;
+	decode(replayLog->buffer, method, blockSize, replayedInstructions, replayed);
+
+	// Compare the operations in the order they ran
+	long numChanged = 0;
+	long numResults = 0;
+	long numPlacements = 0;
+	long numAccesses = 0;
+	double recordedTime[metricNumOps] = {0};
+	double replayedTime[metricNumOps] = {0};
+	long numCompared[metricNumOps] = {0};
+	std::string changes;
+	for (int i=0;i<min(recorded.size(), replayed.size());i++){
+		if (!compareRecords(recorded[i], replayed[i], changes)){
+			numChanged++;
+			numResults += recorded[i].result != replayed[i].result;
+			numPlacements += changes.find("placement") != std::string::npos;
+			numAccesses += recorded[i].accessTime != replayed[i].accessTime;
+			if (numChanged <= replayMaxReported){
+				cout << "\t> Operation " << i+1 << " (" << opNames[recorded[i].opClass] << " of file " << recorded[i].fileName << "): " << changes << endl;
+			}
+		}
+		if (recorded[i].opClass == replayed[i].opClass){
+			recordedTime[recorded[i].opClass] += recorded[i].wallTime;
+			replayedTime[recorded[i].opClass] += replayed[i].wallTime;
+			numCompared[recorded[i].opClass]++;
+		}
+	}
+	if (numChanged > replayMaxReported){
+		cout << "\t> ... and " << numChanged - replayMaxReported << " more changed operation(s)" << endl;
+	}
+	if (recorded.size() != replayed.size()){
+		cout << "\t> The log holds " << recorded.size() << " operation(s) but the replay ran " << replayed.size() << endl;
+	}
+	cout << "Replay of " << replayed.size() << " operation(s): " << numChanged << " changed (" << numResults << " result(s), ";
+	cout << numPlacements << " placement(s), " << numAccesses << " access count(s))" << endl;
+
+	// Wall time of every class in both runs
+	streamsize defaultPrecision = cout.precision();
+	cout << fixed << setprecision(2);
+	for (int op=0;op<metricNumOps;op++){
+		if (numCompared[op] == 0){
+			continue;
+		}
+		double recordedMean = recordedTime[op] / numCompared[op] / 1000;
+		double replayedMean = replayedTime[op] / numCompared[op] / 1000;
+		cout << "\t> " << opNames[op] << ": " << numCompared[op] << " operation(s), mean wall time " << recordedMean << " us recorded, " << replayedMean << " us replayed";
+		if (recordedMean > 0){
+			cout << " (" << showpos << (replayedMean - recordedMean) / recordedMean * 100 << noshowpos << "%)";
+		}
+		cout << endl;
+	}
+	cout << endl;
+	cout.unsetf(ios::floatfield);
+	cout.precision(defaultPrecision);
+	return numChanged == 0 && recorded.size() == replayed.size();
+}
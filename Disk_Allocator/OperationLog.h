@@ -0,0 +1,111 @@
+// OperationLog.h
+#ifndef OPERATIONLOG_H
+#define OPERATIONLOG_H
+#pragma once
+
+// First bytes of a log file and version of its format
+#define operationLogMagic "DAOL"
+#define operationLogVersion 1
+// Tags of the records of a log
+#define logRecordInstruction 'I'
+#define logRecordOperation 'O'
+// Bytes a log buffers before they are written to its file
+#define logFlushBytes 65536
+// Changes printed by a replay before the rest are only counted
+#define replayMaxReported 20
+
+class VirtualDisk;
+
+// Outcome of one file operation, as recorded in a log
+typedef struct OperationRecord {
+	int opClass;				// Class of the operation (metricOpAdd - metricOpDelete)
+	int64_t fileName;			// File operated on
+	int result;					// Return value of the operation ('1' success, '0' failure)
+	long accessTime;			// Accesses to memory of the operation
+	int64_t wallTime;			// Wall-clock latency of the operation (ns)
+	bool hasINode;				// Whether the file had an inode after the operation
+	iNode fileINode;			// Inode of the file after the operation
+	vector<int> blocks;			// Blocks of the file after the operation, in file order
+} OperationRecord;
+
+/*
+ * Record and replay log of the file operations
+ *	Records every instruction of a run in file order, and the outcome
+ *	of every add, append, read and delete the disk executes: its result,
+ *	access count, wall time, and the inode and blocks of the file after
+ *	it, so the placement decisions are in the log. Records are packed
+ *	as LEB128 varints (signed values zigzag encoded, blocks as the
+ *	difference to the block before), buffered in memory and written to
+ *	the log file in bulk.
+ *	A replay runs the instructions of a log again on a new disk of the
+ *	same allocation method and block size, and compares the outcome of
+ *	every operation with the one recorded, so two versions of the
+ *	program can be compared on the same input.
+ */
+class OperationLog{
+	// Private variables for OperationLog
+	std::string logFileName;		// File of the log ('' to keep the log in memory)
+	ofstream logFile;
+	vector<uint8_t> buffer;			// Records not yet written to the file
+	vector<int> fileBlocks;			// Blocks of the file of the last operation recorded
+	std::mutex logMutex;			// Guards the buffer (the asynchronous ring's workers record too)
+	long numInstructions;			// Instructions recorded
+	long numOperations;				// Operations recorded
+	long bytesWritten;				// Bytes written to the file
+	static const char* opNames[metricNumOps];
+	int putVarint(uint64_t value);
+	int putSigned(int64_t value);
+	int putToken(const std::string &token);
+	int writeBuffer();
+	static bool getVarint(vector<uint8_t> &bytes, size_t &pos, uint64_t &value);
+	static bool getSigned(vector<uint8_t> &bytes, size_t &pos, int64_t &value);
+	static int decode(vector<uint8_t> &bytes, int &method, int &blockSize, std::queue<queue<string> > &instructions, vector<OperationRecord> &records);
+	static bool compareRecords(OperationRecord &recorded, OperationRecord &replayed, std::string &changes);
+public:
+	// Constructors/Destructors
+	OperationLog(std::string fileName, int method, int blockSize);
+	~OperationLog();
+
+	// Recording methods
+	int recordInstruction(std::queue<string> instruction);
+	int recordOperation(VirtualDisk* disk, int opClass, int64_t fileName, int result, int64_t wallTime);
+	int flush();
+	int finish();
+	bool isOpen();
+	template <typename Operation>
+	static int run(VirtualDisk* disk, int opClass, int64_t fileName, Operation operation);
+
+	// Replay methods
+	static int replay(std::string fileName);
+};
+
+
+/*
+ * Runs a file operation and records its outcome
+ *	Without a log on the disk the operation is only run. A template on
+ *	the operation, so the callers' lambdas are called in place rather
+ *	than wrapped (and allocated) on every operation.
+ *
+ * Input:
+ *		disk - Disk running the operation
+ *		opClass - Class of the operation
+ *		fileName - File operated on
+ *		operation - Operation to run
+ *
+ * Returns:
+ *		Return value of the operation
+ */
+template <typename Operation>
+int OperationLog::run(VirtualDisk* disk, int opClass, int64_t fileName, Operation operation){
+	OperationLog* log = disk->getOperationLog();
+	if (!log){
+		return operation();
+	}
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	int result = operation();
+	int64_t wallTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+	log->recordOperation(disk, opClass, fileName, result, wallTime);
+	return result;
+}
+
+#endif
@@ -0,0 +1,258 @@
+#include "Header.h"				// Header file
+#include "VirtualDisk.h"
+#include "OperationMetrics.h"	// OperationMetrics file
+
+// Compiler Directive
+using namespace std;
+
+#ifdef diskMetrics
+
+// Names of the operation classes in the exports
+const char* OperationMetrics::opNames[metricNumOps] = {"add", "append", "read", "read-offset", "delete"};
+
+
+/*
+ * Contructor for LatencyHistogram
+ *	The histogram starts empty, buckets are added as values need them.
+ *
+ */
+LatencyHistogram::LatencyHistogram(){
+	totalCount = 0;
+	maxValue = 0;
+}
+
+
+/*
+ * Finds the bucket of a value
+ *
+ * Input:
+ *		value - Value to place (0 or more)
+ *
+ * Returns:
+ *		Bucket holding the value
+ */
+int LatencyHistogram::getBucket(int64_t value){
+	int subBuckets = 1 << histogramSubBucketBits;
+	if (value < subBuckets){
+		// Small values get a bucket each
+		return value;
+	}
+	// Drop the low bits below the precision kept for the value's power of 2
+	int shift = std::bit_width((uint64_t)value) - histogramSubBucketBits;
+	return subBuckets + (shift-1) * (subBuckets/2) + (int)((value >> shift) - subBuckets/2);
+}
+
+
+/*
+ * Finds the largest value of a bucket
+ *
+ * Input:
+ *		bucket - Bucket of the histogram
+ *
+ * Returns:
+ *		Largest value placed in the bucket
+ */
+int64_t LatencyHistogram::getBucketHigh(int bucket){
+	int subBuckets = 1 << histogramSubBucketBits;
+	if (bucket < subBuckets){
+		return bucket;
+	}
+	int shift = (bucket - subBuckets) / (subBuckets/2) + 1;
+	int64_t first = (int64_t)((bucket - subBuckets) % (subBuckets/2) + subBuckets/2) << shift;
+	return first + ((int64_t)1 << shift) - 1;
+}
+
+
+/*
+ * Records a value
+ *
+ * Input:
+ *		value - Value to record (negative values are recorded as 0)
+ *
+ * Returns:
+ *		Number of values recorded
+ */
+int LatencyHistogram::record(int64_t value){
+	value = max(value, (int64_t)0);
+	int bucket = getBucket(value);
+	if (bucket >= counts.size()){
+		counts.resize(bucket+1, 0);
+	}
+	counts[bucket]++;
+	maxValue = max(maxValue, value);
+	return ++totalCount;
+}
+
+
+/*
+ * Finds a percentile of the values recorded
+ *	The value is the top of the bucket holding the percentile, and
+ *	never more than the largest value recorded.
+ *
+ * Input:
+ *		percentile - Percentile to find (0 to 100)
+ *
+ * Returns:
+ *		Value at the percentile ('0' if nothing was recorded)
+ */
+int64_t LatencyHistogram::getPercentile(double percentile){
+	long target = max((long)ceil(percentile / 100 * totalCount), 1L);
+	long seen = 0;
+	for (int i=0;i<counts.size();i++){
+		seen += counts[i];
+		if (seen >= target){
+			return min(getBucketHigh(i), maxValue);
+		}
+	}
+	return maxValue;
+}
+
+
+/*
+ * Getter methods for the histogram
+ *
+ */
+long LatencyHistogram::getCount(){
+	return totalCount;
+}
+
+int64_t LatencyHistogram::getMax(){
+	return maxValue;
+}
+
+
+/*
+ * Contructor for OperationMetrics
+ *	Metrics are exported as JSON at the end of the run until another
+ *	format or interval is set.
+ *
+ */
+OperationMetrics::OperationMetrics(){
+	exportFormat = metricsJSON;
+	exportInterval = 0;
+	numRecorded = 0;
+	numExports = 0;
+}
+
+
+/*
+ * Sets the format and interval of the exports
+ *
+ * Input:
+ *		format - 1 - JSON, 2 - CSV
+ *		interval - Operations between exports ('0' for the end of the run only)
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if the format or interval is invalid
+ */
+int OperationMetrics::setExport(int format, long interval){
+	if ((format != metricsJSON && format != metricsCSV) || interval < 0){
+		cerr << "Error: Metrics format has to be 1 (JSON) or 2 (CSV) with an interval of 0 or more operations." << endl << endl;
+		return 0;
+	}
+	exportFormat = format;
+	exportInterval = interval;
+	return 1;
+}
+
+
+/*
+ * Records an operation
+ *	Exports the metrics when the interval is reached.
+ *
+ * Input:
+ *		opClass - Class of the operation
+ *		method - Allocation method of the disk (1-5)
+ *		wallTime - Wall-clock latency of the operation (ns)
+ *		accessCount - Accesses to memory of the operation
+ *		deviceTime - Simulated device time of the operation (us)
+ *
+ * Returns:
+ *		Number of operations recorded
+ */
+int OperationMetrics::record(int opClass, int method, int64_t wallTime, int accessCount, double deviceTime){
+	OperationHistograms &operation = histograms[method-1][opClass];
+	operation.wallTime.record(wallTime);
+	operation.accesses.record(accessCount);
+	operation.deviceTime.record(llround(deviceTime * 1000));
+	numRecorded++;
+	if (exportInterval > 0 && numRecorded % exportInterval == 0){
+		exportMetrics();
+	}
+	return numRecorded;
+}
+
+
+/*
+ * Prints the metrics of every operation class and allocation method
+ *	JSON exports are one object per line. CSV exports print the header
+ *	with the first export and one row per histogram.
+ *
+ * Output:
+ *		Count, p50, p90, p99 and max of the latency, accesses and device
+ *		time of every class and method with operations
+ */
+void OperationMetrics::exportMetrics(){
+	const char* metricNames[3] = {"wall_ns", "accesses", "device_ns"};
+	numExports++;
+	if (exportFormat == metricsCSV && numExports == 1){
+		cout << "export,operations,op,method,count,metric,p50,p90,p99,max" << endl;
+	}
+	if (exportFormat == metricsJSON){
+		cout << "{\"export\":" << numExports << ",\"operations\":" << numRecorded << ",\"metrics\":[";
+	}
+	bool firstEntry = true;
+	for (int method=1;method<=5;method++){
+		for (int op=0;op<metricNumOps;op++){
+			OperationHistograms &operation = histograms[method-1][op];
+			if (operation.wallTime.getCount() == 0){
+				continue;
+			}
+			LatencyHistogram* metrics[3] = {&operation.wallTime, &operation.accesses, &operation.deviceTime};
+			if (exportFormat == metricsJSON){
+				cout << (firstEntry ? "" : ",") << "{\"op\":\"" << opNames[op] << "\",\"method\":" << method << ",\"count\":" << operation.wallTime.getCount();
+			}
+			for (int i=0;i<3;i++){
+				if (exportFormat == metricsJSON){
+					cout << ",\"" << metricNames[i] << "\":{\"p50\":" << metrics[i]->getPercentile(50) << ",\"p90\":" << metrics[i]->getPercentile(90);
+					cout << ",\"p99\":" << metrics[i]->getPercentile(99) << ",\"max\":" << metrics[i]->getMax() << "}";
+				} else {
+					cout << numExports << "," << numRecorded << "," << opNames[op] << "," << method << "," << operation.wallTime.getCount() << "," << metricNames[i] << ",";
+					cout << metrics[i]->getPercentile(50) << "," << metrics[i]->getPercentile(90) << "," << metrics[i]->getPercentile(99) << "," << metrics[i]->getMax() << endl;
+				}
+			}
+			if (exportFormat == metricsJSON){
+				cout << "}";
+			}
+			firstEntry = false;
+		}
+	}
+	if (exportFormat == metricsJSON){
+		cout << "]}" << endl;
+	}
+}
+
+
+/*
+ * Contructor for MetricScope
+ *	Starts the clock of the operation.
+ *
+ * Input:
+ *		disk - Disk running the operation
+ *		operationClass - Class of the operation
+ *
+ */
+MetricScope::MetricScope(VirtualDisk* disk, int operationClass){
+	currentDisk = disk;
+	opClass = operationClass;
+	startTime = std::chrono::steady_clock::now();
+}
+
+MetricScope::~MetricScope(){
+	// Operation returned, record it with its final cost
+	int64_t wallTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+	currentDisk->getMetrics()->record(opClass, currentDisk->getAllocationMethod(), wallTime, currentDisk->getAccessTime(), currentDisk->getDeviceTime());
+}
+
+#endif
@@ -0,0 +1,108 @@
+// OperationMetrics.h
+#ifndef OPERATIONMETRICS_H
+#define OPERATIONMETRICS_H
+#pragma once
+
+// Operation classes of the metrics (also used by the operation log)
+#define metricOpAdd 0
+#define metricOpAppend 1
+#define metricOpRead 2
+#define metricOpReadOffset 3
+#define metricOpDelete 4
+#define metricNumOps 5
+
+// Operation metrics are only built with -DdiskMetrics, otherwise the
+// recording points below compile to nothing
+#ifdef diskMetrics
+
+// Export formats of the metrics
+#define metricsJSON 1
+#define metricsCSV 2
+
+// Sub-buckets of a histogram per power of 2 (2^5, values are kept to about 3%)
+#define histogramSubBucketBits 5
+
+/*
+ * Histogram of non-negative values (HDR layout)
+ *	Values below 2^subBits get a bucket each. Every power of 2 above
+ *	that is split into 2^(subBits-1) buckets of equal width, so a value
+ *	is kept to a fixed relative precision whatever its size, and the
+ *	buckets grow with the log of the largest value.
+ */
+class LatencyHistogram{
+	vector<long> counts;		// Values in every bucket
+	long totalCount;			// Values recorded
+	int64_t maxValue;			// Largest value recorded
+	static int getBucket(int64_t value);
+	static int64_t getBucketHigh(int bucket);
+public:
+	// Constructors/Destructors
+	LatencyHistogram();
+
+	// General methods
+	int record(int64_t value);
+	int64_t getPercentile(double percentile);
+
+	// Getter methods
+	long getCount();
+	int64_t getMax();
+};
+
+// Histograms of one operation class on one allocation method
+typedef struct OperationHistograms {
+	LatencyHistogram wallTime;		// Wall-clock latency (ns)
+	LatencyHistogram accesses;		// Accesses to memory
+	LatencyHistogram deviceTime;	// Simulated device time (ns)
+} OperationHistograms;
+
+/*
+ * Metrics of the file operations of a disk
+ *	Every add, append, read, offset read and delete records its wall
+ *	clock latency and simulated cost in the histograms of its class and
+ *	allocation method. The percentiles are exported as JSON (one object
+ *	per line) or CSV at the end of a run, and every N operations if an
+ *	interval is set.
+ */
+class OperationMetrics{
+	OperationHistograms histograms[5][metricNumOps];	// Histograms of every allocation method (1-5) and class
+	int exportFormat;			// Format of the exports (1 - JSON, 2 - CSV)
+	long exportInterval;		// Operations between exports ('0' for the end of the run only)
+	long numRecorded;			// Operations recorded
+	long numExports;			// Exports printed
+	static const char* opNames[metricNumOps];
+public:
+	// Constructors/Destructors
+	OperationMetrics();
+
+	// General methods
+	int setExport(int format, long interval);
+	int record(int opClass, int method, int64_t wallTime, int accessCount, double deviceTime);
+
+	// Printing methods
+	void exportMetrics();
+};
+
+/*
+ * Records one operation of a disk
+ *	Made at the start of an operation and destroyed when the operation
+ *	returns, whichever way it returns, so the latency covers the whole
+ *	operation and the access count and device time are final.
+ */
+class MetricScope{
+	VirtualDisk* currentDisk;
+	int opClass;
+	std::chrono::steady_clock::time_point startTime;
+public:
+	MetricScope(VirtualDisk* disk, int operationClass);
+	~MetricScope();
+};
+
+#define metricScope(opClass) MetricScope operationMetricScope(this, opClass)
+
+#else
+
+#define metricScope(opClass)
+
+#endif
+
+#endif
@@ -0,0 +1,224 @@
+#include "Header.h"				// Header file
+#include "ReadAhead.h"			// ReadAhead file
+
+// Compiler Directive
+using namespace std;
+
+
+/*
+ * Contructor for ReadAhead
+ *	The window starts at one block and grows while prefetches are used.
+ *	Blocks that can be fetched in any order (every method but linked,
+ *	whose blocks hold the pointer to the next one) are handed out
+ *	sorted, to let the device stream neighbouring blocks.
+ *
+ * Input:
+ *		maxBlocks - Largest window (blocks)
+ *		anyOrder - true if the blocks of a file can be fetched in any order
+ *
+ */
+ReadAhead::ReadAhead(int maxBlocks, bool anyOrder){
+	maxWindow = maxBlocks;
+	sortBatches = anyOrder;
+	window = 1;
+	streamFile = -1;
+	streamNext = 0;
+	triggerBlock = -1;
+	batchNumber = 0;
+}
+
+
+/*
+ * Decides whether a read is sequential and plans its first batch
+ *	A whole-file read always starts a stream from the first block. An
+ *	offset read starts a stream when it reads the first block of the file
+ *	or continues from the previous read of the same file. Reads of the
+ *	same block again or of a block the stream has already prefetched
+ *	are left to the trigger block, and any other read is random and not
+ *	prefetched.
+ *
+ * Input:
+ *		fileName - File being read
+ *		fileBlocks - Blocks of the file, in file order
+ *		logicalBlock - Logical block of the read (0 for a whole-file read)
+ *		wholeFile - true for a whole-file read
+ *
+ * Returns:
+ *		Blocks to prefetch (empty if none)
+ */
+vector<int> ReadAhead::planRead(int64_t fileName, vector<int> fileBlocks, int logicalBlock, bool wholeFile){
+	vector<int> batch;
+	bool sequential = wholeFile || logicalBlock == 0;
+	bool sameBlock = false;
+	if (lastLogicalBlock.count(fileName) > 0){
+		// Block after the previous read of the file
+		sequential = sequential || lastLogicalBlock[fileName] == logicalBlock-1;
+		sameBlock = lastLogicalBlock[fileName] == logicalBlock;
+	}
+	// Remember where the reader ends up
+	lastLogicalBlock[fileName] = wholeFile ? (int)fileBlocks.size()-1 : logicalBlock;
+	if (logicalBlock >= fileBlocks.size()){
+		return batch;
+	}
+	if (!wholeFile && (sameBlock || pendingBlocks.count(fileBlocks[logicalBlock]) > 0)){
+		// Block already read or prefetched by the current stream
+		return batch;
+	}
+	if (!sequential){
+		// Random read, no read-ahead
+		return batch;
+	}
+	// Start a new stream, retiring the batches of the previous one
+	while (!batches.empty()){
+		retireBatch(batches.begin()->first);
+	}
+	streamFile = fileName;
+	streamBlocks = fileBlocks;
+	streamNext = logicalBlock;
+	return nextBatch();
+}
+
+
+/*
+ * Takes the next window of the current stream
+ *	The batch before the latest one is retired first, since the reader
+ *	has moved past it by the time the next batch is requested.
+ *
+ * Returns:
+ *		Blocks to prefetch (empty at the end of the stream)
+ */
+vector<int> ReadAhead::nextBatch(){
+	vector<int> batch;
+	if (batches.size() > 1){
+		retireBatch(batches.begin()->first);
+	}
+	if (streamFile == -1 || streamNext >= streamBlocks.size()){
+		triggerBlock = -1;
+		return batch;
+	}
+	batchNumber++;
+	for (int i=0;i<window && streamNext < streamBlocks.size();i++){
+		batch.push_back(streamBlocks[streamNext]);
+		pendingBlocks[streamBlocks[streamNext]] = batchNumber;
+		streamNext++;
+	}
+	batches[batchNumber] = pair<int, int>(batch.size(), 0);
+	// Request the next batch once the reader is half way through this one
+	triggerBlock = batch[batch.size()/2];
+	if (sortBatches){
+		sort(batch.begin(), batch.end());
+	}
+	return batch;
+}
+
+
+/*
+ * Retires a batch and adapts the window
+ *	Blocks of the batch that were never read are wasted prefetches.
+ *
+ * Input:
+ *		batch - Number of the batch to retire
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int ReadAhead::retireBatch(int batch){
+	double usedRatio = batches[batch].second * 1.00 / max(batches[batch].first, 1);
+	if (usedRatio >= 0.75){
+		// Most of the batch was read, double the window
+		window = min(window*2, maxWindow);
+	} else if (usedRatio < 0.25){
+		// Most of the batch was wasted, halve the window
+		window = max(window/2, 1);
+	}
+	for (map<int, int>::iterator it = pendingBlocks.begin(); it != pendingBlocks.end();){
+		if (it->second == batch){
+			it = pendingBlocks.erase(it);
+		} else {
+			it++;
+		}
+	}
+	batches.erase(batch);
+	return 1;
+}
+
+
+/*
+ * Records a block read
+ *	A prefetched block that is no longer in the cache was evicted
+ *	before it was read and counts as wasted.
+ *
+ * Input:
+ *		block - Block read
+ *		cached - true if the read was served by the cache
+ *
+ * Returns:
+ *		true if the block is the trigger and the next batch should be prefetched
+ */
+bool ReadAhead::noteRead(int block, bool cached){
+	if (pendingBlocks.count(block) > 0){
+		if (cached){
+			// A prefetched block has been used
+			batches[pendingBlocks[block]].second++;
+		}
+		pendingBlocks.erase(block);
+	}
+	if (block == triggerBlock){
+		triggerBlock = -1;
+		return true;
+	}
+	return false;
+}
+
+
+/*
+ * Forgets a prefetched block that left the cache
+ *
+ * Input:
+ *		block - Block evicted or freed
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int ReadAhead::forgetBlock(int block){
+	pendingBlocks.erase(block);
+	if (block == triggerBlock){
+		triggerBlock = -1;
+	}
+	return 1;
+}
+
+
+/*
+ * Forgets the read position of a deleted file
+ *
+ * Input:
+ *		fileName - File deleted
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int ReadAhead::forgetFile(int64_t fileName){
+	lastLogicalBlock.erase(fileName);
+	if (streamFile == fileName){
+		// End the stream without judging its batches
+		streamFile = -1;
+		triggerBlock = -1;
+		pendingBlocks.clear();
+		batches.clear();
+	}
+	return 1;
+}
+
+
+/*
+ * Getter methods for the window sizes
+ *
+ */
+int ReadAhead::getWindow(){
+	return window;
+}
+
+int ReadAhead::getMaxWindow(){
+	return maxWindow;
+}
@@ -0,0 +1,43 @@
+// ReadAhead.h
+#ifndef READAHEAD_H
+#define READAHEAD_H
+#pragma once
+
+/*
+ * Adaptive sequential read-ahead
+ *	Remembers the last logical block read of every file. A whole-file
+ *	read, or an offset read that continues from the previous read of
+ *	the same file, starts a sequential stream. Blocks of the stream are
+ *	prefetched in batches of the current window, and the next batch is
+ *	requested once the reader reaches the middle of the latest batch.
+ *	When a batch is retired the window doubles if most of its blocks
+ *	were read and halves if most of them were wasted.
+ */
+class ReadAhead{
+	int maxWindow;							// Largest window (blocks)
+	int window;								// Current window (blocks)
+	std::map<int64_t, int> lastLogicalBlock;	// Last logical block read of each file
+	vector<int> streamBlocks;				// Blocks of the file being streamed, in file order
+	int64_t streamFile;						// File being streamed (-1 if none)
+	int streamNext;							// Next logical block of the stream to prefetch
+	int triggerBlock;						// Block that requests the next batch when read
+	std::map<int, int> pendingBlocks;		// Prefetched blocks not read yet (block -> batch)
+	std::map<int, pair<int, int> > batches;	// Outstanding batches (batch -> blocks prefetched, blocks read)
+	int batchNumber;						// Number of the latest batch
+	bool sortBatches;						// Whether the blocks of a batch can be fetched in any order
+	int retireBatch(int batch);
+public:
+	// Constructors/Destructors
+	ReadAhead(int maxBlocks, bool anyOrder);
+
+	// General methods
+	vector<int> planRead(int64_t fileName, vector<int> fileBlocks, int logicalBlock, bool wholeFile);
+	vector<int> nextBatch();
+	bool noteRead(int block, bool cached);
+	int forgetBlock(int block);
+	int forgetFile(int64_t fileName);
+	int getWindow();
+	int getMaxWindow();
+};
+
+#endif
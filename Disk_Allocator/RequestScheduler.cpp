@@ -0,0 +1,339 @@
+#include "Header.h"				// Header file
+#include "VirtualDisk.h"		// VirtualDisk file
+#include "DeviceModel.h"		// DeviceModel file
+#include "RequestScheduler.h"	// RequestScheduler file
+
+// Compiler Directive
+using namespace std;
+
+
+/*
+ * Contructor for RequestScheduler
+ *	Scheduling is disabled until a policy is set.
+ *
+ */
+RequestScheduler::RequestScheduler(VirtualDisk* disk){
+	currentDisk = disk;
+	policy = 0;
+	interarrivalTime = 0;
+	clock = 0;
+	numSubmitted = 0;
+	sweepUp = true;
+	headMovement = 0;
+	busyTime = 0;
+}
+
+
+/*
+ * Sets the scheduling policy
+ *	The clock and statistics restart, so the policy's results only
+ *	cover the requests submitted after it was set.
+ *
+ * Input:
+ *		policyType - 1 FCFS, 2 SSTF, 3 SCAN, 4 C-SCAN, 5 LOOK, 6 C-LOOK
+ *		interarrival - Time between request arrivals (us), '0' for all at once
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if the policy is unrecognised
+ */
+int RequestScheduler::setPolicy(int policyType, int interarrival){
+	if (policyType < scheduleFCFS || policyType > scheduleCLOOK || interarrival < 0){
+		cerr << "Error: Unrecognised scheduling policy " << policyType << "." << endl << endl;
+		return 0;
+	}
+	policy = policyType;
+	interarrivalTime = interarrival;
+	clock = 0;
+	numSubmitted = 0;
+	sweepUp = true;
+	latencies.clear();
+	headMovement = 0;
+	busyTime = 0;
+	return 1;
+}
+
+
+/*
+ * Checks whether requests are being scheduled
+ *
+ * Returns:
+ *		true if a policy is set
+ */
+bool RequestScheduler::isEnabled(){
+	return policy != 0;
+}
+
+
+/*
+ * Getter method for the name of the policy
+ *
+ * Returns:
+ *		Name of the scheduling policy
+ */
+std::string RequestScheduler::getName(){
+	switch (policy){
+		case (scheduleFCFS): return "FCFS";
+		case (scheduleSSTF): return "SSTF";
+		case (scheduleSCAN): return "SCAN";
+		case (scheduleCSCAN): return "C-SCAN";
+		case (scheduleLOOK): return "LOOK";
+		case (scheduleCLOOK): return "C-LOOK";
+	}
+	return "None";
+}
+
+
+/*
+ * Getter method for the arrival time of the next request submitted
+ *
+ * Returns:
+ *		Simulated arrival time (us)
+ */
+double RequestScheduler::getNextArrival(){
+	return numSubmitted * interarrivalTime;
+}
+
+
+/*
+ * Adds a request to the request queue
+ *	The argument tokens move into the request, so the caller's queue
+ *	is left empty.
+ *
+ * Input:
+ *		command - Instruction token of the request
+ *		arguments - File name and the rest of the instruction
+ *		fileName - File targeted by the request (the main file of an offset read)
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int RequestScheduler::submit(const std::string &command, std::queue<string> &arguments, int64_t fileName){
+	pendingRequests.emplace_back();
+	ScheduledRequest &newRequest = pendingRequests.back();
+	newRequest.command = command;
+	newRequest.arguments.swap(arguments);
+	newRequest.fileName = fileName;
+	newRequest.sequence = numSubmitted;
+	newRequest.arrivalTime = getNextArrival();
+	numSubmitted++;
+	return 1;
+}
+
+
+/*
+ * Checks whether the disk can start a request before a given time
+ *
+ * Input:
+ *		time - Simulated time (us)
+ *
+ * Returns:
+ *		true if a request is waiting and the disk is free before the time
+ */
+bool RequestScheduler::isReady(double time){
+	return !pendingRequests.empty() && clock < time;
+}
+
+
+/*
+ * Checks whether any request is waiting
+ *
+ * Returns:
+ *		true if the request queue is not empty
+ */
+bool RequestScheduler::hasPending(){
+	return !pendingRequests.empty();
+}
+
+
+/*
+ * Checks whether a waiting request may be served now
+ *	A request has to have arrived, and no earlier request for the same
+ *	file may still be waiting.
+ *
+ * Input:
+ *		request - Position of the request in the queue
+ *
+ * Returns:
+ *		true if the request can be picked
+ */
+bool RequestScheduler::isEligible(int request){
+	if (pendingRequests[request].arrivalTime > clock){
+		return false;
+	}
+	for (int i=0;i<request;i++){
+		if (pendingRequests[i].fileName == pendingRequests[request].fileName){
+			return false;
+		}
+	}
+	return true;
+}
+
+
+/*
+ * Moves the head to a block without transferring data
+ *	Used when a SCAN or C-SCAN sweep runs on to the edge of the disk.
+ *
+ * Input:
+ *		block - Block to move the head to
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int RequestScheduler::sweepTo(int block){
+	DeviceModel* device = currentDisk->getDeviceModel();
+	if (device->getHeadBlock() != block){
+		device->seek(block);
+	}
+	return 1;
+}
+
+
+/*
+ * Picks the next request according to the policy
+ *
+ * Returns:
+ *		Position of the request in the queue
+ */
+int RequestScheduler::pickRequest(){
+	int head = currentDisk->getDeviceModel()->getHeadBlock();
+	int lastBlock = currentDisk->getVCB()->totalBlockNum-1;
+	// The lists are kept between picks, so picking does not allocate
+	eligible.clear();
+	targets.clear();
+	for (int i=0;i<pendingRequests.size();i++){
+		if (isEligible(i)){
+			eligible.push_back(i);
+			targets.push_back(currentDisk->getTargetBlock(pendingRequests[i].fileName));
+		}
+	}
+	if (policy == scheduleFCFS){
+		// Earliest request
+		return eligible[0];
+	}
+	// Nearest request above (or at) and below the head, and the lowest request
+	int best = 0, above = -1, below = -1, lowest = 0;
+	for (int i=0;i<eligible.size();i++){
+		if (abs(targets[i] - head) < abs(targets[best] - head)){
+			best = i;
+		}
+		if (targets[i] >= head && (above == -1 || targets[i] < targets[above])){
+			above = i;
+		}
+		if (targets[i] <= head && (below == -1 || targets[i] > targets[below])){
+			below = i;
+		}
+		if (targets[i] < targets[lowest]){
+			lowest = i;
+		}
+	}
+	switch (policy){
+		case (scheduleSSTF): {
+			// Shortest seek first
+			return eligible[best];
+		}
+		case (scheduleSCAN):
+		case (scheduleLOOK): {
+			// Keep sweeping in one direction and turn around when no request is left ahead
+			if (sweepUp && above == -1){
+				if (policy == scheduleSCAN){
+					sweepTo(lastBlock);
+				}
+				sweepUp = false;
+			} else if (!sweepUp && below == -1){
+				if (policy == scheduleSCAN){
+					sweepTo(0);
+				}
+				sweepUp = true;
+			}
+			return eligible[sweepUp ? above : below];
+		}
+		case (scheduleCSCAN):
+		case (scheduleCLOOK): {
+			// Sweep upwards only and return to the start when no request is left ahead
+			if (above != -1){
+				return eligible[above];
+			}
+			if (policy == scheduleCSCAN){
+				sweepTo(lastBlock);
+				sweepTo(0);
+			}
+			return eligible[lowest];
+		}
+	}
+	return eligible[0];
+}
+
+
+/*
+ * Takes the next request to serve
+ *	If no request has arrived yet, the disk idles until the next
+ *	arrival.
+ *
+ * Returns:
+ *		Request to serve (valid until the next request is taken)
+ */
+ScheduledRequest &RequestScheduler::nextRequest(){
+	DeviceModel* device = currentDisk->getDeviceModel();
+	double firstArrival = pendingRequests[0].arrivalTime;
+	for (int i=1;i<pendingRequests.size();i++){
+		firstArrival = min(firstArrival, pendingRequests[i].arrivalTime);
+	}
+	// Idle until a request arrives
+	clock = max(clock, firstArrival);
+	startHeadMovement = device->getHeadMovement();
+	startBusyTime = device->getBusyTime();
+	int request = pickRequest();
+	currentRequest = std::move(pendingRequests[request]);
+	pendingRequests.erase(pendingRequests.begin() + request);
+	return currentRequest;
+}
+
+
+/*
+ * Completes the request being served
+ *	The request keeps the disk busy for the device time it used.
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int RequestScheduler::completeRequest(){
+	DeviceModel* device = currentDisk->getDeviceModel();
+	double serviceTime = device->getBusyTime() - startBusyTime;
+	clock += serviceTime;
+	busyTime += serviceTime;
+	headMovement += device->getHeadMovement() - startHeadMovement;
+	latencies.push_back(clock - currentRequest.arrivalTime);
+	return 1;
+}
+
+
+/*
+ * Prints the statistics of the scheduled requests
+ *
+ * Output:
+ *		Requests completed, throughput, mean and p99 latency, head movement
+ */
+void RequestScheduler::printStats(){
+	if (latencies.empty()){
+		return;
+	}
+	streamsize defaultPrecision = cout.precision();
+	vector<double> sortedLatencies = latencies;
+	sort(sortedLatencies.begin(), sortedLatencies.end());
+	double totalLatency = 0;
+	for (int i=0;i<sortedLatencies.size();i++){
+		totalLatency += sortedLatencies[i];
+	}
+	int p99 = max((int)ceil(sortedLatencies.size() * 0.99) - 1, 0);
+	cout << "Request scheduler (" << getName() << ", requests every " << fixed << setprecision(1) << interarrivalTime << " us)" << endl;
+	cout << "\t> Requests completed: " << latencies.size() << endl;
+	cout << "\t> Throughput: " << latencies.size() / max(clock, 1.00) * 1000000 << " requests/s" << endl;
+	cout << "\t> Mean latency: " << totalLatency / latencies.size() << " us" << endl;
+	cout << "\t> P99 latency: " << sortedLatencies[p99] << " us" << endl;
+	cout << "\t> Device busy time: " << busyTime << " us" << endl;
+	cout << "\t> Head movement: " << headMovement << " block(s)" << endl;
+	cout << endl;
+	cout.unsetf(ios::floatfield);
+	cout.precision(defaultPrecision);
+}
@@ -0,0 +1,73 @@
+// RequestScheduler.h
+#ifndef REQUESTSCHEDULER_H
+#define REQUESTSCHEDULER_H
+#pragma once
+
+// Disk scheduling policies
+#define scheduleFCFS 1
+#define scheduleSSTF 2
+#define scheduleSCAN 3
+#define scheduleCSCAN 4
+#define scheduleLOOK 5
+#define scheduleCLOOK 6
+
+// File instruction waiting in the request queue
+typedef struct ScheduledRequest {
+	std::string command;				// Instruction token (add, append, read or delete)
+	std::queue<string> arguments;		// File name and the rest of the instruction
+	int64_t fileName;					// File targeted (without the offset)
+	int sequence;					// Position of the request in the trace
+	double arrivalTime;				// Simulated arrival time (us)
+} ScheduledRequest;
+
+/*
+ * Disk request scheduler
+ *	File instructions (add, append, read, delete) get arrival times a
+ *	fixed interval apart and wait in a request queue. Whenever the disk
+ *	is idle the policy picks the next request from those that have
+ *	arrived, by the block the request starts at (the first block or
+ *	index block of the file, or the block a new file would be added
+ *	at). Requests for the same file are always served in trace order.
+ *	A request's service time is the device time it keeps the disk
+ *	busy, and its latency runs from its arrival to its completion.
+ */
+class RequestScheduler{
+	// Private variables for RequestScheduler
+	VirtualDisk* currentDisk;
+	int policy;								// Scheduling policy ('0' if disabled)
+	double interarrivalTime;				// Time between request arrivals (us)
+	double clock;							// Simulated time (us)
+	int numSubmitted;						// Requests submitted since the policy was set
+	bool sweepUp;							// Direction of the SCAN/LOOK sweep
+	vector<ScheduledRequest> pendingRequests;	// Requests waiting, in trace order
+	ScheduledRequest currentRequest;		// Request being served
+	vector<int> eligible;					// Requests the last pick chose from
+	vector<int> targets;					// Target blocks of the eligible requests
+	long startHeadMovement;					// Device head movement before the current request
+	double startBusyTime;					// Device busy time before the current request
+	vector<double> latencies;				// Latency of every completed request (us)
+	long headMovement;						// Blocks travelled by the head for the requests
+	double busyTime;						// Device time spent on the requests (us)
+	bool isEligible(int request);
+	int pickRequest();
+	int sweepTo(int block);
+public:
+	// Function declarations/prototypes
+	RequestScheduler(VirtualDisk* disk);
+	int setPolicy(int policyType, int interarrival);
+	bool isEnabled();
+	std::string getName();
+
+	// Request queue methods
+	double getNextArrival();
+	int submit(const std::string &command, std::queue<string> &arguments, int64_t fileName);
+	bool isReady(double time);
+	bool hasPending();
+	ScheduledRequest &nextRequest();
+	int completeRequest();
+
+	// Printing methods
+	void printStats();
+};
+
+#endif
@@ -0,0 +1,640 @@
+#include "Header.h"				// Header file
+#include "DataKernels.h"		// DataKernels file
+#include "RoaringBitmap.h"		// RoaringBitmap file
+
+// Compiler Directive
+using namespace std;
+
+
+/*
+ * Sets or clears a range of bits in the words of a bitmap container
+ *
+ * Input:
+ *		words - Words of the bitmap
+ *		low - First bit
+ *		high - Last bit
+ *		value - true to set the bits, false to clear them
+ *
+ */
+static void setWordRange(vector<uint64_t> &words, int low, int high, bool value){
+	for (int word=low >> 6;word<=high >> 6;word++){
+		// Bits of the range that fall in this word
+		int firstBit = (word == low >> 6) ? low & 63 : 0;
+		int lastBit = (word == high >> 6) ? high & 63 : 63;
+		uint64_t mask = (~0ULL >> (63-lastBit)) & (~0ULL << firstBit);
+		if (value){
+			words[word] |= mask;
+		} else {
+			words[word] &= ~mask;
+		}
+	}
+}
+
+
+/*
+ * Adds a run of set blocks to the run being followed
+ *	The run continues the followed run if it starts right after it.
+ *
+ * Returns:
+ *		true if the followed run is now long enough
+ */
+static bool followRun(int start, int end, int runLength, int &pendingStart, int &pendingEnd){
+	if (start != pendingEnd+1){
+		// A used block lies between them, start a new run
+		pendingStart = start;
+	}
+	pendingEnd = end;
+	return pendingEnd-pendingStart+1 >= runLength;
+}
+
+
+/*
+ * Contructor for RoaringBitmap
+ *	The bitmap starts with no set blocks.
+ *
+ */
+RoaringBitmap::RoaringBitmap(){
+	cardinality = 0;
+	chunkWords.assign(roaringBitmapWords, 0);
+}
+
+
+/*
+ * Builds the bitmap from a dense bit map
+ *
+ * Input:
+ *		bitMap - Dense bit map (1 - set, 0 - not set)
+ *
+ * Returns:
+ *		Number of set blocks
+ */
+int RoaringBitmap::build(vector<int> &bitMap){
+	chunkKeys.clear();
+	containers.clear();
+	cardinality = 0;
+	for (int base=0;base<bitMap.size();base+=roaringChunkBlocks){
+		int chunkBlocks = min((int)bitMap.size()-base, roaringChunkBlocks);
+		std::fill(chunkWords.begin(), chunkWords.end(), 0);
+		for (int i=0;i<chunkBlocks;i++){
+			chunkWords[i >> 6] |= (uint64_t)(bitMap[base+i] == 1) << (i & 63);
+		}
+		RoaringContainer container;
+		fromWords(container, chunkWords);
+		if (container.cardinality > 0){
+			chunkKeys.push_back(base / roaringChunkBlocks);
+			cardinality += container.cardinality;
+			containers.push_back(std::move(container));
+		}
+	}
+	return cardinality;
+}
+
+
+/*
+ * Sets or clears a run of blocks
+ *	A chunk covered whole becomes one run (or is dropped), any other
+ *	chunk is rebuilt through a bitmap.
+ *
+ * Input:
+ *		startBlock - First block of the run
+ *		numBlocks - Number of blocks in the run
+ *		value - true to set the blocks, false to clear them
+ *
+ * Returns:
+ *		Number of set blocks
+ */
+int RoaringBitmap::setRange(int startBlock, int numBlocks, bool value){
+	int block = startBlock;
+	int endBlock = startBlock+numBlocks-1;
+	while (block <= endBlock){
+		int key = block / roaringChunkBlocks;
+		int base = key*roaringChunkBlocks;
+		int chunkEnd = min(endBlock, base+roaringChunkBlocks-1);
+		int position = lower_bound(chunkKeys.begin(), chunkKeys.end(), key) - chunkKeys.begin();
+		bool found = position < chunkKeys.size() && chunkKeys[position] == key;
+		if (!found && !value){
+			// Nothing set in the chunk
+			block = chunkEnd+1;
+			continue;
+		}
+		if (!found){
+			chunkKeys.insert(chunkKeys.begin()+position, key);
+			containers.insert(containers.begin()+position, RoaringContainer{containerArray, 0});
+		}
+		RoaringContainer &container = containers[position];
+		cardinality -= container.cardinality;
+		if (block == base && chunkEnd == base+roaringChunkBlocks-1){
+			// Whole chunk
+			container.values.clear();
+			container.words.clear();
+			container.runs.assign(1, pair<uint16_t, uint16_t>(0, roaringChunkBlocks-1));
+			container.type = containerRun;
+			container.cardinality = value ? roaringChunkBlocks : 0;
+		} else {
+			toWords(container, chunkWords);
+			setWordRange(chunkWords, block-base, chunkEnd-base, value);
+			fromWords(container, chunkWords);
+		}
+		cardinality += container.cardinality;
+		if (container.cardinality == 0){
+			// Drop the empty chunk
+			chunkKeys.erase(chunkKeys.begin()+position);
+			containers.erase(containers.begin()+position);
+		}
+		block = chunkEnd+1;
+	}
+	return cardinality;
+}
+
+
+/*
+ * Finds the chunk of a key
+ *
+ * Returns:
+ *		Position of the chunk
+ *		'-1' if the chunk has no set blocks
+ */
+int RoaringBitmap::findChunk(int key){
+	int position = lower_bound(chunkKeys.begin(), chunkKeys.end(), key) - chunkKeys.begin();
+	if (position < chunkKeys.size() && chunkKeys[position] == key){
+		return position;
+	}
+	return -1;
+}
+
+
+/*
+ * Expands a container into the words of a bitmap
+ *
+ * Output:
+ *		words - One bit per block of the chunk
+ *
+ * Returns:
+ *		Number of set blocks
+ */
+int RoaringBitmap::toWords(RoaringContainer &container, vector<uint64_t> &words){
+	switch (container.type){
+		case (containerArray): {
+			std::fill(words.begin(), words.end(), 0);
+			for (int i=0;i<container.values.size();i++){
+				words[container.values[i] >> 6] |= 1ULL << (container.values[i] & 63);
+			}
+			break;
+		}
+		case (containerBitmap): {
+			std::copy(container.words.begin(), container.words.end(), words.begin());
+			break;
+		}
+		case (containerRun): {
+			std::fill(words.begin(), words.end(), 0);
+			for (int i=0;i<container.runs.size();i++){
+				setWordRange(words, container.runs[i].first, container.runs[i].first+container.runs[i].second, true);
+			}
+			break;
+		}
+	}
+	return container.cardinality;
+}
+
+
+/*
+ * Stores the words of a bitmap in the smallest container
+ *	An array takes 2 bytes per set block, a bitmap 8 KB, and a run
+ *	list 4 bytes per run.
+ *
+ * Input:
+ *		words - One bit per block of the chunk
+ *
+ * Returns:
+ *		Container type chosen
+ */
+int RoaringBitmap::fromWords(RoaringContainer &container, vector<uint64_t> &words){
+	int numSet = 0;
+	int numRuns = 0;
+	uint64_t carry = 0;
+	for (int i=0;i<roaringBitmapWords;i++){
+		numSet += std::popcount(words[i]);
+		// Set bits whose previous bit is not set start a run
+		numRuns += std::popcount(words[i] & ~((words[i] << 1) | carry));
+		carry = words[i] >> 63;
+	}
+	int arrayBytes = numSet <= roaringArrayLimit ? numSet*2 : INT_MAX;
+	int bitmapBytes = roaringBitmapWords*8;
+	int runBytes = numRuns*4;
+	vector<uint16_t>().swap(container.values);
+	vector<uint64_t>().swap(container.words);
+	vector<pair<uint16_t, uint16_t> >().swap(container.runs);
+	container.cardinality = numSet;
+	if (runBytes <= arrayBytes && runBytes <= bitmapBytes){
+		container.type = containerRun;
+		container.runs.reserve(numRuns);
+		int position = 0;
+		while (position < roaringChunkBlocks){
+			uint64_t remaining = words[position >> 6] >> (position & 63);
+			if (remaining == 0){
+				// Nothing set in the rest of the word
+				position = ((position >> 6)+1) << 6;
+				continue;
+			}
+			position += std::countr_zero(remaining);
+			int runStart = position;
+			while (position < roaringChunkBlocks){
+				int numOnes = std::countr_one(words[position >> 6] >> (position & 63));
+				position += numOnes;
+				if (numOnes == 0 || (position & 63) != 0){
+					// The run ends inside the word
+					break;
+				}
+			}
+			container.runs.push_back(pair<uint16_t, uint16_t>(runStart, position-1-runStart));
+		}
+	} else if (arrayBytes <= bitmapBytes){
+		container.type = containerArray;
+		container.values.reserve(numSet);
+		for (int i=0;i<roaringBitmapWords;i++){
+			uint64_t word = words[i];
+			while (word){
+				container.values.push_back((i << 6) + std::countr_zero(word));
+				// Clear the lowest set bit
+				word &= word-1;
+			}
+		}
+	} else {
+		container.type = containerBitmap;
+		container.words = words;
+	}
+	return container.type;
+}
+
+
+/*
+ * Counts the set blocks of a container before a position
+ *
+ */
+int RoaringBitmap::containerRank(RoaringContainer &container, int low){
+	int numBefore = 0;
+	switch (container.type){
+		case (containerArray): {
+			numBefore = lower_bound(container.values.begin(), container.values.end(), low) - container.values.begin();
+			break;
+		}
+		case (containerBitmap): {
+			for (int i=0;i<(low >> 6);i++){
+				numBefore += std::popcount(container.words[i]);
+			}
+			if (low & 63){
+				numBefore += std::popcount(container.words[low >> 6] & (~0ULL >> (64-(low & 63))));
+			}
+			break;
+		}
+		case (containerRun): {
+			for (int i=0;i<container.runs.size() && container.runs[i].first < low;i++){
+				numBefore += min(container.runs[i].first+container.runs[i].second, low-1) - container.runs[i].first + 1;
+			}
+			break;
+		}
+	}
+	return numBefore;
+}
+
+
+/*
+ * Finds the k-th set block of a container (k from 0)
+ *
+ */
+int RoaringBitmap::containerSelect(RoaringContainer &container, int k){
+	switch (container.type){
+		case (containerArray): {
+			return container.values[k];
+		}
+		case (containerBitmap): {
+			for (int i=0;i<roaringBitmapWords;i++){
+				int numSet = std::popcount(container.words[i]);
+				if (k < numSet){
+					uint64_t word = container.words[i];
+					for (int j=0;j<k;j++){
+						// Clear the lowest set bit
+						word &= word-1;
+					}
+					return (i << 6) + std::countr_zero(word);
+				}
+				k -= numSet;
+			}
+			break;
+		}
+		case (containerRun): {
+			for (int i=0;i<container.runs.size();i++){
+				if (k <= container.runs[i].second){
+					return container.runs[i].first + k;
+				}
+				k -= container.runs[i].second+1;
+			}
+			break;
+		}
+	}
+	return -1;
+}
+
+
+/*
+ * Follows the runs of set blocks of a container
+ *	Runs before fromLow are skipped, and a run that started in the
+ *	previous chunk is continued.
+ *
+ * Input:
+ *		container - Container of the chunk
+ *		base - First block of the chunk
+ *		fromLow - First position in the chunk to look at
+ *		runLength - Number of set blocks needed in a row
+ *		pendingStart, pendingEnd - Run being followed
+ *
+ * Returns:
+ *		First block of a long enough run
+ *		'-1' if the chunk does not finish one
+ */
+int RoaringBitmap::scanRuns(RoaringContainer &container, int base, int fromLow, int runLength, int &pendingStart, int &pendingEnd){
+	switch (container.type){
+		case (containerArray): {
+			int i = lower_bound(container.values.begin(), container.values.end(), fromLow) - container.values.begin();
+			while (i < container.values.size()){
+				// Group the consecutive values into one run
+				int runStart = container.values[i];
+				while (i+1 < container.values.size() && container.values[i+1] == container.values[i]+1){
+					i++;
+				}
+				if (followRun(base+runStart, base+container.values[i], runLength, pendingStart, pendingEnd)){
+					return pendingStart;
+				}
+				i++;
+			}
+			break;
+		}
+		case (containerBitmap): {
+			int position = fromLow;
+			while (position < roaringChunkBlocks){
+				uint64_t remaining = container.words[position >> 6] >> (position & 63);
+				if (remaining == 0){
+					position = ((position >> 6)+1) << 6;
+					continue;
+				}
+				position += std::countr_zero(remaining);
+				int runStart = position;
+				while (position < roaringChunkBlocks){
+					int numOnes = std::countr_one(container.words[position >> 6] >> (position & 63));
+					position += numOnes;
+					if (numOnes == 0 || (position & 63) != 0){
+						break;
+					}
+				}
+				if (followRun(base+runStart, base+position-1, runLength, pendingStart, pendingEnd)){
+					return pendingStart;
+				}
+			}
+			break;
+		}
+		case (containerRun): {
+			for (int i=0;i<container.runs.size();i++){
+				int runEnd = container.runs[i].first+container.runs[i].second;
+				if (runEnd < fromLow){
+					continue;
+				}
+				if (followRun(base+max((int)container.runs[i].first, fromLow), base+runEnd, runLength, pendingStart, pendingEnd)){
+					return pendingStart;
+				}
+			}
+			break;
+		}
+	}
+	return -1;
+}
+
+
+/*
+ * Checks if a block is set
+ *
+ */
+bool RoaringBitmap::contains(int block){
+	int position = findChunk(block / roaringChunkBlocks);
+	if (position == -1){
+		return false;
+	}
+	int low = block % roaringChunkBlocks;
+	RoaringContainer &container = containers[position];
+	switch (container.type){
+		case (containerArray): {
+			return binary_search(container.values.begin(), container.values.end(), low);
+		}
+		case (containerBitmap): {
+			return (container.words[low >> 6] >> (low & 63)) & 1;
+		}
+		case (containerRun): {
+			// Last run starting at or before the block
+			vector<pair<uint16_t, uint16_t> >::iterator it = upper_bound(container.runs.begin(), container.runs.end(), pair<uint16_t, uint16_t>(low, UINT16_MAX));
+			return it != container.runs.begin() && low <= (it-1)->first + (it-1)->second;
+		}
+	}
+	return false;
+}
+
+
+/*
+ * Counts the set blocks before a block
+ *
+ * Input:
+ *		block - Block to count up to (not included)
+ *
+ * Returns:
+ *		Number of set blocks before the block
+ */
+long RoaringBitmap::rank(int block){
+	int key = block / roaringChunkBlocks;
+	long numBefore = 0;
+	for (int i=0;i<chunkKeys.size() && chunkKeys[i] <= key;i++){
+		if (chunkKeys[i] < key){
+			numBefore += containers[i].cardinality;
+		} else {
+			numBefore += containerRank(containers[i], block % roaringChunkBlocks);
+		}
+	}
+	return numBefore;
+}
+
+
+/*
+ * Finds the k-th set block
+ *
+ * Input:
+ *		k - Number of set blocks before the one wanted (from 0)
+ *
+ * Returns:
+ *		Block number
+ *		'-1' if fewer blocks are set
+ */
+int RoaringBitmap::select(long k){
+	if (k < 0){
+		return -1;
+	}
+	for (int i=0;i<chunkKeys.size();i++){
+		if (k < containers[i].cardinality){
+			return chunkKeys[i]*roaringChunkBlocks + containerSelect(containers[i], k);
+		}
+		k -= containers[i].cardinality;
+	}
+	return -1;
+}
+
+
+/*
+ * Finds the first run of set blocks of a length
+ *	A run may cross from one chunk into the next. Chunks without set
+ *	blocks are skipped at once.
+ *
+ * Input:
+ *		runLength - Number of set blocks needed in a row
+ *		fromBlock - First block the run may start at
+ *
+ * Returns:
+ *		First block of the run
+ *		'-1' if there is no such run
+ */
+int RoaringBitmap::findRun(int runLength, int fromBlock){
+	int firstKey = fromBlock / roaringChunkBlocks;
+	int pendingStart = -1;
+	int pendingEnd = -2;
+	int position = lower_bound(chunkKeys.begin(), chunkKeys.end(), firstKey) - chunkKeys.begin();
+	for (;position<chunkKeys.size();position++){
+		int base = chunkKeys[position]*roaringChunkBlocks;
+		int fromLow = chunkKeys[position] == firstKey ? fromBlock-base : 0;
+		int runStart = scanRuns(containers[position], base, fromLow, max(runLength, 1), pendingStart, pendingEnd);
+		if (runStart != -1){
+			return runStart;
+		}
+	}
+	return -1;
+}
+
+
+/*
+ * Getter method for the number of set blocks
+ *
+ */
+long RoaringBitmap::getCardinality(){
+	return cardinality;
+}
+
+
+/*
+ * Getter method for the memory held by the bitmap
+ *
+ * Returns:
+ *		Bytes of the bitmap, its chunk list, containers and working bitmap
+ */
+long RoaringBitmap::getMemoryBytes(){
+	long numBytes = sizeof(RoaringBitmap) + chunkKeys.capacity()*sizeof(int) + containers.capacity()*sizeof(RoaringContainer);
+	numBytes += chunkWords.capacity()*sizeof(uint64_t);
+	for (int i=0;i<containers.size();i++){
+		numBytes += containers[i].values.capacity()*sizeof(uint16_t);
+		numBytes += containers[i].words.capacity()*sizeof(uint64_t);
+		numBytes += containers[i].runs.capacity()*sizeof(pair<uint16_t, uint16_t>);
+	}
+	return numBytes;
+}
+
+
+/*
+ * Getter method for the number of containers of a type
+ *
+ */
+int RoaringBitmap::getNumContainers(int type){
+	int numContainers = 0;
+	for (int i=0;i<containers.size();i++){
+		numContainers += containers[i].type == type;
+	}
+	return numContainers;
+}
+
+
+/*
+ * Compares the bitmap with the dense bit map on a large volume
+ *	Builds both maps for a volume of alternating used and free runs
+ *	(the same layout every time) and prints their memory use and the
+ *	time of the free run search requestBlocks runs, of rank and of
+ *	select.
+ *
+ * Input:
+ *		numBlocks - Number of blocks in the volume
+ *
+ */
+void RoaringBitmap::compareDense(int numBlocks){
+	std::mt19937 generator(1007);
+	vector<int> bitMap(numBlocks, 0);
+	int block = 1;
+	bool freeRun = false;
+	while (block < numBlocks){
+		// Used runs are longer than free runs, as on a filling volume
+		int runLength = 1 + generator() % (freeRun ? 256 : 2048);
+		for (int i=block;i<min(numBlocks, block+runLength);i++){
+			bitMap[i] = freeRun;
+		}
+		block += runLength;
+		freeRun = !freeRun;
+	}
+	RoaringBitmap compressed;
+	compressed.build(bitMap);
+	cout << "Free space map comparison (" << numBlocks << " blocks, " << compressed.getCardinality() << " free)" << endl;
+	cout << "\t> Dense bit map: " << (long)bitMap.capacity()*sizeof(int) << " bytes (" << (numBlocks+7)/8 << " bytes packed)" << endl;
+	cout << "\t> Compressed map: " << compressed.getMemoryBytes() << " bytes (" << compressed.getNumContainers(containerArray) << " array, ";
+	cout << compressed.getNumContainers(containerBitmap) << " bitmap, " << compressed.getNumContainers(containerRun) << " run containers)" << endl;
+	streamsize defaultPrecision = cout.precision();
+	cout << fixed << setprecision(3);
+	int runLengths[] = {1, 64, 256, 1024};
+	for (int i=0;i<4;i++){
+		int denseBlock = 0;
+		int compressedBlock = 0;
+		int numQueries = 20;
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		for (int j=0;j<numQueries;j++){
+			denseBlock = DataKernels::findFreeRun(bitMap.data(), numBlocks, runLengths[i]);
+		}
+		double denseTime = chrono::duration<double, micro>(chrono::steady_clock::now()-start).count() / numQueries;
+		start = chrono::steady_clock::now();
+		for (int j=0;j<numQueries;j++){
+			compressedBlock = compressed.findRun(runLengths[i], 0);
+		}
+		double compressedTime = chrono::duration<double, micro>(chrono::steady_clock::now()-start).count() / numQueries;
+		cout << "\t> requestBlocks(" << runLengths[i] << "): block " << compressedBlock << ", dense " << denseTime << " us, compressed " << compressedTime << " us";
+		if (denseBlock != compressedBlock){
+			cout << " (dense found block " << denseBlock << ")";
+		}
+		cout << endl;
+	}
+	// Rank and select at blocks spread over the volume
+	int numQueries = 20;
+	long denseRank = 0;
+	long compressedRank = 0;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (int j=0;j<numQueries;j++){
+		denseRank += std::count(bitMap.begin(), bitMap.begin()+(long)numBlocks*j/numQueries, 1);
+	}
+	double denseTime = chrono::duration<double, micro>(chrono::steady_clock::now()-start).count() / numQueries;
+	start = chrono::steady_clock::now();
+	for (int j=0;j<numQueries;j++){
+		compressedRank += compressed.rank((long)numBlocks*j/numQueries);
+	}
+	double compressedTime = chrono::duration<double, micro>(chrono::steady_clock::now()-start).count() / numQueries;
+	cout << "\t> rank: dense " << denseTime << " us, compressed " << compressedTime << " us" << (denseRank == compressedRank ? "" : " (results differ)") << endl;
+	vector<int> selected(numQueries);
+	start = chrono::steady_clock::now();
+	for (int j=0;j<numQueries;j++){
+		selected[j] = compressed.select(compressed.getCardinality()*j/numQueries);
+	}
+	compressedTime = chrono::duration<double, micro>(chrono::steady_clock::now()-start).count() / numQueries;
+	bool selectValid = true;
+	for (int j=0;j<numQueries;j++){
+		// The k-th free block has k free blocks before it
+		selectValid = selectValid && compressed.rank(selected[j]) == compressed.getCardinality()*j/numQueries;
+	}
+	cout << "\t> select: compressed " << compressedTime << " us" << (selectValid ? "" : " (results differ)") << endl << endl;
+	cout.unsetf(ios::floatfield);
+	cout.precision(defaultPrecision);
+}
@@ -0,0 +1,71 @@
+// RoaringBitmap.h
+#ifndef ROARINGBITMAP_H
+#define ROARINGBITMAP_H
+#pragma once
+
+// Layout of a chunk
+#define roaringChunkBlocks 65536	// Blocks in a chunk (low 16 bits of the block number)
+#define roaringArrayLimit 4096		// Most blocks in an array container (a bitmap is smaller above it)
+#define roaringBitmapWords 1024		// 64-bit words in a bitmap container
+
+// Container types
+#define containerArray 1
+#define containerBitmap 2
+#define containerRun 3
+
+/*
+ * Set blocks of one chunk
+ *	Only the list of the container's type is used.
+ */
+typedef struct RoaringContainer {
+	int type;									// Container type (1 - Array, 2 - Bitmap, 3 - Run)
+	int cardinality;							// Number of set blocks in the chunk
+	vector<uint16_t> values;					// Array: set blocks in order
+	vector<uint64_t> words;						// Bitmap: one bit per block of the chunk
+	vector<pair<uint16_t, uint16_t> > runs;		// Run: first block and length-1 of every run in order
+} RoaringContainer;
+
+/*
+ * Compressed bitmap of free blocks (roaring layout)
+ *	Block numbers are split into a chunk (high bits) and a position in
+ *	the chunk (low 16 bits). Only chunks holding set blocks are kept,
+ *	each in the smallest of three containers: a sorted array for few
+ *	blocks, a bitmap for many scattered blocks, and a list of runs for
+ *	long free or used stretches. A container is rebuilt through a
+ *	bitmap when it changes, then stored in the smallest type again.
+ */
+class RoaringBitmap{
+	vector<int> chunkKeys;						// High bits of every chunk kept, in order
+	vector<RoaringContainer> containers;		// Container of every chunk kept
+	long cardinality;							// Number of set blocks
+	vector<uint64_t> chunkWords;				// Bitmap a changed container is rebuilt through
+	int findChunk(int key);
+	int toWords(RoaringContainer &container, vector<uint64_t> &words);
+	int fromWords(RoaringContainer &container, vector<uint64_t> &words);
+	int containerRank(RoaringContainer &container, int low);
+	int containerSelect(RoaringContainer &container, int k);
+	int scanRuns(RoaringContainer &container, int base, int fromLow, int runLength, int &pendingStart, int &pendingEnd);
+public:
+	// Constructors/Destructors
+	RoaringBitmap();
+
+	// General methods
+	int build(vector<int> &bitMap);
+	int setRange(int startBlock, int numBlocks, bool value);
+
+	// Query methods
+	bool contains(int block);
+	long rank(int block);
+	int select(long k);
+	int findRun(int runLength, int fromBlock);
+
+	// Getter methods
+	long getCardinality();
+	long getMemoryBytes();
+	int getNumContainers(int type);
+
+	// Printing methods
+	static void compareDense(int numBlocks);
+};
+
+#endif
@@ -0,0 +1,419 @@
+#include "Header.h"				// Header file
+#include "VirtualDisk.h"
+#include "SegmentLog.h"			// SegmentLog file
+#include "ByteStore.h"
+
+// Compiler Directive
+using namespace std;
+
+
+/*
+ * Contructor for SegmentLog
+ *	Segments start after the superblock, and the last segment holds
+ *	whatever blocks are left over. Every segment starts clean.
+ *
+ */
+SegmentLog::SegmentLog(VirtualDisk* disk, int numBlocks){
+	currentDisk = disk;
+	segmentBlocks = numBlocks;
+	numSegments = ceil((currentDisk->getVCB()->totalBlockNum-1)*1.00 / segmentBlocks);
+	liveBlocks.assign(numSegments, 0);
+	lastWrite.assign(numSegments, 0);
+	blockOwner.assign(currentDisk->getVCB()->totalBlockNum, -1);
+	headSegment = -1;
+	headBlock = -1;
+	logTime = 0;
+	userBlocksWritten = 0;
+	cleanerBlocksWritten = 0;
+	segmentsCleaned = 0;
+	cleanerAccessTime = 0;
+	cleanerDeviceTime = 0;
+}
+
+
+/*
+ * Appends a block at the log head
+ *	When the head segment is full, the head moves to the next clean
+ *	segment. The block is marked as used in the free space bit map.
+ *
+ * Input:
+ *		fileName - File the block belongs to
+ *		cleaner - true if the block is written by the cleaner
+ *
+ * Returns:
+ *		Block number of the appended block
+ *		'-1' if there is no clean segment left
+ */
+int SegmentLog::appendBlock(int64_t fileName, bool cleaner){
+	// Copy-on-write: preserve the log state for the latest snapshot
+	currentDisk->preserveLog();
+	if (headSegment == -1 || headBlock > getSegmentEnd(headSegment)){
+		// Head segment full, look for the next clean segment
+		int nextSegment = -1;
+		for (int i=1; i <= numSegments; i++){
+			int segment = (headSegment + i + numSegments) % numSegments;
+			if (isClean(segment)){
+				nextSegment = segment;
+				break;
+			}
+		}
+		if (nextSegment == -1){
+			return -1;
+		}
+		headSegment = nextSegment;
+		headBlock = getSegmentStart(headSegment);
+	}
+	int block = headBlock;
+	headBlock++;
+	// Update the segment usage table
+	liveBlocks[headSegment]++;
+	lastWrite[headSegment] = ++logTime;
+	blockOwner[block] = fileName;
+	if (cleaner){
+		cleanerBlocksWritten++;
+	} else {
+		userBlocksWritten++;
+	}
+	// Update free space bit map
+	currentDisk->updateFreeSpace(block, 1, 0);
+	return block;
+}
+
+
+/*
+ * Releases a dead block
+ *	The block is marked as free in the free space bit map, but the log
+ *	only writes to it again once its segment is clean.
+ *
+ * Input:
+ *		block - Block no longer used by its file
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int SegmentLog::releaseBlock(int block){
+	// Copy-on-write: preserve the log state for the latest snapshot
+	currentDisk->preserveLog();
+	liveBlocks[getSegment(block)]--;
+	blockOwner[block] = -1;
+	// Update the free space bit map + number of free blocks
+	currentDisk->updateFreeSpace(block, 1, 1);
+	return 1;
+}
+
+
+/*
+ * Makes space at the log head
+ *	Segments are cleaned while the log cannot take the requested
+ *	number of blocks or fewer than logCleanSegments segments are clean,
+ *	as long as the block budget lasts and a segment is worth cleaning.
+ *
+ * Input:
+ *		numBlocks - Blocks about to be appended
+ *		blockBudget - Most blocks the cleaner may move
+ *
+ * Returns:
+ *		Number of blocks moved by the cleaner
+ *		'-1' if the log still cannot take the requested blocks
+ */
+int SegmentLog::makeSpace(int numBlocks, int blockBudget){
+	int blocksMoved = 0;
+	int startAccessTime = currentDisk->getAccessTime();
+	double startDeviceTime = currentDisk->getDeviceTime();
+	long segmentsBefore = segmentsCleaned;
+	// Every cleaning gains blocks, so a pass per segment is enough
+	for (int i=0; i < numSegments && blocksMoved < blockBudget; i++){
+		if (getAvailableBlocks() >= numBlocks && getNumCleanSegments() >= logCleanSegments){
+			break;
+		}
+		int segment = pickSegment();
+		if (segment == -1){
+			// No segment worth cleaning
+			break;
+		}
+		blocksMoved += cleanSegment(segment);
+	}
+	if (segmentsCleaned > segmentsBefore){
+		cleanerAccessTime += currentDisk->getAccessTime() - startAccessTime;
+		cleanerDeviceTime += currentDisk->getDeviceTime() - startDeviceTime;
+		currentDisk->getOut() << "Segment cleaner cleaned " << segmentsCleaned - segmentsBefore << " segment(s) and moved " << blocksMoved << " live block(s)." << endl;
+	}
+	if (getAvailableBlocks() < numBlocks){
+		return -1;
+	}
+	return blocksMoved;
+}
+
+
+/*
+ * Picks the segment to clean by cost-benefit
+ *	Cleaning a segment with live fraction u reads the whole segment and
+ *	writes u of it back, freeing 1-u. Older segments are favoured since
+ *	their live blocks are less likely to die soon. A segment is only a
+ *	candidate if cleaning it gains blocks and the log has room for its
+ *	live blocks and the index blocks that have to be rewritten.
+ *
+ * Returns:
+ *		Segment to clean
+ *		'-1' if no segment is worth cleaning
+ */
+int SegmentLog::pickSegment(){
+	int bestSegment = -1;
+	double bestRatio = -1;
+	for (int segment=0; segment < numSegments; segment++){
+		int segmentSize = getSegmentEnd(segment) - getSegmentStart(segment) + 1;
+		if (segment == headSegment || liveBlocks[segment] == 0 || liveBlocks[segment] == segmentSize){
+			continue;
+		}
+		// Blocks the cleaner writes: the live blocks and the index blocks of their files
+		set<int64_t> owners;
+		int blocksNeeded = liveBlocks[segment];
+		for (int block=getSegmentStart(segment); block <= getSegmentEnd(segment); block++){
+			if (blockOwner[block] != -1 && owners.insert(blockOwner[block]).second){
+				if (getSegment(currentDisk->checkINode(blockOwner[block])->Index) != segment){
+					// Index block outside the segment is rewritten as well
+					blocksNeeded++;
+				}
+			}
+		}
+		if (blocksNeeded >= segmentSize || blocksNeeded > getAvailableBlocks(segment)){
+			continue;
+		}
+		double usage = liveBlocks[segment]*1.00 / segmentSize;
+		double ratio = (1-usage) * (logTime - lastWrite[segment]) / (1+usage);
+		if (ratio > bestRatio){
+			bestRatio = ratio;
+			bestSegment = segment;
+		}
+	}
+	return bestSegment;
+}
+
+
+/*
+ * Cleans a segment
+ *	The live data blocks of every file in the segment are copied to the
+ *	log head, then the file's index block is rewritten at the log head
+ *	with the new locations and the inode map (directory) is updated.
+ *
+ * Input:
+ *		segment - Segment to clean
+ *
+ * Returns:
+ *		Number of blocks moved
+ */
+int SegmentLog::cleanSegment(int segment){
+	int blocksMoved = 0;
+	int blockSize = currentDisk->getBlockSize();
+	Data* diskData = currentDisk->getData();
+	set<int64_t> owners;
+	for (int block=getSegmentStart(segment); block <= getSegmentEnd(segment); block++){
+		if (blockOwner[block] != -1){
+			owners.insert(blockOwner[block]);
+		}
+	}
+	for (set<int64_t>::iterator it = owners.begin(); it != owners.end(); it++){
+		iNode* tempDirPtr = currentDisk->checkINode(*it);
+		int indexBlockStartingAddr = (tempDirPtr->Index-1)*blockSize;
+		for (int i=0; i < blockSize; i++){
+			int dataBlock = diskData[indexBlockStartingAddr+i].data;
+			// Increment access time and charge the read to the device (Accessed memory)
+			currentDisk->accessBlock(tempDirPtr->Index);
+			if (dataBlock != -1 && getSegment(dataBlock) == segment){
+				// Move the live data block to the log head
+				int newBlock = appendBlock(*it, true);
+				copyBlock(dataBlock, newBlock);
+				releaseBlock(dataBlock);
+				// Point the index entry to the new location
+				currentDisk->writeEntry(indexBlockStartingAddr+i, newBlock, false);
+				blocksMoved++;
+			}
+		}
+		// Rewrite the index block at the log head
+		int newIndex = appendBlock(*it, true);
+		copyBlock(tempDirPtr->Index, newIndex);
+		releaseBlock(tempDirPtr->Index);
+		blocksMoved++;
+		// Update the inode map with the new index block
+		currentDisk->updateINode(tempDirPtr, *it, newIndex, -1);
+		// Increment access time and charge the write to the device (Accessed memory)
+		currentDisk->accessBlock(0, true);
+	}
+	segmentsCleaned++;
+	return blocksMoved;
+}
+
+
+/*
+ * Copies a block and clears the source
+ *	The whole block is read before it is written, so the device
+ *	streams each block instead of seeking between them per entry.
+ *
+ * Input:
+ *		fromBlock - Block to copy
+ *		toBlock - Destination block
+ *
+ * Returns:
+ *		Number of entries copied
+ */
+int SegmentLog::copyBlock(int fromBlock, int toBlock){
+	int blockSize = currentDisk->getBlockSize();
+	Data* diskData = currentDisk->getData();
+	int fromAddr = (fromBlock*blockSize) - blockSize;
+	int toAddr = (toBlock*blockSize) - blockSize;
+	vector<int> buffer(blockSize);
+	for (int i=0; i < blockSize; i++){
+		// Read the entry and leave the dead copy empty
+		buffer[i] = diskData[fromAddr+i].data;
+		// Write the entry without charging a write
+		currentDisk->writeEntry(fromAddr+i, -1, false);
+		// Increment access time and charge the read to the device (Accessed memory)
+		currentDisk->accessBlock(fromBlock);
+	}
+	for (int i=0; i < blockSize; i++){
+		// Write the entry to the destination block
+		currentDisk->writeEntry(toAddr+i, buffer[i]);
+	}
+	if (currentDisk->getByteStore()){
+		// The bytes of the entries move with them
+		currentDisk->getByteStore()->moveBlocks(fromBlock, toBlock, 1);
+	}
+	return blockSize;
+}
+
+
+/*
+ * Segment layout methods
+ *	Segment n covers blocks 1+n*segmentBlocks onwards, the last
+ *	segment ends at the last block of the disk.
+ *
+ */
+int SegmentLog::getSegment(int block){
+	return (block-1) / segmentBlocks;
+}
+
+int SegmentLog::getSegmentStart(int segment){
+	return 1 + segment*segmentBlocks;
+}
+
+int SegmentLog::getSegmentEnd(int segment){
+	return min(getSegmentStart(segment) + segmentBlocks - 1, currentDisk->getVCB()->totalBlockNum - 1);
+}
+
+
+/*
+ * Checks whether a segment is clean
+ *	A segment without live blocks can be written from its start again,
+ *	except for the segment at the log head.
+ *
+ * Input:
+ *		segment - Segment to check
+ *
+ * Returns:
+ *		true if the log head may move into the segment
+ */
+bool SegmentLog::isClean(int segment){
+	return segment != headSegment && liveBlocks[segment] == 0;
+}
+
+
+/*
+ * Getter method for the next block the log head writes
+ *
+ * Returns:
+ *		Next block at the log head
+ *		'-1' if the head has to move to a clean segment first
+ */
+int SegmentLog::getNextBlock(){
+	if (headSegment == -1 || headBlock > getSegmentEnd(headSegment)){
+		return -1;
+	}
+	return headBlock;
+}
+
+
+/*
+ * Counts the clean segments
+ *
+ * Returns:
+ *		Number of clean segments
+ */
+int SegmentLog::getNumCleanSegments(){
+	int numClean = 0;
+	for (int segment=0; segment < numSegments; segment++){
+		if (isClean(segment)){
+			numClean++;
+		}
+	}
+	return numClean;
+}
+
+
+/*
+ * Counts the blocks the log can take without cleaning
+ *
+ * Input:
+ *		excludeSegment - Segment not counted even if clean (-1 for none)
+ *
+ * Returns:
+ *		Blocks left in the head segment plus the blocks of clean segments
+ */
+int SegmentLog::getAvailableBlocks(int excludeSegment){
+	int numAvailable = 0;
+	if (headSegment != -1){
+		numAvailable += max(getSegmentEnd(headSegment) - headBlock + 1, 0);
+	}
+	for (int segment=0; segment < numSegments; segment++){
+		if (segment != excludeSegment && isClean(segment)){
+			numAvailable += getSegmentEnd(segment) - getSegmentStart(segment) + 1;
+		}
+	}
+	return numAvailable;
+}
+
+
+/*
+ * Calculates the write amplification of the log
+ *
+ * Returns:
+ *		Blocks written to the device per block written by file operations
+ */
+double SegmentLog::getWriteAmplification(){
+	if (userBlocksWritten == 0){
+		return 1;
+	}
+	return (userBlocksWritten + cleanerBlocksWritten)*1.00 / userBlocksWritten;
+}
+
+
+/*
+ * Prints the segment usage table and cleaner statistics
+ *
+ * Output:
+ *		Live blocks and age of every segment
+ *		Write amplification
+ *		Cleaner overhead (segments cleaned, blocks moved, accesses and device time)
+ */
+void SegmentLog::printLogStats(){
+	std::ostream &out = currentDisk->getOut();
+	streamsize defaultPrecision = out.precision();
+	out << "Log-structured statistics" << endl;
+	out << "\t> Segment usage (segment:live/size:age): ";
+	for (int segment=0; segment < numSegments; segment++){
+		out << segment << ":" << liveBlocks[segment] << "/" << getSegmentEnd(segment)-getSegmentStart(segment)+1 << ":";
+		if (segment == headSegment){
+			out << "head ";
+		} else if (isClean(segment)){
+			out << "clean ";
+		} else {
+			out << logTime - lastWrite[segment] << " ";
+		}
+	}
+	out << endl;
+	out << "\t> Blocks written: " << userBlocksWritten << " by files, " << cleanerBlocksWritten << " by the cleaner" << endl;
+	out << "\t> Write amplification: " << fixed << setprecision(2) << getWriteAmplification() << endl;
+	out << "\t> Cleaner overhead: " << segmentsCleaned << " segment(s) cleaned, " << cleanerAccessTime << " accesses to memory, ";
+	out << setprecision(1) << cleanerDeviceTime << " us simulated device time" << endl << endl;
+	out.unsetf(ios::floatfield);
+	out.precision(defaultPrecision);
+}
@@ -0,0 +1,69 @@
+// SegmentLog.h
+#ifndef SEGMENTLOG_H
+#define SEGMENTLOG_H
+#pragma once
+
+// Number of blocks in a log segment
+#define logSegmentBlocks 4
+// Number of clean segments the cleaner tries to keep
+#define logCleanSegments 1
+
+/*
+ * Log for the log-structured allocation method (method 5)
+ *	The data blocks after the superblock are split into segments, and
+ *	every block written (file data, index blocks and blocks moved by
+ *	the cleaner) is appended at the log head. The head only moves into
+ *	clean segments, so deleted blocks are not reused until the cleaner
+ *	has moved the live blocks out of their segment. The directory
+ *	entry of a file holds the location of its latest index block and
+ *	serves as the inode map.
+ *
+ *	The segment usage table keeps the live blocks and last write time
+ *	of every segment. The cleaner picks segments by cost-benefit,
+ *	(1-u)*age/(1+u) with u the live fraction of the segment.
+ */
+class SegmentLog{
+	// Private variables for SegmentLog
+	VirtualDisk* currentDisk;
+	int segmentBlocks;				// Blocks in a segment
+	int numSegments;				// Number of segments
+	vector<int> liveBlocks;			// Segment usage table - live blocks of each segment
+	vector<long> lastWrite;			// Segment usage table - log time of the last write to each segment
+	vector<int64_t> blockOwner;		// File owning each live block (-1 if dead or free)
+	int headSegment;				// Segment being written (-1 if none)
+	int headBlock;					// Next block to write in the head segment
+	long logTime;					// Blocks written so far (log clock)
+	long userBlocksWritten;			// Blocks written by file operations
+	long cleanerBlocksWritten;		// Blocks written by the cleaner
+	long segmentsCleaned;			// Segments cleaned
+	long cleanerAccessTime;			// Accesses to memory spent cleaning
+	double cleanerDeviceTime;		// Simulated device time spent cleaning (us)
+public:
+	// Function declarations/prototypes
+	SegmentLog(VirtualDisk* disk, int numBlocks);
+
+	// Log methods
+	int appendBlock(int64_t fileName, bool cleaner=false);
+	int releaseBlock(int block);
+	int makeSpace(int numBlocks, int blockBudget=INT_MAX);
+
+	// Cleaner methods
+	int pickSegment();
+	int cleanSegment(int segment);
+	int copyBlock(int fromBlock, int toBlock);
+
+	// Utility methods
+	int getSegment(int block);
+	int getSegmentStart(int segment);
+	int getSegmentEnd(int segment);
+	bool isClean(int segment);
+	int getNumCleanSegments();
+	int getAvailableBlocks(int excludeSegment=-1);
+	int getNextBlock();
+	double getWriteAmplification();
+
+	// Printing methods
+	void printLogStats();
+};
+
+#endif
@@ -0,0 +1,545 @@
+#include "Header.h"				// Header file
+#include "VirtualDisk.h"
+#include "SegmentLog.h"
+#include "DirectoryTree.h"
+#include "RoaringBitmap.h"
+#include "Snapshot.h"			// Snapshot file
+
+// Compiler Directive
+using namespace std;
+
+
+/*
+ * Contructor for SnapshotManager
+ *	Snapshots are numbered from 1.
+ *
+ */
+SnapshotManager::SnapshotManager(VirtualDisk* disk){
+	currentDisk = disk;
+	nextId = 1;
+	pagesPreserved = 0;
+}
+
+
+/*
+ * Takes a snapshot
+ *	No data is copied, the snapshot starts with an empty page table.
+ *
+ * Returns:
+ *		Number of the new snapshot
+ */
+int SnapshotManager::takeSnapshot(){
+	Snapshot newSnapshot;
+	newSnapshot.id = nextId++;
+	snapshots.push_back(newSnapshot);
+	return newSnapshot.id;
+}
+
+
+/*
+ * Preserves a block before it is written
+ *	Only the first write to the block after the latest snapshot copies
+ *	it, later writes find the block already preserved.
+ *
+ * Input:
+ *		block - Block about to be written
+ *
+ * Returns:
+ *		'1' if the block was copied
+ *		'0' if it was already preserved or there is no snapshot
+ */
+int SnapshotManager::preserveBlock(int block){
+	if (snapshots.empty() || snapshots.back().dataPages.count(block) > 0){
+		return 0;
+	}
+	int blockSize = currentDisk->getBlockSize();
+	Data* blockStart = currentDisk->getData() + (block*blockSize) - blockSize;
+	snapshots.back().dataPages[block] = vector<Data>(blockStart, blockStart+blockSize);
+	pagesPreserved++;
+	return 1;
+}
+
+
+/*
+ * Preserves a block in an older snapshot
+ *	Used for a block retired by a lazy delete before the latest
+ *	snapshot: its entries are still the ones the snapshot taken before
+ *	the delete holds, unless that snapshot already preserved it.
+ *
+ * Input:
+ *		id - Snapshot to preserve the block in
+ *		block - Block about to be cleared
+ *
+ * Returns:
+ *		'1' if the block was copied
+ *		'0' if it was already preserved or the snapshot does not exist
+ */
+int SnapshotManager::preserveBlockIn(int id, int block){
+	int snapshotIndex = findSnapshot(id);
+	if (snapshotIndex == -1 || snapshots[snapshotIndex].dataPages.count(block) > 0){
+		return 0;
+	}
+	int blockSize = currentDisk->getBlockSize();
+	Data* blockStart = currentDisk->getData() + (block*blockSize) - blockSize;
+	snapshots[snapshotIndex].dataPages[block] = vector<Data>(blockStart, blockStart+blockSize);
+	pagesPreserved++;
+	return 1;
+}
+
+
+/*
+ * Preserves the pages of the free block map holding a range of blocks
+ *	before the range is marked as used or free
+ *
+ * Input:
+ *		firstBlock - First block about to change
+ *		numBlocks - Number of blocks about to change
+ *
+ * Returns:
+ *		Number of pages copied
+ */
+int SnapshotManager::preserveFreeMap(int firstBlock, int numBlocks){
+	if (snapshots.empty() || numBlocks < 1){
+		return 0;
+	}
+	int totalBlocks = currentDisk->getVCB()->totalBlockNum;
+	int pagesCopied = 0;
+	for (int page=firstBlock/mapPageBlocks; page <= (firstBlock+numBlocks-1)/mapPageBlocks; page++){
+		if (snapshots.back().mapPages.count(page) > 0){
+			continue;
+		}
+		// Copy whether every block of the page is free
+		vector<int> &mapPage = snapshots.back().mapPages[page];
+		for (int block=page*mapPageBlocks; block < min((page+1)*mapPageBlocks, totalBlocks); block++){
+			mapPage.push_back(currentDisk->isFreeBlock(block));
+		}
+		pagesCopied++;
+	}
+	pagesPreserved += pagesCopied;
+	return pagesCopied;
+}
+
+
+/*
+ * Preserves the page of the directory holding an inode before the
+ * inode is changed
+ *	Once the directory tree is copied, the copy already holds the
+ *	inodes as they were.
+ *
+ * Input:
+ *		entry - Position of the inode in the directory
+ *
+ * Returns:
+ *		'1' if the page was copied
+ *		'0' if it was already preserved or there is no snapshot
+ */
+int SnapshotManager::preserveDirectory(int entry){
+	int page = entry/dirPageEntries;
+	if (snapshots.empty() || !snapshots.back().tree.empty() || snapshots.back().dirPages.count(page) > 0){
+		return 0;
+	}
+	iNode* dir = currentDisk->getDir();
+	int pageEnd = min((page+1)*dirPageEntries, currentDisk->getDirSize());
+	snapshots.back().dirPages[page] = vector<iNode>(dir+page*dirPageEntries, dir+pageEnd);
+	pagesPreserved++;
+	return 1;
+}
+
+
+/*
+ * Preserves the directory tree before a file is inserted or deleted
+ *	An insert or delete may split, merge or free nodes anywhere on the
+ *	path, so the whole tree is copied.
+ *
+ * Returns:
+ *		'1' if the tree was copied
+ *		'0' if it was already preserved or there is no snapshot
+ */
+int SnapshotManager::preserveTree(){
+	if (snapshots.empty() || !snapshots.back().tree.empty()){
+		return 0;
+	}
+	snapshots.back().tree.push_back(*currentDisk->getDirTree());
+	pagesPreserved++;
+	return 1;
+}
+
+
+/*
+ * Preserves the log state before a block is appended or released
+ *
+ * Returns:
+ *		'1' if the log state was copied
+ *		'0' if it was already preserved or there is no snapshot
+ */
+int SnapshotManager::preserveLog(){
+	if (snapshots.empty() || !snapshots.back().log.empty()){
+		return 0;
+	}
+	snapshots.back().log.push_back(*currentDisk->getLog());
+	pagesPreserved++;
+	return 1;
+}
+
+
+/*
+ * Rolls the disk back to a snapshot
+ *	Every page changed since the snapshot is written back with its
+ *	contents at the time of the snapshot. Snapshots taken after it are
+ *	dropped, and the snapshot itself starts over with an empty page
+ *	table since the disk matches it again. The caller rebuilds the
+ *	free space statistics from the restored map and directory.
+ *
+ * Input:
+ *		id - Snapshot to roll back to
+ *
+ * Returns:
+ *		Number of blocks restored
+ *		'-1' if the snapshot does not exist
+ */
+int SnapshotManager::rollback(int id){
+	int snapshotIndex = findSnapshot(id);
+	if (snapshotIndex == -1){
+		return -1;
+	}
+	int blockSize = currentDisk->getBlockSize();
+	Data* diskData = currentDisk->getData();
+	set<int> changedBlocks = getChangedBlocks(snapshotIndex, snapshots.size());
+	for (set<int>::iterator it = changedBlocks.begin(); it != changedBlocks.end(); it++){
+		vector<Data> blockData = readBlock(snapshotIndex, *it);
+		for (int i=0; i < blockSize; i++){
+			// Write the entry as it was at the snapshot
+			diskData[(*it*blockSize)-blockSize+i] = blockData[i];
+			// Increment access time and charge the write to the device (Accessed memory)
+			currentDisk->accessBlock(*it, true);
+		}
+	}
+	if (restoreMetadata(snapshotIndex) > 0){
+		// Increment access time and charge the write to the device (Accessed memory)
+		currentDisk->accessBlock(0, true);
+	}
+	// Drop the newer snapshots, the disk now matches the snapshot
+	snapshots.erase(snapshots.begin()+snapshotIndex+1, snapshots.end());
+	snapshots.back().dataPages.clear();
+	snapshots.back().mapPages.clear();
+	snapshots.back().dirPages.clear();
+	snapshots.back().tree.clear();
+	snapshots.back().log.clear();
+	return changedBlocks.size();
+}
+
+
+/*
+ * Prints the differences between two snapshots
+ *	Only blocks preserved between the two snapshots can differ, so
+ *	only those are compared.
+ *
+ * Input:
+ *		fromId - Older snapshot
+ *		toId - Newer snapshot, '-1' for the current disk
+ *
+ * Output:
+ *		Blocks whose contents differ
+ *		Files added, removed or relocated
+ *		Free blocks of both
+ *
+ * Returns:
+ *		Number of blocks that differ
+ *		'-1' if a snapshot does not exist
+ */
+int SnapshotManager::diff(int fromId, int toId){
+	int fromIndex = findSnapshot(fromId);
+	int toIndex = toId == -1 ? snapshots.size() : findSnapshot(toId);
+	if (fromIndex == -1 || toIndex == -1){
+		return -1;
+	}
+	if (fromIndex > toIndex){
+		swap(fromIndex, toIndex);
+		swap(fromId, toId);
+	}
+	std::ostream &out = currentDisk->getOut();
+	int numChanged = 0;
+	set<int> changedBlocks = getChangedBlocks(fromIndex, toIndex);
+	out << "Diff of snapshot " << fromId << " against ";
+	if (toIndex == snapshots.size()){
+		out << "the current disk" << endl;
+	} else {
+		out << "snapshot " << toId << endl;
+	}
+	out << "\t> Changed blocks: ";
+	for (set<int>::iterator it = changedBlocks.begin(); it != changedBlocks.end(); it++){
+		vector<Data> fromData = readBlock(fromIndex, *it);
+		vector<Data> toData = readBlock(toIndex, *it);
+		for (int i=0; i < fromData.size(); i++){
+			// Lengths are '-1' except in contiguous indexed extents
+			if (fromData[i].data != toData[i].data || fromData[i].length != toData[i].length){
+				out << "B" << *it << " ";
+				numChanged++;
+				break;
+			}
+		}
+	}
+	out << "(" << numChanged << ")" << endl;
+	// Compare the directories
+	vector<iNode> fromDir = readDirectory(fromIndex);
+	vector<iNode> toDir = readDirectory(toIndex);
+	map<int64_t, iNode> fromFiles;
+	map<int64_t, iNode> toFiles;
+	for (int i=0; i < fromDir.size(); i++){
+		if (fromDir[i].FileIdentifier != -1){
+			fromFiles[fromDir[i].FileIdentifier] = fromDir[i];
+		}
+	}
+	// The directory tree may have more inodes than the older directory
+	for (int i=0; i < toDir.size(); i++){
+		if (toDir[i].FileIdentifier != -1){
+			toFiles[toDir[i].FileIdentifier] = toDir[i];
+		}
+	}
+	out << "\t> Files added: ";
+	for (map<int64_t, iNode>::iterator it = toFiles.begin(); it != toFiles.end(); it++){
+		if (fromFiles.count(it->first) == 0){
+			out << it->first << " ";
+		}
+	}
+	out << endl << "\t> Files removed: ";
+	for (map<int64_t, iNode>::iterator it = fromFiles.begin(); it != fromFiles.end(); it++){
+		if (toFiles.count(it->first) == 0){
+			out << it->first << " ";
+		}
+	}
+	out << endl << "\t> Files relocated: ";
+	for (map<int64_t, iNode>::iterator it = fromFiles.begin(); it != fromFiles.end(); it++){
+		if (toFiles.count(it->first) > 0){
+			iNode &toEntry = toFiles[it->first];
+			if (it->second.StartBlock != toEntry.StartBlock || it->second.LastBlock != toEntry.LastBlock || it->second.Length != toEntry.Length || it->second.Index != toEntry.Index){
+				out << it->first << " ";
+			}
+		}
+	}
+	out << endl;
+	out << "\t> Free blocks: " << readFreeBlocks(fromIndex) << " -> " << readFreeBlocks(toIndex) << endl << endl;
+	return numChanged;
+}
+
+
+/*
+ * Finds a snapshot by number
+ *
+ * Input:
+ *		id - Snapshot number
+ *
+ * Returns:
+ *		Position of the snapshot, '-1' if not found
+ */
+int SnapshotManager::findSnapshot(int id){
+	for (int i=0; i < snapshots.size(); i++){
+		if (snapshots[i].id == id){
+			return i;
+		}
+	}
+	return -1;
+}
+
+
+/*
+ * Reads a block as it was at a snapshot
+ *	The first snapshot from the requested one onwards that preserved
+ *	the block holds its contents, otherwise the block is unchanged.
+ *
+ * Input:
+ *		snapshotIndex - Position of the snapshot, snapshots.size() for the current disk
+ *		block - Block to read
+ *
+ * Returns:
+ *		Entries of the block
+ */
+vector<Data> SnapshotManager::readBlock(int snapshotIndex, int block){
+	for (int i=snapshotIndex; i < snapshots.size(); i++){
+		if (snapshots[i].dataPages.count(block) > 0){
+			return snapshots[i].dataPages[block];
+		}
+	}
+	int blockSize = currentDisk->getBlockSize();
+	Data* blockStart = currentDisk->getData() + (block*blockSize) - blockSize;
+	return vector<Data>(blockStart, blockStart+blockSize);
+}
+
+
+/*
+ * Finds the directory tree as it was at a snapshot
+ *
+ * Input:
+ *		snapshotIndex - Position of the snapshot
+ *
+ * Returns:
+ *		Position of the first snapshot from the requested one onwards
+ *		that copied the tree, snapshots.size() if the tree is unchanged
+ */
+int SnapshotManager::findTreeCopy(int snapshotIndex){
+	int treeIndex = snapshotIndex;
+	while (treeIndex < snapshots.size() && snapshots[treeIndex].tree.empty()){
+		treeIndex++;
+	}
+	return treeIndex;
+}
+
+
+/*
+ * Reads the directory inodes as they were at a snapshot
+ *	Starts from the tree copy of the snapshot, or the current
+ *	directory, and lays the preserved pages over it from the newest
+ *	snapshot to the oldest, so the oldest copy of a page wins.
+ *
+ * Input:
+ *		snapshotIndex - Position of the snapshot, snapshots.size() for the current disk
+ *
+ * Returns:
+ *		Copy of the directory inodes
+ */
+vector<iNode> SnapshotManager::readDirectory(int snapshotIndex){
+	int treeIndex = findTreeCopy(snapshotIndex);
+	vector<iNode> dir;
+	if (treeIndex < snapshots.size()){
+		DirectoryTree &tree = snapshots[treeIndex].tree[0];
+		dir.assign(tree.getSlots(), tree.getSlots()+tree.getNumSlots());
+	} else {
+		dir.assign(currentDisk->getDir(), currentDisk->getDir()+currentDisk->getDirSize());
+	}
+	// Pages preserved after the tree was copied are not kept, so the pages of its snapshot are older
+	for (int i=min(treeIndex, (int)snapshots.size()-1); i >= snapshotIndex; i--){
+		for (map<int, vector<iNode> >::iterator it = snapshots[i].dirPages.begin(); it != snapshots[i].dirPages.end(); it++){
+			copy(it->second.begin(), it->second.end(), dir.begin()+it->first*dirPageEntries);
+		}
+	}
+	return dir;
+}
+
+
+/*
+ * Reads the number of free blocks at a snapshot
+ *	Only blocks of the preserved map pages can have changed, so the
+ *	current number is corrected by the blocks of those pages.
+ *
+ * Input:
+ *		snapshotIndex - Position of the snapshot, snapshots.size() for the current disk
+ *
+ * Returns:
+ *		Number of free blocks
+ */
+int SnapshotManager::readFreeBlocks(int snapshotIndex){
+	int numFreeBlock = currentDisk->getVCB()->numFreeBlock;
+	set<int> pagesRead;
+	for (int i=snapshotIndex; i < snapshots.size(); i++){
+		for (map<int, vector<int> >::iterator it = snapshots[i].mapPages.begin(); it != snapshots[i].mapPages.end(); it++){
+			if (!pagesRead.insert(it->first).second){
+				// A newer copy of the page than the one already read
+				continue;
+			}
+			for (int j=0; j < it->second.size(); j++){
+				numFreeBlock += it->second[j] - currentDisk->isFreeBlock(it->first*mapPageBlocks+j);
+			}
+		}
+	}
+	return numFreeBlock;
+}
+
+
+/*
+ * Writes the metadata as it was at a snapshot back to the disk
+ *	Only the preserved pages of the free block map and the directory
+ *	are written, along with the tree and log state if they changed.
+ *
+ * Input:
+ *		snapshotIndex - Position of the snapshot
+ *
+ * Returns:
+ *		Number of pages restored
+ */
+int SnapshotManager::restoreMetadata(int snapshotIndex){
+	VCB* diskVCB = currentDisk->getVCB();
+	RoaringBitmap* freeMap = currentDisk->getFreeMap();
+	int pagesRestored = 0;
+	// Free block map, the first snapshot that preserved a page holds it
+	set<int> pagesRead;
+	for (int i=snapshotIndex; i < snapshots.size(); i++){
+		for (map<int, vector<int> >::iterator it = snapshots[i].mapPages.begin(); it != snapshots[i].mapPages.end(); it++){
+			if (!pagesRead.insert(it->first).second){
+				continue;
+			}
+			for (int j=0; j < it->second.size(); j++){
+				int block = it->first*mapPageBlocks+j;
+				if (currentDisk->isFreeBlock(block) == (it->second[j] == 1)){
+					continue;
+				}
+				diskVCB->numFreeBlock += it->second[j] == 1 ? 1 : -1;
+				if (freeMap){
+					// The compressed map replaces the bit map
+					freeMap->setRange(block, 1, it->second[j] == 1);
+				} else {
+					diskVCB->FreeBlockBitMap[block] = it->second[j];
+				}
+			}
+			pagesRestored++;
+		}
+	}
+	// Directory, the tree holds its inodes, which may have grown since it was copied
+	int treeIndex = findTreeCopy(snapshotIndex);
+	if (treeIndex < snapshots.size()){
+		*currentDisk->getDirTree() = snapshots[treeIndex].tree[0];
+		pagesRestored++;
+	}
+	for (int i=min(treeIndex, (int)snapshots.size()-1); i >= snapshotIndex; i--){
+		for (map<int, vector<iNode> >::iterator it = snapshots[i].dirPages.begin(); it != snapshots[i].dirPages.end(); it++){
+			copy(it->second.begin(), it->second.end(), currentDisk->getDir()+it->first*dirPageEntries);
+			pagesRestored++;
+		}
+	}
+	// Log state
+	for (int i=snapshotIndex; i < snapshots.size(); i++){
+		if (!snapshots[i].log.empty()){
+			*currentDisk->getLog() = snapshots[i].log[0];
+			pagesRestored++;
+			break;
+		}
+	}
+	return pagesRestored;
+}
+
+
+/*
+ * Lists the blocks written between two snapshots
+ *
+ * Input:
+ *		fromIndex - Position of the older snapshot
+ *		toIndex - Position of the newer snapshot, snapshots.size() for the current disk
+ *
+ * Returns:
+ *		Blocks preserved by the snapshots from the older one up to the newer one
+ */
+set<int> SnapshotManager::getChangedBlocks(int fromIndex, int toIndex){
+	set<int> changedBlocks;
+	for (int i=fromIndex; i < toIndex; i++){
+		for (map<int, vector<Data> >::iterator it = snapshots[i].dataPages.begin(); it != snapshots[i].dataPages.end(); it++){
+			changedBlocks.insert(it->first);
+		}
+	}
+	return changedBlocks;
+}
+
+
+/*
+ * Getter methods for the snapshot statistics
+ *
+ */
+int SnapshotManager::getNumSnapshots(){
+	return snapshots.size();
+}
+
+int SnapshotManager::getLatestId(){
+	return snapshots.empty() ? 0 : snapshots.back().id;
+}
+
+long SnapshotManager::getPagesPreserved(){
+	return pagesPreserved;
+}
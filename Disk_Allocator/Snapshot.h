@@ -0,0 +1,66 @@
+// Snapshot.h
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+#pragma once
+
+// Blocks in a page of the free block map
+#define mapPageBlocks 16
+// Inodes in a page of the directory
+#define dirPageEntries 8
+
+// Pages preserved for one snapshot
+typedef struct Snapshot {
+	int id;									// Snapshot number
+	map<int, vector<Data> > dataPages;		// Blocks as they were before their first write after the snapshot
+	map<int, vector<int> > mapPages;		// Pages of the free block map before their first change ('1' for a free block)
+	map<int, vector<iNode> > dirPages;		// Pages of the directory inodes before their first change
+	vector<DirectoryTree> tree;				// Directory tree before its first insert or delete (empty if unchanged)
+	vector<SegmentLog> log;					// Log state before its first change (empty if unchanged)
+} Snapshot;
+
+/*
+ * Copy-on-write snapshots
+ *	Taking a snapshot only starts an empty page table. The first time a
+ *	block, a page of the free block map or a page of the directory is
+ *	changed after the latest snapshot, its old contents are preserved
+ *	in that snapshot. A page of an older snapshot that was not
+ *	preserved is found in the next newer snapshot that preserved it, or
+ *	is unchanged on the disk. Rollback and diff only visit preserved
+ *	pages. The free space statistics are derived from the map and the
+ *	directory, so they are rebuilt by the disk after a rollback.
+ */
+class SnapshotManager{
+	// Private variables for SnapshotManager
+	VirtualDisk* currentDisk;
+	vector<Snapshot> snapshots;		// Snapshots, oldest first
+	int nextId;						// Number of the next snapshot
+	long pagesPreserved;			// Pages copied by copy-on-write
+public:
+	// Function declarations/prototypes
+	SnapshotManager(VirtualDisk* disk);
+
+	// Snapshot methods
+	int takeSnapshot();
+	int preserveBlock(int block);
+	int preserveBlockIn(int id, int block);
+	int preserveFreeMap(int firstBlock, int numBlocks);
+	int preserveDirectory(int entry);
+	int preserveTree();
+	int preserveLog();
+	int rollback(int id);
+	int diff(int fromId, int toId);
+
+	// Utility methods
+	int findSnapshot(int id);
+	vector<Data> readBlock(int snapshotIndex, int block);
+	int findTreeCopy(int snapshotIndex);
+	vector<iNode> readDirectory(int snapshotIndex);
+	int readFreeBlocks(int snapshotIndex);
+	int restoreMetadata(int snapshotIndex);
+	set<int> getChangedBlocks(int fromIndex, int toIndex);
+	int getNumSnapshots();
+	int getLatestId();
+	long getPagesPreserved();
+};
+
+#endif
@@ -0,0 +1,375 @@
+#include "Header.h"				// Header file
+#include "VirtualDisk.h"		// VirtualDisk file
+#include "StripedVolume.h"		// StripedVolume file
+
+// Compiler Directive
+using namespace std;
+
+
+/*
+ * Contructor for StripedVolume
+ *	Sets up the member disks with the allocation method and block size
+ *	of the main disk. A linked block keeps its last entry for the
+ *	pointer, so it holds one entry of file data less.
+ *
+ */
+StripedVolume::StripedVolume(int numMembers, int unitBlocks, int method, int blockSize){
+	for (int i=0;i<numMembers;i++){
+		members.push_back(new VirtualDisk(method, blockSize));
+		// Members run in parallel, so they do not print
+		members[i]->setQuiet(true);
+	}
+	stripeUnit = unitBlocks;
+	unitEntries = unitBlocks * (method == 2 ? blockSize-1 : blockSize);
+	numOperations = 0;
+	entriesMoved = 0;
+	volumeTime = 0;
+	memberTime = 0;
+	wallTime = 0;
+	memberData.resize(numMembers);
+}
+
+StripedVolume::~StripedVolume(){
+	// Destructor, free the member disks
+	for (int i=0;i<members.size();i++){
+		delete members[i];
+	}
+}
+
+
+/*
+ * Adds a file to the volume
+ *	The file data is cut into stripe units and dealt out to the members,
+ *	then every member holding a unit adds its share at the same time.
+ *	If any member cannot take its share, the shares already added are
+ *	deleted again so the file is not left half written.
+ *
+ * Input:
+ *		fileName - Name of the file
+ *		fileContents - File data
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if the file exists or a member ran out of space
+ */
+int StripedVolume::addFile(int64_t fileName, queue<string> fileContents){
+	cout << "Adding file " << fileName << " to the striped volume (" << members.size() << " members, stripe unit of " << stripeUnit << " block(s))." << endl;
+	if (volumeDirectory.count(fileName) > 0){
+		cerr << "Error: File " << fileName << " already exists in the striped volume." << endl << endl;
+		return 0;
+	}
+	int numEntries = fileContents.size();
+	vector<queue<string> > memberContents(members.size());
+	vector<bool> active(members.size(), false);
+	for (int i=0;i<numEntries;i++){
+		// Deal the entry to the member holding its stripe unit
+		memberContents[getMember(i)].push(fileContents.front());
+		active[getMember(i)] = true;
+		fileContents.pop();
+	}
+	vector<int> results;
+	vector<double> times;
+	runOnMembers(stripeOpAdd, fileName, active, memberContents, results, times);
+	vector<bool> added(members.size(), false);
+	bool failed = false;
+	for (int i=0;i<members.size();i++){
+		added[i] = active[i] && results[i];
+		failed = failed || (active[i] && !results[i]);
+	}
+	if (failed){
+		// Undo the shares that were added
+		runOnMembers(stripeOpDelete, fileName, added, memberContents, results, times);
+		cerr << "Error: Adding of file " << fileName << " failed as a member of the striped volume is out of space." << endl << endl;
+		return 0;
+	}
+	// Record the file in the global directory
+	volumeDirectory[fileName] = numEntries;
+	cout << "Added file " << fileName << ": " << numEntries << " entries in " << (numEntries + unitEntries-1) / unitEntries << " stripe unit(s) on member(s) ";
+	for (int i=0;i<members.size();i++){
+		if (active[i]){
+			cout << i+1 << " ";
+		}
+	}
+	cout << endl;
+	recordOperation(active, times, numEntries);
+	return 1;
+}
+
+
+/*
+ * Reads a file from the volume
+ *	A whole-file read takes every member's share at the same time and
+ *	puts the stripe units back in file order. An offset read takes
+ *	that entry from the one member holding it.
+ *
+ * Input:
+ *		fileName - Name of the file
+ *		fileOffset - Entry to read, counted from 1 ('0' reads the whole file)
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if the file or the entry does not exist
+ */
+int StripedVolume::readFile(int64_t fileName, int64_t fileOffset){
+	if (volumeDirectory.count(fileName) == 0){
+		cerr << "Error: File entry " << fileName << " does not exist in the striped volume." << endl << endl;
+		return 0;
+	}
+	int numEntries = volumeDirectory[fileName];
+	vector<bool> active(members.size(), false);
+	vector<double> times(members.size(), 0);
+	if (fileOffset > 0){
+		// Offset read, only the member holding the entry is used
+		if (fileOffset > numEntries){
+			cout << "Error: File " << fileName << "(" << fileOffset << ") cannot be found on the striped volume." << endl << endl;
+			return 0;
+		}
+		int member = getMember(fileOffset-1);
+		VirtualDisk* memberDisk = members[member];
+		// Reset the access time and simulated device time of the member
+		memberDisk->beginOperation();
+		// Increment access time and charge the read to the member (Accessed memory)
+		memberDisk->accessBlock(0);
+		vector<std::span<Data> > runs = memberDisk->readRange(memberDisk->checkINode(fileName), getMemberEntry(fileOffset-1)+1, 1);
+		if (runs.empty()){
+			cout << "Error: File " << fileName << "(" << fileOffset << ") cannot be found on member " << member+1 << " of the striped volume." << endl << endl;
+			return 0;
+		}
+		// Increment access time and charge the read to the member (Accessed memory)
+		memberDisk->accessBlock(runs[0][0].block);
+		cout << "Read File " << fileName << "(" << fileOffset << ") from member " << member+1 << " of the striped volume." << endl;
+		cout << "File data: " << runs[0][0].data << endl;
+		active[member] = true;
+		times[member] = memberDisk->getDeviceTime();
+		recordOperation(active, times, 0);
+		return 1;
+	}
+	vector<queue<string> > memberContents(members.size());
+	for (int i=0;i<numEntries;i++){
+		// Count the entries each member holds
+		memberContents[getMember(i)].push("");
+		active[getMember(i)] = true;
+	}
+	vector<int> results;
+	runOnMembers(stripeOpRead, fileName, active, memberContents, results, times);
+	cout << "Read File " << fileName << " from the striped volume." << endl;
+	cout << "File data: ";
+	for (int i=0;i<numEntries;i++){
+		// Take the entry from its member, in file order
+		cout << memberData[getMember(i)][getMemberEntry(i)] << " ";
+	}
+	cout << endl;
+	recordOperation(active, times, numEntries);
+	return 1;
+}
+
+
+/*
+ * Deletes a file from the volume
+ *	Every member holding a stripe unit of the file deletes its share
+ *	at the same time.
+ *
+ * Input:
+ *		fileName - Name of the file
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if the file does not exist
+ */
+int StripedVolume::deleteFile(int64_t fileName){
+	if (volumeDirectory.count(fileName) == 0){
+		cerr << "Error: File entry " << fileName << " does not exist in the striped volume." << endl << endl;
+		return 0;
+	}
+	vector<queue<string> > memberContents(members.size());
+	vector<bool> active(members.size(), false);
+	for (int i=0;i<volumeDirectory[fileName] && i < members.size()*unitEntries;i++){
+		active[getMember(i)] = true;
+	}
+	vector<int> results;
+	vector<double> times;
+	runOnMembers(stripeOpDelete, fileName, active, memberContents, results, times);
+	volumeDirectory.erase(fileName);
+	cout << "Deleted file " << fileName << " from the striped volume." << endl;
+	recordOperation(active, times, 0);
+	return 1;
+}
+
+
+/*
+ * Runs an operation on the members at the same time
+ *	One thread is started for every active member. The members are
+ *	quiet, so only the calling thread prints.
+ *
+ * Input:
+ *		operation - stripeOpAdd, stripeOpRead or stripeOpDelete
+ *		fileName - Name of the file
+ *		active - Members that take part
+ *		memberContents - Share of the file data of each member (only the
+ *						 number of entries is used by a read)
+ *
+ * Output:
+ *		results - Return value of the operation on each member
+ *		times - Simulated device time of the operation on each member (us)
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int StripedVolume::runOnMembers(int operation, int64_t fileName, vector<bool> &active, vector<queue<string> > &memberContents, vector<int> &results, vector<double> &times){
+	results.assign(members.size(), 0);
+	times.assign(members.size(), 0);
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	vector<std::thread> threads;
+	for (int i=0;i<members.size();i++){
+		if (!active[i]){
+			continue;
+		}
+		threads.push_back(std::thread([this, i, operation, fileName, &memberContents, &results, &times](){
+			// Each thread only touches its own member disk
+			if (operation == stripeOpAdd){
+				results[i] = members[i]->addFile(fileName, memberContents[i]);
+			} else if (operation == stripeOpRead){
+				results[i] = readMember(i, fileName, memberContents[i].size());
+			} else {
+				results[i] = members[i]->deleteFile(fileName);
+			}
+			times[i] = members[i]->getDeviceTime();
+		}));
+	}
+	for (int i=0;i<threads.size();i++){
+		threads[i].join();
+	}
+	wallTime += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+	return 1;
+}
+
+
+/*
+ * Reads a member's share of a file
+ *	The entries are copied out of the member's disk data through the
+ *	spans of its range read, charging every block read to the member.
+ *
+ * Input:
+ *		member - Member disk (starting from 0)
+ *		fileName - Name of the file
+ *		numEntries - Number of entries the member holds
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if the member does not hold the file
+ */
+int StripedVolume::readMember(int member, int64_t fileName, int numEntries){
+	VirtualDisk* memberDisk = members[member];
+	memberData[member].clear();
+	// Reset the access time and simulated device time of the member
+	memberDisk->beginOperation();
+	iNode* tempDirPtr = memberDisk->checkINode(fileName);
+	// Increment access time and charge the read to the member (Accessed memory)
+	memberDisk->accessBlock(0);
+	if (!tempDirPtr){
+		return 0;
+	}
+	vector<std::span<Data> > runs = memberDisk->readRange(tempDirPtr, 1, numEntries);
+	for (int i=0;i<runs.size();i++){
+		for (int j=0;j<runs[i].size();j++){
+			memberData[member].push_back(runs[i][j].data);
+			// Increment access time and charge the read to the member (Accessed memory)
+			memberDisk->accessBlock(runs[i][j].block);
+		}
+	}
+	return 1;
+}
+
+
+/*
+ * Records the times of a volume operation and prints them
+ *	The members work at the same time, so the operation takes as long
+ *	as its slowest member.
+ *
+ * Input:
+ *		active - Members that took part
+ *		times - Simulated device time of the operation on each member (us)
+ *		numEntries - Entries moved by the operation (0 if not a whole-file transfer)
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int StripedVolume::recordOperation(vector<bool> &active, vector<double> &times, int numEntries){
+	double slowestTime = 0;
+	double totalTime = 0;
+	int numActive = 0;
+	for (int i=0;i<members.size();i++){
+		if (active[i]){
+			slowestTime = max(slowestTime, times[i]);
+			totalTime += times[i];
+			numActive++;
+		}
+	}
+	numOperations++;
+	entriesMoved += numEntries;
+	volumeTime += slowestTime;
+	memberTime += totalTime;
+	streamsize defaultPrecision = cout.precision();
+	cout << "Simulated volume time is " << fixed << setprecision(1) << slowestTime << " us (" << totalTime << " us over " << numActive << " member(s))" << endl;
+	cout << endl;
+	cout.unsetf(ios::floatfield);
+	cout.precision(defaultPrecision);
+	return 1;
+}
+
+
+/*
+ * Locates an entry of a file on the volume
+ *
+ * Input:
+ *		entry - Entry of the file (starting from 0)
+ *
+ * Returns:
+ *		getMember - Member holding the entry (starting from 0)
+ *		getMemberEntry - Entry of the member's share holding it (starting from 0)
+ */
+int StripedVolume::getMember(int entry){
+	return (entry / unitEntries) % members.size();
+}
+
+int StripedVolume::getMemberEntry(int entry){
+	return (entry / unitEntries / members.size()) * unitEntries + entry % unitEntries;
+}
+
+
+/*
+ * Getter methods for the volume layout
+ *
+ */
+int StripedVolume::getNumMembers(){
+	return members.size();
+}
+
+int StripedVolume::getStripeUnit(){
+	return stripeUnit;
+}
+
+bool StripedVolume::hasFile(int64_t fileName){
+	return volumeDirectory.count(fileName) > 0;
+}
+
+
+/*
+ * Prints the statistics of the volume
+ *	The speedup is the time the operations would take on one device
+ *	over the time they take with the members working in parallel.
+ *
+ */
+void StripedVolume::printStats(){
+	streamsize defaultPrecision = cout.precision();
+	cout << "Striped volume (" << members.size() << " members, stripe unit of " << stripeUnit << " block(s))" << endl;
+	cout << "\t> Files: " << volumeDirectory.size() << endl;
+	cout << "\t> Operations: " << numOperations << endl;
+	cout << "\t> Simulated time: " << fixed << setprecision(1) << volumeTime << " us (" << memberTime << " us over the members)" << endl;
+	cout << "\t> Speedup over one member: " << setprecision(2) << memberTime / max(volumeTime, 0.001) << endl;
+	cout << "\t> Throughput: " << entriesMoved / max(volumeTime / 1000, 0.001) << " entries/ms" << endl;
+	cout << "\t> Wall time of the parallel sections: " << setprecision(1) << wallTime << " ms" << endl;
+	cout << endl;
+	cout.unsetf(ios::floatfield);
+	cout.precision(defaultPrecision);
+}
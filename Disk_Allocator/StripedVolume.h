@@ -0,0 +1,58 @@
+// StripedVolume.h
+#ifndef STRIPEDVOLUME_H
+#define STRIPEDVOLUME_H
+#pragma once
+
+// Operations run on the members of a striped volume
+#define stripeOpAdd 1
+#define stripeOpRead 2
+#define stripeOpDelete 3
+
+/*
+ * RAID-0 striped volume over several virtual disks
+ *	A file is cut into stripe units of a fixed number of blocks, and
+ *	unit k is stored on member k % N. Each member keeps its share of
+ *	the file as a local file with the same file name, in the order of
+ *	its units. The volume keeps a global directory of file sizes, so
+ *	an entry of a file can be located on its member without asking
+ *	the others. Whole-file operations run on all members at once, one
+ *	thread per member. Members are separate devices, so the simulated
+ *	time of a volume operation is the time of its slowest member.
+ */
+class StripedVolume{
+	// Private variables for StripedVolume
+	vector<VirtualDisk*> members;			// Member disks
+	int stripeUnit;							// Blocks in a stripe unit
+	int unitEntries;						// Entries of file data in a stripe unit
+	std::map<int64_t, int> volumeDirectory;	// Global directory (file -> number of entries)
+	long numOperations;						// Volume operations completed
+	long entriesMoved;						// Entries written and read by whole-file operations
+	double volumeTime;						// Simulated time of all operations, members in parallel (us)
+	double memberTime;						// Simulated time of all operations summed over the members (us)
+	double wallTime;						// Wall time of the parallel sections (ms)
+	vector<vector<int> > memberData;		// Entries read from each member by the last whole-file read
+	int getMember(int entry);
+	int getMemberEntry(int entry);
+	int runOnMembers(int operation, int64_t fileName, vector<bool> &active, vector<queue<string> > &memberContents, vector<int> &results, vector<double> &times);
+	int readMember(int member, int64_t fileName, int numEntries);
+	int recordOperation(vector<bool> &active, vector<double> &times, int numEntries);
+public:
+	// Constructors/Destructors
+	StripedVolume(int numMembers, int unitBlocks, int method, int blockSize);
+	~StripedVolume();
+
+	// File operation methods
+	int addFile(int64_t fileName, queue<string> fileContents);
+	int readFile(int64_t fileName, int64_t fileOffset);
+	int deleteFile(int64_t fileName);
+
+	// Getter methods
+	int getNumMembers();
+	int getStripeUnit();
+	bool hasFile(int64_t fileName);
+
+	// Printing methods
+	void printStats();
+};
+
+#endif
@@ -1,1640 +1,5019 @@
-#include "Header.h"
-#include "VirtualDisk.h"		// Header file
-
-// Compiler Directive
-using namespace std;
-
-/*
- * Contructor for VirtualDisk
- *
- */
-VirtualDisk::VirtualDisk() {
-	cout << endl;
-	cout << "======================================================================" << endl;
-	cout << "   _____  _     _               _ _                 _             " << endl;
-	cout << "  |  __ \\(_)   | |        /\\   | | |               | |            " << endl;
-	cout << "  | |  | |_ ___| | __    /  \\  | | | ___   ___ __ _| |_ ___  _ __ " << endl;
-	cout << "  | |  | | / __| |/ /   / /\\ \\ | | |/ _ \\ / __/ _\\` | __/ _ \\| '__|" << endl;
-	cout << "  | |__| | \\__ \\   <   / ____ \\| | | (_) | (_| (_| | || (_) | |   " << endl;
-	cout << "  |_____/|_|___/_|\\_\\ /_/    \\_\\_|_|\\___/ \\___\\__,_|\\__\\___/|_|   " << endl;
-	cout << "                                                                  " << endl;
-	cout << "======================================================================" << endl;
-	cout << endl;
-	cout << "Welcome to your virtual disk. You have " << MAX_ELEMENTS << " entries available for use." << endl;
-	// Call methods to set up the virtual disk
-	setupDisk();
-	// Print VCB details
-	printVCB();
-	// Print virtual disk map
-	printDiskMap();
-}
-
-VirtualDisk::~VirtualDisk(){
-	// Destructor, free explicitly allocated memory 
-	delete DiskVCB;
-	delete[] DiskDir;
-	delete[] DiskData;
-}
-
-
-/*
- * Check directory structure for inode
- *	This method goes into the virtual disk's directory structure
- *	and returns a pointer to a matching file name. If no value is passed
- *	for the file name, it will search for an empty empty in the
- *	directory structure and return it. If no entry is found, return null.
- * Output:
- *		pointer to the entry in the directory structure
- *		Returns NULL if no entry is found
- */
-iNode* VirtualDisk::checkINode(int file=-1){
-	// Initialise a temp pointer to our directory structure
-	iNode* tempDirPtr = DiskDir;
-	// Loop through our directory structure
-	for (int i=0; i < DiskVCB->blockSize-1; i++){
-		// If there is a match to the passed file name
-		if (DiskDir[i].FileIdentifier == file){
-			// Return a pointer to the entry
-			return tempDirPtr;	
-		} else {
-			// If not a match, move pointer to next entry
-			tempDirPtr++;
-		}
-	}
-	// If no entry found, return null
-	return NULL;
-}
-
-
-
-
-/*
- * Update inode data in directory structure
- *	This method updates the passed inode pointer's values depending
- *	on the allocation method
- *
- *		
- */
-int VirtualDisk::updateINode(iNode* iNodeEntry, int fileName, int startValue, int endValue=-1){
-	// Update the file identifier to the passed file name
-	iNodeEntry->FileIdentifier = fileName;
-	if (allocationMethod == 1){
-		// Allocation method 1 - Contiguous
-		// Update start block and length
-		iNodeEntry->StartBlock = startValue;
-		iNodeEntry->Length = endValue;
-	} else if (allocationMethod == 2){
-		// Allocation method 2 - Linked
-		// Update start block and last block
-		iNodeEntry->StartBlock = startValue;
-		iNodeEntry->LastBlock = endValue;
-	} else if (allocationMethod == 3){
-		// Allocation method 3 - Indexed
-		// Update index block
-		iNodeEntry->Index = startValue;
-	} else if (allocationMethod == 4){
-		// Allocation method 4 - Contiguous Indexed
-		// Update index block
-		iNodeEntry->Index = startValue;
-	}
-	return 1;
-}
-
-
-
-
-/*
- * Update free space information (bit map + VCB num of free blocks)
- *	This method updates the free block information in the VCB.
- *	The bit map will be updated with the passed value, and the
- *	number of free blocks in the VCB will be changed accordingly.
- *
- */
-int VirtualDisk::updateFreeSpace(int startValue, int valueLen, int newValue=0){
-	// Check that the existing value is not the same as the passed value
-	if (DiskVCB->FreeBlockBitMap[startValue] != newValue){
-		// Loop for the passed length of the blocks to update
-		for (int i=0;i<valueLen;i++){
-			// Update the blt map value to the new value
-			DiskVCB->FreeBlockBitMap[startValue+i] = newValue;
-		}
-		if (newValue == 0){
-			// Marking blocks as used, decrease the number of free blocks in VCB
-			DiskVCB->numFreeBlock -= valueLen;
-		} else if (newValue == 1){
-			// Marking blocks as free, increase the number of free blocks in VCB
-			DiskVCB->numFreeBlock += valueLen;
-		}		
-		return 1;
-	} else {
-		// No change to the value of the free space
-		return 0;
-	}
-}
-
-
-
-
-/*
- * Requests for free blocks
- *	This method checks the free block bit map for free blocks 
- *  of a certain length, and returns the starting block if
- *  available.
- *
- * Returns:
- *		Allocated block number when completed successfully
- *		'-1' if no space available.
- */
-int VirtualDisk::requestBlocks(int numBlocks){
-	bool validBlocks = true;
-	// Check if requested block exceeds total number of free blocks
-	if (numBlocks <= DiskVCB->numFreeBlock){
-		// Check if number of blocks requested is greater than 1 (contiguous)
-		if (numBlocks > 1) {
-			// Loop through the bit map
-			for (int i=0; i < DiskVCB->FreeBlockBitMap.size();i++){
-				// If a free block is found
-				if (DiskVCB->FreeBlockBitMap[i] == 1){
-					// Loop forward the number of blocks requested
-					for (int j=1; j < numBlocks; j++){
-						// If any of the blocks in the lookahead is used
-						if (DiskVCB->FreeBlockBitMap[i+j] == 0){
-							validBlocks = false;
-							// Skip the current blocks that have already been searched
-							i += j;
-							break;
-						}
-					}
-					// If there is a contiguous block found
-					if (validBlocks){
-						// Return the starting block index
-						return i;
-					} else {
-						validBlocks = true;
-					}
-				}
-			}
-		} else {
-			// User requested for a single block
-			for (int i=0; i < DiskVCB->FreeBlockBitMap.size();i++){
-				if (DiskVCB->FreeBlockBitMap[i] == 1){
-					// If a free block is found, return the index
-					return i;
-				}
-			}
-		}
-		// If no free blocks found, return -1
-		return -1;
-	} else {
-		// If requested number of blocks exceeds total free blocks, return -1
-		return -1;
-	}
-}
-
-
-
-/*
- * Set up current disk
- *	This method intialises a new VCB for the disk, and
- *  calls all necessary methods to configure the 
- *  parameters of the virtual disk. The methods for
- *	setting up disk data and disk directories is called.
- *	The method to update free space information is also called.
- *
- * Returns:
- *		'1' when completed successfully
- *		
- */
-int VirtualDisk::setupDisk(){
-	// Initialise new VCB structure
-	DiskVCB = new VCB;
-	// Get user to input file allocation method
-	VirtualDisk::setAllocationMethod();
-	// Get user to input block size
-	VirtualDisk::setBlockSize();
-	// Initialise disk data based on block size and allocation method
-	setupDiskData();
-	// Set up directory structure
-	setupDiskDir();
-	return 1;
-}
-
-
-
-/*
- * Set up current disk data
- *	This method initialises the structures for
- *	storing data in our disk, setting the entry index,
- *	the block index based on the block size, and the
- *	default data value to -1 (empty).
- *
- * Returns:
- *		'1' when completed successfully
- *		
- */
-int VirtualDisk::setupDiskData(){
-	// Initialise new Data structure array (First block reserved for superblock)
-	DiskData = new Data[MAX_ELEMENTS-DiskVCB->blockSize];
-	for (int i=DiskVCB->blockSize; i < MAX_ELEMENTS; i++){
-		// Write the index of the data entry
-		DiskData[i-DiskVCB->blockSize].index = i;
-		// Write the block number of the data entry
-		DiskData[i-DiskVCB->blockSize].block = nearbyint(i/DiskVCB->blockSize);
-		// Write the data of the data entry as -1 (unused)
-		DiskData[i-DiskVCB->blockSize].data = -1;
-		// If allocation method is Contiguous Indexed
-		if (allocationMethod == 4){	
-			// Write the length of the data entry as -1 (unused)
-			DiskData[i-DiskVCB->blockSize].length = -1;
-		}
-	}
-	return 1;
-}
-
-
-
-
-/*
- * Set up current disk directory
- *	This method initialises the directory structure for
- *	the virtual disk.
- *
- * Returns:
- *		'1' when completed successfully
- *		
- */
-int VirtualDisk::setupDiskDir(){
-	// Initialise new iNode structure array (First entry reserved for VCB)
-	DiskDir = new iNode[DiskVCB->blockSize-1];
-	for (int i=0; i < DiskVCB->blockSize-1; i++){
-		// Write the file identifier of the inode to -1 (unused)
-		DiskDir[i].FileIdentifier = -1;
-		// Switch case to initialise respective iNODE variables
-		switch (allocationMethod){				
-			case (1): {
-				// Contiguous - Initialise and set StartBlock and Length to -1 (unused)
-				DiskDir[i].StartBlock = -1;
-				DiskDir[i].Length = -1;		
-				break;
-			}
-			case (2): {
-				// Linked - Initialise and set StartBlock and LastBlock to -1 (unused)
-				DiskDir[i].StartBlock = -1;
-				DiskDir[i].LastBlock = -1;
-				break;
-			}
-			case (3): {
-				// Indexed - Initialise and set Index to -1 (unused)
-				DiskDir[i].Index = -1;
-				break;
-			}
-			case (4): {
-				// Contiguous Indexed - Initialise and set Index to -1 (unused)
-				DiskDir[i].Index = -1;
-				break;
-			}
-		}
-	}
-	return 1;
-}
-
-
-
-
-/*
- * Sets user input for block size
- *	This method asks the user to input a block size for
- * 	the virtual disk. blockSize is intepreted to be the number of
- * 	entries in a block, and validated to be an integer that is
- *	not less than 1 (if blockSize is 1, no files can be stored), and
- *	not more than half of the available entries (minimum of 2 blocks)
- *
- * Input:
- *		Via cin 
- *
- * Returns:
- *		'1' when completed successfully
- *
- */
-int VirtualDisk::setBlockSize(){
-	int tempBlockSize;
-	cout << endl << "Please enter the size of each block: ";
-	bool valid = false;
-	while (!valid){
-		// Get user input and save it to a temp variable
-		cin >> tempBlockSize;
-		// Validate that user input is a number
-		while (!cin.good()) {
-			// User input invalid, reset input stream
-		    cin.clear();
-		    cin.ignore(INT_MAX,'\n');
-		    // Get user input again
-		    cout << "Please enter a valid block size: ";
-		    cin >> tempBlockSize;
-		}
-		// Round tempBlockSize off to nearest int
-		tempBlockSize = nearbyint(tempBlockSize);
-		// If tempBlockSize is less than 1, getUserBlockSize() again.
-		if (tempBlockSize <= 1 || tempBlockSize > MAX_ELEMENTS / 2){
-			cout << "Your specified block size of " << tempBlockSize << " has to be greater than 1 and less than " << MAX_ELEMENTS/2 << endl;
-			cout << "Please select another block size: ";
-		} else if (MAX_ELEMENTS % tempBlockSize != 0){
-		// Check for valid block size that fits into our total entries, else getUserBlockSize() again.
-			cout << "Your specified block size of " << tempBlockSize << " will result in " << MAX_ELEMENTS % tempBlockSize << " unusable entries." << endl;
-			cout << "Please select another block size: ";
-		} else {
-			valid = true;
-			// Save block size to VCB
-			DiskVCB->blockSize = tempBlockSize;
-			// Calculate and save total number of blocks to VCB
-			DiskVCB->totalBlockNum = MAX_ELEMENTS / tempBlockSize;
-			// Calculate and save total number of free blocks to VCB (first block used as superblock)
-			DiskVCB->numFreeBlock = MAX_ELEMENTS / tempBlockSize - 1;
-			// Build free space bit map
-			buildFSBitMap();
-			return 1;
-		}
-	}
-}
-
-
-
-
-/*
- * Sets user input for disk allocation method
- *	This method gives the user a list of disk allocation methods to 
- * 	choose from (Contiguous, Linked, Indexed, Contiguous Indexed). The user's 
- *	input is validated to be an integer, and must be one of the available
- *	options provided (either 1, 2, 3 or 4).
- *
- * Input:
- *		Via cin 
- *
- * Returns:
- *		'1' when completed successfully
- *
- */
-int VirtualDisk::setAllocationMethod(){
-	int userInput;
-	cout << "Please choose a disk block allocation method" << endl;
-	cout << "\t1. Contiguous Allocation" << endl;
-	cout << "\t2. Linked Allocation" << endl;
-	cout << "\t3. Indexed Allocation" << endl;
-	cout << "\t4. Contiguous Indexed Allocation" << endl;
-	cout << endl << "Allocation Method (e.g. 1): ";
-	bool valid = false;
-	// While input is not valid
-	while (!valid){
-		cin >> userInput;
-		// If input is not of type int
-		while (!cin.good()){
-			// flush the stream and prompt user to try again
-			cin.clear();
-		    cin.ignore(INT_MAX,'\n');
-	    	cout << "Please enter a valid option (e.g. 1): ";
-		    cin >> userInput;
-		}
-		// Round off value to nearest integer
-		userInput = nearbyint(userInput);
-		// If rounded number is wihin the available options
-		if (userInput >=1 && userInput <= 4){
-			// Set valid to true to exit the while loop
-			valid = true;
-			// Save input value to class variable
-			allocationMethod = userInput;
-			return 1;
-		} else {
-			// User entered invalid input type
-			cout << "Invalid input. Please enter a valid option from 1 to 4: ";
-		}
-	}
-}
-
-
-
-
-
-/*
- * Builds the free space bit map in the VCB
- *	This method goes into the virtual disk's VCB to build the
- *	free block bit map. The first block is reserved for superblock
- *	and thus marked as used. The rest of the blocks are deemed as free
- *	as this function is called on first initialisation of the disk.
- *		
- */
-int VirtualDisk::buildFSBitMap(){
-	// Mark first bit as used (superblock)
-	DiskVCB->FreeBlockBitMap.push_back(0);
-	for (int i=0;i < DiskVCB->totalBlockNum-1;i++){
-		// Mark the remaining bits as unused
-		DiskVCB->FreeBlockBitMap.push_back(1);
-	}
-}
-
-
-/*
- * Prints Volume Control Block (current disk configuration)
- *	This method prints the current virtual disk configurations 
- *
- * Output:
- *		Total entries available for the disk
- *		Block Size (Number of entries per block)
- *		Total number of blocks
- *		Number of free blocks
- *		Free block bit map
- *		Allocation Method
- *		
- */
-void VirtualDisk::printVCB(){
-	cout << endl << "Your virtual disk has been configured successfully." << endl;
-	cout << endl << "Disk Properties" << endl;
-	cout << "\t> Total entries available: " << MAX_ELEMENTS << endl;
-	cout << "\t> Block Size: " << DiskVCB->blockSize << endl;
-	cout << "\t> Total number of blocks: " << DiskVCB->totalBlockNum << endl;
-	cout << "\t> Number of free blocks: " << DiskVCB->numFreeBlock << endl;
-	//cout << "\t> Free block bit map: " << DiskVCB->FreeBlockBitMap << endl;
-	cout << "\t> Allocation Method: " << allocationMethod << " => ";
-	// Switch case to translate DiskVCB->s allocationMethod int to the respective allocation method name
-	switch (allocationMethod){				
-		case (1): {
-			cout << "Contiguous allocation" << endl;
-			break;
-		}
-		case (2): {
-			cout << "Linked allocation" << endl;
-			break;
-		}
-		case (3): {
-			cout << "Indexed allocation" << endl;
-			break;
-		}
-		case (4): {
-			cout << "Contiguous Indexed allocation" << endl;
-			break;
-		}
-	}
-	cout << endl;
-
-}
-
-
-
-
-/*
- * Prints the disk map to console
- *	This method goes through the virtual disk to print
- *	the data in the disk, then calls the method to print
- *	the free block bit map.
- *
- * Output:
- *		Block index
- *		Entry index
- *		Entry data
- *		
- */
-void VirtualDisk::printDiskMap(){
-	iNode* tempDirPtr = DiskDir;
-	cout << endl;			
-	// Print formatting of headers
-	cout << setw(printDiskMapWidth) << "Block" << setw(printDiskMapWidth) << "Index" << setw(printDiskMapWidth) << "Data" << endl;
-	// Loop for each entry in our disk
-	for (int i=0; i < MAX_ELEMENTS; i++){
-		// Print block divider for visual identification
-		if (i % DiskVCB->blockSize == 0){
-			cout << "=======================================" << endl;
-		} else {
-			// Print entry divider for visual identification
-			cout << "---------------------------------------" << endl;		
-		}
-
-		// Print Superblock (VCB + Directory Structure)
-		if (i < DiskVCB->blockSize){
-			cout << setw(printDiskMapWidth) << nearbyint(i/DiskVCB->blockSize) << setw(printDiskMapWidth) << i << setw(printDiskMapWidth);
-			if (i == 0){
-				// VCB
-				cout << DiskVCB->totalBlockNum << "," << DiskVCB->numFreeBlock << "," << DiskVCB->blockSize << ",";
-				cout << "[";
-				for (int j=0; j < DiskVCB->FreeBlockBitMap.size();j++){
-					cout << DiskVCB->FreeBlockBitMap[j];
-				}
-				cout << "]" << endl;
-			} else {
-				// Directory Structure (inodes)
-				// Switch case to translate allocationMethod int to the respective inode format
-				switch (allocationMethod){
-					case (1): {
-						// Allocation method 1 - Contiguous
-						if (tempDirPtr->FileIdentifier == -1){
-							// File identifier is -1 (unused), print '-'' instead
-							cout << "-" << endl;	
-						} else {
-							// Print file identifier, start block and length
-							cout << tempDirPtr->FileIdentifier << "," << tempDirPtr->StartBlock << "," << tempDirPtr->Length << endl;
-						}
-						tempDirPtr++;
-						break;
-					}
-					case (2): {
-						// Allocation method 2 - Linked
-						if (tempDirPtr->FileIdentifier == -1){
-							// File identifier is -1 (unused), print '-'' instead
-							cout << "-" << endl;	
-						} else {
-							// Print file identifier, start block and last block
-							cout << tempDirPtr->FileIdentifier << "," << tempDirPtr->StartBlock << "," << tempDirPtr->LastBlock << endl;
-						}
-						tempDirPtr++;
-						break;
-					}
-					case (3): {
-						// Allocation method 3 - Indexed
-						if (tempDirPtr->FileIdentifier == -1){
-							// File identifier is -1 (unused), print '-'' instead
-							cout << "-" << endl;	
-						} else {
-							// Print file identifier and index block
-							cout << tempDirPtr->FileIdentifier << "," << tempDirPtr->Index << endl;
-						}
-						tempDirPtr++;
-						break;
-					}
-					case (4): {
-						// Allocation method 4 - Contiguous Indexed
-						if (tempDirPtr->FileIdentifier == -1){
-							// File identifier is -1 (unused), print '-'' instead
-							cout << "-" << endl;	
-						} else {
-							// Print file identifier and index block
-							cout << tempDirPtr->FileIdentifier << "," << tempDirPtr->Index << endl;
-						}
-						// Move directory structure pointer to the next entry
-						tempDirPtr++;
-						break;
-					}
-				}					
-			}
-		} else{
-			// Print Disk Data
-			if (allocationMethod == 4){
-				// Allocation method 4 - Contiguous Index
-				// Set formatting and print block number and index
-				cout << setw(printDiskMapWidth) << DiskData[i-DiskVCB->blockSize].block << setw(printDiskMapWidth) << DiskData[i-DiskVCB->blockSize].index << setw(printDiskMapWidth);
-				// If data entry is not -1 (used)
-				if (DiskData[i-DiskVCB->blockSize].data != -1){
-					// If data entry length is specified (used as index block)
-					if (DiskData[i-DiskVCB->blockSize].length != -1){
-						// Print file data and length
-						cout << DiskData[i-DiskVCB->blockSize].data << "," << DiskData[i-DiskVCB->blockSize].length <<  endl;
-					} else {
-						// Print file data
-						cout << DiskData[i-DiskVCB->blockSize].data <<  endl;
-					}
-				} else {
-					// Print empty placeholder
-					cout << "-" << endl;
-				}			
-			} else {
-				// Allocation methods 1,2,3 - Contiguous, Linked, Indexed
-				// Set formatting and print block number and index
-				cout << setw(printDiskMapWidth) << DiskData[i-DiskVCB->blockSize].block << setw(printDiskMapWidth) << DiskData[i-DiskVCB->blockSize].index << setw(printDiskMapWidth);
-				// If data entry is not -1 (used)
-				if (DiskData[i-DiskVCB->blockSize].data != -1){
-					// Print file data
-					cout << DiskData[i-DiskVCB->blockSize].data<< endl;
-				} else {
-					// Print empty placeholder
-					cout << "-" << endl;
-				}			
-			}
-		}
-	}
-	// Print ending divider
-	cout << "=======================================" << endl;
-	// Call method to print the free space bit map of our disk.
-	printFreeSpaceBitMap();
-}
-
-
-
-
-/*
- * Prints the free space bit map to console
- *	This method goes into the virtual disk's VCB to access the
- *	free block bit map, then prints out the bit map to console.
- *
- * Output:
- *		Printout of free space bit map array with:
- *		'0' for a used block
- * 		'1' for a free block
- *		
- */
-void VirtualDisk::printFreeSpaceBitMap(){
-	// Print heading + number of free space / total free space
-	cout << endl << "Free space bit map ("<< DiskVCB->numFreeBlock << "/" << DiskVCB->FreeBlockBitMap.size() << ")" << endl;
-	cout << "[";
-	for (int j=0; j < DiskVCB->FreeBlockBitMap.size();j++){
-		// Print each bit of the bit map
-		cout << DiskVCB->FreeBlockBitMap[j];
-	}
-	cout << "]" << endl << endl;
-}
-
-
-
-
-
-/*
- * Adds file data to virtual disk
- *	This method checks if the requested file to be added exists in the file
- *  directory. If yes, the file will not be added. If the file does not exists,
- *	blocks will be requested to store the file on the virtual disk, and respectively
- *	saved to disk using the respective allocated methods.
- *
- * Returns:
- *		'1' when completed successfully
- *		'0' if unsuccessful
- *		
- */
-int VirtualDisk::addFile(int fileName, queue<string> fileContents){
-	int allocatedBlockStartingAddr = 0;
-	int allocatedBlock = 0;
-	int dataCount = fileContents.size();
-	int accessTime = 0;
-	// Check if file name exists in the directory structure
-	iNode* tempDirPtr = checkINode(fileName);
-	// Increment access time (Accessed memory)
-	accessTime++;
-	if (tempDirPtr){
-		// Existing file name found in directory structure
-		cout << "Adding file " << fileName << "." << endl;		
-		cout << "Error: File " << fileName << " already exists in the virtual disk." << endl << endl;
-		return 0;
-	} else {
-		// File does not exist in directory structure, request for new iNode entry in directory structure
-		tempDirPtr = checkINode();
-		// Increment access time (Accessed memory)
-		accessTime++;
-	}
-	if (tempDirPtr){
-		// iNode entry obtained successfully
-		switch (allocationMethod){				
-			case (1): {
-				// Allocation method 1 - Contiguous
-				// Calculate the number of blocks needed to store the file
-				int blocksNeeded = ceil(fileContents.size()*1.00 / DiskVCB->blockSize);
-				// Check if there is enough free blocks to support the file
-				if (ceil(fileContents.size()*1.00 / DiskVCB->blockSize) > DiskVCB->numFreeBlock){
-					// Number of blocks exceeds available number of free blocks on the virtual disk
-					cout << "Adding file " << fileName << "." << endl;		
-					cout << "Error: File "<< fileName <<"'s size exceeds available space on the virtual disk." << endl << endl;
-					return 0;
-				}
-				// Request for contiguous chunk of blocks
-				allocatedBlock = requestBlocks(blocksNeeded);
-				// Check if allocation was successful
-				if (allocatedBlock != -1){
-					// Contiguous block available
-					cout << "Adding file " << fileName << " and found free block starting at " << allocatedBlock << endl;
-					// Calculate the position of the block in disk data
-					allocatedBlockStartingAddr = (allocatedBlock*DiskVCB->blockSize) - DiskVCB->blockSize;
-					cout << "Added file " << fileName << " at ";
-					// Loop through every entry of the file
-					for(int i=0;i < dataCount;i++){
-						if (i % DiskVCB->blockSize == 0){
-							// Printing of allocation block number
-							cout << "B" << DiskData[allocatedBlockStartingAddr+i].block << "(";
-							cout << fileContents.front();
-							if(fileContents.size() > 1){
-								cout << ",";
-							} else {
-								cout << ") ";
-							}
-						} else {
-							// Printing of file content
-							cout << fileContents.front();
-							if(fileContents.size() > 1 && i % DiskVCB->blockSize != DiskVCB->blockSize-1){
-								cout << ",";
-							} else {
-								cout << ") ";
-							}
-						}
-						// Write file entry to disk data
-						DiskData[allocatedBlockStartingAddr+i].data = stoi(fileContents.front());
-						// Increment access time (Accessed memory)
-						accessTime++;
-						// Delete file entry from the queue
-						fileContents.pop();
-					}
-					// Update the file's inode in the directory structure
-					updateINode(tempDirPtr, fileName, allocatedBlock, blocksNeeded);
-					// Increment access time (Accessed memory)
-					accessTime++;
-					// Update the free space bit map and number of free blocks
-					updateFreeSpace(allocatedBlock, blocksNeeded);					
-					// Increment access time (Accessed memory)
-					accessTime++;
-				} else {
-					// No contiguous block available
-					cout << "No available space in disk found." << endl;
-					return 0;
-				}
-				cout << endl;
-				break;
-			}
-			case (2): {
-				// Allocation Method 2 - Linked
-				// Calculate the number of blocks needed to store the file and if there is enough free blocks to support the file
-				if (ceil(fileContents.size()*1.00 / (DiskVCB->blockSize-1)) > DiskVCB->numFreeBlock){
-					// Number of blocks exceeds available number of free blocks on the virtual disk
-					cout << "Adding file " << fileName << "." << endl;
-					cout << "Error: File "<< fileName <<"'s size exceeds available space on the virtual disk." << endl;
-					return 0;
-				}
-				int firstAllocatedBlock;
-				for(int i=0; i < dataCount; i++){
-					if (fileContents.size() != 0){
-						if (fileContents.size() == dataCount){
-							// Request 1 block as head of linked list
-							allocatedBlock = requestBlocks(1);
-							// Save the head block
-							firstAllocatedBlock = allocatedBlock;
-							cout << "Adding file " << fileName << " and found free block starting at " << firstAllocatedBlock << endl;
-							cout << "Added file " << fileName << " at ";		
-							if (allocatedBlock != -1){
-								// If allocation successful, update free space bit map
-								updateFreeSpace(allocatedBlock, 1);
-								// Increment access time (Accessed memory)
-								accessTime++;
-								// Calculate the position of the block in the disk data
-								allocatedBlockStartingAddr = (allocatedBlock*DiskVCB->blockSize) - DiskVCB->blockSize;
-								cout << "B" << allocatedBlock << "(";
-							} else {
-								// No blocks allocated
-								cout << "No available space in disk found." << endl;
-								return 0;
-							}
-						}
-						if (allocatedBlock != -1){
-							// Print the file entry
-							cout << fileContents.front();
-							if(fileContents.size() > 1 && i % (DiskVCB->blockSize-1) != DiskVCB->blockSize-2){
-								cout << ",";
-							} else {
-								cout << ") ";
-							}
-							// Write file entry to disk data
-							DiskData[allocatedBlockStartingAddr+(i % (DiskVCB->blockSize-1))].data = stoi(fileContents.front());
-							// Increment access time (Accessed memory)
-							accessTime++;
-							// Delete file entry from the queue
-							fileContents.pop();
-						} else {
-							// No block available
-							cout << "No available space in disk found." << endl;
-							return 0;
-						}		
-						if(i % (DiskVCB->blockSize-1) == DiskVCB->blockSize-2 && fileContents.size() != 0){
-							// Before reaching the last entry of the block, request for the next block to set the next block pointer
-							allocatedBlock = requestBlocks(1);
-							if (allocatedBlock != -1){
-								// Write the next block pointer to disk data
-								DiskData[allocatedBlockStartingAddr+(i % (DiskVCB->blockSize-1))+1].data = allocatedBlock;
-								// Increment access time (Accessed memory)
-								accessTime++;
-								// Update free space bit map
-								updateFreeSpace(allocatedBlock, 1);
-								// Calculate offset of the next block in the disk data
-								allocatedBlockStartingAddr = (allocatedBlock*DiskVCB->blockSize) - DiskVCB->blockSize;
-								cout << "B" << allocatedBlock << "(";
-							}
-						}
-					}
-				}
-				// Update the file's inode in the directory structure
-				updateINode(tempDirPtr, fileName, firstAllocatedBlock, allocatedBlock);
-				// Increment access time (Accessed memory)
-				accessTime++;
-				cout << endl;
-				break;
-			}
-			case (3): {
-				// Allocation method 3 - Indexed
-				// Calculate the number of blocks needed to store the file and if there is enough free blocks to support the file
-				if ((ceil(fileContents.size() > DiskVCB->blockSize*DiskVCB->blockSize)) || ((fileContents.size()/ DiskVCB->blockSize)+1) > DiskVCB->numFreeBlock){
-					cout << "Adding file " << fileName << "." << endl;		
-					cout << "Error: File "<< fileName <<"'s size exceeds available space on the virtual disk." << endl << endl;
-					return 0;
-				}
-				int indexBlock = 0;
-				if(dataCount == fileContents.size()){
-					// Request for indx block
-					indexBlock = requestBlocks(1);
-					// Increment access time (Accessed memory)
-					accessTime++;
-					// Update free space bit map
-					updateFreeSpace(indexBlock, 1);
-				}
-				int firstAllocatedBlock = 0;
-				// Loop for every file entry
-				for(int i=0; i < dataCount; i++){
-					if (fileContents.size() != 0){
-						// For every new block of data
-						if(i % DiskVCB->blockSize == 0){
-							// Request for one block
-							allocatedBlock = requestBlocks(1);
-							// Increment access time (Accessed memory)
-							accessTime++;
-							if (allocatedBlock != -1){
-								// Calculate position of current block in disk data
-								allocatedBlockStartingAddr = (indexBlock*DiskVCB->blockSize) - DiskVCB->blockSize;
-								// Save data block to index block
-								DiskData[allocatedBlockStartingAddr+(i / DiskVCB->blockSize)].data = allocatedBlock;
-								// Increment access time (Accessed memory)
-								accessTime++;
-								// Update free block bit map
-								updateFreeSpace(allocatedBlock, 1);
-								if (dataCount == fileContents.size()){
-									// Save first allocated block
-									firstAllocatedBlock = allocatedBlock;
-									cout << "Adding file " << fileName << " and found free block starting at " << firstAllocatedBlock << endl;
-									cout << "Added file " << fileName << " at ";		
-								}
-								// Calculate position of allocated block in disk data
-								allocatedBlockStartingAddr = (allocatedBlock*DiskVCB->blockSize) - DiskVCB->blockSize;
-								cout << "B" << allocatedBlock << "(";
-							} else {
-								cout << "No available space in disk found." << endl;
-								return 0;
-							}
-						}
-						if (allocatedBlock != -1){
-							// Print file entry
-							cout << fileContents.front();
-							if(fileContents.size() > 1 && i % DiskVCB->blockSize != DiskVCB->blockSize-1){
-								cout << ",";
-							} else {
-								cout << ") ";
-							}
-							// Write file entry to disk data
-							DiskData[allocatedBlockStartingAddr+(i % DiskVCB->blockSize)].data = stoi(fileContents.front());
-							// Increment access time (Accessed memory)
-							accessTime++;
-							// Delete file entry from the queue
-							fileContents.pop();
-						} else {
-							cout << "No available space in disk found." << endl;
-							return 0;
-						}
-					}
-				}
-				cout << endl;
-				// Update the file's inode in the directory structure
-				updateINode(tempDirPtr, fileName, indexBlock);
-				// Increment access time (Accessed memory)
-				accessTime++;
-				break;
-			}
-			case (4): {
-				// Allocation method 4 - Contiguous Indexed
-				// Calculate total number of blocks needed
-				int blocksNeeded = ceil(fileContents.size()*1.00 / DiskVCB->blockSize);
-				// Check if there is enough free blocks to support the file (total blocks needed + 1 index block)
-				if(blocksNeeded+1 > DiskVCB->numFreeBlock){
-					cout << "Adding file " << fileName << "." << endl;		
-					cout << "Error: File "<< fileName <<"'s size exceeds available space on the virtual disk." << endl << endl;
-					return 0;
-				} else {
-					// Request index block
-					int indexBlock = requestBlocks(1);
-					// Increment access time (Accessed memory)
-					accessTime++;
-					int entriesUsed = 0;
-					std::map<int, int> blocksToUse;
-					// Update free space bit map
-					updateFreeSpace(indexBlock, 1);
-					int tempBlockNum = blocksNeeded;
-					// Preprocess blocks needed for the file
-					while (tempBlockNum > 0 && blocksNeeded > 0){
-						// Get the chunks of blocks necessary for the file
-						if(entriesUsed == DiskVCB->blockSize){
-							// File entries exceeded index block capacity
-							cout << "Error: File "<< fileName <<"'s size exceeds available space on the virtual disk." << endl << endl;
-							// Release reserved blocks if allocation failed - Index block
-							updateFreeSpace(indexBlock,1,1);
-							int tempBlock, tempLength;
-							while(blocksToUse.empty() == false){
-								// Get block index
-								tempBlock = blocksToUse.begin()->first;
-								// Get block length
-								tempLength = blocksToUse.begin()->second;
-								// Release reserved blocks - File data blocks
-								updateFreeSpace(tempBlock, tempLength, 1);
-								// Delete the block data from our map
-								blocksToUse.erase(blocksToUse.begin());
-							}
-							return 0;
-						}
-						// Request a contiguous chunk of blocks
-						allocatedBlock = requestBlocks(tempBlockNum);
-						// Increment access time (Accessed memory)
-						accessTime++;
-						if(allocatedBlock == -1){
-							// If no available chunk of blocks of the size, decrement the number
-							tempBlockNum--;
-						} else {
-							// Update free space bit map with allocated chunk of blocks
-							updateFreeSpace(allocatedBlock, tempBlockNum);
-							// Insert the allocated block and length of the blocks into the map
-							blocksToUse.insert(std::pair<int,int>(allocatedBlock, tempBlockNum));
-							blocksNeeded -= tempBlockNum;
-							tempBlockNum = blocksNeeded;
-							entriesUsed++;
-						}
-					}
-					// File can be supported on the virtual disk.
-					int blockLen = 0;
-					int indexBlockOffset = 0;
-					cout << "Adding file " << fileName << " with index block at " << indexBlock << endl;
-					cout << "Added file " << fileName << " at ";
-					// Proceed to save to disk data
-					while(blocksToUse.empty() == false){
-						// Get the first allocated block number
-						allocatedBlock = blocksToUse.begin()->first;
-						// Get the first length of the block
-						blockLen = blocksToUse.begin()->second;
-						// Calculate position of allocated block in disk data
-						allocatedBlockStartingAddr = (allocatedBlock*DiskVCB->blockSize) - DiskVCB->blockSize;
-						// Loop for totol length of the blocks
-						for(int i=0;i < (blockLen*DiskVCB->blockSize);i++){
-							if (fileContents.size() != 0){
-								// For every new 'block'
-								if (i % DiskVCB->blockSize == 0){
-									// Print block details
-									cout << "B" << DiskData[allocatedBlockStartingAddr+i].block << "(";
-									cout << fileContents.front();
-									if(fileContents.size() > 1){
-										cout << ",";
-									} else {
-										cout << ") ";
-									}
-								} else {
-									// Print file data
-									cout << fileContents.front();
-									if(fileContents.size() > 1 && i % DiskVCB->blockSize != DiskVCB->blockSize-1){
-										cout << ",";
-									} else {
-										cout << ") ";
-									}
-								}
-								// Write file entry to disk data
-								DiskData[allocatedBlockStartingAddr+i].data = stoi(fileContents.front());
-								// Increment access time (Accessed memory)
-								accessTime++;
-								// Delete file entry from the queue
-								fileContents.pop();
-							}
-						}
-						// Save the block number into index block
-						DiskData[(indexBlock*DiskVCB->blockSize)-DiskVCB->blockSize+indexBlockOffset].data = allocatedBlock;
-						// Increment access time (Accessed memory)
-						accessTime++;
-						// Save the block length into index block
-						DiskData[(indexBlock*DiskVCB->blockSize)-DiskVCB->blockSize+indexBlockOffset].length = blockLen;
-						// Increment access time (Accessed memory)
-						accessTime++;
-						// Increment index block offset
-						indexBlockOffset++;
-						// Delete the block data from our map
-						blocksToUse.erase(allocatedBlock);
-					}
-					// Update the file's inode in the directory structure
-					updateINode(tempDirPtr, fileName, indexBlock);
-					// Increment access time (Accessed memory)
-					accessTime++;
-				}
-				cout << endl;
-				break;
-			}
-		}	
-		cout << "Total access time (accesses to memory) is " << accessTime << endl << endl;	
-		return 1;
-	} else {
-		cout << "Adding file " << fileName << "." << endl;		
-		cout << "Error: File system unable to support any more files." << endl << endl;
-		return 0;
-	}
-}
-
-
-
-
-/*
- * Reads file data from virtual disk
- *	This method checks if the requested file to be read exists in the file
- *  directory. If yes, the file will be read. If the file does not exists,
- *	an error is printed and the method ends.
- *
- * Returns:
- *		'1' when completed successfully
- *		'0' if unsuccessful
- *		
- */
-int VirtualDisk::readFile(int fileName){
-	int accessTime = 0;
-	// Get main file name by deducting the remainder of the modulus of 100
-	int mainFileID = fileName - (fileName % 100);
-	// Get the file offset within the file
-	int fileOffset = fileName % 100;
-	// Check if file name exists in the directory structure
-	iNode* tempDirPtr = checkINode(mainFileID);
-	// Increment access time (Accessed memory)
-	accessTime++;
-	if (tempDirPtr){
-		// File found
-		switch (allocationMethod){				
-			case (1): {
-				// Allocation method 1 - Contiguous
-				if(fileOffset > 0){
-					// File data entry selected
-					cout << "Read File " << mainFileID << "(" << fileName << ")" << " from virtual disk." << endl;
-					if(fileOffset <= tempDirPtr->Length * DiskVCB->blockSize){
-						// Calculate direct position of the entry in disk data
-						int tempAddr = (tempDirPtr->StartBlock * DiskVCB->blockSize)-DiskVCB->blockSize+fileOffset-1;
-						if(DiskData[tempAddr].data != -1){
-							// If there is data at the entry, print the data entry details
-							cout << "Located at block: " << DiskData[tempAddr].block << ", index: " << DiskData[tempAddr].index << " with data: " << DiskData[tempAddr].data << endl;
-						} else {
-							// No data found, print error message and exit method
-							cout << "Error: File " << mainFileID << "(" << fileName << ") cannot be found on the virtual disk." << endl << endl;
-							return 0;
-						}
-						// Increment access time (Accessed memory)
-						accessTime++;
-					} else {
-						// File offset is out of allocated boundaries, print error and exit method
-						cout << "Error: File " << mainFileID << "(" << fileName << ") cannot be found on the virtual disk." << endl << endl;
-						return 0;
-					}
-
-				} else {
-					// Direct file number given (print whole file)
-					cout << "Read File " << fileName << " from virtual disk." << endl;
-					cout << "File " << mainFileID << " is stored from block " << tempDirPtr->StartBlock << " to " << tempDirPtr->StartBlock + tempDirPtr->Length-1 << "." << endl;
-					cout << "File data: ";
-					// Calculate direct starting position of the block
-					int tempAddr = (tempDirPtr->StartBlock * DiskVCB->blockSize)-DiskVCB->blockSize;
-					for(int i=0;i< tempDirPtr->Length*DiskVCB->blockSize;i++){
-						// Loop through the entries in the blocks
-						if (DiskData[tempAddr+i].data != -1){
-							// If there is data at the entry, print the data entry details
-							cout << DiskData[tempAddr+i].data << " ";
-						}
-						// Increment access time (Accessed memory)
-						accessTime++;
-					}
-					cout << endl;
-				}
-				break;
-			}
-			case (2): {
-				// Allocation method 2 - Linked
-				if(fileOffset > 0){				
-					// Print data entry
-					cout << "Read File " << mainFileID << "(" << fileName << ")" << " from virtual disk." << endl;
-					// Calculate direct position of starting 'head' block in disk data
- 					int tempAddr = (tempDirPtr->StartBlock * DiskVCB->blockSize)-DiskVCB->blockSize;
- 					// Calcualte the number of blocks to jump ahead based on the offset
-					int jumps = floor((fileOffset-1) / (DiskVCB->blockSize-1));
-					for (int i=0;i<jumps;i++){
-						// Jump ahead (reduce unnecessary accesses to memory)
-						if(DiskData[tempAddr].block != tempDirPtr->LastBlock){
-							// Calculate offset of the next block directly
-							tempAddr = ((DiskData[tempAddr+(DiskVCB->blockSize-1)].data) * DiskVCB->blockSize) - DiskVCB->blockSize;
-							// Update the remaining number of offsets
-							fileOffset -= (DiskVCB->blockSize-1);
-						} else {
-							if(i < jumps){
-								// Current block is the last block specified in the inode but we have more jumps to do, print error and exit method.
-								cout << "Error: File " << mainFileID << "(" << fileName << ") cannot be found on the virtual disk." << endl << endl;
-								return 0;								
-							}
-						}
-						// Increment access time (Accessed memory)
-						accessTime++;
-					}
-					// Target block found, add the remaining offset within the block 
-					tempAddr += fileOffset-1;
-					if (DiskData[tempAddr].data == -1){
-						// No data found, print error and exit method
-						cout << "Error: File " << mainFileID << "(" << fileName << ") cannot be found on the virtual disk." << endl << endl;
-						return 0;
-					} else {
-						// Entry has data, print data entry details
-						cout << "Located at block: " << DiskData[tempAddr].block << ", index: " << DiskData[tempAddr].index << " with data: " << DiskData[tempAddr].data << endl;
-					}
-					// Increment access time (Accessed memory)
-					accessTime++;
-				} else {
-					// Direct file number given (print whole file)
-					cout << "Read File " << fileName << " from virtual disk." << endl;
-					cout << "File " << mainFileID << " starts at block " << tempDirPtr->StartBlock << " and ends at block " << tempDirPtr->LastBlock << "." << endl;
-					cout << "File data: ";
-					// Calculate direct position of starting 'head' block in disk data
-					int tempAddr = (tempDirPtr->StartBlock * DiskVCB->blockSize)-DiskVCB->blockSize;
-					// Initialise internal block offset
-					int offset = 0;
-					// While data entry is not empty
-					while (DiskData[tempAddr+offset].data != -1){
-						// At every last entry of the block, get next block info
-						if (offset > 0 && (offset % (DiskVCB->blockSize)) == (DiskVCB->blockSize-1)){
-							// Calculate direct position of the next block
-							tempAddr = (DiskData[tempAddr+offset].data * DiskVCB->blockSize)-DiskVCB->blockSize;
-							// Reset internal block offset 
-							offset = 0;
-						} else {
-							// Print data entry details
-							cout << DiskData[tempAddr+offset].data << " ";
-							// Increment internal block offset
-							offset++;
-						}
-						// Increment access time (Accessed memory)
-						accessTime++;
-					}
-					cout << endl;
-				}
-				break;
-			}
-			case (3): {
-				// Allocation method 3 - Indexed
-				int indexBlockStartingAddr = 0;
-				if(fileOffset > 0){
-					// File data entry selected
-					cout << "Read File " << mainFileID << "(" << fileName << ")" << " from virtual disk." << endl;
-					// Calculate number of offset within index block
-					int jumps = floor((fileOffset-1)/DiskVCB->blockSize);
-					// Update remaining offset within data block
-					fileOffset -= (jumps*DiskVCB->blockSize)+1;
-					// Calculate direct position of index block in disk data
- 					indexBlockStartingAddr = ((tempDirPtr->Index)*DiskVCB->blockSize)-DiskVCB->blockSize;
- 					// If jumps required within index block is greater than number of entries in it
-					if(jumps > DiskVCB->blockSize){
-						// File offset is out of allocated boundaries of index block, print error and exit method
-						cout << "Error: File " << mainFileID << "(" << fileName << ") cannot be found on the virtual disk." << endl << endl;
-						return 0;
-					} else {
-						// Valid number of jumps within index block
-						if(DiskData[indexBlockStartingAddr+jumps].data == -1){
-							// Selected entry in index block is empty, prin error and exit method
-							cout << "Error: File " << mainFileID << "(" << fileName << ") cannot be found on the virtual disk." << endl << endl;
-							return 0;
-						} else {
-							// Entry in index block has data, save the block number
-							int tempBlock = DiskData[indexBlockStartingAddr+jumps].data;
-							// Calculate direct position of the block in disk data
-							int tempAddr = (tempBlock*DiskVCB->blockSize)-DiskVCB->blockSize+fileOffset;
-							if(DiskData[tempAddr].data != -1){
-								// File entry has data, print disk data details
-								cout << "Located at block: " << DiskData[tempAddr].block << ", index: " << DiskData[tempAddr].index << " with data: " << DiskData[tempAddr].data << endl;
-							} else {
-								// Selected offset in data block is empty, print error and exit method
-								cout << "Error: File " << mainFileID << "(" << fileName << ") cannot be found on the virtual disk." << endl << endl;
-								return 0;
-							}
-							// Increment access time (Accessed memory)
-							accessTime++;
-						}
-						// Increment access time (Accessed memory)
-						accessTime++;
-					}
-				} else {
-					// Direct file number given (print whole file)
-					int allocatedBlockStartingAddr = 0;
-					queue<int> indexNumbers;
-					// Calculate direct position of index block in disk data
-					indexBlockStartingAddr = ((tempDirPtr->Index - 1)*DiskVCB->blockSize);
-					// Increment access time (Accessed memory)
-					accessTime++;
-					for (int i = 0; i < DiskVCB->blockSize; i++){
-						// Go through each entry in the index block
-						if(DiskData[indexBlockStartingAddr + i].data != -1){
-							// Index block entry has data, push block number to queue
-							indexNumbers.push(DiskData[indexBlockStartingAddr + i].data);
-						}
-						// Increment access time (Accessed memory)
-						accessTime++;
-					}
-					cout << "Read File " << fileName << " from virtual disk." << endl;
-					cout << "File " << mainFileID << "\'s index block is at block " << tempDirPtr->Index << "." << endl;
-					cout << "File data: ";
-					// Process every entry in the queue
-					while(indexNumbers.size() > 0){
-						// Calculate direct position of the first block in the front of the queue
-						allocatedBlockStartingAddr = (((indexNumbers.front()-1)*DiskVCB->blockSize)+1);
-						// Loop through each entry in the block
-						for(int i = 0; i < DiskVCB->blockSize; i++){
-							if (DiskData[allocatedBlockStartingAddr+i-1].data != -1){
-								// Print data entry details
-								cout << DiskData[(allocatedBlockStartingAddr+i-1)].data << " ";
-							}
-							// Increment access time (Accessed memory)
-							accessTime++;
-						}
-						// Remove ('dequeue') first item from the queue
-						indexNumbers.pop();
-					}
-					cout << endl;
-				}
-				break;
-			}
-			case (4): {
-				// Allocation method 4 - Contiguous indexed
-				int indexBlockStartingAddr = 0;
-				if(fileOffset > 0){
-					// File data entry selected
-					cout << "Read File " << mainFileID << "(" << fileName << ")" << " from virtual disk." << endl;
-					// Calculate number of blocks required to jump ahead to the offset
-					int jumps = floor((fileOffset-1)/DiskVCB->blockSize);
-					// Update new offset within data block
-					fileOffset -= (jumps*DiskVCB->blockSize)+1;
-					// Set start of index block
- 					indexBlockStartingAddr = ((tempDirPtr->Index)*DiskVCB->blockSize)-DiskVCB->blockSize;
-					// Increment access time (Accessed memory)
-					accessTime++;
- 					// Set offset within index block
- 					int indexBlockOffset = 0;
- 					while(jumps > 0){
-						// If number of jumps is greater than current entry's length in index block
-						if(jumps - DiskData[indexBlockStartingAddr+indexBlockOffset].length >= 0){
-							// Deduct the number of jumps required
-	 						jumps -= DiskData[indexBlockStartingAddr+indexBlockOffset].length; 						
-						} else {
-							// Our data entry is within this index block entry
-							break;
-						}
-						// Increment access time (Accessed memory)
-						accessTime++;
-						// Move pointer to the next entry in the index block
-						indexBlockOffset++;
- 						if(indexBlockOffset > DiskVCB->blockSize-1){
- 							// If we moved out of the index block's limits, return error and exit method.
- 							cout << "Error: File " << mainFileID << "(" << fileName << ") cannot be found on the virtual disk." << endl << endl;
-							return 0;
- 						}
- 					}
- 					// Calculate direct position to the tart of the target contiguous block
- 					int tempBlockAddr = (DiskData[indexBlockStartingAddr+indexBlockOffset].data*DiskVCB->blockSize)-DiskVCB->blockSize;
-					// Increment access time (Accessed memory)
-					accessTime++;
- 					//Calculate offset within the contiguous block
- 					fileOffset += (jumps*DiskVCB->blockSize);
- 					if(fileOffset > (DiskData[indexBlockStartingAddr+indexBlockOffset].length*DiskVCB->blockSize)-1){
- 						// Entry requested is out of bounds of the blocks, return error and exit method
- 						cout << "Error: File " << mainFileID << "(" << fileName << ") cannot be found on the virtual disk." << endl << endl;
-						return 0;
- 					}
-					// Increment access time (Accessed memory)
-					accessTime++;
- 					if(DiskData[tempBlockAddr+fileOffset].data != -1){
- 						// Print data entry details
-						cout << "Located at block: " << DiskData[tempBlockAddr+fileOffset].block << ", index: " << DiskData[tempBlockAddr+fileOffset].index << " with data: " << DiskData[tempBlockAddr+fileOffset].data << endl;
- 					} else {
- 						// File entry is empty, print error and exit method.
- 						cout << "Error: File " << mainFileID << "(" << fileName << ") cannot be found on the virtual disk." << endl << endl;
- 						return 0;
- 					}
-					// Increment access time (Accessed memory)
-					accessTime++;
-				} else {
-					// Direct file number given (print whole file)
-					int allocatedBlockStartingAddr = 0;
-					// Initialise a queue of data pairs
-					queue<std::pair<int,int> > indexNumbers;
-					// Calculate direct position of index block in disk data
-					indexBlockStartingAddr = ((tempDirPtr->Index - 1)*DiskVCB->blockSize);
-					// Increment access time (Accessed memory)
-					accessTime++;
-					// Loop through each entry in the index block
-					for (int i = 0; i < DiskVCB->blockSize; i++){
-						if(DiskData[indexBlockStartingAddr + i].data != -1){
-							// Push the block and length as a pair into the queue
-							indexNumbers.push(std::pair<int,int>(DiskData[indexBlockStartingAddr + i].data, DiskData[indexBlockStartingAddr + i].length));
-						}
-						// Increment access time (Accessed memory)
-						accessTime++;
-					}
-					cout << "Read File " << fileName << " from virtual disk." << endl;
-					cout << "File " << mainFileID << "\'s index block is at block " << tempDirPtr->Index << "." << endl;
-					cout << "File data: ";
-					// Process every entry in the queue
-					while(indexNumbers.size() > 0){
-						// Calculate direct position of the first block in the front of the queue
-						allocatedBlockStartingAddr = (((indexNumbers.front().first-1)*DiskVCB->blockSize)+1);
-						for(int i = 0; i < indexNumbers.front().second*DiskVCB->blockSize; i++){
-							// Loop through each entry in the block
-							if (DiskData[allocatedBlockStartingAddr+i-1].data != -1){
-								// Print data entry details
-								cout << DiskData[(allocatedBlockStartingAddr+i-1)].data << " ";
-							}
-							// Increment access time (Accessed memory)
-							accessTime++;
-						}
-						// Remove ('dequeue') first item from the queue
-						indexNumbers.pop();
-					}
-					cout << endl;
-				}
-				break;
-			}
-		}
-		cout << "Total access time (accesses to memory) is " << accessTime << endl << endl;	
-		return 1;
-	} else {
-		// File not found in the directory structure, print error and exit method
-		cout << "Read File " << mainFileID << "(" << fileName << ")" << " from virtual disk." << endl;
-		cerr << "Error: File entry "<< mainFileID << "(" << fileName << ")" << " does not exist in the virtual disk." << endl << endl;
-		return 0;
-	}
-	return 1;
-}
-
-
-
-
-/*
- *  Deletes file data from virtual disk
- *	This method checks if the requested file to be deleted exists in the file
- *  directory. If yes, the file will be deleted. If the file does not exists,
- *	an error is printed and the method ends.
- *
- * Returns:
- *		'1' when completed successfully
- *		'0' if unsuccessful
- *		
- */
-int VirtualDisk::deleteFile(int fileName){
-	int accessTime = 0;
-	iNode* tempDirPtr;
-	// Check if file name exists in the directory structure
-	tempDirPtr = checkINode(fileName);
-	// Increment access time (Accessed memory)
-	accessTime++;
-	if (tempDirPtr){
-		// File found
-		switch (allocationMethod){				
-			case (1): {
-				// Allocation method 1 - Contiguous
-				cout << "Deleting File " << fileName << " from virtual disk." << endl;
-				cout << "Deleted File " << fileName << " from virtual disk and freed ";
-				// Calculate direct position of the block in disk data  
-				int tempAddr = (tempDirPtr->StartBlock * DiskVCB->blockSize)-DiskVCB->blockSize;
-				// Increment access time (Accessed memory)
-				accessTime++;
-				for(int i=0;i< tempDirPtr->Length*DiskVCB->blockSize;i++){
-					// Loop through all entries in the contiguous blocks
-					if (i % DiskVCB->blockSize == 0){
-						// Print block number
-						cout << "B" << DiskData[tempAddr+i].block << " ";
-					}
-					if (DiskData[tempAddr+i].data != -1){
-						// If there is data in the entry, set to -1 (unused)
-						DiskData[tempAddr+i].data = -1;
-					}
-					// Increment access time (Accessed memory)
-					accessTime++;
-				}
-				// Update the free space bit map + number of free blocks
-				updateFreeSpace(tempDirPtr->StartBlock, tempDirPtr->Length, 1);
-				// Update the inode in directory structure to -1 (unused)
-				updateINode(tempDirPtr,-1,-1);
-				// Increment access time (Accessed memory)
-				accessTime++;
-				cout << endl;
-				break;
-			}
-			case (2): {
-				// Allocation method 2 - Linked
-				cout << "Deleting File " << fileName << " from virtual disk." << endl;
-				cout << "Deleted File " << fileName << " from virtual disk and freed ";
-				// Calculate direct position of the block in disk data
-				int tempAddr = (tempDirPtr->StartBlock * DiskVCB->blockSize)-DiskVCB->blockSize;
-				// Increment access time (Accessed memory)
-				accessTime++;
-				int offset = 0;
-				int tempBlock = 0;
-				// While data entry is not empty
-				while (DiskData[tempAddr+offset].data != -1){
-					// At every last entry of the block
-					if ((offset % (DiskVCB->blockSize)) == (DiskVCB->blockSize-1)){
-						// Print block number
-						cout << "B" << DiskData[tempAddr+offset].block << " ";
-						// Update the free space bit map + number of free blocks
-						updateFreeSpace(DiskData[tempAddr+offset].block, 1, 1);
-						// Get next block number
-						tempBlock = tempAddr+offset;
-						// Calculate direct position of the next block in disk data
-						tempAddr = (DiskData[tempAddr+offset].data * DiskVCB->blockSize)-DiskVCB->blockSize;
-						// Delete the entry in the current block
-						DiskData[tempBlock].data = -1;
-						// Reset internal offset within the block
-						offset = 0;
-					} else {
-						// If there is data in the entry, set to -1 (unused)
-						DiskData[tempAddr+offset].data = -1;
-						// Increase internal offset within the block
-						offset++;
-					}
-					// Increment access time (Accessed memory)
-					accessTime++;
-
-				}
-				// Print block number
-				cout << "B" << DiskData[tempAddr+offset].block << " ";
-				// Update the free space bit map + number of free blocks
-				updateFreeSpace(DiskData[tempAddr+offset].block, 1, 1);
-				// Update the inode in directory structure to -1 (unused)
-				updateINode(tempDirPtr,-1,-1);
-				// Increment access time (Accessed memory)
-				accessTime++;
-				cout << endl;
-				break;
-			}
-			case (3): {
-				// Allocation method 3 - Indexed
-				cout << "Deleting File " << fileName << " from virtual disk." << endl;
-				cout << "Deleted File " << fileName << " from virtual disk and freed ";
-				// Direct file number
-				int indexBlockStartingAddr = 0;
-				int allocatedBlockStartingAddr = 0;
-				queue<int> indexNumbers;
-				// Calculate direct position of index block in disk data
-				indexBlockStartingAddr = ((tempDirPtr->Index - 1)*DiskVCB->blockSize);
-				// Increment access time (Accessed memory)
-				accessTime++;
-				for (int i = 0; i < DiskVCB->blockSize; i++){
-					// Go through each entry in the index block
-					if(DiskData[indexBlockStartingAddr + i].data != -1){
-						// Index block entry has data, push block number to queue
-						indexNumbers.push(DiskData[indexBlockStartingAddr + i].data);
-
-						DiskData[indexBlockStartingAddr+i].data = -1;
-					}
-					// Increment access time (Accessed memory)
-					accessTime++;
-				}
-				cout << "B" << DiskData[indexBlockStartingAddr].block << " ";
-				// Update the free space bit map + number of free blocks
-				updateFreeSpace(DiskData[indexBlockStartingAddr].block, 1, 1);
-				while(indexNumbers.size() > 0){
-					allocatedBlockStartingAddr = (((indexNumbers.front()-1)*DiskVCB->blockSize)+1);
-					for(int i = 0; i < DiskVCB->blockSize; i++){
-						if (DiskData[allocatedBlockStartingAddr+i-1].data != -1){
-							// If there is data in the entry, set to -1 (unused)
-							DiskData[(allocatedBlockStartingAddr+i-1)].data = -1;
-						}
-						// Increment access time (Accessed memory)
-						accessTime++;
-
-					}
-					// Print block number
-					cout << "B" << indexNumbers.front() << " ";
-					// Update the free space bit map + number of free blocks
-					updateFreeSpace(indexNumbers.front(), 1, 1);
-					// Remove ('dequeue') first item from the queue
-					indexNumbers.pop();
-				}
-				// Update the inode in directory structure to -1 (unused)
-				updateINode(tempDirPtr,-1,-1);
-				// Increment access time (Accessed memory)
-				accessTime++;
-				cout << endl;
-				break;
-			}
-			case (4): {
-				cout << "Deleting File " << fileName << " from virtual disk." << endl;
-				cout << "Deleted File " << fileName << " from virtual disk and freed ";
-				int indexBlockStartingAddr = 0;
-				int allocatedBlockStartingAddr = 0;
-				// Initialise a queue of data pairs
-				queue<std::pair<int,int> > indexNumbers;
-				// Calculate direct position of index block in disk data
-				indexBlockStartingAddr = ((tempDirPtr->Index - 1)*DiskVCB->blockSize);
-				// Increment access time (Accessed memory)
-				accessTime++;
-				for (int i = 0; i < DiskVCB->blockSize; i++){
-					// Loop through each entry in the index block
-					if(DiskData[indexBlockStartingAddr + i].data != -1){
-						// Push the bock and length as a pair into the queue
-						indexNumbers.push(std::pair<int,int>(DiskData[indexBlockStartingAddr + i].data, DiskData[indexBlockStartingAddr + i].length));
-						// Write index block entry data to -1 (unused)
-						DiskData[indexBlockStartingAddr+i].data = -1;
-						// Write index block entry length to -1 (unused)
-						DiskData[indexBlockStartingAddr+i].length = -1;
-					}
-					// Increment access time (Accessed memory)
-					accessTime++;
-				}
-				// Update the free space bit map + number of free blocks
-				updateFreeSpace(DiskData[indexBlockStartingAddr].block, 1, 1);
-				// Print blokc number
-				cout << "B" << DiskData[indexBlockStartingAddr].block << " ";
-				// Process every entry in the queue
-				while(indexNumbers.size() > 0){
-					// Calculate direct position of the first block in the front of the queue
-					allocatedBlockStartingAddr = (((indexNumbers.front().first-1)*DiskVCB->blockSize)+1);
-					for(int i = 0; i < indexNumbers.front().second*DiskVCB->blockSize; i++){
-						// Loop each entry in the block
-						if (DiskData[allocatedBlockStartingAddr+i-1].data != -1){
-							// If there is data in the entry, set to -1 (unused)
-							DiskData[(allocatedBlockStartingAddr+i-1)].data = -1;
-						}
-						if (i % DiskVCB->blockSize == 0){
-							// Print block number for every new block accessed
-							cout << "B" << DiskData[allocatedBlockStartingAddr+i].block << " ";
-						}
-						// Increment access time (Accessed memory)
-						accessTime++;
-					}
-					// Update the free space bit map + number of free blocks
-					updateFreeSpace(DiskData[allocatedBlockStartingAddr].block, indexNumbers.front().second, 1);
-					// Remove ('dequeue') first item from the queue
-					indexNumbers.pop();
-				}
-
-				// Update the inode in directory structure to -1 (unused)
-				updateINode(tempDirPtr,-1,-1);	
-				// Increment access time (Accessed memory)
-				accessTime++;
-				cout << endl;
-				break;
-			}
-		}
-		cout << "Total access time (accesses to memory) is " << accessTime << endl << endl;	
-	} else {
-		// File not found in the directory structure, print error and exit method
-		cout << "Deleting File " << fileName << "(" << fileName << ")" << " from virtual disk." << endl;
-		cerr << "Error: File entry "<< fileName << "(" << fileName << ")" << " does not exist in the virtual disk." << endl << endl;
-		return 0;
-	}
-	return 1;
-}
-
-
-
-
-
-
-
-/*
- * Getter method for the disk's VCB
- *
- * Returns:
- *		Disk VCB pointer
- *
- */
-VCB* VirtualDisk::getVCB(){
-	return DiskVCB;
-}
-
-
-/*
- * Getter method for the disk data
- *
- * Returns:
- *		Disk Data structure pointer
- *
- */
-
-
-Data* VirtualDisk::getData(){
-	return DiskData;
-}
-
-
-/*
- * Getter method for blockSize
- *
- * Returns:
- *		Block size for the Disk
- *
- */
-int VirtualDisk::getBlockSize(){
-	return DiskVCB->blockSize;
-}
-
-
-
-/*
- * Getter method for allocation method
- *
- * Returns:
- *		'1' for Contiguous
- *		'2' for Linked
- *		'3' for Indexed
- *		'4' for Contiguous Indexed
- *
- */
-int VirtualDisk::getAllocationMethod(){
-	return allocationMethod;
-}
-
-
+#include "Header.h"
+#include "VirtualDisk.h"		// Header file
+#include "DeviceModel.h"
+#include "BlockCache.h"
+#include "ReadAhead.h"
+#include "WriteBuffer.h"
+#include "SegmentLog.h"
+#include "DirectoryTree.h"
+#include "RoaringBitmap.h"
+#include "Snapshot.h"
+#include "OperationArena.h"
+#include "DataKernels.h"
+#include "ByteStore.h"
+#include "OperationMetrics.h"
+#include "DiskTracer.h"
+#include "OperationLog.h"
+
+// Compiler Directive
+using namespace std;
+
+/*
+ * Contructor for VirtualDisk
+ *
+ */
+VirtualDisk::VirtualDisk() : DiskOut(cout.rdbuf()), DiskErr(cerr.rdbuf()) {
+	// Errors flush the output first, as cerr does
+	DiskErr.tie(&DiskOut);
+	DiskErr.setf(ios::unitbuf);
+	DiskOut << endl;
+	DiskOut << "======================================================================" << endl;
+	DiskOut << "   _____  _     _               _ _                 _             " << endl;
+	DiskOut << "  |  __ \\(_)   | |        /\\   | | |               | |            " << endl;
+	DiskOut << "  | |  | |_ ___| | __    /  \\  | | | ___   ___ __ _| |_ ___  _ __ " << endl;
+	DiskOut << "  | |  | | / __| |/ /   / /\\ \\ | | |/ _ \\ / __/ _\\` | __/ _ \\| '__|" << endl;
+	DiskOut << "  | |__| | \\__ \\   <   / ____ \\| | | (_) | (_| (_| | || (_) | |   " << endl;
+	DiskOut << "  |_____/|_|___/_|\\_\\ /_/    \\_\\_|_|\\___/ \\___\\__,_|\\__\\___/|_|   " << endl;
+	DiskOut << "                                                                  " << endl;
+	DiskOut << "======================================================================" << endl;
+	DiskOut << endl;
+	DiskOut << "Welcome to your virtual disk. You have " << MAX_ELEMENTS << " entries available for use." << endl;
+	DiskDevice = NULL;
+	DiskCache = NULL;
+	DiskReadAhead = NULL;
+	DiskWriteBuffer = NULL;
+	DiskLog = NULL;
+	DiskSnapshots = NULL;
+	DiskArena = NULL;
+	DiskFreeMap = NULL;
+	DiskDirTree = NULL;
+	DiskBytes = NULL;
+	DiskOpLog = NULL;
+	blockBytes = deviceBlockBytes;
+#ifdef diskMetrics
+	DiskMetrics = new OperationMetrics();
+#endif
+#ifdef diskTrace
+	traceAccesses = 0;
+	traceBlocks = 0;
+	traceLastBlock = -1;
+#endif
+	accessTime = 0;
+	deviceTime = 0;
+	streakBlock = -1;
+	lazyDelete = false;
+	blocksRetired = 0;
+	blocksScrubbed = 0;
+	freeMapQueries = 0;
+	compressedQueryTime = 0;
+	// Call methods to set up the virtual disk
+	setupDisk();
+	// Print VCB details
+	printVCB();
+	// Print virtual disk map
+	printDiskMap();
+}
+
+/*
+ * Contructor for VirtualDisk without user input
+ *	Sets up a disk with a given allocation method and block size,
+ *	without the banner or any prompts. Used for the member disks of
+ *	a striped volume. The caller validates both values.
+ *
+ * Input:
+ *		method - Allocation method (1-5)
+ *		blockSize - Number of entries in a block
+ *
+ */
+VirtualDisk::VirtualDisk(int method, int blockSize) : DiskOut(cout.rdbuf()), DiskErr(cerr.rdbuf()) {
+	// Errors flush the output first, as cerr does
+	DiskErr.tie(&DiskOut);
+	DiskErr.setf(ios::unitbuf);
+	DiskDevice = NULL;
+	DiskCache = NULL;
+	DiskReadAhead = NULL;
+	DiskWriteBuffer = NULL;
+	DiskLog = NULL;
+	DiskSnapshots = NULL;
+	DiskArena = NULL;
+	DiskFreeMap = NULL;
+	DiskDirTree = NULL;
+	DiskBytes = NULL;
+	DiskOpLog = NULL;
+	blockBytes = deviceBlockBytes;
+#ifdef diskMetrics
+	DiskMetrics = new OperationMetrics();
+#endif
+#ifdef diskTrace
+	traceAccesses = 0;
+	traceBlocks = 0;
+	traceLastBlock = -1;
+#endif
+	accessTime = 0;
+	deviceTime = 0;
+	streakBlock = -1;
+	lazyDelete = false;
+	blocksRetired = 0;
+	blocksScrubbed = 0;
+	freeMapQueries = 0;
+	compressedQueryTime = 0;
+	// Initialise new VCB structure
+	DiskVCB = new VCB;
+	allocationMethod = method;
+	applyBlockSize(blockSize);
+	initialiseDisk();
+}
+
+VirtualDisk::~VirtualDisk(){
+	// Destructor, free explicitly allocated memory 
+	delete DiskVCB;
+	delete[] DiskDir;
+	delete[] DiskData;
+	delete DiskDevice;
+	delete DiskCache;
+	delete DiskReadAhead;
+	delete DiskWriteBuffer;
+	delete DiskLog;
+	delete DiskSnapshots;
+	delete DiskArena;
+	delete DiskFreeMap;
+	delete DiskDirTree;
+	delete DiskBytes;
+	delete DiskOpLog;
+#ifdef diskMetrics
+	delete DiskMetrics;
+#endif
+}
+
+
+/*
+ * Runs an operation with the policy of the disk's allocation method
+ *	The only switch on the allocation method of a file operation. The
+ *	operation is instantiated for every policy, so the kernels it calls
+ *	are picked at compile time.
+ *
+ * Input:
+ *		operation - Callable taking the policy (an empty tag object)
+ *
+ * Returns:
+ *		Return value of the operation
+ */
+template <class Operation>
+auto VirtualDisk::withPolicy(Operation operation){
+	switch (allocationMethod){
+		case (2):
+			return operation(LinkedPolicy());
+		case (3):
+			return operation(IndexedPolicy());
+		case (4):
+			return operation(ContiguousIndexedPolicy());
+		case (5):
+			return operation(LogStructuredPolicy());
+		default:
+			// Allocation method 1 - Contiguous
+			return operation(ContiguousPolicy());
+	}
+}
+
+
+/*
+ * Check directory structure for inode
+ *	This method goes into the virtual disk's directory structure
+ *	and returns a pointer to a matching file name. If no value is passed
+ *	for the file name, it will search for an empty empty in the
+ *	directory structure and return it. If no entry is found, return null.
+ *	With the directory tree, a file is looked up in the tree instead.
+ * Output:
+ *		pointer to the entry in the directory structure
+ *		Returns NULL if no entry is found
+ */
+iNode* VirtualDisk::checkINode(int64_t file=-1){
+	// Trace the lookup (no-op without -DdiskTrace)
+	traceScope("checkINode", this);
+	traceArg("file", file);
+	if (DiskDirTree){
+		// Look the file up in the directory tree (its inodes are handed out by insert)
+		return file == -1 ? NULL : DiskDirTree->find(file);
+	}
+	// Initialise a temp pointer to our directory structure
+	iNode* tempDirPtr = DiskDir;
+	// Loop through our directory structure
+	for (int i=0; i < DiskVCB->blockSize-1; i++){
+		// If there is a match to the passed file name
+		if (DiskDir[i].FileIdentifier == file){
+			// Return a pointer to the entry
+			return tempDirPtr;	
+		} else {
+			// If not a match, move pointer to next entry
+			tempDirPtr++;
+		}
+	}
+	// If no entry found, return null
+	return NULL;
+}
+
+
+
+
+/*
+ * Update inode data in directory structure
+ *	This method updates the passed inode pointer's values depending
+ *	on the allocation method. A file deleted from the directory tree
+ *	is removed from the tree.
+ *
+ *		
+ */
+int VirtualDisk::updateINode(iNode* iNodeEntry, int64_t fileName, int startValue, int endValue=-1){
+	// Run the inode update of the allocation method
+	return withPolicy([&]<class Policy>(Policy){ return updateINodeAs<Policy>(iNodeEntry, fileName, startValue, endValue); });
+}
+
+
+/*
+ * Update inode data of one allocation policy
+ *	The kernels call it directly, since they know their policy.
+ *
+ */
+template <class Policy>
+int VirtualDisk::updateINodeAs(iNode* iNodeEntry, int64_t fileName, int startValue, int endValue){
+	// Copy-on-write: preserve the directory page of the inode for the latest snapshot
+	preserveINode(iNodeEntry);
+	if (DiskDirTree && fileName == -1 && iNodeEntry->FileIdentifier != -1){
+		// File deleted, remove it from the directory tree and charge the nodes written (Accessed memory)
+		preserveTree();
+		DiskDirTree->erase(iNodeEntry->FileIdentifier);
+		for (int i=0;i<DiskDirTree->getLastWrites().size();i++){
+			accessBlock(DiskDirTree->getLastWrites()[i], true);
+		}
+	}
+	// Update the file identifier to the passed file name
+	iNodeEntry->FileIdentifier = fileName;
+	// Update the fields used by the allocation method
+	return updateINodeKernel(Policy(), iNodeEntry, startValue, endValue);
+}
+
+
+/*
+ * Updates an inode for allocation method 1 - Contiguous
+ *	Saves the start block and length.
+ *
+ */
+int VirtualDisk::updateINodeKernel(ContiguousPolicy, iNode* iNodeEntry, int startValue, int endValue){
+	iNodeEntry->StartBlock = startValue;
+	iNodeEntry->Length = endValue;
+	return 1;
+}
+
+
+/*
+ * Updates an inode for allocation method 2 - Linked
+ *	Saves the start block and last block.
+ *
+ */
+int VirtualDisk::updateINodeKernel(LinkedPolicy, iNode* iNodeEntry, int startValue, int endValue){
+	iNodeEntry->StartBlock = startValue;
+	iNodeEntry->LastBlock = endValue;
+	return 1;
+}
+
+
+/*
+ * Updates an inode for allocation methods 3 - Indexed, 4 - Contiguous
+ * Indexed and 5 - Log-structured
+ *	Saves the index block (the latest one in the inode map for a
+ *	log-structured disk).
+ *
+ */
+int VirtualDisk::updateINodeKernel(IndexedPolicy, iNode* iNodeEntry, int startValue, int endValue){
+	iNodeEntry->Index = startValue;
+	return 1;
+}
+
+
+
+
+/*
+ * Starts the access accounting of an operation
+ *	Resets the access time and simulated device time, and the arena
+ *	of the operation's temporary containers.
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int VirtualDisk::beginOperation(){
+	// Reuse the arena for the temporary containers of this operation
+	DiskArena->reset();
+	accessTime = 0;
+	deviceTime = 0;
+	streakBlock = -1;
+	opPrefetched = 0;
+	if (DiskCache){
+		// Save the cache statistics to report the operation's share
+		opCacheHits = DiskCache->getHits();
+		opCacheMisses = DiskCache->getMisses();
+		opCacheEvictions = DiskCache->getEvictions();
+	}
+	return 1;
+}
+
+
+
+
+/*
+ * Charges one entry access of an operation
+ *	This method increments the access time (accesses to memory) and
+ *	charges the access to the simulated device. Block 0 holds the VCB
+ *	and directory structure, so metadata accesses are charged to it.
+ *	When a block cache is set, the first access to a block looks it up
+ *	in the cache and the following accesses to the same block are
+ *	served the same way, so a block read from the cache costs the
+ *	cache hit time once instead of device time for every entry.
+ *	In write-back mode a write only leaves its block dirty, and reads
+ *	of dirty blocks are served from memory.
+ *
+ * Input:
+ *		block - Block of the entry being accessed
+ *		write - true if the entry is written
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int VirtualDisk::accessBlock(int block, bool write){
+	// Increment access time (Accessed memory)
+	accessTime++;
+#ifdef diskTrace
+	// Count the access, and the block when the access moves to another block, for the trace spans
+	traceAccesses++;
+	if (block != traceLastBlock){
+		traceBlocks++;
+		traceLastBlock = block;
+	}
+#endif
+	if (DiskWriteBuffer){
+		if (write){
+			// Leave the block dirty in memory until the buffer is flushed
+			DiskWriteBuffer->markDirty(block);
+			return 1;
+		}
+		if (DiskWriteBuffer->isDirty(block)){
+			// Unflushed block, read it from memory
+			return 1;
+		}
+	}
+	if (DiskCache){
+		if (block != streakBlock || write != streakWrite){
+			// First access to the block, look it up in the cache
+			streakBlock = block;
+			streakWrite = write;
+			if (write){
+				// Write through to the device and keep the block in the cache
+				DiskCache->store(block);
+				streakCached = false;
+			} else {
+				streakCached = DiskCache->access(block);
+				if (streakCached){
+					deviceTime += cacheHitTime;
+				}
+				if (DiskReadAhead && DiskReadAhead->noteRead(block, streakCached)){
+					// Reader reached the trigger block, prefetch the next window
+					prefetchBlocks(DiskReadAhead->nextBatch());
+				}
+			}
+		}
+		if (streakCached){
+			// Block served by the cache
+			return 1;
+		}
+	}
+	// Charge the entry's share of the block to the device
+	deviceTime += DiskDevice->access(block, blockBytes / DiskVCB->blockSize, write);
+	return 1;
+}
+
+
+
+
+/*
+ * Charges a directory lookup of an operation
+ *	The superblock is read for the VCB. With the directory tree, the
+ *	metadata block of every node on the path of the last lookup is
+ *	read as well, and the blocks of the nodes the last insert or delete
+ *	changed are written.
+ *
+ * Input:
+ *		write - true if the last tree operation changed nodes
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int VirtualDisk::accessDirectory(bool write){
+	// Increment access time and charge the read to the device (Accessed memory)
+	accessBlock(0);
+	if (DiskDirTree){
+		for (int i=0;i<DiskDirTree->getLastPath().size();i++){
+			accessBlock(DiskDirTree->getLastPath()[i]);
+		}
+		for (int i=0;write && i<DiskDirTree->getLastWrites().size();i++){
+			accessBlock(DiskDirTree->getLastWrites()[i], true);
+		}
+	}
+	return 1;
+}
+
+
+
+
+/*
+ * Prints the access time and simulated device time of an operation
+ *
+ * Output:
+ *		Total access time (accesses to memory)
+ *		Simulated device time in microseconds
+ */
+void VirtualDisk::printAccessTime(){
+	streamsize defaultPrecision = DiskOut.precision();
+	DiskOut << "Total access time (accesses to memory) is " << accessTime << endl;
+	DiskOut << "Simulated " << DiskDevice->getName() << " time is " << fixed << setprecision(1) << deviceTime << " us" << endl;
+	if (DiskCache){
+		DiskOut << "Block cache (" << DiskCache->getName() << ", " << DiskCache->getCapacity() << " blocks): ";
+		DiskOut << DiskCache->getHits()-opCacheHits << " hit(s), " << DiskCache->getMisses()-opCacheMisses << " miss(es), ";
+		DiskOut << DiskCache->getEvictions()-opCacheEvictions << " eviction(s)" << endl;
+		if (DiskReadAhead){
+			DiskOut << "Read-ahead prefetched " << opPrefetched << " block(s) (window " << DiskReadAhead->getWindow() << " of " << DiskReadAhead->getMaxWindow() << " blocks)" << endl;
+		}
+	}
+	DiskOut << endl;
+	DiskOut.unsetf(ios::floatfield);
+	DiskOut.precision(defaultPrecision);
+}
+
+
+
+
+/*
+ * Update free space information (bit map + VCB num of free blocks)
+ *	This method updates the free block information in the VCB.
+ *	The bit map will be updated with the passed value, and the
+ *	number of free blocks in the VCB will be changed accordingly.
+ *	A temporary release (the defragmenter freeing a file's own blocks
+ *	while it looks for a lower run) keeps the blocks' buffered writes,
+ *	as the blocks are marked as used again or moved right after.
+ *
+ */
+int VirtualDisk::updateFreeSpace(int startValue, int valueLen, int newValue=0, bool temporary){
+	// Trace the free space update (no-op without -DdiskTrace)
+	traceScope("updateFreeSpace", this);
+	traceArg("first", startValue);
+	traceArg("length", valueLen);
+	// Check that the existing value is not the same as the passed value
+	if (isFreeBlock(startValue) != (newValue == 1)){
+		// Copy-on-write: preserve the free map pages of the blocks for the latest snapshot
+		preserveFreeMap(startValue, valueLen);
+		// Loop for the passed length of the blocks to update
+		for (int i=0;i<valueLen;i++){
+			if (!DiskFreeMap){
+				// Update the blt map value to the new value
+				DiskVCB->FreeBlockBitMap[startValue+i] = newValue;
+			}
+			if (newValue == 0 && isStaleBlock(startValue+i)){
+				// Reallocated block left behind by a lazy delete, clear its stale entries
+				scrubBlock(startValue+i);
+			}
+		}
+		if (newValue == 0){
+			// Marking blocks as used, decrease the number of free blocks in VCB
+			DiskVCB->numFreeBlock -= valueLen;
+		} else if (newValue == 1){
+			// Marking blocks as free, increase the number of free blocks in VCB
+			DiskVCB->numFreeBlock += valueLen;
+		}		
+		if (DiskFreeMap){
+			// The compressed map replaces the bit map
+			DiskFreeMap->setRange(startValue, valueLen, newValue == 1);
+		}
+		// Update the free extent statistics around the changed blocks
+		updateFreeExtents(startValue, valueLen, newValue);
+		if (DiskCache && newValue == 1){
+			// Freed blocks no longer need to stay in the cache
+			for (int i=0;i<valueLen;i++){
+				DiskCache->invalidate(startValue+i);
+				if (DiskReadAhead){
+					DiskReadAhead->forgetBlock(startValue+i);
+				}
+			}
+		}
+		if (DiskWriteBuffer && newValue == 1 && !temporary){
+			// Freed blocks never need to be written
+			for (int i=0;i<valueLen;i++){
+				DiskWriteBuffer->discard(startValue+i);
+			}
+		}
+		return 1;
+	} else {
+		// No change to the value of the free space
+		return 0;
+	}
+}
+
+
+
+
+/*
+ * Update free extent statistics
+ *	This method updates the free extent statistics after a run of
+ *	blocks has changed in the free space bit map. Freed blocks are
+ *	merged with the free runs on either side of them using the run
+ *	boundaries, and used blocks split the free run that contained them.
+ *	Only the runs touching the changed blocks are visited, so the
+ *	statistics can be queried in O(1) after every operation.
+ *
+ * Input:
+ *		startValue - First block that changed
+ *		valueLen - Number of blocks that changed
+ *		newValue - '1' if the blocks were freed, '0' if they were used
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int VirtualDisk::updateFreeExtents(int startValue, int valueLen, int newValue){
+	int endValue = startValue+valueLen-1;
+	int runStart = startValue;
+	int runEnd = endValue;
+	if (newValue == 1){
+		// Blocks freed, merge with the free run ending right before the blocks
+		if (startValue > 0 && isFreeBlock(startValue-1)){
+			runStart = DiskStats.freeRunStart[startValue-1];
+			removeFreeExtent(runStart, startValue-1);
+		}
+		// Merge with the free run starting right after the blocks
+		if (endValue+1 < DiskVCB->totalBlockNum && isFreeBlock(endValue+1)){
+			runEnd = DiskStats.freeRunEnd[endValue+1];
+			removeFreeExtent(endValue+1, runEnd);
+		}
+		addFreeExtent(runStart, runEnd);
+	} else {
+		// Blocks used, find the start of the free run that contained them
+		while (runStart > 0 && isFreeBlock(runStart-1)){
+			runStart--;
+		}
+		runEnd = DiskStats.freeRunEnd[runStart];
+		removeFreeExtent(runStart, runEnd);
+		// Keep the remaining free blocks before and after the used blocks
+		if (runStart < startValue){
+			addFreeExtent(runStart, startValue-1);
+		}
+		if (endValue < runEnd){
+			addFreeExtent(endValue+1, runEnd);
+		}
+	}
+	return 1;
+}
+
+
+
+
+/*
+ * Add a free run to the free extent statistics
+ *
+ * Input:
+ *		startValue - First block of the free run
+ *		endValue - Last block of the free run
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int VirtualDisk::addFreeExtent(int startValue, int endValue){
+	int runLength = endValue-startValue+1;
+	// Save the run boundaries
+	DiskStats.freeRunEnd[startValue] = endValue;
+	DiskStats.freeRunStart[endValue] = startValue;
+	// Update the histogram and largest free extent
+	DiskStats.freeExtentHistogram[runLength]++;
+	DiskStats.numFreeExtents++;
+	if (runLength > DiskStats.largestFreeExtent){
+		DiskStats.largestFreeExtent = runLength;
+	}
+	return 1;
+}
+
+
+
+
+/*
+ * Remove a free run from the free extent statistics
+ *
+ * Input:
+ *		startValue - First block of the free run
+ *		endValue - Last block of the free run
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int VirtualDisk::removeFreeExtent(int startValue, int endValue){
+	int runLength = endValue-startValue+1;
+	// Update the histogram
+	DiskStats.freeExtentHistogram[runLength]--;
+	DiskStats.numFreeExtents--;
+	// Move the largest free extent down to the next run length still in use
+	while (DiskStats.largestFreeExtent > 0 && DiskStats.freeExtentHistogram[DiskStats.largestFreeExtent] == 0){
+		DiskStats.largestFreeExtent--;
+	}
+	return 1;
+}
+
+
+
+
+/*
+ * Record the extents and internal fragmentation of a file
+ *	Replaces any previous record of the file.
+ *
+ * Input:
+ *		fileName - File identifier
+ *		numExtents - Extents of the file (1 for contiguous, chain blocks for linked, index entries for indexed)
+ *		unusedEntries - Unused entries in the file's allocated blocks
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int VirtualDisk::recordFileStats(int64_t fileName, int numExtents, int unusedEntries){
+	// Remove the previous record of the file
+	removeFileStats(fileName);
+	if (!spareFileRecords.empty()){
+		// Reuse the node of a removed record instead of allocating one
+		std::map<int64_t, pair<int,int> >::node_type fileRecord = std::move(spareFileRecords.back());
+		spareFileRecords.pop_back();
+		fileRecord.key() = fileName;
+		fileRecord.mapped() = std::pair<int,int>(numExtents, unusedEntries);
+		DiskStats.fileExtents.insert(std::move(fileRecord));
+	} else {
+		DiskStats.fileExtents[fileName] = std::pair<int,int>(numExtents, unusedEntries);
+	}
+	DiskStats.numFiles++;
+	DiskStats.numFileExtents += numExtents;
+	DiskStats.unusedEntries += unusedEntries;
+	return 1;
+}
+
+
+
+
+/*
+ * Remove the extents and internal fragmentation record of a file
+ *
+ * Input:
+ *		fileName - File identifier
+ *
+ * Returns:
+ *		'1' if a record was removed
+ *		'0' if the file has no record
+ */
+int VirtualDisk::removeFileStats(int64_t fileName){
+	std::map<int64_t, pair<int,int> >::iterator fileRecord = DiskStats.fileExtents.find(fileName);
+	if (fileRecord == DiskStats.fileExtents.end()){
+		return 0;
+	}
+	DiskStats.numFiles--;
+	DiskStats.numFileExtents -= fileRecord->second.first;
+	DiskStats.unusedEntries -= fileRecord->second.second;
+	// Keep the node for the next record
+	spareFileRecords.push_back(DiskStats.fileExtents.extract(fileRecord));
+	return 1;
+}
+
+
+
+
+/*
+ * Counts the used entries of a block
+ *	Entries of a file are written from the start of a block, so the
+ *	first unused entry ends the block's data.
+ *
+ * Input:
+ *		block - Block to count
+ *		numEntries - Entries of the block that can hold data
+ *
+ * Returns:
+ *		Number of used entries
+ */
+int VirtualDisk::getBlockFill(int block, int numEntries){
+	int blockStartingAddr = (block*DiskVCB->blockSize) - DiskVCB->blockSize;
+	int usedEntries = 0;
+	while (usedEntries < numEntries && DiskData[blockStartingAddr+usedEntries].data != -1){
+		usedEntries++;
+	}
+	return usedEntries;
+}
+
+
+
+
+/*
+ * Writes queued entries into a block
+ *	Entries are written from the first given entry until the block
+ *	is full or the queue is empty, and printed as B<block>(entries).
+ *
+ * Input:
+ *		block - Block to write
+ *		firstEntry - First unused entry of the block
+ *		numEntries - Entries of the block that can hold data
+ *		fileContents - Entries to write, written entries are removed
+ *
+ * Returns:
+ *		Number of entries written
+ */
+int VirtualDisk::appendEntries(int block, int firstEntry, int numEntries, queue<string> &fileContents){
+	int blockStartingAddr = (block*DiskVCB->blockSize) - DiskVCB->blockSize;
+	int entriesWritten = 0;
+	if (firstEntry >= numEntries || fileContents.empty()){
+		// Block is full or nothing left to write
+		return 0;
+	}
+	DiskOut << "B" << block << "(";
+	for (int i=firstEntry;i<numEntries && !fileContents.empty();i++){
+		DiskOut << fileContents.front();
+		// Write file entry to disk data
+		writeEntry(blockStartingAddr+i, stoi(fileContents.front()));
+		// Delete file entry from the queue
+		fileContents.pop();
+		entriesWritten++;
+		if (i < numEntries-1 && !fileContents.empty()){
+			DiskOut << ",";
+		}
+	}
+	DiskOut << ") ";
+	return entriesWritten;
+}
+
+
+
+
+
+/*
+ * Finds the block a file operation starts at
+ *	Existing files start at their first block (contiguous and linked)
+ *	or their index block, and a new file starts at the block it would
+ *	be allocated. Used by the request scheduler to order requests.
+ *
+ * Input:
+ *		fileName - File targeted by the operation
+ *
+ * Returns:
+ *		Block number ('-1' if no block is free for a new file)
+ */
+int VirtualDisk::getTargetBlock(int64_t fileName){
+	return withPolicy([&]<class Policy>(Policy){ return getTargetBlockAs<Policy>(fileName); });
+}
+
+
+/*
+ * Finds the block a file operation starts at with one allocation policy
+ *
+ */
+template <class Policy>
+int VirtualDisk::getTargetBlockAs(int64_t fileName){
+	iNode* tempDirPtr = checkINode(fileName);
+	if (!tempDirPtr){
+		if constexpr (Policy::logStructured){
+			if (DiskLog->getNextBlock() != -1){
+				// New blocks are written at the log head
+				return DiskLog->getNextBlock();
+			}
+		}
+		return findFreeBlock();
+	}
+	return Policy::firstBlock(tempDirPtr);
+}
+
+
+
+
+/*
+ * Requests for free blocks
+ *	This method checks the free block bit map for free blocks 
+ *  of a certain length, and returns the starting block if
+ *  available.
+ *
+ * Returns:
+ *		Allocated block number when completed successfully
+ *		'-1' if no space available.
+ */
+int VirtualDisk::requestBlocks(int numBlocks){
+	// Trace the free run search (no-op without -DdiskTrace)
+	traceScope("requestBlocks", this);
+	traceArg("requested", numBlocks);
+	// Check if requested block exceeds total number of free blocks
+	if (numBlocks <= DiskVCB->numFreeBlock){
+		if (DiskFreeMap){
+			// Search the compressed map, it replaces the bit map (freemapbench compares the two)
+			chrono::steady_clock::time_point start = chrono::steady_clock::now();
+			int allocatedBlock = DiskFreeMap->findRun(numBlocks, 0);
+			compressedQueryTime += chrono::duration<double, micro>(chrono::steady_clock::now()-start).count();
+			freeMapQueries++;
+			return allocatedBlock;
+		}
+		// Find the first run of free blocks of the requested length (a single block is a run of 1)
+		return DataKernels::findFreeRun(DiskVCB->FreeBlockBitMap.data(), DiskVCB->FreeBlockBitMap.size(), numBlocks);
+	} else {
+		// If requested number of blocks exceeds total free blocks, return -1
+		return -1;
+	}
+}
+
+
+/*
+ * Finds the first free block without allocating it
+ *	The same search as requestBlocks(1), but it is not timed, counted
+ *	in the free map statistics or traced, so looking ahead (the request
+ *	scheduler) does not show up as allocations.
+ *
+ * Returns:
+ *		First free block
+ *		'-1' if no block is free
+ */
+int VirtualDisk::findFreeBlock(){
+	if (DiskVCB->numFreeBlock == 0){
+		return -1;
+	}
+	if (DiskFreeMap){
+		return DiskFreeMap->findRun(1, 0);
+	}
+	return DataKernels::findFreeRun(DiskVCB->FreeBlockBitMap.data(), DiskVCB->FreeBlockBitMap.size(), 1);
+}
+
+
+/*
+ * Sets all entries of a run of blocks to -1 (unused)
+ *	A block holding data is preserved for the latest snapshot before
+ *	it is cleared. Access is not charged, the caller charges the
+ *	entries it walks.
+ *
+ * Input:
+ *		firstBlock - First block of the run
+ *		numBlocks - Number of blocks in the run
+ *
+ * Returns:
+ *		Number of entries that held data
+ */
+int VirtualDisk::clearBlocks(int firstBlock, int numBlocks){
+	int numCleared = 0;
+	for (int block=firstBlock;block<firstBlock+numBlocks;block++){
+		Data* blockStart = DiskData+(block-1)*DiskVCB->blockSize;
+		int numData = DataKernels::countData(blockStart, DiskVCB->blockSize);
+		if (numData > 0){
+			// Copy-on-write: preserve the block for the latest snapshot
+			preserveBlock(block);
+			DataKernels::fillEmpty(blockStart, DiskVCB->blockSize);
+			numCleared += numData;
+		}
+	}
+	return numCleared;
+}
+
+
+/*
+ * Prints the data of the entries holding data in a range of disk data
+ *	The values are gathered into the operation arena first and then
+ *	printed, separated by spaces.
+ *
+ * Input:
+ *		dataAddr - Position of the first entry in disk data
+ *		numEntries - Number of entries in the range
+ *
+ * Returns:
+ *		Number of values printed
+ */
+int VirtualDisk::printFileData(int dataAddr, int numEntries){
+	// Room for the last register of values written by the kernel
+	std::pmr::vector<int> values(numEntries+8, DiskArena);
+	int numValues = DataKernels::compactData(DiskData+dataAddr, numEntries, values.data());
+	for (int i=0;i<numValues;i++){
+		DiskOut << values[i] << " ";
+	}
+	return numValues;
+}
+
+
+
+/*
+ * Set up current disk
+ *	This method intialises a new VCB for the disk, and
+ *  calls all necessary methods to configure the 
+ *  parameters of the virtual disk. The methods for
+ *	setting up disk data and disk directories is called.
+ *	The method to update free space information is also called.
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		
+ */
+int VirtualDisk::setupDisk(){
+	// Initialise new VCB structure
+	DiskVCB = new VCB;
+	// Get user to input file allocation method
+	VirtualDisk::setAllocationMethod();
+	// Get user to input block size
+	VirtualDisk::setBlockSize();
+	// Set up the disk for the chosen method and block size
+	return initialiseDisk();
+}
+
+
+
+
+/*
+ * Initialise current disk
+ *	This method sets up the disk data, directory structure and
+ *	simulated device once the allocation method and block size are
+ *	known.
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *
+ */
+int VirtualDisk::initialiseDisk(){
+	// Set up the arena for the temporary containers of the operations
+	DiskArena = new OperationArena(opArenaBytes);
+	// Room for the nodes of removed file records
+	spareFileRecords.reserve(MAX_ELEMENTS);
+	// Initialise disk data based on block size and allocation method
+	setupDiskData();
+	// Set up directory structure
+	setupDiskDir();
+	if (allocationMethod == 5){
+		// Set up the segments of the log
+		DiskLog = new SegmentLog(this, logSegmentBlocks);
+	}
+	// Simulate a hard disk drive by default
+	setDeviceModel(1);
+	return 1;
+}
+
+
+
+
+/*
+ * Sets the simulated device of the disk
+ *	Every block access of the file operations is charged
+ *	to this device to estimate the operation's latency.
+ *
+ * Input:
+ *		modelType - '1' for HDD, '2' for SATA SSD, '3' for NVMe
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if the model type is unrecognised
+ */
+int VirtualDisk::setDeviceModel(int modelType){
+	DeviceModel* newDevice = NULL;
+	switch (modelType){
+		case (1): {
+			newDevice = new HDDModel(DiskVCB->totalBlockNum);
+			break;
+		}
+		case (2): {
+			newDevice = new SATASSDModel(DiskVCB->totalBlockNum);
+			break;
+		}
+		case (3): {
+			newDevice = new NVMeModel(DiskVCB->totalBlockNum);
+			break;
+		}
+		default: {
+			DiskErr << "Error: Unrecognised device model " << modelType << "." << endl << endl;
+			return 0;
+		}
+	}
+	// Replace the previous device
+	delete DiskDevice;
+	DiskDevice = newDevice;
+	return 1;
+}
+
+
+
+
+/*
+ * Sets the block cache of the disk
+ *	Reads of blocks held by the cache are served at the cache hit
+ *	time instead of being charged to the device. Writes go through
+ *	to the device and also place the block in the cache.
+ *
+ * Input:
+ *		policyType - '0' disables the cache, '1' for LRU, '2' for CLOCK, '3' for ARC
+ *		numBlocks - Capacity of the cache in blocks
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if the policy type or capacity is invalid
+ */
+int VirtualDisk::setBlockCache(int policyType, int numBlocks){
+	BlockCache* newCache = NULL;
+	if (policyType != 0 && numBlocks < 1){
+		DiskErr << "Error: Cache capacity has to be at least 1 block." << endl << endl;
+		return 0;
+	}
+	switch (policyType){
+		case (0): {
+			// No cache
+			break;
+		}
+		case (1): {
+			newCache = new LRUCache(numBlocks);
+			break;
+		}
+		case (2): {
+			newCache = new ClockCache(numBlocks);
+			break;
+		}
+		case (3): {
+			newCache = new ARCCache(numBlocks);
+			break;
+		}
+		default: {
+			DiskErr << "Error: Unrecognised cache policy " << policyType << "." << endl << endl;
+			return 0;
+		}
+	}
+	// Replace the previous cache
+	delete DiskCache;
+	DiskCache = newCache;
+	return 1;
+}
+
+
+/*
+ * Set up sequential read-ahead
+ *	Sequential readers have the blocks ahead of them prefetched into
+ *	the block cache, so read-ahead needs a cache to be set.
+ *
+ * Input:
+ *		maxWindow - Largest number of blocks prefetched at once, '0' disables read-ahead
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if there is no block cache or the window is invalid
+ */
+int VirtualDisk::setReadAhead(int maxWindow){
+	if (maxWindow < 0){
+		DiskErr << "Error: Read-ahead window cannot be negative." << endl << endl;
+		return 0;
+	}
+	if (maxWindow > 0 && !DiskCache){
+		DiskErr << "Error: Read-ahead needs a block cache, set one with the cache instruction first." << endl << endl;
+		return 0;
+	}
+	// Replace the previous read-ahead state
+	delete DiskReadAhead;
+	DiskReadAhead = NULL;
+	if (maxWindow > 0){
+		// Blocks reached through the block before are fetched in file order, the others in disk order
+		DiskReadAhead = new ReadAhead(maxWindow, withPolicy([]<class Policy>(Policy){ return !Policy::chained; }));
+	}
+	return 1;
+}
+
+
+
+
+/*
+ * Lists the data blocks of a file in file order
+ *	Linked files are listed by following the next block pointers, and
+ *	indexed files by the entries of their index block. Index blocks
+ *	are not listed.
+ *
+ * Input:
+ *		iNodeEntry - Directory entry of the file
+ *
+ * Returns:
+ *		Data blocks of the file
+ */
+vector<int> VirtualDisk::getFileBlocks(iNode* iNodeEntry){
+	vector<int> fileBlocks;
+	listFileBlocks(iNodeEntry, fileBlocks);
+	return fileBlocks;
+}
+
+/*
+ * Lists the data blocks of a file into a list the caller keeps
+ *
+ * Input:
+ *		iNodeEntry - Directory entry of the file
+ *
+ * Output:
+ *		fileBlocks - Data blocks of the file are added to the end
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int VirtualDisk::listFileBlocks(iNode* iNodeEntry, vector<int> &fileBlocks){
+	// Run the block listing kernel of the allocation method
+	return withPolicy([&]<class Policy>(Policy){ return blocksKernel(Policy(), iNodeEntry, fileBlocks); });
+}
+
+
+
+/*
+ * Lists the blocks of a file with allocation method 1 - Contiguous
+ *
+ */
+int VirtualDisk::blocksKernel(ContiguousPolicy, iNode* iNodeEntry, vector<int> &fileBlocks){
+	for (int i=0;i<iNodeEntry->Length;i++){
+		fileBlocks.push_back(iNodeEntry->StartBlock+i);
+	}
+	return 1;
+}
+
+
+/*
+ * Lists the blocks of a file with allocation method 2 - Linked
+ *
+ */
+int VirtualDisk::blocksKernel(LinkedPolicy, iNode* iNodeEntry, vector<int> &fileBlocks){
+	int currentBlock = iNodeEntry->StartBlock;
+	// A chain cannot be longer than the disk
+	while (currentBlock > 0 && fileBlocks.size() < DiskVCB->totalBlockNum){
+		fileBlocks.push_back(currentBlock);
+		if (currentBlock == iNodeEntry->LastBlock){
+			break;
+		}
+		// Last entry of the block points to the next block
+		currentBlock = DiskData[(currentBlock*DiskVCB->blockSize)-1].data;
+	}
+	return 1;
+}
+
+
+/*
+ * Lists the blocks of a file with allocation methods 3 - Indexed and 5 - Log-structured
+ *
+ */
+int VirtualDisk::blocksKernel(IndexedPolicy, iNode* iNodeEntry, vector<int> &fileBlocks){
+	int indexBlockStartingAddr = (iNodeEntry->Index-1)*DiskVCB->blockSize;
+	for (int i=0;i<DiskVCB->blockSize;i++){
+		if (DiskData[indexBlockStartingAddr+i].data != -1){
+			fileBlocks.push_back(DiskData[indexBlockStartingAddr+i].data);
+		}
+	}
+	return 1;
+}
+
+
+/*
+ * Lists the blocks of a file with allocation method 4 - Contiguous Indexed
+ *
+ */
+int VirtualDisk::blocksKernel(ContiguousIndexedPolicy, iNode* iNodeEntry, vector<int> &fileBlocks){
+	int indexBlockStartingAddr = (iNodeEntry->Index-1)*DiskVCB->blockSize;
+	for (int i=0;i<DiskVCB->blockSize;i++){
+		if (DiskData[indexBlockStartingAddr+i].data != -1){
+			// Expand the extent into its blocks
+			for (int j=0;j<DiskData[indexBlockStartingAddr+i].length;j++){
+				fileBlocks.push_back(DiskData[indexBlockStartingAddr+i].data+j);
+			}
+		}
+	}
+	return 1;
+}
+
+
+
+
+/*
+ * Counts the extents of a file with allocation method 1 - Contiguous
+ *	A contiguous file is a single extent.
+ *
+ * Input:
+ *		iNodeEntry - Directory entry of the file
+ *		fileBlocks - Data blocks of the file
+ *
+ * Returns:
+ *		Number of extents
+ */
+int VirtualDisk::extentsKernel(ContiguousPolicy, iNode* iNodeEntry, vector<int> &fileBlocks){
+	return 1;
+}
+
+
+/*
+ * Counts the extents of a file with allocation method 2 - Linked
+ *	Every block of the chain is an extent.
+ *
+ */
+int VirtualDisk::extentsKernel(LinkedPolicy, iNode* iNodeEntry, vector<int> &fileBlocks){
+	return fileBlocks.size();
+}
+
+
+/*
+ * Counts the extents of a file with allocation methods 3 - Indexed and 5 - Log-structured
+ *	Every data block is an index entry.
+ *
+ */
+int VirtualDisk::extentsKernel(IndexedPolicy, iNode* iNodeEntry, vector<int> &fileBlocks){
+	return fileBlocks.size();
+}
+
+
+/*
+ * Counts the extents of a file with allocation method 4 - Contiguous Indexed
+ *	Every index entry holds an extent.
+ *
+ */
+int VirtualDisk::extentsKernel(ContiguousIndexedPolicy, iNode* iNodeEntry, vector<int> &fileBlocks){
+	int indexBlockStartingAddr = (iNodeEntry->Index-1)*DiskVCB->blockSize;
+	int numExtents = 0;
+	for (int i=0;i<DiskVCB->blockSize;i++){
+		if (DiskData[indexBlockStartingAddr+i].data != -1){
+			numExtents++;
+		}
+	}
+	return numExtents;
+}
+
+
+
+
+/*
+ * Starts read-ahead for a file read
+ *	Works out the logical block of the read from the entry offset and
+ *	prefetches the first window if the read is sequential.
+ *
+ * Input:
+ *		iNodeEntry - Directory entry of the file
+ *		fileOffset - Entry offset of the read, '0' for a whole-file read
+ *
+ * Returns:
+ *		Number of blocks prefetched
+ */
+int VirtualDisk::startReadAhead(iNode* iNodeEntry, int64_t fileOffset){
+	return withPolicy([&]<class Policy>(Policy){ return startReadAheadAs<Policy>(iNodeEntry, fileOffset); });
+}
+
+
+/*
+ * Starts read-ahead for a file read with one allocation policy
+ *
+ */
+template <class Policy>
+int VirtualDisk::startReadAheadAs(iNode* iNodeEntry, int64_t fileOffset){
+	int entriesPerBlock = Policy::entriesPerBlock(DiskVCB->blockSize);
+	int logicalBlock = fileOffset > 0 ? min((fileOffset-1) / entriesPerBlock, (int64_t)INT_MAX) : 0;
+	vector<int> fileBlocks;
+	blocksKernel(Policy(), iNodeEntry, fileBlocks);
+	return prefetchBlocks(DiskReadAhead->planRead(iNodeEntry->FileIdentifier, fileBlocks, logicalBlock, fileOffset == 0));
+}
+
+
+
+
+/*
+ * Prefetches blocks into the block cache
+ *	Blocks already in the cache are skipped, and the others are read in
+ *	the order the read-ahead hands them out. Prefetches are charged to
+ *	the device but not to the access time.
+ *
+ * Input:
+ *		blocks - Blocks to prefetch
+ *
+ * Returns:
+ *		Number of blocks prefetched
+ */
+int VirtualDisk::prefetchBlocks(vector<int> blocks){
+	int numPrefetched = 0;
+	for (int i=0;i<blocks.size();i++){
+		if (!DiskCache->contains(blocks[i])){
+			// Read the whole block from the device into the cache
+			DiskCache->store(blocks[i]);
+			deviceTime += DiskDevice->access(blocks[i], blockBytes, false);
+			numPrefetched++;
+		}
+	}
+	opPrefetched += numPrefetched;
+	return numPrefetched;
+}
+
+
+
+
+/*
+ * Set up write-back buffering
+ *	Writes are held in a buffer of dirty blocks and written to the
+ *	device in runs of adjacent blocks when the buffer is flushed.
+ *	Any dirty blocks of the previous buffer are flushed first.
+ *
+ * Input:
+ *		maxDirtyBlocks - Dirty blocks that trigger a flush, below '1' disables write-back
+ *		maxAge - Operations a dirty block may wait before a flush
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if the time threshold is invalid
+ */
+int VirtualDisk::setWriteBack(int maxDirtyBlocks, int maxAge){
+	if (maxDirtyBlocks > 0 && maxAge < 1){
+		DiskErr << "Error: Write-back time threshold has to be at least 1 operation." << endl << endl;
+		return 0;
+	}
+	// Write out the previous buffer before replacing it
+	flushWriteBack();
+	delete DiskWriteBuffer;
+	DiskWriteBuffer = NULL;
+	if (maxDirtyBlocks > 0){
+		DiskWriteBuffer = new WriteBuffer(maxDirtyBlocks, maxAge);
+	}
+	return 1;
+}
+
+
+
+
+/*
+ * Ends an operation for the write-back buffer
+ *	Advances the buffer's clock and flushes it if the size or time
+ *	threshold has been reached.
+ *
+ * Returns:
+ *		'1' if the buffer was flushed
+ *		'0' otherwise
+ */
+int VirtualDisk::checkWriteBack(){
+	if (!DiskWriteBuffer){
+		return 0;
+	}
+	DiskWriteBuffer->nextOperation();
+	if (DiskWriteBuffer->needsFlush()){
+		return flushWriteBack();
+	}
+	return 0;
+}
+
+
+
+
+/*
+ * Flushes the write-back buffer to the device
+ *	Every run of adjacent dirty blocks is written as one device write,
+ *	and the bitmap and directory updates of all buffered operations are
+ *	written once with block 0.
+ *
+ * Output:
+ *		Blocks and device writes of the flush
+ *		Entry writes buffered so far against device writes issued
+ *
+ * Returns:
+ *		'1' when the buffer was flushed
+ *		'0' if there was nothing to flush
+ */
+int VirtualDisk::flushWriteBack(){
+	if (!DiskWriteBuffer || DiskWriteBuffer->getNumDirty() == 0){
+		return 0;
+	}
+	double flushTime = 0;
+	int numDirty = DiskWriteBuffer->getNumDirty();
+	vector<pair<int, int> > dirtyRuns = DiskWriteBuffer->takeRuns();
+	for (int i=0;i<dirtyRuns.size();i++){
+		// Write the whole run in one device request
+		flushTime += DiskDevice->access(dirtyRuns[i].first, dirtyRuns[i].second * blockBytes, true);
+		if (DiskCache){
+			for (int j=0;j<dirtyRuns[i].second;j++){
+				DiskCache->store(dirtyRuns[i].first+j);
+			}
+		}
+	}
+	streamsize defaultPrecision = DiskOut.precision();
+	long bufferedWrites = DiskWriteBuffer->getBufferedWrites();
+	long flushWrites = DiskWriteBuffer->getFlushWrites();
+	DiskOut << "Write-back flush: " << numDirty << " dirty block(s) written in " << dirtyRuns.size() << " device write(s)" << endl;
+	DiskOut << "Simulated " << DiskDevice->getName() << " time is " << fixed << setprecision(1) << flushTime << " us" << endl;
+	DiskOut << bufferedWrites << " entry write(s) buffered so far, written in " << flushWrites << " device write(s) (";
+	DiskOut << (bufferedWrites - flushWrites) * 100.00 / max(bufferedWrites, 1L) << "% fewer device operations)" << endl;
+	DiskOut << endl;
+	DiskOut.unsetf(ios::floatfield);
+	DiskOut.precision(defaultPrecision);
+	return 1;
+}
+
+
+
+
+/*
+ * Takes a copy-on-write snapshot of the disk
+ *	Nothing is copied when the snapshot is taken. Blocks and the
+ *	metadata are copied on their first write after the snapshot.
+ *
+ * Returns:
+ *		Number of the new snapshot
+ *		'0' in byte mode
+ */
+int VirtualDisk::takeSnapshot(){
+	if (DiskBytes){
+		DiskErr << "Error: Snapshots do not preserve the byte slab of byte mode." << endl << endl;
+		return 0;
+	}
+	if (!DiskSnapshots){
+		DiskSnapshots = new SnapshotManager(this);
+	}
+	return DiskSnapshots->takeSnapshot();
+}
+
+
+
+
+/*
+ * Rolls the disk back to a snapshot
+ *	The blocks changed since the snapshot are written back, so the
+ *	rollback is charged like any other operation. The free space
+ *	statistics are rebuilt and read-ahead restarts, since the files
+ *	they were following may have changed.
+ *
+ * Input:
+ *		id - Snapshot to roll back to
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if the snapshot does not exist
+ */
+int VirtualDisk::rollbackSnapshot(int id){
+	if (!DiskSnapshots || DiskSnapshots->findSnapshot(id) == -1){
+		DiskErr << "Error: Snapshot " << id << " does not exist." << endl << endl;
+		return 0;
+	}
+	// Reset the access time and simulated device time of the operation
+	beginOperation();
+	int blocksRestored = DiskSnapshots->rollback(id);
+	for (int block=1;block<DiskVCB->totalBlockNum;block++){
+		if (retireSnapshot[block] >= id){
+			// Retired after the snapshot, the entries left behind are the ones of the snapshot
+			dataGeneration[block] = blockGeneration[block];
+		}
+	}
+	// The statistics are not preserved, rebuild them from the restored free map and directory
+	buildFSStats();
+	buildFileStats();
+	DiskOut << "Rolled back to snapshot " << id << " and restored " << blocksRestored << " block(s)." << endl;
+	if (DiskReadAhead){
+		setReadAhead(DiskReadAhead->getMaxWindow());
+	}
+	// Print the access time and simulated device time of the operation
+	printAccessTime();
+	return 1;
+}
+
+
+
+
+/*
+ * Prints the differences between two snapshots
+ *
+ * Input:
+ *		fromId - Older snapshot
+ *		toId - Newer snapshot, '-1' for the current disk
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if a snapshot does not exist
+ */
+int VirtualDisk::diffSnapshots(int fromId, int toId){
+	if (!DiskSnapshots || DiskSnapshots->diff(fromId, toId) == -1){
+		DiskErr << "Error: Snapshot does not exist." << endl << endl;
+		return 0;
+	}
+	return 1;
+}
+
+
+
+
+/*
+ * Copy-on-write hooks
+ *	Called before a block, a range of the free block map, an inode,
+ *	the directory tree or the log state is changed. Without snapshots
+ *	they do nothing.
+ *
+ * Input:
+ *		block - Block about to be written
+ *		startValue, valueLen - Blocks about to be marked as used or free
+ *		iNodeEntry - Inode about to be written
+ *
+ * Returns:
+ *		Number of pages copied
+ */
+int VirtualDisk::preserveBlock(int block){
+	if (isStaleBlock(block)){
+		// First write to a block left behind by a lazy delete, clear its stale entries first
+		return scrubBlock(block);
+	}
+	if (DiskSnapshots){
+		return DiskSnapshots->preserveBlock(block);
+	}
+	return 0;
+}
+
+int VirtualDisk::preserveFreeMap(int startValue, int valueLen){
+	if (DiskSnapshots){
+		return DiskSnapshots->preserveFreeMap(startValue, valueLen);
+	}
+	return 0;
+}
+
+int VirtualDisk::preserveINode(iNode* iNodeEntry){
+	if (DiskSnapshots){
+		return DiskSnapshots->preserveDirectory(iNodeEntry - getDir());
+	}
+	return 0;
+}
+
+int VirtualDisk::preserveTree(){
+	if (DiskSnapshots){
+		return DiskSnapshots->preserveTree();
+	}
+	return 0;
+}
+
+int VirtualDisk::preserveLog(){
+	if (DiskSnapshots){
+		return DiskSnapshots->preserveLog();
+	}
+	return 0;
+}
+
+
+
+
+/*
+ * Writes one entry of the disk data
+ *	Every write to an entry goes through here, so the block of the
+ *	entry is preserved for the latest snapshot before it changes.
+ *	writeExtent() also writes the length (contiguous indexed entries).
+ *
+ * Input:
+ *		addr - Position of the entry in the disk data
+ *		data - Value to write ('-1' for unused)
+ *		length - Length of the extent ('-1' for unused)
+ *		charge - true to charge the write to the device (Accessed memory)
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int VirtualDisk::writeEntry(int addr, int data, bool charge){
+	preserveBlock(DiskData[addr].block);
+	DiskData[addr].data = data;
+	if (charge){
+		accessBlock(DiskData[addr].block, true);
+	}
+	return 1;
+}
+
+int VirtualDisk::writeExtent(int addr, int data, int length, bool charge){
+	preserveBlock(DiskData[addr].block);
+	DiskData[addr].data = data;
+	DiskData[addr].length = length;
+	if (charge){
+		accessBlock(DiskData[addr].block, true);
+	}
+	return 1;
+}
+
+
+
+
+/*
+ * Switches lazy deletion on or off
+ *	A lazy delete only frees the blocks of a file and bumps their
+ *	generation, so it costs O(extents) instead of O(entries). The
+ *	entries of a retired block are stale: they are shown as empty and
+ *	cleared when the block is reallocated or first written. Blocks
+ *	retired before lazy deletion is switched off stay stale until then.
+ *
+ * Input:
+ *		enabled - Whether deletes are lazy
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int VirtualDisk::setLazyDelete(bool enabled){
+	lazyDelete = enabled;
+	return 1;
+}
+
+
+/*
+ * Selects the free block map of the disk
+ *	The compressed map replaces the dense bit map in the VCB: it is
+ *	built from the bit map, which is then released, and switching back
+ *	rebuilds the bit map from it. Snapshots copy the map in use, so it
+ *	cannot be changed after a snapshot is taken.
+ *
+ * Input:
+ *		mapType - 1 - Dense bit map, 2 - Compressed (roaring) map
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if the map type is unknown
+ */
+int VirtualDisk::setFreeMap(int mapType){
+	if (mapType != 1 && mapType != 2){
+		DiskErr << "Error: Free space map has to be 1 (dense) or 2 (compressed)." << endl << endl;
+		return 0;
+	}
+	if (DiskSnapshots){
+		DiskErr << "Error: Free space map cannot be changed after a snapshot is taken." << endl << endl;
+		return 0;
+	}
+	freeMapQueries = 0;
+	compressedQueryTime = 0;
+	if (mapType == 2 && !DiskFreeMap){
+		DiskFreeMap = new RoaringBitmap();
+		DiskFreeMap->build(DiskVCB->FreeBlockBitMap);
+		vector<int>().swap(DiskVCB->FreeBlockBitMap);
+	} else if (mapType == 1 && DiskFreeMap){
+		DiskVCB->FreeBlockBitMap.assign(DiskVCB->totalBlockNum, 0);
+		for (int i=0;i<DiskVCB->totalBlockNum;i++){
+			DiskVCB->FreeBlockBitMap[i] = isFreeBlock(i);
+		}
+		delete DiskFreeMap;
+		DiskFreeMap = NULL;
+	}
+	return 1;
+}
+
+
+/*
+ * Selects the directory structure
+ *	The inode array in the superblock holds at most blockSize-1 files.
+ *	The directory tree keeps its nodes in metadata blocks taken from
+ *	the free space, so it grows with the number of files. The directory
+ *	can only be changed while the disk holds no files and before the
+ *	first snapshot. The log-structured method writes every data block
+ *	through its log, so it keeps the inode array.
+ *
+ * Input:
+ *		dirType - 1 - Inode array, 2 - Directory tree (B+-tree)
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if the directory cannot be changed
+ */
+int VirtualDisk::setDirectory(int dirType){
+	if (dirType != 1 && dirType != 2){
+		DiskErr << "Error: Directory has to be 1 (inode array) or 2 (B+-tree)." << endl << endl;
+		return 0;
+	}
+	if (dirType == 2 && allocationMethod == 5){
+		DiskErr << "Error: The log-structured method only supports the inode array directory." << endl << endl;
+		return 0;
+	}
+	if (DiskSnapshots){
+		DiskErr << "Error: Directory cannot be changed after a snapshot is taken." << endl << endl;
+		return 0;
+	}
+	for (int i=0;i<getDirSize();i++){
+		if (getDir()[i].FileIdentifier != -1){
+			DiskErr << "Error: Directory can only be changed while the disk holds no files." << endl << endl;
+			return 0;
+		}
+	}
+	// An empty tree holds no metadata blocks
+	delete DiskDirTree;
+	DiskDirTree = NULL;
+	if (dirType == 2){
+		// Every entry of a metadata block holds a key of the node
+		DiskDirTree = new DirectoryTree(this, DiskVCB->blockSize);
+	}
+	return 1;
+}
+
+
+/*
+ * Selects byte mode
+ *	In byte mode every block holds payloadBytes real bytes in the byte
+ *	slab, and the device is charged for them instead of the default
+ *	block size. Files are added and read as bytes. The mode can only
+ *	be changed while the disk holds no files and before the first
+ *	snapshot, since snapshots do not preserve the slab.
+ *
+ * Input:
+ *		payloadBytes - Bytes in a block (a power of 2 from 512 to 65536, '0' for int entries)
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if the mode cannot be changed
+ */
+int VirtualDisk::setByteMode(int payloadBytes){
+	if (payloadBytes != 0 && (payloadBytes < byteBlockMinBytes || payloadBytes > byteBlockMaxBytes || (payloadBytes & (payloadBytes-1)) != 0)){
+		DiskErr << "Error: Byte mode block size has to be a power of 2 from " << byteBlockMinBytes << " to " << byteBlockMaxBytes << " bytes." << endl << endl;
+		return 0;
+	}
+	if (DiskSnapshots){
+		DiskErr << "Error: Byte mode cannot be changed after a snapshot is taken." << endl << endl;
+		return 0;
+	}
+	for (int i=0;i<getDirSize();i++){
+		if (getDir()[i].FileIdentifier != -1){
+			DiskErr << "Error: Byte mode can only be changed while the disk holds no files." << endl << endl;
+			return 0;
+		}
+	}
+	delete DiskBytes;
+	DiskBytes = NULL;
+	blockBytes = deviceBlockBytes;
+	if (payloadBytes != 0){
+		DiskBytes = new ByteStore(DiskVCB->totalBlockNum, DiskVCB->blockSize, payloadBytes);
+		blockBytes = payloadBytes;
+	}
+	return 1;
+}
+
+
+/*
+ * Retires a run of blocks freed by a lazy delete
+ *	Only the generation of each block is bumped, the entries are left
+ *	as they are. The latest snapshot is noted, so a snapshot taken
+ *	later knows the block was already stale without clearing it.
+ *
+ * Input:
+ *		firstBlock - First block of the run
+ *		numBlocks - Number of blocks in the run
+ *
+ * Returns:
+ *		Number of blocks retired
+ */
+int VirtualDisk::retireBlocks(int firstBlock, int numBlocks){
+	for (int block=firstBlock;block<firstBlock+numBlocks;block++){
+		// Entries written in an older generation are stale
+		blockGeneration[block]++;
+		retireSnapshot[block] = DiskSnapshots ? DiskSnapshots->getLatestId() : 0;
+	}
+	blocksRetired += numBlocks;
+	return numBlocks;
+}
+
+
+/*
+ * Checks if a block holds stale entries of a lazily deleted file
+ *
+ * Input:
+ *		block - Block to check
+ *
+ * Returns:
+ *		true if the entries are from an older generation of the block
+ */
+bool VirtualDisk::isStaleBlock(int block){
+	return dataGeneration[block] != blockGeneration[block];
+}
+
+
+/*
+ * Clears the stale entries of a block
+ *	The block is preserved for the latest snapshot first, since the
+ *	lazy delete did not touch it. A block retired before the latest
+ *	snapshot was free when it was taken, so that snapshot keeps it
+ *	cleared and the snapshot taken before the delete keeps the entries.
+ *	Snapshots therefore never have to clear stale blocks when they are
+ *	taken. Clearing is not charged to the device, the block is about to
+ *	be written or is only being shown.
+ *
+ * Input:
+ *		block - Stale block
+ *
+ * Returns:
+ *		'1' if a page was copied for the latest snapshot
+ *		'0' otherwise
+ */
+int VirtualDisk::scrubBlock(int block){
+	int pageCopied = 0;
+	bool staleAtSnapshot = DiskSnapshots && retireSnapshot[block] != DiskSnapshots->getLatestId();
+	if (DiskSnapshots){
+		// Copy-on-write: preserve the block for the latest snapshot, or for the one before the delete
+		pageCopied = staleAtSnapshot ? DiskSnapshots->preserveBlockIn(retireSnapshot[block], block) : DiskSnapshots->preserveBlock(block);
+	}
+	Data* blockStart = DiskData+(block-1)*DiskVCB->blockSize;
+	DataKernels::fillEmpty(blockStart, DiskVCB->blockSize);
+	// Index block entries of contiguous indexed files also hold a length
+	for (int i=0;i<DiskVCB->blockSize;i++){
+		blockStart[i].length = -1;
+	}
+	if (staleAtSnapshot){
+		// The latest snapshot holds the block cleared
+		pageCopied += DiskSnapshots->preserveBlock(block);
+	}
+	dataGeneration[block] = blockGeneration[block];
+	blocksScrubbed++;
+	return pageCopied;
+}
+
+
+/*
+ * Set up current disk data
+ *	This method initialises the structures for
+ *	storing data in our disk, setting the entry index,
+ *	the block index based on the block size, and the
+ *	default data value to -1 (empty).
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		
+ */
+int VirtualDisk::setupDiskData(){
+	// Initialise new Data structure array (First block reserved for superblock)
+	DiskData = new Data[MAX_ELEMENTS-DiskVCB->blockSize];
+	for (int i=DiskVCB->blockSize; i < MAX_ELEMENTS; i++){
+		// Write the index of the data entry
+		DiskData[i-DiskVCB->blockSize].index = i;
+		// Write the block number of the data entry
+		DiskData[i-DiskVCB->blockSize].block = nearbyint(i/DiskVCB->blockSize);
+		// Write the data of the data entry as -1 (unused)
+		DiskData[i-DiskVCB->blockSize].data = -1;
+		// Write the length of the data entry as -1 (only contiguous indexed extents set it)
+		DiskData[i-DiskVCB->blockSize].length = -1;
+	}
+	return 1;
+}
+
+
+
+
+/*
+ * Set up current disk directory
+ *	This method initialises the directory structure for
+ *	the virtual disk.
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		
+ */
+int VirtualDisk::setupDiskDir(){
+	// Initialise new iNode structure array (First entry reserved for VCB)
+	DiskDir = new iNode[DiskVCB->blockSize-1];
+	for (int i=0; i < DiskVCB->blockSize-1; i++){
+		// Write the file identifier of the inode to -1 (unused)
+		DiskDir[i].FileIdentifier = -1;
+		// Write the fields of the allocation method to -1 (unused), every method's fields share these two
+		DiskDir[i].StartBlock = -1;
+		DiskDir[i].Length = -1;
+	}
+	return 1;
+}
+
+
+
+
+/*
+ * Sets user input for block size
+ *	This method asks the user to input a block size for
+ * 	the virtual disk. blockSize is intepreted to be the number of
+ * 	entries in a block, and validated to be an integer that is
+ *	not less than 1 (if blockSize is 1, no files can be stored), and
+ *	not more than half of the available entries (minimum of 2 blocks)
+ *
+ * Input:
+ *		Via cin 
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *
+ */
+int VirtualDisk::setBlockSize(){
+	int tempBlockSize;
+	DiskOut << endl << "Please enter the size of each block: ";
+	bool valid = false;
+	while (!valid){
+		// Get user input and save it to a temp variable
+		cin >> tempBlockSize;
+		// Validate that user input is a number
+		while (!cin.good()) {
+			// User input invalid, reset input stream
+		    cin.clear();
+		    cin.ignore(INT_MAX,'\n');
+		    // Get user input again
+		    DiskOut << "Please enter a valid block size: ";
+		    cin >> tempBlockSize;
+		}
+		// Round tempBlockSize off to nearest int
+		tempBlockSize = nearbyint(tempBlockSize);
+		// If tempBlockSize is less than 1, getUserBlockSize() again.
+		if (tempBlockSize <= 1 || tempBlockSize > MAX_ELEMENTS / 2){
+			DiskOut << "Your specified block size of " << tempBlockSize << " has to be greater than 1 and less than " << MAX_ELEMENTS/2 << endl;
+			DiskOut << "Please select another block size: ";
+		} else if (MAX_ELEMENTS % tempBlockSize != 0){
+		// Check for valid block size that fits into our total entries, else getUserBlockSize() again.
+			DiskOut << "Your specified block size of " << tempBlockSize << " will result in " << MAX_ELEMENTS % tempBlockSize << " unusable entries." << endl;
+			DiskOut << "Please select another block size: ";
+		} else {
+			valid = true;
+			// Save block size and block counts to VCB
+			return applyBlockSize(tempBlockSize);
+		}
+	}
+}
+
+
+
+
+/*
+ * Applies a validated block size
+ *	Saves the block size and the block counts it gives to the VCB,
+ *	then builds the free space bit map.
+ *
+ * Input:
+ *		newBlockSize - Number of entries in a block
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *
+ */
+int VirtualDisk::applyBlockSize(int newBlockSize){
+	// Save block size to VCB
+	DiskVCB->blockSize = newBlockSize;
+	// Calculate and save total number of blocks to VCB
+	DiskVCB->totalBlockNum = MAX_ELEMENTS / newBlockSize;
+	// Calculate and save total number of free blocks to VCB (first block used as superblock)
+	DiskVCB->numFreeBlock = MAX_ELEMENTS / newBlockSize - 1;
+	// Build free space bit map
+	buildFSBitMap();
+	// Every block starts in generation 0 with its entries cleared
+	blockGeneration.assign(DiskVCB->totalBlockNum, 0);
+	dataGeneration.assign(DiskVCB->totalBlockNum, 0);
+	retireSnapshot.assign(DiskVCB->totalBlockNum, 0);
+	return 1;
+}
+
+
+
+
+/*
+ * Sets user input for disk allocation method
+ *	This method gives the user a list of disk allocation methods to 
+ * 	choose from (Contiguous, Linked, Indexed, Contiguous Indexed, Log-structured).
+ *	The user's input is validated to be an integer, and must be one of the
+ *	available options provided (either 1, 2, 3, 4 or 5).
+ *
+ * Input:
+ *		Via cin 
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *
+ */
+int VirtualDisk::setAllocationMethod(){
+	int userInput;
+	DiskOut << "Please choose a disk block allocation method" << endl;
+	DiskOut << "\t1. Contiguous Allocation" << endl;
+	DiskOut << "\t2. Linked Allocation" << endl;
+	DiskOut << "\t3. Indexed Allocation" << endl;
+	DiskOut << "\t4. Contiguous Indexed Allocation" << endl;
+	DiskOut << "\t5. Log-structured Allocation" << endl;
+	DiskOut << endl << "Allocation Method (e.g. 1): ";
+	bool valid = false;
+	// While input is not valid
+	while (!valid){
+		cin >> userInput;
+		// If input is not of type int
+		while (!cin.good()){
+			// flush the stream and prompt user to try again
+			cin.clear();
+		    cin.ignore(INT_MAX,'\n');
+	    	DiskOut << "Please enter a valid option (e.g. 1): ";
+		    cin >> userInput;
+		}
+		// Round off value to nearest integer
+		userInput = nearbyint(userInput);
+		// If rounded number is wihin the available options
+		if (userInput >=1 && userInput <= 5){
+			// Set valid to true to exit the while loop
+			valid = true;
+			// Save input value to class variable
+			allocationMethod = userInput;
+			return 1;
+		} else {
+			// User entered invalid input type
+			DiskOut << "Invalid input. Please enter a valid option from 1 to 5: ";
+		}
+	}
+}
+
+
+
+
+
+/*
+ * Builds the free space bit map in the VCB
+ *	This method goes into the virtual disk's VCB to build the
+ *	free block bit map. The first block is reserved for superblock
+ *	and thus marked as used. The rest of the blocks are deemed as free
+ *	as this function is called on first initialisation of the disk.
+ *		
+ */
+int VirtualDisk::buildFSBitMap(){
+	// Mark first bit as used (superblock)
+	DiskVCB->FreeBlockBitMap.push_back(0);
+	for (int i=0;i < DiskVCB->totalBlockNum-1;i++){
+		// Mark the remaining bits as unused
+		DiskVCB->FreeBlockBitMap.push_back(1);
+	}
+	// Build the free space statistics from the new bit map
+	buildFSStats();
+	// A new disk holds no files
+	DiskStats.numFiles = 0;
+	DiskStats.numFileExtents = 0;
+	DiskStats.unusedEntries = 0;
+	return 1;
+}
+
+
+
+
+/*
+ * Builds the free space statistics from the free space bit map
+ *	This method resets the statistics and records every run of
+ *	free blocks found in the bit map. Afterwards the statistics are
+ *	kept up to date by updateFreeSpace().
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int VirtualDisk::buildFSStats(){
+	int runStart = -1;
+	DiskStats.largestFreeExtent = 0;
+	DiskStats.numFreeExtents = 0;
+	DiskStats.freeExtentHistogram.assign(DiskVCB->totalBlockNum+1, 0);
+	DiskStats.freeRunEnd.assign(DiskVCB->totalBlockNum, -1);
+	DiskStats.freeRunStart.assign(DiskVCB->totalBlockNum, -1);
+	for (int i=0; i <= DiskVCB->totalBlockNum; i++){
+		if (i < DiskVCB->totalBlockNum && isFreeBlock(i)){
+			// Start of a new free run
+			if (runStart == -1){
+				runStart = i;
+			}
+		} else if (runStart != -1){
+			// End of the current free run
+			addFreeExtent(runStart, i-1);
+			runStart = -1;
+		}
+	}
+	return 1;
+}
+
+
+
+
+/*
+ * Builds the file statistics from the directory
+ *	This method resets the extents and unused entries of every file
+ *	and records them again from the file's blocks, as after a rollback
+ *	the directory and data blocks are restored but the statistics are
+ *	not. Afterwards they are kept up to date by recordFileStats().
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int VirtualDisk::buildFileStats(){
+	// Run the file statistics of the allocation method
+	return withPolicy([&]<class Policy>(Policy){ return buildFileStatsAs<Policy>(); });
+}
+
+
+/*
+ * Builds the file statistics with the kernels of one allocation policy
+ *
+ */
+template <class Policy>
+int VirtualDisk::buildFileStatsAs(){
+	int entriesPerBlock = Policy::entriesPerBlock(DiskVCB->blockSize);
+	iNode* dir = getDir();
+	// Keep the nodes of the old records for the new ones
+	while (!DiskStats.fileExtents.empty()){
+		spareFileRecords.push_back(DiskStats.fileExtents.extract(DiskStats.fileExtents.begin()));
+	}
+	DiskStats.numFiles = 0;
+	DiskStats.numFileExtents = 0;
+	DiskStats.unusedEntries = 0;
+	for (int i=0;i<getDirSize();i++){
+		if (dir[i].FileIdentifier == -1){
+			continue;
+		}
+		vector<int> fileBlocks;
+		blocksKernel(Policy(), &dir[i], fileBlocks);
+		int dataCount = 0;
+		for (int j=0;j<fileBlocks.size();j++){
+			dataCount += getBlockFill(fileBlocks[j], entriesPerBlock);
+		}
+		recordFileStats(dir[i].FileIdentifier, extentsKernel(Policy(), &dir[i], fileBlocks), fileBlocks.size()*entriesPerBlock - dataCount);
+	}
+	return 1;
+}
+
+
+/*
+ * Prints Volume Control Block (current disk configuration)
+ *	This method prints the current virtual disk configurations 
+ *
+ * Output:
+ *		Total entries available for the disk
+ *		Block Size (Number of entries per block)
+ *		Total number of blocks
+ *		Number of free blocks
+ *		Free block bit map
+ *		Allocation Method
+ *		
+ */
+void VirtualDisk::printVCB(){
+	DiskOut << endl << "Your virtual disk has been configured successfully." << endl;
+	DiskOut << endl << "Disk Properties" << endl;
+	DiskOut << "\t> Total entries available: " << MAX_ELEMENTS << endl;
+	DiskOut << "\t> Block Size: " << DiskVCB->blockSize << endl;
+	DiskOut << "\t> Total number of blocks: " << DiskVCB->totalBlockNum << endl;
+	DiskOut << "\t> Number of free blocks: " << DiskVCB->numFreeBlock << endl;
+	//DiskOut << "\t> Free block bit map: " << DiskVCB->FreeBlockBitMap << endl;
+	DiskOut << "\t> Allocation Method: " << allocationMethod << " => ";
+	// Switch case to translate DiskVCB->s allocationMethod int to the respective allocation method name
+	switch (allocationMethod){				
+		case (1): {
+			DiskOut << "Contiguous allocation" << endl;
+			break;
+		}
+		case (2): {
+			DiskOut << "Linked allocation" << endl;
+			break;
+		}
+		case (3): {
+			DiskOut << "Indexed allocation" << endl;
+			break;
+		}
+		case (4): {
+			DiskOut << "Contiguous Indexed allocation" << endl;
+			break;
+		}
+		case (5): {
+			DiskOut << "Log-structured allocation" << endl;
+			break;
+		}
+	}
+	DiskOut << endl;
+
+}
+
+
+
+
+/*
+ * Prints the disk map to console
+ *	This method goes through the virtual disk to print
+ *	the data in the disk, then calls the method to print
+ *	the free block bit map. The blocks of the directory tree show the
+ *	keys of their nodes.
+ *
+ * Output:
+ *		Block index
+ *		Entry index
+ *		Entry data
+ *		
+ */
+void VirtualDisk::printDiskMap(){
+	iNode* tempDirPtr = DiskDir;
+	DiskOut << endl;			
+	// Print formatting of headers
+	DiskOut << setw(printDiskMapWidth) << "Block" << setw(printDiskMapWidth) << "Index" << setw(printDiskMapWidth) << "Data" << endl;
+	// Loop for each entry in our disk
+	for (int i=0; i < MAX_ELEMENTS; i++){
+		// Print block divider for visual identification
+		if (i % DiskVCB->blockSize == 0){
+			DiskOut << "=======================================" << endl;
+		} else {
+			// Print entry divider for visual identification
+			DiskOut << "---------------------------------------" << endl;		
+		}
+
+		// Print Superblock (VCB + Directory Structure)
+		if (i < DiskVCB->blockSize){
+			DiskOut << setw(printDiskMapWidth) << nearbyint(i/DiskVCB->blockSize) << setw(printDiskMapWidth) << i << setw(printDiskMapWidth);
+			if (i == 0){
+				// VCB
+				DiskOut << DiskVCB->totalBlockNum << "," << DiskVCB->numFreeBlock << "," << DiskVCB->blockSize << ",";
+				DiskOut << "[";
+				for (int j=0; j < DiskVCB->totalBlockNum;j++){
+					DiskOut << isFreeBlock(j);
+				}
+				DiskOut << "]" << endl;
+			} else if (DiskDirTree){
+				// Directory tree - the first inode entry points to the root node
+				if (i == 1 && DiskDirTree->getRootBlock() != -1){
+					// Print the root block and number of files
+					DiskOut << "root:" << DiskDirTree->getRootBlock() << "," << DiskDirTree->getNumFiles() << endl;
+				} else {
+					DiskOut << "-" << endl;
+				}
+			} else {
+				// Directory Structure (inodes)
+				if (tempDirPtr->FileIdentifier == -1){
+					// File identifier is -1 (unused), print '-'' instead
+					DiskOut << "-" << endl;	
+				} else {
+					// Print file identifier and the inode fields of the allocation method
+					DiskOut << tempDirPtr->FileIdentifier << ",";
+					withPolicy([&]<class Policy>(Policy){ Policy::printINode(DiskOut, tempDirPtr); });
+					DiskOut << endl;
+				}
+				// Move directory structure pointer to the next entry
+				tempDirPtr++;
+			}
+		} else{
+			// Print Disk Data
+			if (DiskDirTree && DiskDirTree->isNodeBlock(DiskData[i-DiskVCB->blockSize].block)){
+				// Metadata block of the directory tree
+				// Set formatting and print block number and index
+				DiskOut << setw(printDiskMapWidth) << DiskData[i-DiskVCB->blockSize].block << setw(printDiskMapWidth) << DiskData[i-DiskVCB->blockSize].index << setw(printDiskMapWidth);
+				int64_t nodeKey = DiskDirTree->getNodeKey(DiskData[i-DiskVCB->blockSize].block, i % DiskVCB->blockSize);
+				if (nodeKey != -1){
+					// Print the key held by the node
+					DiskOut << "dir:" << nodeKey << endl;
+				} else {
+					// Print unused key placeholder
+					DiskOut << "dir" << endl;
+				}
+			} else {
+				// Set formatting and print block number and index
+				DiskOut << setw(printDiskMapWidth) << DiskData[i-DiskVCB->blockSize].block << setw(printDiskMapWidth) << DiskData[i-DiskVCB->blockSize].index << setw(printDiskMapWidth);
+				// If data entry is not -1 (used) and not left behind by a lazy delete
+				if (DiskData[i-DiskVCB->blockSize].data != -1 && !isStaleBlock(DiskData[i-DiskVCB->blockSize].block)){
+					// If data entry length is specified (contiguous indexed extent in an index block)
+					if (DiskData[i-DiskVCB->blockSize].length != -1){
+						// Print file data and length
+						DiskOut << DiskData[i-DiskVCB->blockSize].data << "," << DiskData[i-DiskVCB->blockSize].length <<  endl;
+					} else {
+						// Print file data
+						DiskOut << DiskData[i-DiskVCB->blockSize].data <<  endl;
+					}
+				} else {
+					// Print empty placeholder
+					DiskOut << "-" << endl;
+				}			
+			}
+		}
+	}
+	// Print ending divider
+	DiskOut << "=======================================" << endl;
+	if (DiskDirTree){
+		// Print the metadata blocks of the directory tree
+		DiskDirTree->printUsage();
+	}
+	// Call method to print the free space bit map of our disk.
+	printFreeSpaceBitMap();
+}
+
+
+
+
+/*
+ * Prints the free space bit map to console
+ *	This method goes into the virtual disk's VCB to access the
+ *	free block bit map, then prints out the bit map to console.
+ *
+ * Output:
+ *		Printout of free space bit map array with:
+ *		'0' for a used block
+ * 		'1' for a free block
+ *		
+ */
+void VirtualDisk::printFreeSpaceBitMap(){
+	// Print heading + number of free space / total free space
+	DiskOut << endl << "Free space bit map ("<< DiskVCB->numFreeBlock << "/" << DiskVCB->totalBlockNum << ")" << endl;
+	DiskOut << "[";
+	for (int j=0; j < DiskVCB->totalBlockNum;j++){
+		// Print each bit of the bit map
+		DiskOut << isFreeBlock(j);
+	}
+	DiskOut << "]" << endl << endl;
+}
+
+
+
+
+
+/*
+ * Prints the free space statistics to console
+ *	This method prints the statistics maintained by updateFreeSpace()
+ *	and the per file extent records.
+ *
+ * Output:
+ *		Free blocks, free extents and largest free extent
+ *		Free extent histogram (run length: number of runs)
+ *		External fragmentation index
+ *		Average extents per file
+ *		Internal fragmentation (unused entries in last blocks)
+ *
+ */
+void VirtualDisk::printFSStats(){
+	streamsize defaultPrecision = DiskOut.precision();
+	DiskOut << "Free space statistics" << endl;
+	DiskOut << "\t> Free blocks: " << DiskVCB->numFreeBlock << "/" << DiskVCB->totalBlockNum << endl;
+	DiskOut << "\t> Free extents: " << DiskStats.numFreeExtents << endl;
+	DiskOut << "\t> Largest free extent: " << DiskStats.largestFreeExtent << " block(s)" << endl;
+	DiskOut << "\t> Free extent histogram (length:count): ";
+	for (int i=1; i < DiskStats.freeExtentHistogram.size(); i++){
+		if (DiskStats.freeExtentHistogram[i] > 0){
+			DiskOut << i << ":" << DiskStats.freeExtentHistogram[i] << " ";
+		}
+	}
+	DiskOut << endl;
+	DiskOut << "\t> External fragmentation: " << fixed << setprecision(2) << getExternalFragmentation() << endl;
+	DiskOut << "\t> Files: " << DiskStats.numFiles << endl;
+	DiskOut << "\t> Average extents per file: " << getAverageFileExtents() << endl;
+	DiskOut.unsetf(ios::floatfield);
+	DiskOut.precision(defaultPrecision);
+	DiskOut << "\t> Internal fragmentation: " << DiskStats.unusedEntries << " unused entries" << endl << endl;
+	if (DiskLog){
+		// Segment usage and cleaner statistics of the log
+		DiskLog->printLogStats();
+	}
+}
+
+
+
+
+
+/*
+ * Prints the statistics of the operation arena
+ *	Overflows are allocations that did not fit in the arena's buffer
+ *	and went to the heap.
+ *
+ */
+void VirtualDisk::printArenaStats(){
+	DiskOut << "Operation arena" << endl;
+	DiskOut << "\t> Operations: " << DiskArena->getResets() << endl;
+	DiskOut << "\t> Peak use: " << DiskArena->getPeakBytes() << "/" << DiskArena->getCapacity() << " bytes" << endl;
+	DiskOut << "\t> Heap overflows: " << DiskArena->getOverflows() << endl << endl;
+}
+
+
+/*
+ * Prints the memory of the compressed free block map and the time
+ * of the requestBlocks searches on it
+ *
+ */
+void VirtualDisk::printFreeMapStats(){
+	streamsize defaultPrecision = DiskOut.precision();
+	DiskOut << fixed << setprecision(3);
+	DiskOut << "Free space map" << endl;
+	DiskOut << "\t> Dense bit map: " << DiskVCB->FreeBlockBitMap.capacity()*sizeof(int) << " bytes (released, " << DiskVCB->totalBlockNum*sizeof(int) << " bytes when in use)" << endl;
+	DiskOut << "\t> Compressed map: " << DiskFreeMap->getMemoryBytes() << " bytes (" << DiskFreeMap->getNumContainers(containerArray) << " array, ";
+	DiskOut << DiskFreeMap->getNumContainers(containerBitmap) << " bitmap, " << DiskFreeMap->getNumContainers(containerRun) << " run containers)" << endl;
+	DiskOut << "\t> requestBlocks searches: " << freeMapQueries;
+	if (freeMapQueries > 0){
+		DiskOut << " (" << compressedQueryTime/freeMapQueries << " us each)";
+	}
+	DiskOut << endl << endl;
+	DiskOut.unsetf(ios::floatfield);
+	DiskOut.precision(defaultPrecision);
+}
+
+
+/*
+ * Prints the statistics of lazy deletion
+ *	Stale blocks are retired blocks that have not been reused yet.
+ *
+ */
+void VirtualDisk::printLazyDeleteStats(){
+	int staleBlocks = 0;
+	for (int block=1;block<DiskVCB->totalBlockNum;block++){
+		staleBlocks += isStaleBlock(block);
+	}
+	DiskOut << "Lazy deletion" << endl;
+	DiskOut << "\t> Blocks retired: " << blocksRetired << endl;
+	DiskOut << "\t> Blocks cleared on reuse: " << blocksScrubbed << endl;
+	DiskOut << "\t> Stale blocks: " << staleBlocks << endl << endl;
+}
+
+
+
+
+
+/*
+ * Adds file data to virtual disk
+ *	This method checks if the requested file to be added exists in the file
+ *  directory. If yes, the file will not be added. If the file does not exists,
+ *	blocks will be requested to store the file on the virtual disk, and respectively
+ *	saved to disk using the respective allocated methods. The entries are
+ *	taken out of fileContents as they are written, so the caller's queue
+ *	is not copied.
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if unsuccessful
+ *		
+ */
+int VirtualDisk::addFile(int64_t fileName, queue<string> &fileContents){
+	// Run the add operation of the allocation method
+	return withPolicy([&]<class Policy>(Policy){ return addFileAs<Policy>(fileName, fileContents); });
+}
+
+
+/*
+ * Adds file data with the kernels of one allocation policy
+ *
+ */
+template <class Policy>
+int VirtualDisk::addFileAs(int64_t fileName, queue<string> &fileContents){
+	// Record the latency and cost of the operation (no-op without -DdiskMetrics)
+	metricScope(metricOpAdd);
+	// Reset the access time and simulated device time of the operation
+	beginOperation();
+	// Trace the operation and its phases (no-op without -DdiskTrace)
+	traceScope("addFile", this);
+	traceArg("file", fileName);
+	// Check if file name exists in the directory structure
+	iNode* tempDirPtr = checkINode(fileName);
+	// Increment access time and charge the directory read to the device (Accessed memory)
+	accessDirectory();
+	if (tempDirPtr){
+		// Existing file name found in directory structure
+		DiskOut << "Adding file " << fileName << "." << endl;		
+		DiskOut << "Error: File " << fileName << " already exists in the virtual disk." << endl << endl;
+		return 0;
+	} else if (DiskDirTree){
+		// File does not exist in the directory tree, insert it (a full node is split into a new metadata block)
+		preserveTree();
+		tempDirPtr = DiskDirTree->insert(fileName);
+		// Increment access time and charge the node reads and writes to the device (Accessed memory)
+		accessDirectory(true);
+	} else {
+		// File does not exist in directory structure, request for new iNode entry in directory structure
+		tempDirPtr = checkINode();
+		// Increment access time and charge the read to the device (Accessed memory)
+		accessBlock(0);
+	}
+	if (tempDirPtr){
+		// iNode entry obtained successfully
+		// Run the add kernel of the allocation method
+		int added;
+		{
+			// Trace the data copy of the kernel (no-op without -DdiskTrace)
+			traceScope("copyData", this);
+			added = addKernel(Policy(), tempDirPtr, fileName, fileContents);
+		}
+		if (!added){
+			if (DiskDirTree){
+				// File not added, take it out of the directory tree again
+				DiskDirTree->erase(fileName);
+			}
+			return 0;
+		}
+		// Print the access time and simulated device time of the operation
+		printAccessTime();
+		return 1;
+	} else {
+		DiskOut << "Adding file " << fileName << "." << endl;		
+		DiskOut << "Error: File system unable to support any more files." << endl << endl;
+		return 0;
+	}
+}
+
+
+
+/*
+ * Adds a file with allocation method 1 - Contiguous
+ *
+ */
+int VirtualDisk::addKernel(ContiguousPolicy, iNode* tempDirPtr, int64_t fileName, queue<string> &fileContents){
+	int allocatedBlockStartingAddr = 0;
+	int allocatedBlock = 0;
+	int dataCount = fileContents.size();
+	// Calculate the number of blocks needed to store the file
+	int blocksNeeded = ceil(fileContents.size()*1.00 / DiskVCB->blockSize);
+	// Check if there is enough free blocks to support the file
+	if (ceil(fileContents.size()*1.00 / DiskVCB->blockSize) > DiskVCB->numFreeBlock){
+		// Number of blocks exceeds available number of free blocks on the virtual disk
+		DiskOut << "Adding file " << fileName << "." << endl;		
+		DiskOut << "Error: File "<< fileName <<"'s size exceeds available space on the virtual disk." << endl << endl;
+		return 0;
+	}
+	// Request for contiguous chunk of blocks
+	allocatedBlock = requestBlocks(blocksNeeded);
+	// Check if allocation was successful
+	if (allocatedBlock != -1){
+		// Contiguous block available
+		DiskOut << "Adding file " << fileName << " and found free block starting at " << allocatedBlock << endl;
+		// Calculate the position of the block in disk data
+		allocatedBlockStartingAddr = (allocatedBlock*DiskVCB->blockSize) - DiskVCB->blockSize;
+		DiskOut << "Added file " << fileName << " at ";
+		// Loop through every entry of the file
+		for(int i=0;i < dataCount;i++){
+			if (i % DiskVCB->blockSize == 0){
+				// Printing of allocation block number
+				DiskOut << "B" << DiskData[allocatedBlockStartingAddr+i].block << "(";
+				DiskOut << fileContents.front();
+				if(fileContents.size() > 1){
+					DiskOut << ",";
+				} else {
+					DiskOut << ") ";
+				}
+			} else {
+				// Printing of file content
+				DiskOut << fileContents.front();
+				if(fileContents.size() > 1 && i % DiskVCB->blockSize != DiskVCB->blockSize-1){
+					DiskOut << ",";
+				} else {
+					DiskOut << ") ";
+				}
+			}
+			// Write file entry to disk data
+			writeEntry(allocatedBlockStartingAddr+i, stoi(fileContents.front()));
+			// Delete file entry from the queue
+			fileContents.pop();
+		}
+		// Update the file's inode in the directory structure
+		updateINodeAs<ContiguousPolicy>(tempDirPtr, fileName, allocatedBlock, blocksNeeded);
+		// Increment access time and charge the write to the device (Accessed memory)
+		accessBlock(0, true);
+		// Update the free space bit map and number of free blocks
+		updateFreeSpace(allocatedBlock, blocksNeeded);					
+		// Increment access time and charge the write to the device (Accessed memory)
+		accessBlock(0, true);
+		// Record one extent and the unused entries of the last block
+		recordFileStats(fileName, 1, blocksNeeded*DiskVCB->blockSize - dataCount);
+	} else {
+		// No contiguous block available
+		DiskOut << "No available space in disk found." << endl;
+		return 0;
+	}
+	DiskOut << endl;
+	return 1;
+}
+
+
+/*
+ * Adds a file with allocation method 2 - Linked
+ *
+ */
+int VirtualDisk::addKernel(LinkedPolicy, iNode* tempDirPtr, int64_t fileName, queue<string> &fileContents){
+	int allocatedBlockStartingAddr = 0;
+	int allocatedBlock = 0;
+	int dataCount = fileContents.size();
+	// Calculate the number of blocks needed to store the file and if there is enough free blocks to support the file
+	if (ceil(fileContents.size()*1.00 / (DiskVCB->blockSize-1)) > DiskVCB->numFreeBlock){
+		// Number of blocks exceeds available number of free blocks on the virtual disk
+		DiskOut << "Adding file " << fileName << "." << endl;
+		DiskOut << "Error: File "<< fileName <<"'s size exceeds available space on the virtual disk." << endl;
+		return 0;
+	}
+	int firstAllocatedBlock;
+	for(int i=0; i < dataCount; i++){
+		if (fileContents.size() != 0){
+			if (fileContents.size() == dataCount){
+				// Request 1 block as head of linked list
+				allocatedBlock = requestBlocks(1);
+				// Save the head block
+				firstAllocatedBlock = allocatedBlock;
+				DiskOut << "Adding file " << fileName << " and found free block starting at " << firstAllocatedBlock << endl;
+				DiskOut << "Added file " << fileName << " at ";		
+				if (allocatedBlock != -1){
+					// If allocation successful, update free space bit map
+					updateFreeSpace(allocatedBlock, 1);
+					// Increment access time and charge the write to the device (Accessed memory)
+					accessBlock(0, true);
+					// Calculate the position of the block in the disk data
+					allocatedBlockStartingAddr = (allocatedBlock*DiskVCB->blockSize) - DiskVCB->blockSize;
+					DiskOut << "B" << allocatedBlock << "(";
+				} else {
+					// No blocks allocated
+					DiskOut << "No available space in disk found." << endl;
+					return 0;
+				}
+			}
+			if (allocatedBlock != -1){
+				// Print the file entry
+				DiskOut << fileContents.front();
+				if(fileContents.size() > 1 && i % (DiskVCB->blockSize-1) != DiskVCB->blockSize-2){
+					DiskOut << ",";
+				} else {
+					DiskOut << ") ";
+				}
+				// Write file entry to disk data
+				writeEntry(allocatedBlockStartingAddr+(i % (DiskVCB->blockSize-1)), stoi(fileContents.front()));
+				// Delete file entry from the queue
+				fileContents.pop();
+			} else {
+				// No block available
+				DiskOut << "No available space in disk found." << endl;
+				return 0;
+			}		
+			if(i % (DiskVCB->blockSize-1) == DiskVCB->blockSize-2 && fileContents.size() != 0){
+				// Before reaching the last entry of the block, request for the next block to set the next block pointer
+				allocatedBlock = requestBlocks(1);
+				if (allocatedBlock != -1){
+					// Write the next block pointer to disk data
+					writeEntry(allocatedBlockStartingAddr+(i % (DiskVCB->blockSize-1))+1, allocatedBlock);
+					// Update free space bit map
+					updateFreeSpace(allocatedBlock, 1);
+					// Calculate offset of the next block in the disk data
+					allocatedBlockStartingAddr = (allocatedBlock*DiskVCB->blockSize) - DiskVCB->blockSize;
+					DiskOut << "B" << allocatedBlock << "(";
+				}
+			}
+		}
+	}
+	// Update the file's inode in the directory structure
+	updateINodeAs<LinkedPolicy>(tempDirPtr, fileName, firstAllocatedBlock, allocatedBlock);
+	// Increment access time and charge the write to the device (Accessed memory)
+	accessBlock(0, true);
+	// Record the chain length and the unused entries of the last block
+	int chainLength = ceil(dataCount*1.00 / (DiskVCB->blockSize-1));
+	recordFileStats(fileName, chainLength, chainLength*(DiskVCB->blockSize-1) - dataCount);
+	DiskOut << endl;
+	return 1;
+}
+
+
+/*
+ * Adds a file with allocation method 3 - Indexed
+ *
+ */
+int VirtualDisk::addKernel(IndexedPolicy, iNode* tempDirPtr, int64_t fileName, queue<string> &fileContents){
+	int allocatedBlockStartingAddr = 0;
+	int allocatedBlock = 0;
+	int dataCount = fileContents.size();
+	// Calculate the number of blocks needed to store the file and if there is enough free blocks to support the file
+	if ((ceil(fileContents.size() > DiskVCB->blockSize*DiskVCB->blockSize)) || ((fileContents.size()/ DiskVCB->blockSize)+1) > DiskVCB->numFreeBlock){
+		DiskOut << "Adding file " << fileName << "." << endl;		
+		DiskOut << "Error: File "<< fileName <<"'s size exceeds available space on the virtual disk." << endl << endl;
+		return 0;
+	}
+	int indexBlock = 0;
+	if(dataCount == fileContents.size()){
+		// Request for indx block
+		indexBlock = requestBlocks(1);
+		// Increment access time and charge the read to the device (Accessed memory)
+		accessBlock(0);
+		// Update free space bit map
+		updateFreeSpace(indexBlock, 1);
+	}
+	int firstAllocatedBlock = 0;
+	// Loop for every file entry
+	for(int i=0; i < dataCount; i++){
+		if (fileContents.size() != 0){
+			// For every new block of data
+			if(i % DiskVCB->blockSize == 0){
+				// Request for one block
+				allocatedBlock = requestBlocks(1);
+				// Increment access time and charge the read to the device (Accessed memory)
+				accessBlock(0);
+				if (allocatedBlock != -1){
+					// Calculate position of current block in disk data
+					allocatedBlockStartingAddr = (indexBlock*DiskVCB->blockSize) - DiskVCB->blockSize;
+					// Save data block to index block
+					writeEntry(allocatedBlockStartingAddr+(i / DiskVCB->blockSize), allocatedBlock);
+					// Update free block bit map
+					updateFreeSpace(allocatedBlock, 1);
+					if (dataCount == fileContents.size()){
+						// Save first allocated block
+						firstAllocatedBlock = allocatedBlock;
+						DiskOut << "Adding file " << fileName << " and found free block starting at " << firstAllocatedBlock << endl;
+						DiskOut << "Added file " << fileName << " at ";		
+					}
+					// Calculate position of allocated block in disk data
+					allocatedBlockStartingAddr = (allocatedBlock*DiskVCB->blockSize) - DiskVCB->blockSize;
+					DiskOut << "B" << allocatedBlock << "(";
+				} else {
+					DiskOut << "No available space in disk found." << endl;
+					return 0;
+				}
+			}
+			if (allocatedBlock != -1){
+				// Print file entry
+				DiskOut << fileContents.front();
+				if(fileContents.size() > 1 && i % DiskVCB->blockSize != DiskVCB->blockSize-1){
+					DiskOut << ",";
+				} else {
+					DiskOut << ") ";
+				}
+				// Write file entry to disk data
+				writeEntry(allocatedBlockStartingAddr+(i % DiskVCB->blockSize), stoi(fileContents.front()));
+				// Delete file entry from the queue
+				fileContents.pop();
+			} else {
+				DiskOut << "No available space in disk found." << endl;
+				return 0;
+			}
+		}
+	}
+	DiskOut << endl;
+	// Update the file's inode in the directory structure
+	updateINodeAs<IndexedPolicy>(tempDirPtr, fileName, indexBlock);
+	// Increment access time and charge the write to the device (Accessed memory)
+	accessBlock(0, true);
+	// Record the index entries and the unused entries of the last block
+	int dataBlocks = ceil(dataCount*1.00 / DiskVCB->blockSize);
+	recordFileStats(fileName, dataBlocks, dataBlocks*DiskVCB->blockSize - dataCount);
+	return 1;
+}
+
+
+/*
+ * Adds a file with allocation method 4 - Contiguous Indexed
+ *
+ */
+int VirtualDisk::addKernel(ContiguousIndexedPolicy, iNode* tempDirPtr, int64_t fileName, queue<string> &fileContents){
+	int allocatedBlockStartingAddr = 0;
+	int allocatedBlock = 0;
+	int dataCount = fileContents.size();
+	// Calculate total number of blocks needed
+	int blocksNeeded = ceil(fileContents.size()*1.00 / DiskVCB->blockSize);
+	// Check if there is enough free blocks to support the file (total blocks needed + 1 index block)
+	if(blocksNeeded+1 > DiskVCB->numFreeBlock){
+		DiskOut << "Adding file " << fileName << "." << endl;		
+		DiskOut << "Error: File "<< fileName <<"'s size exceeds available space on the virtual disk." << endl << endl;
+		return 0;
+	} else {
+		// Request index block
+		int indexBlock = requestBlocks(1);
+		// Increment access time and charge the read to the device (Accessed memory)
+		accessBlock(0);
+		int entriesUsed = 0;
+		std::pmr::map<int, int> blocksToUse(DiskArena);
+		// Update free space bit map
+		updateFreeSpace(indexBlock, 1);
+		int tempBlockNum = blocksNeeded;
+		// Preprocess blocks needed for the file
+		while (tempBlockNum > 0 && blocksNeeded > 0){
+			// Get the chunks of blocks necessary for the file
+			if(entriesUsed == DiskVCB->blockSize){
+				// File entries exceeded index block capacity
+				DiskOut << "Error: File "<< fileName <<"'s size exceeds available space on the virtual disk." << endl << endl;
+				// Release reserved blocks if allocation failed - Index block
+				updateFreeSpace(indexBlock,1,1);
+				int tempBlock, tempLength;
+				while(blocksToUse.empty() == false){
+					// Get block index
+					tempBlock = blocksToUse.begin()->first;
+					// Get block length
+					tempLength = blocksToUse.begin()->second;
+					// Release reserved blocks - File data blocks
+					updateFreeSpace(tempBlock, tempLength, 1);
+					// Delete the block data from our map
+					blocksToUse.erase(blocksToUse.begin());
+				}
+				return 0;
+			}
+			// Request a contiguous chunk of blocks
+			allocatedBlock = requestBlocks(tempBlockNum);
+			// Increment access time and charge the read to the device (Accessed memory)
+			accessBlock(0);
+			if(allocatedBlock == -1){
+				// If no available chunk of blocks of the size, decrement the number
+				tempBlockNum--;
+			} else {
+				// Update free space bit map with allocated chunk of blocks
+				updateFreeSpace(allocatedBlock, tempBlockNum);
+				// Insert the allocated block and length of the blocks into the map
+				blocksToUse.insert(std::pair<int,int>(allocatedBlock, tempBlockNum));
+				blocksNeeded -= tempBlockNum;
+				tempBlockNum = blocksNeeded;
+				entriesUsed++;
+			}
+		}
+		// File can be supported on the virtual disk.
+		int blockLen = 0;
+		int indexBlockOffset = 0;
+		DiskOut << "Adding file " << fileName << " with index block at " << indexBlock << endl;
+		DiskOut << "Added file " << fileName << " at ";
+		// Proceed to save to disk data
+		while(blocksToUse.empty() == false){
+			// Get the first allocated block number
+			allocatedBlock = blocksToUse.begin()->first;
+			// Get the first length of the block
+			blockLen = blocksToUse.begin()->second;
+			// Calculate position of allocated block in disk data
+			allocatedBlockStartingAddr = (allocatedBlock*DiskVCB->blockSize) - DiskVCB->blockSize;
+			// Loop for totol length of the blocks
+			for(int i=0;i < (blockLen*DiskVCB->blockSize);i++){
+				if (fileContents.size() != 0){
+					// For every new 'block'
+					if (i % DiskVCB->blockSize == 0){
+						// Print block details
+						DiskOut << "B" << DiskData[allocatedBlockStartingAddr+i].block << "(";
+						DiskOut << fileContents.front();
+						if(fileContents.size() > 1){
+							DiskOut << ",";
+						} else {
+							DiskOut << ") ";
+						}
+					} else {
+						// Print file data
+						DiskOut << fileContents.front();
+						if(fileContents.size() > 1 && i % DiskVCB->blockSize != DiskVCB->blockSize-1){
+							DiskOut << ",";
+						} else {
+							DiskOut << ") ";
+						}
+					}
+					// Write file entry to disk data
+					writeEntry(allocatedBlockStartingAddr+i, stoi(fileContents.front()));
+					// Delete file entry from the queue
+					fileContents.pop();
+				}
+			}
+			// Save the block number into index block
+			writeEntry((indexBlock*DiskVCB->blockSize)-DiskVCB->blockSize+indexBlockOffset, allocatedBlock);
+			// Save the block length into index block
+			writeExtent((indexBlock*DiskVCB->blockSize)-DiskVCB->blockSize+indexBlockOffset, allocatedBlock, blockLen);
+			// Increment index block offset
+			indexBlockOffset++;
+			// Delete the block data from our map
+			blocksToUse.erase(allocatedBlock);
+		}
+		// Update the file's inode in the directory structure
+		updateINodeAs<ContiguousIndexedPolicy>(tempDirPtr, fileName, indexBlock);
+		// Increment access time and charge the write to the device (Accessed memory)
+		accessBlock(0, true);
+		// Record the index entries and the unused entries of the last block
+		int dataBlocks = ceil(dataCount*1.00 / DiskVCB->blockSize);
+		recordFileStats(fileName, indexBlockOffset, dataBlocks*DiskVCB->blockSize - dataCount);
+	}
+	DiskOut << endl;
+	return 1;
+}
+
+
+/*
+ * Adds a file with allocation method 5 - Log-structured
+ *
+ */
+int VirtualDisk::addKernel(LogStructuredPolicy, iNode* tempDirPtr, int64_t fileName, queue<string> &fileContents){
+	int allocatedBlockStartingAddr = 0;
+	int allocatedBlock = 0;
+	int dataCount = fileContents.size();
+	// Calculate the number of data blocks needed (plus 1 index block) and check that one index block can hold them
+	int dataBlocks = ceil(dataCount*1.00 / DiskVCB->blockSize);
+	if (dataCount > DiskVCB->blockSize*DiskVCB->blockSize){
+		DiskOut << "Adding file " << fileName << "." << endl;		
+		DiskOut << "Error: File "<< fileName <<"'s size exceeds available space on the virtual disk." << endl << endl;
+		return 0;
+	}
+	// Make space at the log head, running the segment cleaner if needed
+	if (DiskLog->makeSpace(dataBlocks+1) == -1){
+		DiskOut << "Adding file " << fileName << "." << endl;		
+		DiskOut << "Error: File "<< fileName <<"'s size exceeds available space on the virtual disk." << endl << endl;
+		return 0;
+	}
+	// Data blocks are appended first, then the index block pointing to them
+	std::pmr::vector<int> dataBlockNumbers(DiskArena);
+	for(int i=0; i < dataCount; i++){
+		// For every new block of data
+		if(i % DiskVCB->blockSize == 0){
+			// Append one block at the log head
+			allocatedBlock = DiskLog->appendBlock(fileName);
+			dataBlockNumbers.push_back(allocatedBlock);
+			if (i == 0){
+				DiskOut << "Adding file " << fileName << " and appending it to the log at block " << allocatedBlock << endl;
+				DiskOut << "Added file " << fileName << " at ";
+			}
+			// Calculate position of allocated block in disk data
+			allocatedBlockStartingAddr = (allocatedBlock*DiskVCB->blockSize) - DiskVCB->blockSize;
+			DiskOut << "B" << allocatedBlock << "(";
+		}
+		// Print file entry
+		DiskOut << fileContents.front();
+		if(fileContents.size() > 1 && i % DiskVCB->blockSize != DiskVCB->blockSize-1){
+			DiskOut << ",";
+		} else {
+			DiskOut << ") ";
+		}
+		// Write file entry to disk data
+		writeEntry(allocatedBlockStartingAddr+(i % DiskVCB->blockSize), stoi(fileContents.front()));
+		// Delete file entry from the queue
+		fileContents.pop();
+	}
+	// Append the index block
+	int indexBlock = DiskLog->appendBlock(fileName);
+	DiskOut << "with index block B" << indexBlock << endl;
+	allocatedBlockStartingAddr = (indexBlock*DiskVCB->blockSize) - DiskVCB->blockSize;
+	for (int i=0; i < dataBlockNumbers.size(); i++){
+		// Save data block to index block
+		writeEntry(allocatedBlockStartingAddr+i, dataBlockNumbers[i]);
+	}
+	// Update the file's entry in the inode map
+	updateINodeAs<LogStructuredPolicy>(tempDirPtr, fileName, indexBlock);
+	// Increment access time and charge the write to the device (Accessed memory)
+	accessBlock(0, true);
+	// Record the index entries and the unused entries of the last block
+	recordFileStats(fileName, dataBlocks, dataBlocks*DiskVCB->blockSize - dataCount);
+	return 1;
+}
+
+
+
+/*
+ * Appends data to the end of a file on the virtual disk
+ *	The partial last block of the file is filled first, then only the
+ *	blocks needed for the remaining entries are added, so the cost of an
+ *	append grows with the appended data and not with the file size.
+ *	Contiguous files are extended in place when the blocks after them are
+ *	free (and moved to a larger run otherwise), linked files get new links
+ *	after their last block, indexed files get new index entries, contiguous
+ *	indexed files extend their last extent or add one new extent, and
+ *	log-structured files rewrite their last block and index block at the
+ *	log head.
+ *
+ * Input:
+ *		fileName - File to append to
+ *		fileContents - Entries to append (taken out of the queue as they are written)
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if unsuccessful
+ */
+int VirtualDisk::appendFile(int64_t fileName, queue<string> &fileContents){
+	// Run the append operation of the allocation method
+	return withPolicy([&]<class Policy>(Policy){ return appendFileAs<Policy>(fileName, fileContents); });
+}
+
+
+/*
+ * Appends data to a file with the kernels of one allocation policy
+ *
+ */
+template <class Policy>
+int VirtualDisk::appendFileAs(int64_t fileName, queue<string> &fileContents){
+	// Record the latency and cost of the operation (no-op without -DdiskMetrics)
+	metricScope(metricOpAppend);
+	int dataCount = fileContents.size();
+	// Reset the access time and simulated device time of the operation
+	beginOperation();
+	// Trace the operation and its phases (no-op without -DdiskTrace)
+	traceScope("appendFile", this);
+	traceArg("file", fileName);
+	// Check if file name exists in the directory structure
+	iNode* tempDirPtr = checkINode(fileName);
+	// Increment access time and charge the directory read to the device (Accessed memory)
+	accessDirectory();
+	DiskOut << "Appending " << dataCount << " entries to file " << fileName << "." << endl;
+	if (!tempDirPtr){
+		DiskOut << "Error: File " << fileName << " does not exist in the virtual disk." << endl << endl;
+		return 0;
+	}
+	// Previous extents and unused entries of the file
+	pair<int, int> fileRecord = DiskStats.fileExtents[fileName];
+	int entriesPerBlock = Policy::entriesPerBlock(DiskVCB->blockSize);
+	int newExtents = 0;
+	int newBlocks = 0;
+	// Run the append kernel of the allocation method
+	int appended;
+	{
+		// Trace the data copy of the kernel (no-op without -DdiskTrace)
+		traceScope("copyData", this);
+		appended = appendKernel(Policy(), tempDirPtr, fileName, fileContents, entriesPerBlock, newExtents, newBlocks);
+	}
+	if (!appended){
+		return 0;
+	}
+	// Record the new extents and the unused entries of the new last block
+	recordFileStats(fileName, fileRecord.first + newExtents, fileRecord.second + newBlocks*entriesPerBlock - dataCount);
+	// Print the access time and simulated device time of the operation
+	printAccessTime();
+	return 1;
+}
+
+
+
+/*
+ * Appends to a file with allocation method 1 - Contiguous
+ *
+ */
+int VirtualDisk::appendKernel(ContiguousPolicy, iNode* tempDirPtr, int64_t fileName, queue<string> &fileContents, int entriesPerBlock, int &newExtents, int &newBlocks){
+	int dataCount = fileContents.size();
+	int lastBlock = tempDirPtr->StartBlock + tempDirPtr->Length-1;
+	int lastEntries = getBlockFill(lastBlock, entriesPerBlock);
+	// Increment access time and charge the read to the device (Accessed memory)
+	accessBlock(lastBlock);
+	// Calculate the number of blocks needed after the last block is filled
+	newBlocks = max((int)ceil((dataCount-(entriesPerBlock-lastEntries))*1.00 / entriesPerBlock), 0);
+	if (newBlocks > DiskVCB->numFreeBlock){
+		DiskOut << "Error: File "<< fileName <<"'s size exceeds available space on the virtual disk." << endl << endl;
+		return 0;
+	}
+	// Check if the blocks after the file are free
+	bool inPlace = true;
+	for (int i=0;i<newBlocks;i++){
+		int nextBlock = tempDirPtr->StartBlock + tempDirPtr->Length + i;
+		if (nextBlock >= DiskVCB->totalBlockNum || !isFreeBlock(nextBlock)){
+			inPlace = false;
+			break;
+		}
+	}
+	// Increment access time and charge the read to the device (Accessed memory)
+	accessBlock(0);
+	// The file stays a single extent, whether it grows in place or moves
+	newExtents = 0;
+	if (inPlace){
+		if (newBlocks > 0){
+			// Extend the file into the blocks after it
+			updateFreeSpace(tempDirPtr->StartBlock + tempDirPtr->Length, newBlocks);
+			// Increment access time and charge the write to the device (Accessed memory)
+			accessBlock(0, true);
+		}
+	} else {
+		// Request a contiguous chunk of blocks for the whole file
+		int allocatedBlock = requestBlocks(tempDirPtr->Length + newBlocks);
+		// Increment access time and charge the read to the device (Accessed memory)
+		accessBlock(0);
+		if (allocatedBlock == -1){
+			DiskOut << "No available space in disk found." << endl << endl;
+			return 0;
+		}
+		DiskOut << "Moving file " << fileName << " to block " << allocatedBlock << " as the blocks after it are in use." << endl;
+		// Update the free space bit map and number of free blocks
+		updateFreeSpace(allocatedBlock, tempDirPtr->Length + newBlocks);
+		int fromAddr = (tempDirPtr->StartBlock*DiskVCB->blockSize) - DiskVCB->blockSize;
+		int toAddr = (allocatedBlock*DiskVCB->blockSize) - DiskVCB->blockSize;
+		for (int i=0;i < tempDirPtr->Length*DiskVCB->blockSize;i++){
+			// Increment access time and charge the read to the device (Accessed memory)
+			accessBlock(DiskData[fromAddr+i].block);
+			// Copy the entry to the new chunk
+			writeEntry(toAddr+i, DiskData[fromAddr+i].data);
+			// Clear the moved entry for the disk map (not written to the device)
+			writeEntry(fromAddr+i, -1, false);
+		}
+		// Release the old chunk
+		updateFreeSpace(tempDirPtr->StartBlock, tempDirPtr->Length, 1);
+		// Increment access time and charge the write to the device (Accessed memory)
+		accessBlock(0, true);
+		lastBlock = allocatedBlock + tempDirPtr->Length-1;
+		updateINodeAs<ContiguousPolicy>(tempDirPtr, fileName, allocatedBlock, tempDirPtr->Length);
+	}
+	DiskOut << "Appended to file " << fileName << " at ";
+	// Fill the partial last block, then the new blocks
+	appendEntries(lastBlock, lastEntries, entriesPerBlock, fileContents);
+	for (int i=1;i<=newBlocks;i++){
+		appendEntries(lastBlock+i, 0, entriesPerBlock, fileContents);
+	}
+	DiskOut << endl;
+	// Update the file's inode in the directory structure
+	updateINodeAs<ContiguousPolicy>(tempDirPtr, fileName, tempDirPtr->StartBlock, tempDirPtr->Length + newBlocks);
+	// Increment access time and charge the write to the device (Accessed memory)
+	accessBlock(0, true);
+	return 1;
+}
+
+
+/*
+ * Appends to a file with allocation method 2 - Linked
+ *
+ */
+int VirtualDisk::appendKernel(LinkedPolicy, iNode* tempDirPtr, int64_t fileName, queue<string> &fileContents, int entriesPerBlock, int &newExtents, int &newBlocks){
+	int dataCount = fileContents.size();
+	int lastBlock = tempDirPtr->LastBlock;
+	int lastEntries = getBlockFill(lastBlock, entriesPerBlock);
+	// Increment access time and charge the read to the device (Accessed memory)
+	accessBlock(lastBlock);
+	// Calculate the number of links needed after the last block is filled
+	newBlocks = max((int)ceil((dataCount-(entriesPerBlock-lastEntries))*1.00 / entriesPerBlock), 0);
+	if (newBlocks > DiskVCB->numFreeBlock){
+		DiskOut << "Error: File "<< fileName <<"'s size exceeds available space on the virtual disk." << endl << endl;
+		return 0;
+	}
+	DiskOut << "Appended to file " << fileName << " at ";
+	// Fill the partial last block
+	appendEntries(lastBlock, lastEntries, entriesPerBlock, fileContents);
+	while (!fileContents.empty()){
+		// Request 1 block as the new end of the linked list
+		int allocatedBlock = requestBlocks(1);
+		// Increment access time and charge the read to the device (Accessed memory)
+		accessBlock(0);
+		// Update free space bit map
+		updateFreeSpace(allocatedBlock, 1);
+		// Increment access time and charge the write to the device (Accessed memory)
+		accessBlock(0, true);
+		// Write the next block pointer to the previous last block
+		writeEntry((lastBlock*DiskVCB->blockSize)-1, allocatedBlock);
+		lastBlock = allocatedBlock;
+		appendEntries(lastBlock, 0, entriesPerBlock, fileContents);
+	}
+	DiskOut << endl;
+	// Update the file's inode in the directory structure
+	updateINodeAs<LinkedPolicy>(tempDirPtr, fileName, tempDirPtr->StartBlock, lastBlock);
+	// Increment access time and charge the write to the device (Accessed memory)
+	accessBlock(0, true);
+	newExtents = newBlocks;
+	return 1;
+}
+
+
+/*
+ * Appends to a file with allocation method 3 - Indexed
+ *
+ */
+int VirtualDisk::appendKernel(IndexedPolicy, iNode* tempDirPtr, int64_t fileName, queue<string> &fileContents, int entriesPerBlock, int &newExtents, int &newBlocks){
+	int dataCount = fileContents.size();
+	int indexBlockStartingAddr = (tempDirPtr->Index*DiskVCB->blockSize) - DiskVCB->blockSize;
+	int indexEntries = getBlockFill(tempDirPtr->Index, DiskVCB->blockSize);
+	// Increment access time and charge the read to the device (Accessed memory)
+	accessBlock(tempDirPtr->Index);
+	int lastBlock = DiskData[indexBlockStartingAddr+indexEntries-1].data;
+	int lastEntries = getBlockFill(lastBlock, entriesPerBlock);
+	// Increment access time and charge the read to the device (Accessed memory)
+	accessBlock(lastBlock);
+	// Calculate the number of index entries needed after the last block is filled
+	newBlocks = max((int)ceil((dataCount-(entriesPerBlock-lastEntries))*1.00 / entriesPerBlock), 0);
+	if (indexEntries+newBlocks > DiskVCB->blockSize || newBlocks > DiskVCB->numFreeBlock){
+		DiskOut << "Error: File "<< fileName <<"'s size exceeds available space on the virtual disk." << endl << endl;
+		return 0;
+	}
+	DiskOut << "Appended to file " << fileName << " at ";
+	// Fill the partial last block
+	appendEntries(lastBlock, lastEntries, entriesPerBlock, fileContents);
+	while (!fileContents.empty()){
+		// Request for one block
+		int allocatedBlock = requestBlocks(1);
+		// Increment access time and charge the read to the device (Accessed memory)
+		accessBlock(0);
+		// Update free block bit map
+		updateFreeSpace(allocatedBlock, 1);
+		// Save data block to index block
+		writeEntry(indexBlockStartingAddr+indexEntries, allocatedBlock);
+		indexEntries++;
+		appendEntries(allocatedBlock, 0, entriesPerBlock, fileContents);
+	}
+	DiskOut << endl;
+	newExtents = newBlocks;
+	return 1;
+}
+
+
+/*
+ * Appends to a file with allocation method 4 - Contiguous Indexed
+ *
+ */
+int VirtualDisk::appendKernel(ContiguousIndexedPolicy, iNode* tempDirPtr, int64_t fileName, queue<string> &fileContents, int entriesPerBlock, int &newExtents, int &newBlocks){
+	int dataCount = fileContents.size();
+	int indexBlockStartingAddr = (tempDirPtr->Index*DiskVCB->blockSize) - DiskVCB->blockSize;
+	int indexEntries = getBlockFill(tempDirPtr->Index, DiskVCB->blockSize);
+	// Increment access time and charge the read to the device (Accessed memory)
+	accessBlock(tempDirPtr->Index);
+	Data* lastExtent = &DiskData[indexBlockStartingAddr+indexEntries-1];
+	int lastBlock = lastExtent->data + lastExtent->length-1;
+	int lastEntries = getBlockFill(lastBlock, entriesPerBlock);
+	// Increment access time and charge the read to the device (Accessed memory)
+	accessBlock(lastBlock);
+	// Calculate the number of blocks needed after the last block is filled
+	newBlocks = max((int)ceil((dataCount-(entriesPerBlock-lastEntries))*1.00 / entriesPerBlock), 0);
+	if (newBlocks > DiskVCB->numFreeBlock){
+		DiskOut << "Error: File "<< fileName <<"'s size exceeds available space on the virtual disk." << endl << endl;
+		return 0;
+	}
+	// Extend the last extent into the free blocks after it
+	int extendLength = 0;
+	while (extendLength < newBlocks && lastBlock+1+extendLength < DiskVCB->totalBlockNum && isFreeBlock(lastBlock+1+extendLength)){
+		extendLength++;
+	}
+	// Increment access time and charge the read to the device (Accessed memory)
+	accessBlock(0);
+	if (extendLength > 0){
+		// Update free space bit map
+		updateFreeSpace(lastBlock+1, extendLength);
+	}
+	// Preprocess the new extents for the remaining blocks
+	std::pmr::map<int, int> blocksToUse(DiskArena);
+	int blocksNeeded = newBlocks - extendLength;
+	int tempBlockNum = blocksNeeded;
+	while (tempBlockNum > 0 && blocksNeeded > 0){
+		if (indexEntries + blocksToUse.size() == DiskVCB->blockSize){
+			// File entries exceeded index block capacity
+			DiskOut << "Error: File "<< fileName <<"'s size exceeds available space on the virtual disk." << endl << endl;
+			// Release reserved blocks if allocation failed
+			if (extendLength > 0){
+				updateFreeSpace(lastBlock+1, extendLength, 1);
+			}
+			while (blocksToUse.empty() == false){
+				updateFreeSpace(blocksToUse.begin()->first, blocksToUse.begin()->second, 1);
+				blocksToUse.erase(blocksToUse.begin());
+			}
+			return 0;
+		}
+		// Request a contiguous chunk of blocks
+		int allocatedBlock = requestBlocks(tempBlockNum);
+		// Increment access time and charge the read to the device (Accessed memory)
+		accessBlock(0);
+		if (allocatedBlock == -1){
+			// If no available chunk of blocks of the size, decrement the number
+			tempBlockNum--;
+		} else {
+			// Update free space bit map with allocated chunk of blocks
+			updateFreeSpace(allocatedBlock, tempBlockNum);
+			blocksToUse.insert(std::pair<int,int>(allocatedBlock, tempBlockNum));
+			blocksNeeded -= tempBlockNum;
+			tempBlockNum = blocksNeeded;
+		}
+	}
+	DiskOut << "Appended to file " << fileName << " at ";
+	// Fill the partial last block, then the blocks the last extent grew into
+	appendEntries(lastBlock, lastEntries, entriesPerBlock, fileContents);
+	for (int i=1;i<=extendLength;i++){
+		appendEntries(lastBlock+i, 0, entriesPerBlock, fileContents);
+	}
+	if (extendLength > 0){
+		// Save the new length of the last extent into the index block
+		writeExtent(lastExtent-DiskData, lastExtent->data, lastExtent->length+extendLength);
+	}
+	while (blocksToUse.empty() == false){
+		int allocatedBlock = blocksToUse.begin()->first;
+		int blockLen = blocksToUse.begin()->second;
+		for (int i=0;i<blockLen;i++){
+			appendEntries(allocatedBlock+i, 0, entriesPerBlock, fileContents);
+		}
+		// Save the block number and length of the new extent into the index block
+		writeExtent(indexBlockStartingAddr+indexEntries, allocatedBlock, blockLen);
+		indexEntries++;
+		newExtents++;
+		// Delete the block data from our map
+		blocksToUse.erase(allocatedBlock);
+	}
+	DiskOut << endl;
+	return 1;
+}
+
+
+/*
+ * Appends to a file with allocation method 5 - Log-structured
+ *
+ */
+int VirtualDisk::appendKernel(LogStructuredPolicy, iNode* tempDirPtr, int64_t fileName, queue<string> &fileContents, int entriesPerBlock, int &newExtents, int &newBlocks){
+	int dataCount = fileContents.size();
+	int indexEntries = getBlockFill(tempDirPtr->Index, DiskVCB->blockSize);
+	// Increment access time and charge the read to the device (Accessed memory)
+	accessBlock(tempDirPtr->Index);
+	int lastEntries = getBlockFill(DiskData[(tempDirPtr->Index-1)*DiskVCB->blockSize+indexEntries-1].data, entriesPerBlock);
+	// Calculate the number of blocks needed after the last block is filled
+	newBlocks = max((int)ceil((dataCount-(entriesPerBlock-lastEntries))*1.00 / entriesPerBlock), 0);
+	// A partial last block is rewritten at the log head
+	int rewriteBlocks = lastEntries < entriesPerBlock ? 1 : 0;
+	if (indexEntries+newBlocks > DiskVCB->blockSize){
+		DiskOut << "Error: File "<< fileName <<"'s size exceeds available space on the virtual disk." << endl << endl;
+		return 0;
+	}
+	// Make space at the log head for the written blocks and the new index block, running the segment cleaner if needed
+	if (DiskLog->makeSpace(rewriteBlocks+newBlocks+1) == -1){
+		DiskOut << "Error: File "<< fileName <<"'s size exceeds available space on the virtual disk." << endl << endl;
+		return 0;
+	}
+	// The cleaner may have moved the blocks of the file, read the index block after it
+	int oldIndexBlock = tempDirPtr->Index;
+	int indexBlockStartingAddr = (oldIndexBlock-1)*DiskVCB->blockSize;
+	std::pmr::vector<int> dataBlockNumbers(DiskArena);
+	for (int i=0;i<indexEntries;i++){
+		dataBlockNumbers.push_back(DiskData[indexBlockStartingAddr+i].data);
+	}
+	DiskOut << "Appended to file " << fileName << " at ";
+	if (rewriteBlocks > 0){
+		// Append a copy of the partial last block at the log head
+		int lastBlock = dataBlockNumbers.back();
+		int allocatedBlock = DiskLog->appendBlock(fileName);
+		int fromAddr = (lastBlock-1)*DiskVCB->blockSize;
+		int toAddr = (allocatedBlock-1)*DiskVCB->blockSize;
+		for (int i=0;i<lastEntries;i++){
+			// Increment access time and charge the read to the device (Accessed memory)
+			accessBlock(lastBlock);
+			// Write the entry and charge the write to the device (Accessed memory)
+			writeEntry(toAddr+i, DiskData[fromAddr+i].data);
+		}
+		for (int i=0;i<DiskVCB->blockSize;i++){
+			// Clear the dead entries for the disk map (not written to the device)
+			writeEntry(fromAddr+i, -1, false);
+		}
+		DiskLog->releaseBlock(lastBlock);
+		dataBlockNumbers.back() = allocatedBlock;
+		appendEntries(allocatedBlock, lastEntries, entriesPerBlock, fileContents);
+	}
+	while (!fileContents.empty()){
+		// Append one block at the log head
+		int allocatedBlock = DiskLog->appendBlock(fileName);
+		dataBlockNumbers.push_back(allocatedBlock);
+		appendEntries(allocatedBlock, 0, entriesPerBlock, fileContents);
+	}
+	// Append the new index block and release the old one
+	int indexBlock = DiskLog->appendBlock(fileName);
+	DiskOut << "with index block B" << indexBlock << endl;
+	for (int i=0;i<dataBlockNumbers.size();i++){
+		// Save data block to index block
+		writeEntry((indexBlock-1)*DiskVCB->blockSize+i, dataBlockNumbers[i]);
+	}
+	for (int i=0;i<DiskVCB->blockSize;i++){
+		// Clear the dead entries for the disk map (not written to the device)
+		writeEntry(indexBlockStartingAddr+i, -1, false);
+	}
+	DiskLog->releaseBlock(oldIndexBlock);
+	// Update the file's entry in the inode map
+	updateINodeAs<LogStructuredPolicy>(tempDirPtr, fileName, indexBlock, -1);
+	// Increment access time and charge the write to the device (Accessed memory)
+	accessBlock(0, true);
+	newExtents = newBlocks;
+	return 1;
+}
+
+
+
+
+/*
+ * Reads file data from virtual disk
+ *	This method checks if the requested file to be read exists in the file
+ *  directory. If yes, the file will be read. If the file does not exists,
+ *	an error is printed and the method ends.
+ *
+ * Input:
+ *		fileName - File to read
+ *		fileOffset - Entry to read (starting from 1), '0' to read the whole file
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if unsuccessful
+ *		
+ */
+int VirtualDisk::readFile(int64_t fileName, int64_t fileOffset){
+	// Run the read operation of the allocation method
+	return withPolicy([&]<class Policy>(Policy){ return readFileAs<Policy>(fileName, fileOffset); });
+}
+
+
+/*
+ * Reads file data with the kernels of one allocation policy
+ *
+ */
+template <class Policy>
+int VirtualDisk::readFileAs(int64_t fileName, int64_t fileOffset){
+	// Record the latency and cost of the operation (no-op without -DdiskMetrics)
+	metricScope(fileOffset > 0 ? metricOpReadOffset : metricOpRead);
+	// Reset the access time and simulated device time of the operation
+	beginOperation();
+	// Trace the operation and its phases (no-op without -DdiskTrace)
+	traceScope("readFile", this);
+	traceArg("file", fileName);
+	traceArg("offset", fileOffset);
+	// Check if file name exists in the directory structure
+	iNode* tempDirPtr = checkINode(fileName);
+	// Increment access time and charge the directory read to the device (Accessed memory)
+	accessDirectory();
+	if (tempDirPtr){
+		// File found
+		if (DiskCache && DiskReadAhead){
+			// Prefetch the blocks ahead of a sequential reader
+			startReadAheadAs<Policy>(tempDirPtr, fileOffset);
+		}
+		// Run the read kernel of the allocation method
+		int read;
+		{
+			// Trace the data copy of the kernel (no-op without -DdiskTrace)
+			traceScope("copyData", this);
+			read = readKernel(Policy(), tempDirPtr, fileName, fileOffset);
+		}
+		if (!read){
+			return 0;
+		}
+		// Print the access time and simulated device time of the operation
+		printAccessTime();
+		return 1;
+	} else {
+		// File not found in the directory structure, print error and exit method
+		DiskOut << "Read File " << fileName << "(" << fileOffset << ")" << " from virtual disk." << endl;
+		DiskErr << "Error: File entry "<< fileName << "(" << fileOffset << ")" << " does not exist in the virtual disk." << endl << endl;
+		return 0;
+	}
+	return 1;
+}
+
+
+
+/*
+ * Reads a file with allocation method 1 - Contiguous
+ *
+ */
+int VirtualDisk::readKernel(ContiguousPolicy, iNode* tempDirPtr, int64_t fileName, int64_t fileOffset){
+	// Offset requested, the kernel moves fileOffset as it walks the file
+	int64_t entryOffset = fileOffset;
+	if(fileOffset > 0){
+		// File data entry selected
+		DiskOut << "Read File " << fileName << "(" << entryOffset << ")" << " from virtual disk." << endl;
+		if(fileOffset <= tempDirPtr->Length * DiskVCB->blockSize){
+			// Calculate direct position of the entry in disk data
+			int tempAddr = (tempDirPtr->StartBlock * DiskVCB->blockSize)-DiskVCB->blockSize+fileOffset-1;
+			if(DiskData[tempAddr].data != -1){
+				// If there is data at the entry, print the data entry details
+				DiskOut << "Located at block: " << DiskData[tempAddr].block << ", index: " << DiskData[tempAddr].index << " with data: " << DiskData[tempAddr].data << endl;
+			} else {
+				// No data found, print error message and exit method
+				DiskOut << "Error: File " << fileName << "(" << entryOffset << ") cannot be found on the virtual disk." << endl << endl;
+				return 0;
+			}
+			// Increment access time and charge the read to the device (Accessed memory)
+			accessBlock(DiskData[tempAddr].block);
+		} else {
+			// File offset is out of allocated boundaries, print error and exit method
+			DiskOut << "Error: File " << fileName << "(" << entryOffset << ") cannot be found on the virtual disk." << endl << endl;
+			return 0;
+		}
+
+	} else {
+		// Direct file number given (print whole file)
+		DiskOut << "Read File " << fileName << " from virtual disk." << endl;
+		DiskOut << "File " << fileName << " is stored from block " << tempDirPtr->StartBlock << " to " << tempDirPtr->StartBlock + tempDirPtr->Length-1 << "." << endl;
+		DiskOut << "File data: ";
+		// Calculate direct starting position of the block
+		int tempAddr = (tempDirPtr->StartBlock * DiskVCB->blockSize)-DiskVCB->blockSize;
+		// Print the data of the entries holding data
+		printFileData(tempAddr, tempDirPtr->Length*DiskVCB->blockSize);
+		for(int i=0;i< tempDirPtr->Length*DiskVCB->blockSize;i++){
+			// Increment access time and charge the read to the device (Accessed memory)
+			accessBlock(DiskData[tempAddr+i].block);
+		}
+		DiskOut << endl;
+	}
+	return 1;
+}
+
+
+/*
+ * Reads a file with allocation method 2 - Linked
+ *
+ */
+int VirtualDisk::readKernel(LinkedPolicy, iNode* tempDirPtr, int64_t fileName, int64_t fileOffset){
+	// Offset requested, the kernel moves fileOffset as it walks the file
+	int64_t entryOffset = fileOffset;
+	if(fileOffset > 0){				
+		// Print data entry
+		DiskOut << "Read File " << fileName << "(" << entryOffset << ")" << " from virtual disk." << endl;
+		// Calculate direct position of starting 'head' block in disk data
+ 		int tempAddr = (tempDirPtr->StartBlock * DiskVCB->blockSize)-DiskVCB->blockSize;
+ 		// Calcualte the number of blocks to jump ahead based on the offset
+		int64_t jumps = (fileOffset-1) / (DiskVCB->blockSize-1);
+		for (int i=0;i<jumps;i++){
+			// Block holding the next block pointer
+			int pointerBlock = DiskData[tempAddr].block;
+			// Jump ahead (reduce unnecessary accesses to memory)
+			if(DiskData[tempAddr].block != tempDirPtr->LastBlock){
+				// Calculate offset of the next block directly
+				tempAddr = ((DiskData[tempAddr+(DiskVCB->blockSize-1)].data) * DiskVCB->blockSize) - DiskVCB->blockSize;
+				// Update the remaining number of offsets
+				fileOffset -= (DiskVCB->blockSize-1);
+			} else {
+				if(i < jumps){
+					// Current block is the last block specified in the inode but we have more jumps to do, print error and exit method.
+					DiskOut << "Error: File " << fileName << "(" << entryOffset << ") cannot be found on the virtual disk." << endl << endl;
+					return 0;								
+				}
+			}
+			// Increment access time and charge the read to the device (Accessed memory)
+			accessBlock(pointerBlock);
+		}
+		// Target block found, add the remaining offset within the block 
+		tempAddr += fileOffset-1;
+		if (DiskData[tempAddr].data == -1){
+			// No data found, print error and exit method
+			DiskOut << "Error: File " << fileName << "(" << entryOffset << ") cannot be found on the virtual disk." << endl << endl;
+			return 0;
+		} else {
+			// Entry has data, print data entry details
+			DiskOut << "Located at block: " << DiskData[tempAddr].block << ", index: " << DiskData[tempAddr].index << " with data: " << DiskData[tempAddr].data << endl;
+		}
+		// Increment access time and charge the read to the device (Accessed memory)
+		accessBlock(DiskData[tempAddr].block);
+	} else {
+		// Direct file number given (print whole file)
+		DiskOut << "Read File " << fileName << " from virtual disk." << endl;
+		DiskOut << "File " << fileName << " starts at block " << tempDirPtr->StartBlock << " and ends at block " << tempDirPtr->LastBlock << "." << endl;
+		DiskOut << "File data: ";
+		// Calculate direct position of starting 'head' block in disk data
+		int tempAddr = (tempDirPtr->StartBlock * DiskVCB->blockSize)-DiskVCB->blockSize;
+		// Initialise internal block offset
+		int offset = 0;
+		// While data entry is not empty
+		while (DiskData[tempAddr+offset].data != -1){
+			// Block of the entry being read
+			int entryBlock = DiskData[tempAddr+offset].block;
+			// At every last entry of the block, get next block info
+			if (offset > 0 && (offset % (DiskVCB->blockSize)) == (DiskVCB->blockSize-1)){
+				// Calculate direct position of the next block
+				tempAddr = (DiskData[tempAddr+offset].data * DiskVCB->blockSize)-DiskVCB->blockSize;
+				// Reset internal block offset 
+				offset = 0;
+			} else {
+				// Print data entry details
+				DiskOut << DiskData[tempAddr+offset].data << " ";
+				// Increment internal block offset
+				offset++;
+			}
+			// Increment access time and charge the read to the device (Accessed memory)
+			accessBlock(entryBlock);
+		}
+		DiskOut << endl;
+	}
+	return 1;
+}
+
+
+/*
+ * Reads a file with allocation methods 3 - Indexed and 5 - Log-structured
+ *
+ */
+int VirtualDisk::readKernel(IndexedPolicy, iNode* tempDirPtr, int64_t fileName, int64_t fileOffset){
+	// Offset requested, the kernel moves fileOffset as it walks the file
+	int64_t entryOffset = fileOffset;
+	int indexBlockStartingAddr = 0;
+	if(fileOffset > 0){
+		// File data entry selected
+		DiskOut << "Read File " << fileName << "(" << entryOffset << ")" << " from virtual disk." << endl;
+		// Calculate number of offset within index block
+		int64_t jumps = (fileOffset-1)/DiskVCB->blockSize;
+		// Update remaining offset within data block
+		fileOffset -= (jumps*DiskVCB->blockSize)+1;
+		// Calculate direct position of index block in disk data
+ 		indexBlockStartingAddr = ((tempDirPtr->Index)*DiskVCB->blockSize)-DiskVCB->blockSize;
+ 		// If jumps required within index block is greater than number of entries in it
+		if(jumps > DiskVCB->blockSize){
+			// File offset is out of allocated boundaries of index block, print error and exit method
+			DiskOut << "Error: File " << fileName << "(" << entryOffset << ") cannot be found on the virtual disk." << endl << endl;
+			return 0;
+		} else {
+			// Valid number of jumps within index block
+			if(DiskData[indexBlockStartingAddr+jumps].data == -1){
+				// Selected entry in index block is empty, prin error and exit method
+				DiskOut << "Error: File " << fileName << "(" << entryOffset << ") cannot be found on the virtual disk." << endl << endl;
+				return 0;
+			} else {
+				// Entry in index block has data, save the block number
+				int tempBlock = DiskData[indexBlockStartingAddr+jumps].data;
+				// Calculate direct position of the block in disk data
+				int tempAddr = (tempBlock*DiskVCB->blockSize)-DiskVCB->blockSize+fileOffset;
+				if(DiskData[tempAddr].data != -1){
+					// File entry has data, print disk data details
+					DiskOut << "Located at block: " << DiskData[tempAddr].block << ", index: " << DiskData[tempAddr].index << " with data: " << DiskData[tempAddr].data << endl;
+				} else {
+					// Selected offset in data block is empty, print error and exit method
+					DiskOut << "Error: File " << fileName << "(" << entryOffset << ") cannot be found on the virtual disk." << endl << endl;
+					return 0;
+				}
+				// Increment access time and charge the read to the device (Accessed memory)
+				accessBlock(DiskData[tempAddr].block);
+			}
+			// Increment access time and charge the read to the device (Accessed memory)
+			accessBlock(tempDirPtr->Index);
+		}
+	} else {
+		// Direct file number given (print whole file)
+		int allocatedBlockStartingAddr = 0;
+		std::queue<int, std::pmr::deque<int> > indexNumbers{std::pmr::deque<int>(DiskArena)};
+		// Calculate direct position of index block in disk data
+		indexBlockStartingAddr = ((tempDirPtr->Index - 1)*DiskVCB->blockSize);
+		// Increment access time and charge the read to the device (Accessed memory)
+		accessBlock(tempDirPtr->Index);
+		for (int i = 0; i < DiskVCB->blockSize; i++){
+			// Go through each entry in the index block
+			if(DiskData[indexBlockStartingAddr + i].data != -1){
+				// Index block entry has data, push block number to queue
+				indexNumbers.push(DiskData[indexBlockStartingAddr + i].data);
+			}
+			// Increment access time and charge the read to the device (Accessed memory)
+			accessBlock(tempDirPtr->Index);
+		}
+		DiskOut << "Read File " << fileName << " from virtual disk." << endl;
+		DiskOut << "File " << fileName << "\'s index block is at block " << tempDirPtr->Index << "." << endl;
+		DiskOut << "File data: ";
+		// Process every entry in the queue
+		while(indexNumbers.size() > 0){
+			// Calculate direct position of the first block in the front of the queue
+			allocatedBlockStartingAddr = (((indexNumbers.front()-1)*DiskVCB->blockSize)+1);
+			// Print the data of the entries holding data
+			printFileData(allocatedBlockStartingAddr-1, DiskVCB->blockSize);
+			// Loop through each entry in the block
+			for(int i = 0; i < DiskVCB->blockSize; i++){
+				// Increment access time and charge the read to the device (Accessed memory)
+				accessBlock(DiskData[allocatedBlockStartingAddr+i-1].block);
+			}
+			// Remove ('dequeue') first item from the queue
+			indexNumbers.pop();
+		}
+		DiskOut << endl;
+	}
+	return 1;
+}
+
+
+/*
+ * Reads a file with allocation method 4 - Contiguous Indexed
+ *
+ */
+int VirtualDisk::readKernel(ContiguousIndexedPolicy, iNode* tempDirPtr, int64_t fileName, int64_t fileOffset){
+	// Offset requested, the kernel moves fileOffset as it walks the file
+	int64_t entryOffset = fileOffset;
+	int indexBlockStartingAddr = 0;
+	if(fileOffset > 0){
+		// File data entry selected
+		DiskOut << "Read File " << fileName << "(" << entryOffset << ")" << " from virtual disk." << endl;
+		// Calculate number of blocks required to jump ahead to the offset
+		int64_t jumps = (fileOffset-1)/DiskVCB->blockSize;
+		// Update new offset within data block
+		fileOffset -= (jumps*DiskVCB->blockSize)+1;
+		// Set start of index block
+ 		indexBlockStartingAddr = ((tempDirPtr->Index)*DiskVCB->blockSize)-DiskVCB->blockSize;
+		// Increment access time and charge the read to the device (Accessed memory)
+		accessBlock(tempDirPtr->Index);
+ 		// Set offset within index block
+ 		int indexBlockOffset = 0;
+ 		while(jumps > 0){
+			// If number of jumps is greater than current entry's length in index block
+			if(jumps - DiskData[indexBlockStartingAddr+indexBlockOffset].length >= 0){
+				// Deduct the number of jumps required
+				jumps -= DiskData[indexBlockStartingAddr+indexBlockOffset].length; 						
+			} else {
+				// Our data entry is within this index block entry
+				break;
+			}
+			// Increment access time and charge the read to the device (Accessed memory)
+			accessBlock(tempDirPtr->Index);
+			// Move pointer to the next entry in the index block
+			indexBlockOffset++;
+ 			if(indexBlockOffset > DiskVCB->blockSize-1){
+ 				// If we moved out of the index block's limits, return error and exit method.
+ 				DiskOut << "Error: File " << fileName << "(" << entryOffset << ") cannot be found on the virtual disk." << endl << endl;
+				return 0;
+ 			}
+ 		}
+ 		// Calculate direct position to the tart of the target contiguous block
+ 		int tempBlockAddr = (DiskData[indexBlockStartingAddr+indexBlockOffset].data*DiskVCB->blockSize)-DiskVCB->blockSize;
+		// Increment access time and charge the read to the device (Accessed memory)
+		accessBlock(tempDirPtr->Index);
+ 		//Calculate offset within the contiguous block
+ 		fileOffset += (jumps*DiskVCB->blockSize);
+ 		if(fileOffset > (DiskData[indexBlockStartingAddr+indexBlockOffset].length*DiskVCB->blockSize)-1){
+ 			// Entry requested is out of bounds of the blocks, return error and exit method
+ 			DiskOut << "Error: File " << fileName << "(" << entryOffset << ") cannot be found on the virtual disk." << endl << endl;
+			return 0;
+ 		}
+		// Increment access time and charge the read to the device (Accessed memory)
+		accessBlock(tempDirPtr->Index);
+ 		if(DiskData[tempBlockAddr+fileOffset].data != -1){
+ 			// Print data entry details
+			DiskOut << "Located at block: " << DiskData[tempBlockAddr+fileOffset].block << ", index: " << DiskData[tempBlockAddr+fileOffset].index << " with data: " << DiskData[tempBlockAddr+fileOffset].data << endl;
+ 		} else {
+ 			// File entry is empty, print error and exit method.
+ 			DiskOut << "Error: File " << fileName << "(" << entryOffset << ") cannot be found on the virtual disk." << endl << endl;
+ 			return 0;
+ 		}
+		// Increment access time and charge the read to the device (Accessed memory)
+		accessBlock(DiskData[tempBlockAddr+fileOffset].block);
+	} else {
+		// Direct file number given (print whole file)
+		int allocatedBlockStartingAddr = 0;
+		// Initialise a queue of data pairs
+		std::queue<std::pair<int,int>, std::pmr::deque<std::pair<int,int> > > indexNumbers{std::pmr::deque<std::pair<int,int> >(DiskArena)};
+		// Calculate direct position of index block in disk data
+		indexBlockStartingAddr = ((tempDirPtr->Index - 1)*DiskVCB->blockSize);
+		// Increment access time and charge the read to the device (Accessed memory)
+		accessBlock(tempDirPtr->Index);
+		// Loop through each entry in the index block
+		for (int i = 0; i < DiskVCB->blockSize; i++){
+			if(DiskData[indexBlockStartingAddr + i].data != -1){
+				// Push the block and length as a pair into the queue
+				indexNumbers.push(std::pair<int,int>(DiskData[indexBlockStartingAddr + i].data, DiskData[indexBlockStartingAddr + i].length));
+			}
+			// Increment access time and charge the read to the device (Accessed memory)
+			accessBlock(tempDirPtr->Index);
+		}
+		DiskOut << "Read File " << fileName << " from virtual disk." << endl;
+		DiskOut << "File " << fileName << "\'s index block is at block " << tempDirPtr->Index << "." << endl;
+		DiskOut << "File data: ";
+		// Process every entry in the queue
+		while(indexNumbers.size() > 0){
+			// Calculate direct position of the first block in the front of the queue
+			allocatedBlockStartingAddr = (((indexNumbers.front().first-1)*DiskVCB->blockSize)+1);
+			// Print the data of the entries holding data
+			printFileData(allocatedBlockStartingAddr-1, indexNumbers.front().second*DiskVCB->blockSize);
+			// Loop through each entry in the blocks
+			for(int i = 0; i < indexNumbers.front().second*DiskVCB->blockSize; i++){
+				// Increment access time and charge the read to the device (Accessed memory)
+				accessBlock(DiskData[allocatedBlockStartingAddr+i-1].block);
+			}
+			// Remove ('dequeue') first item from the queue
+			indexNumbers.pop();
+		}
+		DiskOut << endl;
+	}
+	return 1;
+}
+
+
+
+/*
+ * Reads a range of entries of a file from virtual disk
+ *	The inode is looked up once and readRange() returns the entries as
+ *	spans over the disk data, so the whole range is printed without
+ *	locating each entry on its own. Each entry read is charged to the
+ *	device.
+ *
+ * Input:
+ *		fileName - File to read
+ *		fileOffset - First entry to read (starting from 1)
+ *		count - Number of entries to read
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if unsuccessful
+ */
+int VirtualDisk::readFileRange(int64_t fileName, int64_t fileOffset, int64_t count){
+	// Run the range read of the allocation method
+	return withPolicy([&]<class Policy>(Policy){ return readFileRangeAs<Policy>(fileName, fileOffset, count); });
+}
+
+
+/*
+ * Reads a range of entries of a file with the kernels of one allocation policy
+ *
+ */
+template <class Policy>
+int VirtualDisk::readFileRangeAs(int64_t fileName, int64_t fileOffset, int64_t count){
+	// Record the latency and cost of the operation (no-op without -DdiskMetrics)
+	metricScope(metricOpReadOffset);
+	// Reset the access time and simulated device time of the operation
+	beginOperation();
+	// Trace the operation and its phases (no-op without -DdiskTrace)
+	traceScope("readFileRange", this);
+	traceArg("file", fileName);
+	traceArg("offset", fileOffset);
+	// Check if file name exists in the directory structure
+	iNode* tempDirPtr = checkINode(fileName);
+	// Increment access time and charge the directory read to the device (Accessed memory)
+	accessDirectory();
+	DiskOut << "Read File " << fileName << " entries " << fileOffset << " to " << fileOffset+count-1 << " from virtual disk." << endl;
+	if (!tempDirPtr){
+		DiskErr << "Error: File entry "<< fileName << " does not exist in the virtual disk." << endl << endl;
+		return 0;
+	}
+	if (DiskCache && DiskReadAhead){
+		// Prefetch the blocks ahead of a sequential reader
+		startReadAheadAs<Policy>(tempDirPtr, fileOffset);
+	}
+	vector<std::span<Data> > runs = readRangeAs<Policy>(tempDirPtr, fileOffset, count);
+	if (runs.empty()){
+		DiskOut << "Error: File " << fileName << "(" << fileOffset << ") cannot be found on the virtual disk." << endl << endl;
+		return 0;
+	}
+	int entriesRead = 0;
+	DiskOut << "Located in " << runs.size() << " run(s) of disk data at ";
+	for (int i=0;i<runs.size();i++){
+		// Print the blocks of the run
+		DiskOut << "B" << runs[i].front().block;
+		if (runs[i].back().block != runs[i].front().block){
+			DiskOut << "-B" << runs[i].back().block;
+		}
+		DiskOut << " ";
+		entriesRead += runs[i].size();
+	}
+	DiskOut << endl << "File data: ";
+	{
+		// Trace the data copy of the range (no-op without -DdiskTrace)
+		traceScope("copyData", this);
+		for (int i=0;i<runs.size();i++){
+			for (int j=0;j<runs[i].size();j++){
+				DiskOut << runs[i][j].data << " ";
+				// Increment access time and charge the read to the device (Accessed memory)
+				accessBlock(runs[i][j].block);
+			}
+		}
+	}
+	DiskOut << endl;
+	if (entriesRead < count){
+		// Range runs past the end of the file
+		DiskOut << "File " << fileName << " ends after " << entriesRead << " of the " << count << " entries requested." << endl;
+	}
+	// Print the access time and simulated device time of the operation
+	printAccessTime();
+	return 1;
+}
+
+
+
+
+/*
+ * Locates a range of entries of a file
+ *	The file is walked in runs (the blocks of a contiguous file, every
+ *	block of a linked chain, every data block of an index block or
+ *	every extent of a contiguous index block). Whole runs before the
+ *	offset are skipped, and runs next to each other in the disk data
+ *	are merged into one span. Only the index and pointer reads needed
+ *	to find the runs are charged here.
+ *
+ * Input:
+ *		iNodeEntry - Directory entry of the file
+ *		fileOffset - First entry to read (starting from 1)
+ *		count - Number of entries to read
+ *
+ * Returns:
+ *		Spans over the disk data holding the entries, in file order
+ *		(empty if the offset is past the end of the file)
+ */
+vector<std::span<Data> > VirtualDisk::readRange(iNode* iNodeEntry, int64_t fileOffset, int64_t count){
+	// Run the range kernel of the allocation method
+	return withPolicy([&]<class Policy>(Policy){ return readRangeAs<Policy>(iNodeEntry, fileOffset, count); });
+}
+
+
+/*
+ * Locates a range of entries of a file with one allocation policy
+ *
+ */
+template <class Policy>
+vector<std::span<Data> > VirtualDisk::readRangeAs(iNode* iNodeEntry, int64_t fileOffset, int64_t count){
+	vector<std::span<Data> > runs;
+	int64_t skipEntries = fileOffset-1;
+	int64_t remainingEntries = count;
+	// Run the range kernel of the allocation method
+	rangeKernel(Policy(), iNodeEntry, runs, skipEntries, remainingEntries);
+	return runs;
+}
+
+
+
+/*
+ * Locates a range of entries of a file with allocation method 1 - Contiguous
+ *
+ */
+int VirtualDisk::rangeKernel(ContiguousPolicy, iNode* iNodeEntry, vector<std::span<Data> > &runs, int64_t &skipEntries, int64_t &remainingEntries){
+	addRangeRun(runs, (iNodeEntry->StartBlock-1)*DiskVCB->blockSize, iNodeEntry->Length*DiskVCB->blockSize, skipEntries, remainingEntries);
+	return 1;
+}
+
+
+/*
+ * Locates a range of entries of a file with allocation method 2 - Linked
+ *
+ */
+int VirtualDisk::rangeKernel(LinkedPolicy, iNode* iNodeEntry, vector<std::span<Data> > &runs, int64_t &skipEntries, int64_t &remainingEntries){
+	int currentBlock = iNodeEntry->StartBlock;
+	// Linked blocks give up their last entry to the next block pointer
+	while (addRangeRun(runs, (currentBlock-1)*DiskVCB->blockSize, DiskVCB->blockSize-1, skipEntries, remainingEntries) && currentBlock != iNodeEntry->LastBlock){
+		// Increment access time and charge the read to the device (Accessed memory)
+		accessBlock(currentBlock);
+		// Follow the next block pointer
+		currentBlock = DiskData[(currentBlock*DiskVCB->blockSize)-1].data;
+	}
+	return 1;
+}
+
+
+/*
+ * Locates a range of entries of a file with allocation methods 3 - Indexed and 5 - Log-structured
+ *
+ */
+int VirtualDisk::rangeKernel(IndexedPolicy, iNode* iNodeEntry, vector<std::span<Data> > &runs, int64_t &skipEntries, int64_t &remainingEntries){
+	int indexBlockStartingAddr = (iNodeEntry->Index-1)*DiskVCB->blockSize;
+	// Increment access time and charge the read to the device (Accessed memory)
+	accessBlock(iNodeEntry->Index);
+	for (int i=0;i<DiskVCB->blockSize && DiskData[indexBlockStartingAddr+i].data != -1;i++){
+		if (!addRangeRun(runs, (DiskData[indexBlockStartingAddr+i].data-1)*DiskVCB->blockSize, DiskVCB->blockSize, skipEntries, remainingEntries)){
+			break;
+		}
+	}
+	return 1;
+}
+
+
+/*
+ * Locates a range of entries of a file with allocation method 4 - Contiguous Indexed
+ *
+ */
+int VirtualDisk::rangeKernel(ContiguousIndexedPolicy, iNode* iNodeEntry, vector<std::span<Data> > &runs, int64_t &skipEntries, int64_t &remainingEntries){
+	int indexBlockStartingAddr = (iNodeEntry->Index-1)*DiskVCB->blockSize;
+	// Increment access time and charge the read to the device (Accessed memory)
+	accessBlock(iNodeEntry->Index);
+	for (int i=0;i<DiskVCB->blockSize && DiskData[indexBlockStartingAddr+i].data != -1;i++){
+		if (!addRangeRun(runs, (DiskData[indexBlockStartingAddr+i].data-1)*DiskVCB->blockSize, DiskData[indexBlockStartingAddr+i].length*DiskVCB->blockSize, skipEntries, remainingEntries)){
+			break;
+		}
+	}
+	return 1;
+}
+
+
+
+
+/*
+ * Adds the part of a run inside a range to the range's spans
+ *	Unused entries end the file, so the span stops at the first one.
+ *
+ * Input:
+ *		runs - Spans of the range so far
+ *		runAddr - Position of the run in disk data
+ *		runLength - Number of entries in the run
+ *		skipEntries - Entries still to skip before the range starts
+ *		remainingEntries - Entries of the range still to add
+ *
+ * Returns:
+ *		'1' if the range continues in the next run
+ *		'0' if the range or the file has ended
+ */
+int VirtualDisk::addRangeRun(vector<std::span<Data> > &runs, int runAddr, int runLength, int64_t &skipEntries, int64_t &remainingEntries){
+	if (skipEntries >= runLength){
+		// Whole run is before the range
+		skipEntries -= runLength;
+		return 1;
+	}
+	int startAddr = runAddr + skipEntries;
+	int numEntries = 0;
+	int maxEntries = min(runLength - skipEntries, remainingEntries);
+	skipEntries = 0;
+	while (numEntries < maxEntries && DiskData[startAddr+numEntries].data != -1){
+		numEntries++;
+	}
+	if (numEntries > 0){
+		if (!runs.empty() && runs.back().data() + runs.back().size() == &DiskData[startAddr]){
+			// Run follows the previous one in disk data, merge them
+			runs.back() = std::span<Data>(runs.back().data(), runs.back().size() + numEntries);
+		} else {
+			runs.push_back(std::span<Data>(&DiskData[startAddr], numEntries));
+		}
+	}
+	remainingEntries -= numEntries;
+	return remainingEntries > 0 && numEntries == maxEntries ? 1 : 0;
+}
+
+
+
+
+/*
+ *  Deletes file data from virtual disk
+ *	This method checks if the requested file to be deleted exists in the file
+ *  directory. If yes, the file will be deleted. If the file does not exists,
+ *	an error is printed and the method ends.
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if unsuccessful
+ *		
+ */
+int VirtualDisk::deleteFile(int64_t fileName){
+	// Run the delete operation of the allocation method
+	return withPolicy([&]<class Policy>(Policy){ return deleteFileAs<Policy>(fileName); });
+}
+
+
+/*
+ * Deletes file data with the kernels of one allocation policy
+ *
+ */
+template <class Policy>
+int VirtualDisk::deleteFileAs(int64_t fileName){
+	// Record the latency and cost of the operation (no-op without -DdiskMetrics)
+	metricScope(metricOpDelete);
+	// Reset the access time and simulated device time of the operation
+	beginOperation();
+	// Trace the operation and its phases (no-op without -DdiskTrace)
+	traceScope("deleteFile", this);
+	traceArg("file", fileName);
+	iNode* tempDirPtr;
+	// Check if file name exists in the directory structure
+	tempDirPtr = checkINode(fileName);
+	// Increment access time and charge the directory read to the device (Accessed memory)
+	accessDirectory();
+	if (tempDirPtr){
+		// File found
+		{
+			// Trace the data clearing of the kernel (no-op without -DdiskTrace)
+			traceScope("clearData", this);
+			if (lazyDelete){
+				// Free the blocks only, their entries are cleared when they are reused
+				lazyDeleteKernel(Policy(), tempDirPtr, fileName);
+			} else {
+				// Run the delete kernel of the allocation method
+				deleteKernel(Policy(), tempDirPtr, fileName);
+			}
+		}
+		// Remove the file's extent statistics
+		removeFileStats(fileName);
+		if (DiskReadAhead){
+			// Forget the read position of the file
+			DiskReadAhead->forgetFile(fileName);
+		}
+		// Print the access time and simulated device time of the operation
+		printAccessTime();
+	} else {
+		// File not found in the directory structure, print error and exit method
+		DiskOut << "Deleting File " << fileName << "(" << fileName << ")" << " from virtual disk." << endl;
+		DiskErr << "Error: File entry "<< fileName << "(" << fileName << ")" << " does not exist in the virtual disk." << endl << endl;
+		return 0;
+	}
+	return 1;
+}
+
+
+
+/*
+ * Deletes a file with allocation method 1 - Contiguous
+ *
+ */
+int VirtualDisk::deleteKernel(ContiguousPolicy, iNode* tempDirPtr, int64_t fileName){
+	DiskOut << "Deleting File " << fileName << " from virtual disk." << endl;
+	DiskOut << "Deleted File " << fileName << " from virtual disk and freed ";
+	// Calculate direct position of the block in disk data  
+	int tempAddr = (tempDirPtr->StartBlock * DiskVCB->blockSize)-DiskVCB->blockSize;
+	// Increment access time and charge the read to the device (Accessed memory)
+	accessBlock(tempDirPtr->StartBlock);
+	// Set all entries in the contiguous blocks to -1 (unused)
+	clearBlocks(tempDirPtr->StartBlock, tempDirPtr->Length);
+	for(int i=0;i< tempDirPtr->Length*DiskVCB->blockSize;i++){
+		// Loop through all entries in the contiguous blocks
+		if (i % DiskVCB->blockSize == 0){
+			// Print block number
+			DiskOut << "B" << DiskData[tempAddr+i].block << " ";
+		}
+		// Increment access time and charge the write to the device (Accessed memory)
+		accessBlock(DiskData[tempAddr+i].block, true);
+	}
+	// Update the free space bit map + number of free blocks
+	updateFreeSpace(tempDirPtr->StartBlock, tempDirPtr->Length, 1);
+	// Update the inode in directory structure to -1 (unused)
+	updateINodeAs<ContiguousPolicy>(tempDirPtr,-1,-1);
+	// Increment access time and charge the write to the device (Accessed memory)
+	accessBlock(0, true);
+	DiskOut << endl;
+	return 1;
+}
+
+
+/*
+ * Deletes a file with allocation method 2 - Linked
+ *
+ */
+int VirtualDisk::deleteKernel(LinkedPolicy, iNode* tempDirPtr, int64_t fileName){
+	DiskOut << "Deleting File " << fileName << " from virtual disk." << endl;
+	DiskOut << "Deleted File " << fileName << " from virtual disk and freed ";
+	// Calculate direct position of the block in disk data
+	int tempAddr = (tempDirPtr->StartBlock * DiskVCB->blockSize)-DiskVCB->blockSize;
+	// Increment access time and charge the read to the device (Accessed memory)
+	accessBlock(tempDirPtr->StartBlock);
+	int offset = 0;
+	int tempBlock = 0;
+	// While data entry is not empty
+	while (DiskData[tempAddr+offset].data != -1){
+		// Block of the entry being deleted
+		int entryBlock = DiskData[tempAddr+offset].block;
+		// At every last entry of the block
+		if ((offset % (DiskVCB->blockSize)) == (DiskVCB->blockSize-1)){
+			// Print block number
+			DiskOut << "B" << DiskData[tempAddr+offset].block << " ";
+			// Update the free space bit map + number of free blocks
+			updateFreeSpace(DiskData[tempAddr+offset].block, 1, 1);
+			// Get next block number
+			tempBlock = tempAddr+offset;
+			// Calculate direct position of the next block in disk data
+			tempAddr = (DiskData[tempAddr+offset].data * DiskVCB->blockSize)-DiskVCB->blockSize;
+			// Delete the entry in the current block
+			writeEntry(tempBlock, -1, false);
+			// Reset internal offset within the block
+			offset = 0;
+		} else {
+			// If there is data in the entry, set to -1 (unused)
+			writeEntry(tempAddr+offset, -1, false);
+			// Increase internal offset within the block
+			offset++;
+		}
+		// Increment access time and charge the write to the device (Accessed memory)
+		accessBlock(entryBlock, true);
+
+	}
+	// Print block number
+	DiskOut << "B" << DiskData[tempAddr+offset].block << " ";
+	// Update the free space bit map + number of free blocks
+	updateFreeSpace(DiskData[tempAddr+offset].block, 1, 1);
+	// Update the inode in directory structure to -1 (unused)
+	updateINodeAs<LinkedPolicy>(tempDirPtr,-1,-1);
+	// Increment access time and charge the write to the device (Accessed memory)
+	accessBlock(0, true);
+	DiskOut << endl;
+	return 1;
+}
+
+
+/*
+ * Deletes a file with allocation method 3 - Indexed
+ *
+ */
+int VirtualDisk::deleteKernel(IndexedPolicy, iNode* tempDirPtr, int64_t fileName){
+	DiskOut << "Deleting File " << fileName << " from virtual disk." << endl;
+	DiskOut << "Deleted File " << fileName << " from virtual disk and freed ";
+	// Direct file number
+	int indexBlockStartingAddr = 0;
+	int allocatedBlockStartingAddr = 0;
+	std::queue<int, std::pmr::deque<int> > indexNumbers{std::pmr::deque<int>(DiskArena)};
+	// Calculate direct position of index block in disk data
+	indexBlockStartingAddr = ((tempDirPtr->Index - 1)*DiskVCB->blockSize);
+	// Increment access time and charge the read to the device (Accessed memory)
+	accessBlock(tempDirPtr->Index);
+	for (int i = 0; i < DiskVCB->blockSize; i++){
+		// Go through each entry in the index block
+		if(DiskData[indexBlockStartingAddr + i].data != -1){
+			// Index block entry has data, push block number to queue
+			indexNumbers.push(DiskData[indexBlockStartingAddr + i].data);
+
+			// Write the entry without charging a write
+			writeEntry(indexBlockStartingAddr+i, -1, false);
+		}
+		// Increment access time and charge the write to the device (Accessed memory)
+		accessBlock(tempDirPtr->Index, true);
+	}
+	DiskOut << "B" << DiskData[indexBlockStartingAddr].block << " ";
+	// Update the free space bit map + number of free blocks
+	updateFreeSpace(DiskData[indexBlockStartingAddr].block, 1, 1);
+	while(indexNumbers.size() > 0){
+		allocatedBlockStartingAddr = (((indexNumbers.front()-1)*DiskVCB->blockSize)+1);
+		// Set all entries in the block to -1 (unused)
+		clearBlocks(indexNumbers.front(), 1);
+		for(int i = 0; i < DiskVCB->blockSize; i++){
+			// Increment access time and charge the write to the device (Accessed memory)
+			accessBlock(DiskData[allocatedBlockStartingAddr+i-1].block, true);
+
+		}
+		// Print block number
+		DiskOut << "B" << indexNumbers.front() << " ";
+		// Update the free space bit map + number of free blocks
+		updateFreeSpace(indexNumbers.front(), 1, 1);
+		// Remove ('dequeue') first item from the queue
+		indexNumbers.pop();
+	}
+	// Update the inode in directory structure to -1 (unused)
+	updateINodeAs<IndexedPolicy>(tempDirPtr,-1,-1);
+	// Increment access time and charge the write to the device (Accessed memory)
+	accessBlock(0, true);
+	DiskOut << endl;
+	return 1;
+}
+
+
+/*
+ * Deletes a file with allocation method 4 - Contiguous Indexed
+ *
+ */
+int VirtualDisk::deleteKernel(ContiguousIndexedPolicy, iNode* tempDirPtr, int64_t fileName){
+	DiskOut << "Deleting File " << fileName << " from virtual disk." << endl;
+	DiskOut << "Deleted File " << fileName << " from virtual disk and freed ";
+	int indexBlockStartingAddr = 0;
+	int allocatedBlockStartingAddr = 0;
+	// Initialise a queue of data pairs
+	std::queue<std::pair<int,int>, std::pmr::deque<std::pair<int,int> > > indexNumbers{std::pmr::deque<std::pair<int,int> >(DiskArena)};
+	// Calculate direct position of index block in disk data
+	indexBlockStartingAddr = ((tempDirPtr->Index - 1)*DiskVCB->blockSize);
+	// Increment access time and charge the read to the device (Accessed memory)
+	accessBlock(tempDirPtr->Index);
+	for (int i = 0; i < DiskVCB->blockSize; i++){
+		// Loop through each entry in the index block
+		if(DiskData[indexBlockStartingAddr + i].data != -1){
+			// Push the bock and length as a pair into the queue
+			indexNumbers.push(std::pair<int,int>(DiskData[indexBlockStartingAddr + i].data, DiskData[indexBlockStartingAddr + i].length));
+			// Write index block entry data and length to -1 (unused)
+			writeExtent(indexBlockStartingAddr+i, -1, -1, false);
+		}
+		// Increment access time and charge the write to the device (Accessed memory)
+		accessBlock(tempDirPtr->Index, true);
+	}
+	// Update the free space bit map + number of free blocks
+	updateFreeSpace(DiskData[indexBlockStartingAddr].block, 1, 1);
+	// Print blokc number
+	DiskOut << "B" << DiskData[indexBlockStartingAddr].block << " ";
+	// Process every entry in the queue
+	while(indexNumbers.size() > 0){
+		// Calculate direct position of the first block in the front of the queue
+		allocatedBlockStartingAddr = (((indexNumbers.front().first-1)*DiskVCB->blockSize)+1);
+		// Set all entries in the extent to -1 (unused)
+		clearBlocks(indexNumbers.front().first, indexNumbers.front().second);
+		for(int i = 0; i < indexNumbers.front().second*DiskVCB->blockSize; i++){
+			// Loop each entry in the block
+			if (i % DiskVCB->blockSize == 0){
+				// Print block number for every new block accessed
+				DiskOut << "B" << DiskData[allocatedBlockStartingAddr+i].block << " ";
+			}
+			// Increment access time and charge the write to the device (Accessed memory)
+			accessBlock(DiskData[allocatedBlockStartingAddr+i-1].block, true);
+		}
+		// Update the free space bit map + number of free blocks
+		updateFreeSpace(DiskData[allocatedBlockStartingAddr].block, indexNumbers.front().second, 1);
+		// Remove ('dequeue') first item from the queue
+		indexNumbers.pop();
+	}
+
+	// Update the inode in directory structure to -1 (unused)
+	updateINodeAs<ContiguousIndexedPolicy>(tempDirPtr,-1,-1);	
+	// Increment access time and charge the write to the device (Accessed memory)
+	accessBlock(0, true);
+	DiskOut << endl;
+	return 1;
+}
+
+
+/*
+ * Deletes a file with allocation method 5 - Log-structured
+ *
+ */
+int VirtualDisk::deleteKernel(LogStructuredPolicy, iNode* tempDirPtr, int64_t fileName){
+	DiskOut << "Deleting File " << fileName << " from virtual disk." << endl;
+	DiskOut << "Deleted File " << fileName << " from virtual disk and freed ";
+	int indexBlock = tempDirPtr->Index;
+	int indexBlockStartingAddr = (indexBlock-1)*DiskVCB->blockSize;
+	DiskOut << "B" << indexBlock << " ";
+	for (int i = 0; i < DiskVCB->blockSize; i++){
+		// Increment access time and charge the read to the device (Accessed memory)
+		accessBlock(indexBlock);
+		if (DiskData[indexBlockStartingAddr+i].data != -1){
+			// Data blocks are only released, the cleaner reclaims their segment later
+			int dataBlock = DiskData[indexBlockStartingAddr+i].data;
+			DiskOut << "B" << dataBlock << " ";
+			// Clear the dead entries for the disk map (not written to the device)
+			clearBlocks(dataBlock, 1);
+			DiskLog->releaseBlock(dataBlock);
+			// Write the entry without charging a write
+			writeEntry(indexBlockStartingAddr+i, -1, false);
+		}
+	}
+	DiskLog->releaseBlock(indexBlock);
+	// Remove the file from the inode map
+	updateINodeAs<LogStructuredPolicy>(tempDirPtr,-1,-1);
+	// Increment access time and charge the write to the device (Accessed memory)
+	accessBlock(0, true);
+	DiskOut << endl;
+	return 1;
+}
+
+
+
+/*
+ * Lazily deletes a file with allocation method 1 - Contiguous
+ *	The inode holds the whole extent, so no block is read.
+ *
+ */
+int VirtualDisk::lazyDeleteKernel(ContiguousPolicy, iNode* tempDirPtr, int64_t fileName){
+	DiskOut << "Deleting File " << fileName << " from virtual disk." << endl;
+	DiskOut << "Deleted File " << fileName << " from virtual disk and freed ";
+	for (int i=0;i<tempDirPtr->Length;i++){
+		// Print block number
+		DiskOut << "B" << tempDirPtr->StartBlock+i << " ";
+	}
+	retireBlocks(tempDirPtr->StartBlock, tempDirPtr->Length);
+	// Update the free space bit map + number of free blocks
+	updateFreeSpace(tempDirPtr->StartBlock, tempDirPtr->Length, 1);
+	// Update the inode in directory structure to -1 (unused)
+	updateINodeAs<ContiguousPolicy>(tempDirPtr,-1,-1);
+	// Increment access time and charge the write to the device (Accessed memory)
+	accessBlock(0, true);
+	DiskOut << endl;
+	return 1;
+}
+
+
+/*
+ * Lazily deletes a file with allocation method 2 - Linked
+ *	Only the pointer of each block is read to follow the chain.
+ *
+ */
+int VirtualDisk::lazyDeleteKernel(LinkedPolicy, iNode* tempDirPtr, int64_t fileName){
+	DiskOut << "Deleting File " << fileName << " from virtual disk." << endl;
+	DiskOut << "Deleted File " << fileName << " from virtual disk and freed ";
+	int currentBlock = tempDirPtr->StartBlock;
+	int numBlocks = 0;
+	// A chain cannot be longer than the disk
+	while (currentBlock > 0 && numBlocks < DiskVCB->totalBlockNum){
+		// Print block number
+		DiskOut << "B" << currentBlock << " ";
+		// Increment access time and charge the read to the device (Accessed memory)
+		accessBlock(currentBlock);
+		// Last entry of the block points to the next block
+		int nextBlock = DiskData[(currentBlock*DiskVCB->blockSize)-1].data;
+		retireBlocks(currentBlock, 1);
+		// Update the free space bit map + number of free blocks
+		updateFreeSpace(currentBlock, 1, 1);
+		numBlocks++;
+		if (currentBlock == tempDirPtr->LastBlock){
+			break;
+		}
+		currentBlock = nextBlock;
+	}
+	// Update the inode in directory structure to -1 (unused)
+	updateINodeAs<LinkedPolicy>(tempDirPtr,-1,-1);
+	// Increment access time and charge the write to the device (Accessed memory)
+	accessBlock(0, true);
+	DiskOut << endl;
+	return 1;
+}
+
+
+/*
+ * Lazily deletes a file with allocation method 3 - Indexed
+ *	Only the index block is read.
+ *
+ */
+int VirtualDisk::lazyDeleteKernel(IndexedPolicy, iNode* tempDirPtr, int64_t fileName){
+	DiskOut << "Deleting File " << fileName << " from virtual disk." << endl;
+	DiskOut << "Deleted File " << fileName << " from virtual disk and freed ";
+	int indexBlockStartingAddr = (tempDirPtr->Index-1)*DiskVCB->blockSize;
+	// Increment access time and charge the read to the device (Accessed memory)
+	accessBlock(tempDirPtr->Index);
+	DiskOut << "B" << tempDirPtr->Index << " ";
+	for (int i=0;i<DiskVCB->blockSize;i++){
+		int dataBlock = DiskData[indexBlockStartingAddr+i].data;
+		if (dataBlock != -1){
+			// Print block number
+			DiskOut << "B" << dataBlock << " ";
+			retireBlocks(dataBlock, 1);
+			// Update the free space bit map + number of free blocks
+			updateFreeSpace(dataBlock, 1, 1);
+		}
+	}
+	retireBlocks(tempDirPtr->Index, 1);
+	// Update the free space bit map + number of free blocks
+	updateFreeSpace(tempDirPtr->Index, 1, 1);
+	// Update the inode in directory structure to -1 (unused)
+	updateINodeAs<IndexedPolicy>(tempDirPtr,-1,-1);
+	// Increment access time and charge the write to the device (Accessed memory)
+	accessBlock(0, true);
+	DiskOut << endl;
+	return 1;
+}
+
+
+/*
+ * Lazily deletes a file with allocation method 4 - Contiguous Indexed
+ *	Only the index block is read, and each extent is freed at once.
+ *
+ */
+int VirtualDisk::lazyDeleteKernel(ContiguousIndexedPolicy, iNode* tempDirPtr, int64_t fileName){
+	DiskOut << "Deleting File " << fileName << " from virtual disk." << endl;
+	DiskOut << "Deleted File " << fileName << " from virtual disk and freed ";
+	int indexBlockStartingAddr = (tempDirPtr->Index-1)*DiskVCB->blockSize;
+	// Increment access time and charge the read to the device (Accessed memory)
+	accessBlock(tempDirPtr->Index);
+	DiskOut << "B" << tempDirPtr->Index << " ";
+	for (int i=0;i<DiskVCB->blockSize;i++){
+		int extentBlock = DiskData[indexBlockStartingAddr+i].data;
+		int extentLength = DiskData[indexBlockStartingAddr+i].length;
+		if (extentBlock != -1){
+			for (int j=0;j<extentLength;j++){
+				// Print block number
+				DiskOut << "B" << extentBlock+j << " ";
+			}
+			retireBlocks(extentBlock, extentLength);
+			// Update the free space bit map + number of free blocks
+			updateFreeSpace(extentBlock, extentLength, 1);
+		}
+	}
+	retireBlocks(tempDirPtr->Index, 1);
+	// Update the free space bit map + number of free blocks
+	updateFreeSpace(tempDirPtr->Index, 1, 1);
+	// Update the inode in directory structure to -1 (unused)
+	updateINodeAs<ContiguousIndexedPolicy>(tempDirPtr,-1,-1);
+	// Increment access time and charge the write to the device (Accessed memory)
+	accessBlock(0, true);
+	DiskOut << endl;
+	return 1;
+}
+
+
+/*
+ * Lazily deletes a file with allocation method 5 - Log-structured
+ *	Only the index block is read. The blocks are released to the log,
+ *	and their entries are cleared when the log reuses them.
+ *
+ */
+int VirtualDisk::lazyDeleteKernel(LogStructuredPolicy, iNode* tempDirPtr, int64_t fileName){
+	DiskOut << "Deleting File " << fileName << " from virtual disk." << endl;
+	DiskOut << "Deleted File " << fileName << " from virtual disk and freed ";
+	int indexBlock = tempDirPtr->Index;
+	int indexBlockStartingAddr = (indexBlock-1)*DiskVCB->blockSize;
+	// Increment access time and charge the read to the device (Accessed memory)
+	accessBlock(indexBlock);
+	DiskOut << "B" << indexBlock << " ";
+	for (int i=0;i<DiskVCB->blockSize;i++){
+		int dataBlock = DiskData[indexBlockStartingAddr+i].data;
+		if (dataBlock != -1){
+			DiskOut << "B" << dataBlock << " ";
+			retireBlocks(dataBlock, 1);
+			DiskLog->releaseBlock(dataBlock);
+		}
+	}
+	retireBlocks(indexBlock, 1);
+	DiskLog->releaseBlock(indexBlock);
+	// Remove the file from the inode map
+	updateINodeAs<LogStructuredPolicy>(tempDirPtr,-1,-1);
+	// Increment access time and charge the write to the device (Accessed memory)
+	accessBlock(0, true);
+	DiskOut << endl;
+	return 1;
+}
+
+
+
+
+/*
+ * Lists the files in a range of file names, in order
+ *	The directory tree walks its leaves from the first file name of
+ *	the range. The inode array is read as a whole and sorted.
+ *
+ * Input:
+ *		fromName - First file name of the range
+ *		toName - Last file name of the range
+ *
+ * Returns:
+ *		Number of files listed
+ */
+int VirtualDisk::listFiles(int64_t fromName, int64_t toName){
+	// Reset the access time and simulated device time of the operation
+	beginOperation();
+	vector<iNode*> files;
+	if (DiskDirTree){
+		DiskDirTree->scan(fromName, toName, files);
+	} else {
+		for (int i=0; i < DiskVCB->blockSize-1; i++){
+			if (DiskDir[i].FileIdentifier != -1 && DiskDir[i].FileIdentifier >= fromName && DiskDir[i].FileIdentifier <= toName){
+				files.push_back(&DiskDir[i]);
+			}
+		}
+		std::sort(files.begin(), files.end(), [](iNode* a, iNode* b){ return a->FileIdentifier < b->FileIdentifier; });
+	}
+	// Increment access time and charge the directory read to the device (Accessed memory)
+	accessDirectory();
+	DiskOut << "Listing files " << fromName << " to " << toName << "." << endl;
+	DiskOut << "\t> Files: ";
+	for (int i=0;i<files.size();i++){
+		DiskOut << files[i]->FileIdentifier << " ";
+	}
+	DiskOut << "(" << files.size() << ")" << endl;
+	// Print the access time and simulated device time of the operation
+	printAccessTime();
+	return files.size();
+}
+
+
+
+
+/*
+ * Adds a file of bytes to virtual disk
+ *	The bytes are cut into entries of entryBytes, and the data of each
+ *	entry is the number of its bytes in use. addFile() places the
+ *	entries with the allocation method like the entries of any file,
+ *	and the bytes are then copied into the payloads of the entries.
+ *	Each entry write is charged with its share of the block's bytes.
+ *
+ * Input:
+ *		fileName - Name of the file
+ *		bytes - Contents of the file
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if unsuccessful
+ */
+int VirtualDisk::addBytes(int64_t fileName, std::span<const uint8_t> bytes){
+	int entryBytes = DiskBytes->getEntryBytes();
+	queue<string> fileContents;
+	for (size_t i=0;i<bytes.size();i+=entryBytes){
+		// Bytes in use in the entry (the last entry may be part full)
+		fileContents.push(to_string(min((size_t)entryBytes, bytes.size()-i)));
+	}
+	int numEntries = fileContents.size();
+	if (!addFile(fileName, fileContents)){
+		return 0;
+	}
+	double writeTime = deviceTime;
+	// Copy the bytes into the payloads of the entries, in file order
+	vector<std::span<Data> > runs = readRange(checkINode(fileName), 1, numEntries);
+	size_t byteOffset = 0;
+	for (int i=0;i<runs.size();i++){
+		for (int j=0;j<runs[i].size();j++){
+			byteOffset += DiskBytes->writeEntry(&runs[i][j] - DiskData, bytes.subspan(byteOffset, runs[i][j].data));
+		}
+	}
+	DiskBytes->recordWrite(bytes.size(), writeTime);
+	vector<std::span<const uint8_t> > written(1, bytes);
+	streamsize defaultPrecision = DiskOut.precision();
+	DiskOut << "Stored " << bytes.size() << " bytes of file " << fileName << " in " << numEntries << " entries of " << entryBytes << " bytes (checksum " << hex << ByteStore::checksum(written) << dec << ")";
+	if (writeTime > 0){
+		// Bytes per microsecond are megabytes per second
+		DiskOut << " (" << fixed << setprecision(1) << bytes.size() / writeTime << " MB/s simulated)";
+	}
+	DiskOut << endl << endl;
+	DiskOut.unsetf(ios::floatfield);
+	DiskOut.precision(defaultPrecision);
+	return 1;
+}
+
+
+
+
+/*
+ * Reads bytes of a file from virtual disk
+ *	The bytes are not copied, readBytes() returns views into the byte
+ *	slab. Each entry read is charged to the device.
+ *
+ * Input:
+ *		fileName - File to read
+ *		byteOffset - First byte to read (starting from 0)
+ *		numBytes - Number of bytes to read ('0' reads to the end of the file)
+ *
+ * Returns:
+ *		'1' when completed successfully
+ *		'0' if unsuccessful
+ */
+int VirtualDisk::readFileBytes(int64_t fileName, int64_t byteOffset, int64_t numBytes){
+	// Record the latency and cost of the operation (no-op without -DdiskMetrics)
+	metricScope(byteOffset > 0 ? metricOpReadOffset : metricOpRead);
+	// Reset the access time and simulated device time of the operation
+	beginOperation();
+	// Trace the operation and its phases (no-op without -DdiskTrace)
+	traceScope("readFileBytes", this);
+	traceArg("file", fileName);
+	traceArg("offset", byteOffset);
+	// Check if file name exists in the directory structure
+	iNode* tempDirPtr = checkINode(fileName);
+	// Increment access time and charge the directory read to the device (Accessed memory)
+	accessDirectory();
+	DiskOut << "Read File " << fileName << " bytes from " << byteOffset << " from virtual disk." << endl;
+	if (!tempDirPtr){
+		DiskErr << "Error: File entry "<< fileName << " does not exist in the virtual disk." << endl << endl;
+		return 0;
+	}
+	if (DiskCache && DiskReadAhead){
+		// Prefetch the blocks ahead of a sequential reader
+		startReadAhead(tempDirPtr, byteOffset / DiskBytes->getEntryBytes() + 1);
+	}
+	vector<std::span<const uint8_t> > views;
+	{
+		// Trace the views of the bytes (no-op without -DdiskTrace)
+		traceScope("copyData", this);
+		views = readBytes(tempDirPtr, byteOffset, numBytes, true);
+	}
+	if (views.empty()){
+		DiskOut << "Error: File " << fileName << " has no bytes at offset " << byteOffset << " on the virtual disk." << endl << endl;
+		return 0;
+	}
+	long bytesRead = 0;
+	for (int i=0;i<views.size();i++){
+		bytesRead += views[i].size();
+	}
+	DiskOut << "Viewed " << bytesRead << " bytes in " << views.size() << " view(s) of the byte slab (checksum " << hex << ByteStore::checksum(views) << dec << ")" << endl;
+	if (deviceTime > 0){
+		// Bytes per microsecond are megabytes per second
+		streamsize defaultPrecision = DiskOut.precision();
+		DiskOut << "Throughput is " << fixed << setprecision(1) << bytesRead / deviceTime << " MB/s simulated" << endl;
+		DiskOut.unsetf(ios::floatfield);
+		DiskOut.precision(defaultPrecision);
+	}
+	DiskBytes->recordRead(bytesRead, deviceTime);
+	// Print the access time and simulated device time of the operation
+	printAccessTime();
+	return 1;
+}
+
+
+
+
+/*
+ * Locates a range of bytes of a file
+ *	The entries holding the bytes are found with readRange(), and each
+ *	entry's bytes are added as a read-only view of the byte slab.
+ *	Bytes that follow each other in the slab share one view.
+ *
+ * Input:
+ *		iNodeEntry - Directory entry of the file
+ *		byteOffset - First byte to read (starting from 0)
+ *		numBytes - Number of bytes to read ('0' reads to the end of the file)
+ *		charge - true to charge the entries read to the device
+ *
+ * Returns:
+ *		Views of the bytes, in file order
+ *		(empty if the offset is past the end of the file)
+ */
+vector<std::span<const uint8_t> > VirtualDisk::readBytes(iNode* iNodeEntry, int64_t byteOffset, int64_t numBytes, bool charge){
+	vector<std::span<const uint8_t> > views;
+	int entryBytes = DiskBytes->getEntryBytes();
+	// A file holds at most the payload of the whole disk
+	int64_t maxBytes = (int64_t)DiskVCB->totalBlockNum * blockBytes;
+	if (numBytes <= 0 || numBytes > maxBytes){
+		numBytes = maxBytes;
+	}
+	if (byteOffset < 0){
+		return views;
+	}
+	int64_t firstByte = byteOffset % entryBytes;
+	vector<std::span<Data> > runs = readRange(iNodeEntry, byteOffset / entryBytes + 1, (firstByte + numBytes + entryBytes-1) / entryBytes);
+	for (int i=0;i<runs.size() && numBytes > 0;i++){
+		for (int j=0;j<runs[i].size() && numBytes > 0;j++){
+			if (charge){
+				// Increment access time and charge the read to the device (Accessed memory)
+				accessBlock(runs[i][j].block);
+			}
+			int64_t viewBytes = min(runs[i][j].data - firstByte, numBytes);
+			if (viewBytes > 0){
+				DiskBytes->addView(views, &runs[i][j] - DiskData, firstByte, viewBytes);
+				numBytes -= viewBytes;
+			}
+			firstByte = 0;
+		}
+	}
+	return views;
+}
+
+
+
+
+
+
+
+/*
+ * Getter method for the disk's VCB
+ *
+ * Returns:
+ *		Disk VCB pointer
+ *
+ */
+VCB* VirtualDisk::getVCB(){
+	return DiskVCB;
+}
+
+
+/*
+ * Getter method for the disk's directory structure
+ *	With the directory tree, the inodes are its slots. Unused entries
+ *	have a file identifier of -1 either way.
+ *
+ * Returns:
+ *		Directory structure (inode array) pointer
+ *
+ */
+iNode* VirtualDisk::getDir(){
+	if (DiskDirTree){
+		return DiskDirTree->getSlots();
+	}
+	return DiskDir;
+}
+
+
+/*
+ * Getter method for the number of entries in the directory structure
+ *
+ * Returns:
+ *		Number of inodes in the directory structure
+ *
+ */
+int VirtualDisk::getDirSize(){
+	if (DiskDirTree){
+		return DiskDirTree->getNumSlots();
+	}
+	return DiskVCB->blockSize-1;
+}
+
+
+/*
+ * Getter method for the disk data
+ *
+ * Returns:
+ *		Disk Data structure pointer
+ *
+ */
+
+
+Data* VirtualDisk::getData(){
+	return DiskData;
+}
+
+
+/*
+ * Getter method for the disk's free space statistics
+ *
+ * Returns:
+ *		Free space statistics pointer
+ *
+ */
+FSStats* VirtualDisk::getFSStats(){
+	return &DiskStats;
+}
+
+
+/*
+ * Getter method for the external fragmentation index
+ *	Calculated as 1 - (largest free extent / free blocks), '0' when
+ *	all free blocks form one run and close to '1' when free space is
+ *	split into many small runs.
+ *
+ * Returns:
+ *		External fragmentation index from 0 to 1
+ *
+ */
+double VirtualDisk::getExternalFragmentation(){
+	if (DiskVCB->numFreeBlock == 0){
+		return 0;
+	}
+	return 1 - (DiskStats.largestFreeExtent*1.00 / DiskVCB->numFreeBlock);
+}
+
+
+/*
+ * Getter method for the average number of extents per file
+ *
+ * Returns:
+ *		Average extents per file, '0' if there are no files
+ *
+ */
+double VirtualDisk::getAverageFileExtents(){
+	if (DiskStats.numFiles == 0){
+		return 0;
+	}
+	return DiskStats.numFileExtents*1.00 / DiskStats.numFiles;
+}
+
+
+/*
+ * Getter method for the simulated device
+ *
+ * Returns:
+ *		Device model pointer
+ *
+ */
+DeviceModel* VirtualDisk::getDeviceModel(){
+	return DiskDevice;
+}
+
+
+/*
+ * Getter method for the block cache
+ *
+ * Returns:
+ *		Block cache pointer, NULL if the cache is disabled
+ *
+ */
+BlockCache* VirtualDisk::getBlockCache(){
+	return DiskCache;
+}
+
+
+/*
+ * Getter method for the read-ahead engine
+ *
+ * Returns:
+ *		Read-ahead pointer, NULL if read-ahead is disabled
+ *
+ */
+ReadAhead* VirtualDisk::getReadAhead(){
+	return DiskReadAhead;
+}
+
+
+/*
+ * Getter method for the write-back buffer
+ *
+ * Returns:
+ *		Write buffer pointer, NULL in write-through mode
+ *
+ */
+WriteBuffer* VirtualDisk::getWriteBuffer(){
+	return DiskWriteBuffer;
+}
+
+
+/*
+ * Getter method for the log of the log-structured method
+ *
+ * Returns:
+ *		Log pointer, NULL for the other allocation methods
+ *
+ */
+SegmentLog* VirtualDisk::getLog(){
+	return DiskLog;
+}
+
+
+/*
+ * Getter method for the snapshots
+ *
+ * Returns:
+ *		Snapshot manager pointer, NULL if no snapshot was taken
+ *
+ */
+SnapshotManager* VirtualDisk::getSnapshots(){
+	return DiskSnapshots;
+}
+
+
+/*
+ * Getter method for the delete mode
+ *
+ * Returns:
+ *		true if deletes are lazy
+ *
+ */
+bool VirtualDisk::isLazyDelete(){
+	return lazyDelete;
+}
+
+
+/*
+ * Getter method for the compressed free block map
+ *
+ * Returns:
+ *		Compressed map pointer, NULL if the dense bit map is searched
+ *
+ */
+RoaringBitmap* VirtualDisk::getFreeMap(){
+	return DiskFreeMap;
+}
+
+
+/*
+ * Checks the free block map in use for a free block
+ *
+ * Input:
+ *		block - Block number
+ *
+ * Returns:
+ *		true if the block is free
+ */
+bool VirtualDisk::isFreeBlock(int block){
+	if (DiskFreeMap){
+		return DiskFreeMap->contains(block);
+	}
+	return DiskVCB->FreeBlockBitMap[block] == 1;
+}
+
+
+/*
+ * Getter method for the directory tree
+ *
+ * Returns:
+ *		Directory tree pointer, NULL if the inode array is used
+ *
+ */
+DirectoryTree* VirtualDisk::getDirTree(){
+	return DiskDirTree;
+}
+
+
+/*
+ * Getter method for the byte payloads
+ *
+ * Returns:
+ *		Byte store pointer, NULL if entries hold ints
+ *
+ */
+ByteStore* VirtualDisk::getByteStore(){
+	return DiskBytes;
+}
+
+
+/*
+ * Sets the log the file operations are recorded to
+ *	The disk owns the log and frees it, and the previous log, when it
+ *	is replaced.
+ *
+ * Input:
+ *		log - Operation log (NULL to stop recording)
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int VirtualDisk::setOperationLog(OperationLog* log){
+	delete DiskOpLog;
+	DiskOpLog = log;
+	return 1;
+}
+
+
+/*
+ * Getter method for the operation log
+ *
+ * Returns:
+ *		Operation log pointer, NULL when not recording
+ *
+ */
+OperationLog* VirtualDisk::getOperationLog(){
+	return DiskOpLog;
+}
+
+
+/*
+ * Turns the output of the disk off or on
+ *	A quiet disk runs its operations without printing, so disks on
+ *	other threads never write to cout or change its format.
+ *
+ * Input:
+ *		quiet - true to discard the output of the disk
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int VirtualDisk::setQuiet(bool quiet){
+	DiskOut.rdbuf(quiet ? (std::streambuf*)&DiskDiscard : cout.rdbuf());
+	DiskErr.rdbuf(quiet ? (std::streambuf*)&DiskDiscard : cerr.rdbuf());
+	return 1;
+}
+
+
+/*
+ * Getter method for the output of the disk
+ *	Parts of the disk (the segment log, the defragmenter and the
+ *	snapshots) print through it as well.
+ *
+ * Returns:
+ *		Output stream of the disk
+ */
+std::ostream &VirtualDisk::getOut(){
+	return DiskOut;
+}
+
+
+/*
+ * Discards a character written to the buffer
+ *
+ */
+int DiscardBuffer::overflow(int c){
+	return c;
+}
+
+
+#ifdef diskMetrics
+/*
+ * Getter method for the operation metrics
+ *
+ * Returns:
+ *		Operation metrics pointer
+ *
+ */
+OperationMetrics* VirtualDisk::getMetrics(){
+	return DiskMetrics;
+}
+#endif
+
+
+#ifdef diskTrace
+/*
+ * Getter methods for the counters of the trace spans
+ *	Unlike the access time, the counters are never reset, so a span
+ *	takes the difference over its phase.
+ *
+ * Returns:
+ *		Accesses to memory, or blocks touched, since the disk was made
+ *
+ */
+long VirtualDisk::getTraceAccesses(){
+	return traceAccesses;
+}
+
+long VirtualDisk::getTraceBlocks(){
+	return traceBlocks;
+}
+#endif
+
+
+/*
+ * Getter method for the access time of the last operation
+ *
+ * Returns:
+ *		Accesses to memory
+ *
+ */
+int VirtualDisk::getAccessTime(){
+	return accessTime;
+}
+
+
+/*
+ * Getter method for the simulated device time of the last operation
+ *
+ * Returns:
+ *		Device time in microseconds
+ *
+ */
+double VirtualDisk::getDeviceTime(){
+	return deviceTime;
+}
+
+
+/*
+ * Getter method for blockSize
+ *
+ * Returns:
+ *		Block size for the Disk
+ *
+ */
+int VirtualDisk::getBlockSize(){
+	return DiskVCB->blockSize;
+}
+
+
+
+/*
+ * Getter method for allocation method
+ *
+ * Returns:
+ *		'1' for Contiguous
+ *		'2' for Linked
+ *		'3' for Indexed
+ *		'4' for Contiguous Indexed
+ *
+ */
+int VirtualDisk::getAllocationMethod(){
+	return allocationMethod;
+}
+
+
@@ -1,47 +1,327 @@
-// VirtualDisk.h
-#ifndef VIRTUALDISK_H
-#define VIRTUALDISK_H
-#pragma once
-
-#define printDiskMapWidth 10
-
-class VirtualDisk{
-	VCB* DiskVCB;
-	iNode* DiskDir;
-	Data* DiskData;
-	int allocationMethod;
-public:
-	// Constructors/Destructors
-	VirtualDisk();
-	~VirtualDisk();
-	// General methods
-	int setupDisk();
-	int setupDiskData();
-	int setupDiskDir();
-	int setBlockSize();
-	int setAllocationMethod();
-	int buildFSBitMap();
-
-	// Getter Methods
-	VCB* getVCB();
-	Data* getData();
-	int getBlockSize();
-	int getAllocationMethod();
-
-	// File operation methods
-	int addFile(int fileName, queue<string> args);
-	int readFile(int fileName);
-	int deleteFile(int fileName);
-	// Utility methods	
-	int requestBlocks(int numBlocks);
-	iNode* checkINode(int);
-	int updateINode(iNode* iNodeEntry, int fileName, int startValue, int endValue);
-	int updateFreeSpace(int startValue, int valueLen, int newValue);
-
-	// Printing methods
-	void printVCB();
-	void printDiskMap();
-	void printFreeSpaceBitMap();
-};
-
+// VirtualDisk.h
+#ifndef VIRTUALDISK_H
+#define VIRTUALDISK_H
+#pragma once
+
+#define printDiskMapWidth 10
+
+class DeviceModel;
+class BlockCache;
+class ReadAhead;
+class WriteBuffer;
+class SegmentLog;
+class SnapshotManager;
+class OperationArena;
+class RoaringBitmap;
+class DirectoryTree;
+class ByteStore;
+class OperationMetrics;
+class OperationLog;
+
+/*
+ * Output buffer that discards everything written to it
+ *	A quiet disk prints here, so disks running in parallel (the members
+ *	of a striped volume) or replayed in the background print nothing.
+ */
+class DiscardBuffer : public std::streambuf{
+protected:
+	int overflow(int c);
+};
+class VirtualDisk;
+
+/*
+ * Allocation policies
+ *	Every allocation method is a policy type. The file operations are
+ *	templates on the policy and pick the method's kernels by overloading
+ *	on it, so each kernel call is resolved (and can be inlined) at
+ *	compile time. The disk switches on its method once per operation,
+ *	in withPolicy(). A policy also says how the method lays out its
+ *	inode and its data blocks.
+ */
+// Allocation method 1 - Contiguous (inode holds the start block and length)
+struct ContiguousPolicy {
+	static const bool chained = false;			// Blocks are reached through the block before
+	static const bool logStructured = false;	// New blocks are written at the log head
+	// Entries of a data block
+	static int entriesPerBlock(int blockSize){ return blockSize; }
+	// Block a file operation starts at
+	static int firstBlock(iNode* iNodeEntry){ return iNodeEntry->StartBlock; }
+	// Prints the inode fields of a file
+	static void printINode(std::ostream &out, iNode* iNodeEntry){ out << iNodeEntry->StartBlock << "," << iNodeEntry->Length; }
+};
+
+// Allocation method 2 - Linked (inode holds the start block and last block)
+struct LinkedPolicy {
+	static const bool chained = true;
+	static const bool logStructured = false;
+	// Linked blocks give up their last entry to the next block pointer
+	static int entriesPerBlock(int blockSize){ return blockSize-1; }
+	static int firstBlock(iNode* iNodeEntry){ return iNodeEntry->StartBlock; }
+	static void printINode(std::ostream &out, iNode* iNodeEntry){ out << iNodeEntry->StartBlock << "," << iNodeEntry->LastBlock; }
+};
+
+// Allocation method 3 - Indexed (inode holds the index block)
+struct IndexedPolicy {
+	static const bool chained = false;
+	static const bool logStructured = false;
+	static int entriesPerBlock(int blockSize){ return blockSize; }
+	static int firstBlock(iNode* iNodeEntry){ return iNodeEntry->Index; }
+	static void printINode(std::ostream &out, iNode* iNodeEntry){ out << iNodeEntry->Index; }
+};
+
+// Allocation method 4 - Contiguous Indexed (index block entries hold extents)
+struct ContiguousIndexedPolicy : IndexedPolicy {
+};
+
+// Allocation method 5 - Log-structured (inode holds the latest index block, the inode map)
+struct LogStructuredPolicy : IndexedPolicy {
+	static const bool logStructured = true;
+};
+
+class VirtualDisk{
+	VCB* DiskVCB;
+	iNode* DiskDir;
+	Data* DiskData;
+	FSStats DiskStats;
+	DeviceModel* DiskDevice;
+	BlockCache* DiskCache;
+	ReadAhead* DiskReadAhead;
+	WriteBuffer* DiskWriteBuffer;
+	SegmentLog* DiskLog;
+	SnapshotManager* DiskSnapshots;
+	OperationArena* DiskArena;
+	RoaringBitmap* DiskFreeMap;		// Compressed free block map replacing the VCB's bit map, NULL when the bit map is used
+	DirectoryTree* DiskDirTree;		// B+-tree directory, NULL when the inode array in the superblock is used
+	ByteStore* DiskBytes;			// Byte payloads of the blocks, NULL when entries hold ints
+#ifdef diskMetrics
+	OperationMetrics* DiskMetrics;	// Latency and cost histograms of the file operations
+#endif
+	OperationLog* DiskOpLog;		// Record of the file operations and their outcomes, NULL when not recording
+	std::ostream DiskOut;			// Output of the disk (cout, own format state so parallel disks do not share it)
+	std::ostream DiskErr;			// Error output of the disk (cerr)
+	DiscardBuffer DiskDiscard;		// Output of a quiet disk
+#ifdef diskTrace
+	long traceAccesses;		// Accesses to memory since the disk was made (never reset, for the trace spans)
+	long traceBlocks;		// Blocks touched since the disk was made (consecutive accesses to a block count once)
+	int traceLastBlock;		// Block of the last access counted
+#endif
+	vector<std::map<int64_t, pair<int,int> >::node_type> spareFileRecords;	// Nodes of removed file records, reused by the next record
+	int allocationMethod;
+	int blockBytes;			// Bytes of a block on the simulated device
+	int accessTime;			// Accesses to memory of the current operation
+	double deviceTime;		// Simulated device time of the current operation (us)
+	int streakBlock;		// Block of the previous access in the current operation
+	bool streakWrite;		// Whether the previous access was a write
+	bool streakCached;		// Whether the previous access was served by the cache
+	long opCacheHits;		// Cache hits before the current operation
+	long opCacheMisses;		// Cache misses before the current operation
+	long opCacheEvictions;	// Cache evictions before the current operation
+	int opPrefetched;		// Blocks prefetched by read-ahead in the current operation
+	bool lazyDelete;		// Whether deletes leave the file data behind as stale
+	vector<unsigned int> blockGeneration;	// Generation of every block, bumped when the block is retired
+	vector<unsigned int> dataGeneration;	// Generation the entries of every block were last cleared or written in
+	vector<int> retireSnapshot;				// Latest snapshot when every block was last retired ('0' for none)
+	long blocksRetired;		// Blocks freed by lazy deletes
+	long blocksScrubbed;	// Stale blocks cleared on reuse
+	long freeMapQueries;		// Free run searches of requestBlocks on the compressed map
+	double compressedQueryTime;	// Time of the searches on the compressed map (us)
+	// Operations of one allocation policy, run by the public operations through withPolicy()
+	template <class Operation>
+	auto withPolicy(Operation operation);
+	template <class Policy>
+	int addFileAs(int64_t fileName, queue<string> &fileContents);
+	template <class Policy>
+	int appendFileAs(int64_t fileName, queue<string> &fileContents);
+	template <class Policy>
+	int readFileAs(int64_t fileName, int64_t fileOffset);
+	template <class Policy>
+	int readFileRangeAs(int64_t fileName, int64_t fileOffset, int64_t count);
+	template <class Policy>
+	vector<std::span<Data> > readRangeAs(iNode* iNodeEntry, int64_t fileOffset, int64_t count);
+	template <class Policy>
+	int deleteFileAs(int64_t fileName);
+	template <class Policy>
+	int startReadAheadAs(iNode* iNodeEntry, int64_t fileOffset);
+	template <class Policy>
+	int getTargetBlockAs(int64_t fileName);
+	template <class Policy>
+	int updateINodeAs(iNode* iNodeEntry, int64_t fileName, int startValue, int endValue=-1);
+	template <class Policy>
+	int buildFileStatsAs();
+	// Add kernels
+	int addKernel(ContiguousPolicy, iNode* tempDirPtr, int64_t fileName, queue<string> &fileContents);
+	int addKernel(LinkedPolicy, iNode* tempDirPtr, int64_t fileName, queue<string> &fileContents);
+	int addKernel(IndexedPolicy, iNode* tempDirPtr, int64_t fileName, queue<string> &fileContents);
+	int addKernel(ContiguousIndexedPolicy, iNode* tempDirPtr, int64_t fileName, queue<string> &fileContents);
+	int addKernel(LogStructuredPolicy, iNode* tempDirPtr, int64_t fileName, queue<string> &fileContents);
+	// Append kernels
+	int appendKernel(ContiguousPolicy, iNode* tempDirPtr, int64_t fileName, queue<string> &fileContents, int entriesPerBlock, int &newExtents, int &newBlocks);
+	int appendKernel(LinkedPolicy, iNode* tempDirPtr, int64_t fileName, queue<string> &fileContents, int entriesPerBlock, int &newExtents, int &newBlocks);
+	int appendKernel(IndexedPolicy, iNode* tempDirPtr, int64_t fileName, queue<string> &fileContents, int entriesPerBlock, int &newExtents, int &newBlocks);
+	int appendKernel(ContiguousIndexedPolicy, iNode* tempDirPtr, int64_t fileName, queue<string> &fileContents, int entriesPerBlock, int &newExtents, int &newBlocks);
+	int appendKernel(LogStructuredPolicy, iNode* tempDirPtr, int64_t fileName, queue<string> &fileContents, int entriesPerBlock, int &newExtents, int &newBlocks);
+	// Read kernels (log-structured files use the indexed one)
+	int readKernel(ContiguousPolicy, iNode* tempDirPtr, int64_t fileName, int64_t fileOffset);
+	int readKernel(LinkedPolicy, iNode* tempDirPtr, int64_t fileName, int64_t fileOffset);
+	int readKernel(IndexedPolicy, iNode* tempDirPtr, int64_t fileName, int64_t fileOffset);
+	int readKernel(ContiguousIndexedPolicy, iNode* tempDirPtr, int64_t fileName, int64_t fileOffset);
+	// Delete kernels
+	int deleteKernel(ContiguousPolicy, iNode* tempDirPtr, int64_t fileName);
+	int deleteKernel(LinkedPolicy, iNode* tempDirPtr, int64_t fileName);
+	int deleteKernel(IndexedPolicy, iNode* tempDirPtr, int64_t fileName);
+	int deleteKernel(ContiguousIndexedPolicy, iNode* tempDirPtr, int64_t fileName);
+	int deleteKernel(LogStructuredPolicy, iNode* tempDirPtr, int64_t fileName);
+	// Lazy delete kernels
+	int lazyDeleteKernel(ContiguousPolicy, iNode* tempDirPtr, int64_t fileName);
+	int lazyDeleteKernel(LinkedPolicy, iNode* tempDirPtr, int64_t fileName);
+	int lazyDeleteKernel(IndexedPolicy, iNode* tempDirPtr, int64_t fileName);
+	int lazyDeleteKernel(ContiguousIndexedPolicy, iNode* tempDirPtr, int64_t fileName);
+	int lazyDeleteKernel(LogStructuredPolicy, iNode* tempDirPtr, int64_t fileName);
+	// Range kernels (log-structured files use the indexed one)
+	int rangeKernel(ContiguousPolicy, iNode* iNodeEntry, vector<std::span<Data> > &runs, int64_t &skipEntries, int64_t &remainingEntries);
+	int rangeKernel(LinkedPolicy, iNode* iNodeEntry, vector<std::span<Data> > &runs, int64_t &skipEntries, int64_t &remainingEntries);
+	int rangeKernel(IndexedPolicy, iNode* iNodeEntry, vector<std::span<Data> > &runs, int64_t &skipEntries, int64_t &remainingEntries);
+	int rangeKernel(ContiguousIndexedPolicy, iNode* iNodeEntry, vector<std::span<Data> > &runs, int64_t &skipEntries, int64_t &remainingEntries);
+	// Block listing kernels (log-structured files use the indexed one)
+	int blocksKernel(ContiguousPolicy, iNode* iNodeEntry, vector<int> &fileBlocks);
+	int blocksKernel(LinkedPolicy, iNode* iNodeEntry, vector<int> &fileBlocks);
+	int blocksKernel(IndexedPolicy, iNode* iNodeEntry, vector<int> &fileBlocks);
+	int blocksKernel(ContiguousIndexedPolicy, iNode* iNodeEntry, vector<int> &fileBlocks);
+	// Extent count kernels (log-structured files use the indexed one)
+	int extentsKernel(ContiguousPolicy, iNode* iNodeEntry, vector<int> &fileBlocks);
+	int extentsKernel(LinkedPolicy, iNode* iNodeEntry, vector<int> &fileBlocks);
+	int extentsKernel(IndexedPolicy, iNode* iNodeEntry, vector<int> &fileBlocks);
+	int extentsKernel(ContiguousIndexedPolicy, iNode* iNodeEntry, vector<int> &fileBlocks);
+	// Inode kernels (every indexed method uses the indexed one)
+	int updateINodeKernel(ContiguousPolicy, iNode* iNodeEntry, int startValue, int endValue);
+	int updateINodeKernel(LinkedPolicy, iNode* iNodeEntry, int startValue, int endValue);
+	int updateINodeKernel(IndexedPolicy, iNode* iNodeEntry, int startValue, int endValue);
+public:
+	// Constructors/Destructors
+	VirtualDisk();
+	VirtualDisk(int method, int blockSize);
+	~VirtualDisk();
+	// General methods
+	int setupDisk();
+	int initialiseDisk();
+	int setupDiskData();
+	int setupDiskDir();
+	int setBlockSize();
+	int applyBlockSize(int newBlockSize);
+	int setAllocationMethod();
+	int buildFSBitMap();
+	int buildFSStats();
+	int buildFileStats();
+	int setDeviceModel(int modelType);
+	int setBlockCache(int policyType, int numBlocks);
+	int setReadAhead(int maxWindow);
+	int setWriteBack(int maxDirtyBlocks, int maxAge);
+	int setLazyDelete(bool enabled);
+	int setFreeMap(int mapType);
+	int setDirectory(int dirType);
+	int setByteMode(int payloadBytes);
+
+	// Getter Methods
+	VCB* getVCB();
+	iNode* getDir();
+	int getDirSize();
+	Data* getData();
+	int getBlockSize();
+	int getAllocationMethod();
+	FSStats* getFSStats();
+	DeviceModel* getDeviceModel();
+	BlockCache* getBlockCache();
+	ReadAhead* getReadAhead();
+	WriteBuffer* getWriteBuffer();
+	SegmentLog* getLog();
+	SnapshotManager* getSnapshots();
+	bool isLazyDelete();
+	RoaringBitmap* getFreeMap();
+	bool isFreeBlock(int block);
+	DirectoryTree* getDirTree();
+	ByteStore* getByteStore();
+#ifdef diskMetrics
+	OperationMetrics* getMetrics();
+#endif
+	int setOperationLog(OperationLog* log);
+	OperationLog* getOperationLog();
+	int setQuiet(bool quiet);
+	std::ostream &getOut();
+#ifdef diskTrace
+	long getTraceAccesses();
+	long getTraceBlocks();
+#endif
+	int getAccessTime();
+	double getDeviceTime();
+	double getExternalFragmentation();
+	double getAverageFileExtents();
+
+	// File operation methods
+	int addFile(int64_t fileName, queue<string> &args);
+	int appendFile(int64_t fileName, queue<string> &args);
+	int readFile(int64_t fileName, int64_t fileOffset);
+	int readFileRange(int64_t fileName, int64_t fileOffset, int64_t count);
+	vector<std::span<Data> > readRange(iNode* iNodeEntry, int64_t fileOffset, int64_t count);
+	int deleteFile(int64_t fileName);
+	int listFiles(int64_t fromName, int64_t toName);
+	// Byte file methods
+	int addBytes(int64_t fileName, std::span<const uint8_t> bytes);
+	int readFileBytes(int64_t fileName, int64_t byteOffset, int64_t numBytes);
+	vector<std::span<const uint8_t> > readBytes(iNode* iNodeEntry, int64_t byteOffset, int64_t numBytes, bool charge=false);
+	// Access accounting methods
+	int beginOperation();
+	int accessBlock(int block, bool write=false);
+	int accessDirectory(bool write=false);
+	void printAccessTime();
+	// Read-ahead methods
+	vector<int> getFileBlocks(iNode* iNodeEntry);
+	int listFileBlocks(iNode* iNodeEntry, vector<int> &fileBlocks);
+	int startReadAhead(iNode* iNodeEntry, int64_t fileOffset);
+	int prefetchBlocks(vector<int> blocks);
+	// Write-back methods
+	int checkWriteBack();
+	int flushWriteBack();
+	// Snapshot methods
+	int takeSnapshot();
+	int rollbackSnapshot(int id);
+	int diffSnapshots(int fromId, int toId);
+	int preserveBlock(int block);
+	int preserveFreeMap(int startValue, int valueLen);
+	int preserveINode(iNode* iNodeEntry);
+	int preserveTree();
+	int preserveLog();
+	int writeEntry(int addr, int data, bool charge=true);
+	int writeExtent(int addr, int data, int length, bool charge=true);
+	// Lazy deletion methods
+	int retireBlocks(int firstBlock, int numBlocks);
+	bool isStaleBlock(int block);
+	int scrubBlock(int block);
+	// Utility methods	
+	int requestBlocks(int numBlocks);
+	int findFreeBlock();
+	int clearBlocks(int firstBlock, int numBlocks);
+	int printFileData(int dataAddr, int numEntries);
+	int getTargetBlock(int64_t fileName);
+	iNode* checkINode(int64_t file);
+	int updateINode(iNode* iNodeEntry, int64_t fileName, int startValue, int endValue);
+	int updateFreeSpace(int startValue, int valueLen, int newValue, bool temporary=false);
+	int updateFreeExtents(int startValue, int valueLen, int newValue);
+	int addFreeExtent(int startValue, int endValue);
+	int removeFreeExtent(int startValue, int endValue);
+	int recordFileStats(int64_t fileName, int numExtents, int unusedEntries);
+	int removeFileStats(int64_t fileName);
+	int getBlockFill(int block, int numEntries);
+	int appendEntries(int block, int firstEntry, int numEntries, queue<string> &fileContents);
+	int addRangeRun(vector<std::span<Data> > &runs, int runAddr, int runLength, int64_t &skipEntries, int64_t &remainingEntries);
+
+	// Printing methods
+	void printVCB();
+	void printDiskMap();
+	void printFreeSpaceBitMap();
+	void printFSStats();
+	void printArenaStats();
+	void printLazyDeleteStats();
+	void printFreeMapStats();
+};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,162 @@
+#include "Header.h"				// Header file
+#include "WriteBuffer.h"		// WriteBuffer file
+
+// Compiler Directive
+using namespace std;
+
+
+/*
+ * Contructor for WriteBuffer
+ *
+ */
+WriteBuffer::WriteBuffer(int maxBlocks, int maxOperations){
+	maxDirtyBlocks = maxBlocks;
+	maxAge = maxOperations;
+	operationNumber = 0;
+	numBufferedWrites = 0;
+	numFlushes = 0;
+	numFlushedBlocks = 0;
+	numFlushWrites = 0;
+}
+
+
+/*
+ * Buffers an entry write
+ *	The block keeps the operation it was first dirtied in, so its age
+ *	counts from the oldest unflushed write.
+ *
+ * Input:
+ *		block - Block being written
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int WriteBuffer::markDirty(int block){
+	if (dirtyBlocks.count(block) == 0){
+		dirtyBlocks[block] = operationNumber;
+	}
+	numBufferedWrites++;
+	return 1;
+}
+
+
+/*
+ * Checks whether a block is dirty
+ *
+ * Input:
+ *		block - Block to check
+ *
+ * Returns:
+ *		true if the block has unflushed writes
+ */
+bool WriteBuffer::isDirty(int block){
+	return dirtyBlocks.count(block) > 0;
+}
+
+
+/*
+ * Drops a dirty block that was freed
+ *	A freed block's contents no longer matter, so it is never written.
+ *
+ * Input:
+ *		block - Block freed
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int WriteBuffer::discard(int block){
+	dirtyBlocks.erase(block);
+	return 1;
+}
+
+
+/*
+ * Advances the buffer's clock by one operation
+ *
+ * Returns:
+ *		'1' when completed successfully
+ */
+int WriteBuffer::nextOperation(){
+	operationNumber++;
+	return 1;
+}
+
+
+/*
+ * Checks the size and time thresholds
+ *
+ * Returns:
+ *		true if the buffer should be flushed
+ */
+bool WriteBuffer::needsFlush(){
+	if (dirtyBlocks.empty()){
+		return false;
+	}
+	if (dirtyBlocks.size() >= maxDirtyBlocks){
+		// Size threshold reached
+		return true;
+	}
+	// Find the oldest dirty block
+	int oldestOperation = operationNumber;
+	for (map<int, int>::iterator it = dirtyBlocks.begin(); it != dirtyBlocks.end(); it++){
+		oldestOperation = min(oldestOperation, it->second);
+	}
+	return operationNumber - oldestOperation >= maxAge;
+}
+
+
+/*
+ * Empties the buffer into runs of adjacent dirty blocks
+ *
+ * Returns:
+ *		Runs to write as (start block, number of blocks), in block order
+ */
+vector<pair<int, int> > WriteBuffer::takeRuns(){
+	vector<pair<int, int> > dirtyRuns;
+	for (map<int, int>::iterator it = dirtyBlocks.begin(); it != dirtyBlocks.end(); it++){
+		if (!dirtyRuns.empty() && dirtyRuns.back().first + dirtyRuns.back().second == it->first){
+			// Block continues the previous run
+			dirtyRuns.back().second++;
+		} else {
+			dirtyRuns.push_back(pair<int, int>(it->first, 1));
+		}
+	}
+	numFlushes++;
+	numFlushedBlocks += dirtyBlocks.size();
+	numFlushWrites += dirtyRuns.size();
+	dirtyBlocks.clear();
+	return dirtyRuns;
+}
+
+
+/*
+ * Getter methods for the thresholds and statistics
+ *
+ */
+int WriteBuffer::getNumDirty(){
+	return dirtyBlocks.size();
+}
+
+int WriteBuffer::getMaxDirtyBlocks(){
+	return maxDirtyBlocks;
+}
+
+int WriteBuffer::getMaxAge(){
+	return maxAge;
+}
+
+long WriteBuffer::getBufferedWrites(){
+	return numBufferedWrites;
+}
+
+long WriteBuffer::getFlushes(){
+	return numFlushes;
+}
+
+long WriteBuffer::getFlushedBlocks(){
+	return numFlushedBlocks;
+}
+
+long WriteBuffer::getFlushWrites(){
+	return numFlushWrites;
+}
@@ -0,0 +1,45 @@
+// WriteBuffer.h
+#ifndef WRITEBUFFER_H
+#define WRITEBUFFER_H
+#pragma once
+
+/*
+ * Write-back buffer
+ *	In write-back mode, writes leave their blocks dirty in memory instead
+ *	of going to the device entry by entry. Metadata writes dirty block 0
+ *	once per flush, so bitmap and inode updates are batched as well. The
+ *	buffer is flushed when it holds too many dirty blocks, when its
+ *	oldest dirty block has waited too many operations, or on a sync
+ *	instruction. A flush writes every run of adjacent dirty blocks as a
+ *	single device write.
+ */
+class WriteBuffer{
+	int maxDirtyBlocks;				// Size threshold (blocks)
+	int maxAge;						// Time threshold (operations)
+	std::map<int, int> dirtyBlocks;	// Dirty blocks in block order (block -> operation it was dirtied in)
+	int operationNumber;			// Operations seen by the buffer
+	long numBufferedWrites;			// Entry writes absorbed by the buffer
+	long numFlushes;				// Number of flushes
+	long numFlushedBlocks;			// Blocks written by flushes
+	long numFlushWrites;			// Device writes issued by flushes
+public:
+	// Constructors/Destructors
+	WriteBuffer(int maxBlocks, int maxOperations);
+
+	// General methods
+	int markDirty(int block);
+	bool isDirty(int block);
+	int discard(int block);
+	int nextOperation();
+	bool needsFlush();
+	vector<pair<int, int> > takeRuns();
+	int getNumDirty();
+	int getMaxDirtyBlocks();
+	int getMaxAge();
+	long getBufferedWrites();
+	long getFlushes();
+	long getFlushedBlocks();
+	long getFlushWrites();
+};
+
+#endif
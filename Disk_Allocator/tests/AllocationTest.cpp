@@ -0,0 +1,169 @@
+/*
+// Compile and run the test (from the Disk_Allocator folder)
+cls && g++ tests/AllocationTest.cpp VirtualDisk.cpp InstructionFile.cpp Defragmenter.cpp DeviceModel.cpp BlockCache.cpp ReadAhead.cpp WriteBuffer.cpp SegmentLog.cpp Snapshot.cpp RequestScheduler.cpp IoRing.cpp ClientExecutor.cpp StripedVolume.cpp OperationArena.cpp DataKernels.cpp RoaringBitmap.cpp DirectoryTree.cpp ByteStore.cpp OperationMetrics.cpp DiskTracer.cpp OperationLog.cpp -I. -std=c++20 -o AllocationTest && AllocationTest
+
+*/
+
+/*
+ * Allocation test of the instruction path
+ *	Replaces the global operator new with one that counts, and runs
+ *	traces of add, read and delete iterations through the instruction
+ *	path (InstructionFile::executeAllInstructions, OperationLog::run and
+ *	the disk's kernels) on every allocation method, without and with an
+ *	operation log recording to a file. Only the run of the instructions
+ *	is counted, not the loading of the trace. A run of 1010 iterations
+ *	has to make as many allocations as a run of 10, so the steady state
+ *	makes none.
+ */
+
+//Preprocessor directive
+#include "Header.h"
+#include "VirtualDisk.h"
+#include "Defragmenter.h"
+#include "RequestScheduler.h"
+#include "IoRing.h"
+#include "StripedVolume.h"
+#include "InstructionFile.h"
+#include "OperationMetrics.h"
+#include "OperationLog.h"
+
+// Compiler Directive
+using namespace std;
+
+// Iterations of the short and the long trace
+#define shortIterations 10
+#define longIterations 1010
+// Block size of the disks tested
+#define testBlockSize 4
+// Log file of the logged runs
+#define testLogName "AllocationTest.log"
+
+// Declare forward external variable linkage
+extern const int MAX_ELEMENTS = 128;
+
+// Allocations counted while counting is on
+static std::atomic<long> numAllocations(0);
+static std::atomic<bool> counting(false);
+
+
+/*
+ * Counting replacements of the global allocation functions
+ *
+ */
+void* operator new(std::size_t numBytes){
+	if (counting){
+		numAllocations++;
+	}
+	void* memory = std::malloc(numBytes ? numBytes : 1);
+	if (!memory){
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+void* operator new[](std::size_t numBytes){
+	return operator new(numBytes);
+}
+
+void operator delete(void* memory) noexcept{
+	std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t numBytes) noexcept{
+	std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t numBytes) noexcept{
+	std::free(memory);
+}
+
+
+/*
+ * Builds a trace of add, read and delete iterations
+ *
+ * Input:
+ *		numIterations - Iterations of the trace
+ *
+ * Returns:
+ *		Tokens of every instruction of the trace
+ */
+std::queue<queue<string> > buildTrace(int numIterations){
+	const char* lines[] = {"add,100,1,2,3,4,5", "add,200,6,7", "read,100", "read,100,2", "read,200", "delete,100", "delete,200"};
+	std::queue<queue<string> > instructions;
+	for (int i=0;i<numIterations;i++){
+		for (int j=0;j<7;j++){
+			std::queue<string> tokens;
+			std::istringstream lineStream(lines[j]);
+			std::string token;
+			while (std::getline(lineStream, token, ',')){
+				tokens.push(token);
+			}
+			instructions.push(tokens);
+		}
+	}
+	return instructions;
+}
+
+
+/*
+ * Counts the allocations of one run of a trace
+ *	The output of the run is discarded.
+ *
+ * Input:
+ *		method - Allocation method of the disk (1-5)
+ *		numIterations - Iterations of the trace
+ *		logged - Whether the run is recorded to an operation log
+ *
+ * Returns:
+ *		Allocations made while the instructions ran
+ */
+long countAllocations(int method, int numIterations, bool logged){
+	std::queue<queue<string> > instructions = buildTrace(numIterations);
+	DiscardBuffer discardBuffer;
+	std::streambuf* coutBuffer = cout.rdbuf(&discardBuffer);
+	std::streambuf* cerrBuffer = cerr.rdbuf(&discardBuffer);
+	long runAllocations = 0;
+	{
+		VirtualDisk testDisk(method, testBlockSize);
+		testDisk.setQuiet(true);
+		if (logged){
+			// The disk owns its log
+			testDisk.setOperationLog(new OperationLog(testLogName, method, testBlockSize));
+		}
+		// The instructions are recorded as they are loaded, before counting starts
+		InstructionFile testInstructions(&testDisk, instructions);
+		numAllocations = 0;
+		counting = true;
+		testInstructions.executeAllInstructions();
+		counting = false;
+		runAllocations = numAllocations;
+	}
+	cout.rdbuf(coutBuffer);
+	cerr.rdbuf(cerrBuffer);
+	return runAllocations;
+}
+
+
+/* Main function definition
+ *	Returns '0' when every run passes, '1' otherwise.
+ */
+int main(){
+	int numFailed = 0;
+	for (int logged=0;logged<2;logged++){
+		for (int method=1;method<=5;method++){
+			long shortAllocations = countAllocations(method, shortIterations, logged);
+			long longAllocations = countAllocations(method, longIterations, logged);
+			bool passed = shortAllocations == longAllocations;
+			cout << (passed ? "PASS" : "FAIL") << " method " << method << (logged ? " (logged)" : "") << ": ";
+			cout << shortAllocations << " allocation(s) for " << shortIterations << " iterations, " << longAllocations << " for " << longIterations << endl;
+			numFailed += !passed;
+		}
+	}
+	std::remove(testLogName);
+	cout << (numFailed == 0 ? "All runs passed." : "Some runs failed.") << endl;
+	return numFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,314 @@
+/*
+// Compile and run the test (from the Disk_Allocator folder)
+cls && g++ tests/KernelTest.cpp DataKernels.cpp -I. -std=c++20 -o KernelTest && KernelTest
+
+// Measure the throughput of the kernels as well (build with -O2)
+KernelTest -throughput
+
+*/
+
+/*
+ * Equivalence test of the data kernels
+ *	Runs every SSE2 and AVX2 kernel the processor supports against the
+ *	scalar kernel on the same input, and fails on any difference. The
+ *	ranges start at every offset of a vector register and have lengths
+ *	that are not a multiple of it, from empty ranges to large ones, so
+ *	the unaligned heads and the tails of the vector loops are covered.
+ *
+ *	With '-throughput' every kernel is also timed at each level on a
+ *	16 MB range, and the rate is printed with the speedup over scalar.
+ */
+
+//Preprocessor directive
+#include "Header.h"
+#include "DataKernels.h"
+
+// Compiler Directive
+using namespace std;
+
+// Entries of the large ranges (about a 1 MB data region)
+#define largeEntries 65543
+// Offsets tested from the start of a buffer (entries or blocks)
+#define maxOffset 8
+// Lengths of the small ranges (0 to smallEntries-1)
+#define smallEntries 70
+// Seed of the random inputs
+#define testSeed 1007
+// Entries and blocks of the timed ranges (16 MB of entries or bit map)
+#define throughputEntries 1048576
+#define throughputBlocks 4194304
+// Timed runs of each kernel, the fastest one is reported
+#define throughputRuns 10
+// Kernels timed in the throughput mode
+#define numKernels 4
+
+
+/*
+ * Fills entries with random data
+ *	About one entry in density holds data, the others are empty ('-1').
+ *
+ * Input:
+ *		entries - Entries to fill
+ *		density - One entry in density holds data
+ *		generator - Random number generator
+ *
+ */
+void fillRandom(vector<Data> &entries, int density, std::mt19937 &generator){
+	for (int i=0;i<entries.size();i++){
+		entries[i].index = i;
+		entries[i].block = i/4 + 1;
+		entries[i].data = generator() % density == 0 ? (int)(generator() % 1000) : -1;
+		entries[i].length = (int)(generator() % 8);
+	}
+}
+
+
+/*
+ * Compares two sets of entries field by field
+ *
+ * Returns:
+ *		true if every entry is the same
+ */
+bool sameEntries(vector<Data> &first, vector<Data> &second){
+	for (int i=0;i<first.size();i++){
+		if (first[i].index != second[i].index || first[i].block != second[i].block || first[i].data != second[i].data || first[i].length != second[i].length){
+			return false;
+		}
+	}
+	return true;
+}
+
+
+/*
+ * Runs the entry kernels on one range at the level in use and at the
+ * scalar level
+ *
+ * Input:
+ *		entries - Entries holding the range
+ *		offset - First entry of the range
+ *		numEntries - Number of entries of the range
+ *
+ * Returns:
+ *		Number of kernels that differ from the scalar kernel
+ */
+int compareEntryKernels(vector<Data> &entries, int offset, int numEntries){
+	int level = DataKernels::getLevel();
+	int numFailed = 0;
+	// Count the entries holding data
+	DataKernels::setLevel(kernelScalar);
+	int scalarCount = DataKernels::countData(entries.data()+offset, numEntries);
+	DataKernels::setLevel(level);
+	if (DataKernels::countData(entries.data()+offset, numEntries) != scalarCount){
+		cout << "FAIL " << DataKernels::getName() << " countData at offset " << offset << ", " << numEntries << " entries" << endl;
+		numFailed++;
+	}
+	// Copy the data out (room for numEntries + 8 values)
+	vector<int> scalarValues(numEntries+8, 0);
+	vector<int> values(numEntries+8, 0);
+	DataKernels::setLevel(kernelScalar);
+	int scalarCopied = DataKernels::compactData(entries.data()+offset, numEntries, scalarValues.data());
+	DataKernels::setLevel(level);
+	int numCopied = DataKernels::compactData(entries.data()+offset, numEntries, values.data());
+	if (numCopied != scalarCopied || !std::equal(values.begin(), values.begin()+numCopied, scalarValues.begin())){
+		cout << "FAIL " << DataKernels::getName() << " compactData at offset " << offset << ", " << numEntries << " entries" << endl;
+		numFailed++;
+	}
+	// Clear the range, the entries around it have to be kept
+	vector<Data> scalarEntries = entries;
+	vector<Data> clearedEntries = entries;
+	DataKernels::setLevel(kernelScalar);
+	int scalarCleared = DataKernels::fillEmpty(scalarEntries.data()+offset, numEntries);
+	DataKernels::setLevel(level);
+	int numCleared = DataKernels::fillEmpty(clearedEntries.data()+offset, numEntries);
+	if (numCleared != scalarCleared || !sameEntries(clearedEntries, scalarEntries)){
+		cout << "FAIL " << DataKernels::getName() << " fillEmpty at offset " << offset << ", " << numEntries << " entries" << endl;
+		numFailed++;
+	}
+	return numFailed;
+}
+
+
+/*
+ * Runs the free run search on one bit map at the level in use and at
+ * the scalar level, for several run lengths
+ *
+ * Input:
+ *		bitMap - Bit map holding the range
+ *		offset - First block of the range
+ *		numBlocks - Number of blocks of the range
+ *
+ * Returns:
+ *		Number of searches that differ from the scalar kernel
+ */
+int compareFreeRun(vector<int> &bitMap, int offset, int numBlocks){
+	const int runLengths[] = {1, 2, 3, 7, 8, 31, 32, 33, 64, 100};
+	int level = DataKernels::getLevel();
+	int numFailed = 0;
+	for (int i=0;i<10;i++){
+		DataKernels::setLevel(kernelScalar);
+		int scalarBlock = DataKernels::findFreeRun(bitMap.data()+offset, numBlocks, runLengths[i]);
+		DataKernels::setLevel(level);
+		int firstBlock = DataKernels::findFreeRun(bitMap.data()+offset, numBlocks, runLengths[i]);
+		if (firstBlock != scalarBlock){
+			cout << "FAIL " << DataKernels::getName() << " findFreeRun of " << runLengths[i] << " at offset " << offset << ", " << numBlocks << " blocks: " << firstBlock << " (scalar " << scalarBlock << ")" << endl;
+			numFailed++;
+		}
+	}
+	return numFailed;
+}
+
+
+/*
+ * Tests every kernel of one instruction set against the scalar kernels
+ *
+ * Input:
+ *		level - kernelSSE2 or kernelAVX2
+ *
+ * Returns:
+ *		Number of comparisons that failed
+ */
+int testLevel(int level){
+	std::mt19937 generator(testSeed);
+	int numFailed = 0;
+	int numCompared = 0;
+	DataKernels::setLevel(level);
+	// Data regions: sparse, half full and dense
+	const int densities[] = {9, 2, 1};
+	vector<Data> entries(largeEntries+maxOffset);
+	for (int d=0;d<3;d++){
+		fillRandom(entries, densities[d], generator);
+		for (int offset=0;offset<maxOffset;offset++){
+			for (int numEntries=0;numEntries<smallEntries;numEntries++){
+				numFailed += compareEntryKernels(entries, offset, numEntries);
+				numCompared += 3;
+			}
+			numFailed += compareEntryKernels(entries, offset, largeEntries-offset);
+			numCompared += 3;
+		}
+	}
+	// Free space bit maps: short runs, long runs, and a single run at the end
+	vector<int> bitMap(largeEntries+maxOffset);
+	for (int pattern=0;pattern<3;pattern++){
+		int runBlocks = 0;
+		int runValue = 0;
+		for (int i=0;i<bitMap.size();i++){
+			if (pattern == 2){
+				bitMap[i] = i >= bitMap.size()-100 ? 1 : 0;
+				continue;
+			}
+			if (runBlocks == 0){
+				// Next run of used or free blocks
+				runValue = 1-runValue;
+				runBlocks = 1 + generator() % (pattern == 0 ? 12 : 120);
+			}
+			bitMap[i] = runValue;
+			runBlocks--;
+		}
+		for (int offset=0;offset<maxOffset;offset++){
+			for (int numBlocks=0;numBlocks<smallEntries;numBlocks++){
+				numFailed += compareFreeRun(bitMap, offset, numBlocks);
+				numCompared += 10;
+			}
+			numFailed += compareFreeRun(bitMap, offset, largeEntries-offset);
+			numCompared += 10;
+		}
+	}
+	cout << (numFailed == 0 ? "PASS " : "FAIL ") << DataKernels::getName() << ": " << numCompared-numFailed << "/" << numCompared << " comparisons match the scalar kernels" << endl;
+	return numFailed;
+}
+
+
+/*
+ * Times every kernel at one level on the large ranges
+ *	The entries are half full and the bit map is used except for its
+ *	last 100 blocks, so each kernel goes through the whole range. A
+ *	kernel is run throughputRuns times and the fastest run is kept.
+ *
+ * Input:
+ *		level - Level of the kernels
+ *		scalarTimes - Times of the scalar kernels, NULL when timing them
+ *
+ * Output:
+ *		kernelTimes - Fastest time of each kernel in seconds
+ */
+void measureLevel(int level, double* scalarTimes, double* kernelTimes){
+	const char* kernelNames[numKernels] = {"fillEmpty", "compactData", "countData", "findFreeRun"};
+	std::mt19937 generator(testSeed);
+	vector<Data> source(throughputEntries);
+	fillRandom(source, 2, generator);
+	vector<Data> entries = source;
+	vector<int> values(throughputEntries+8, 0);
+	vector<int> bitMap(throughputBlocks, 0);
+	std::fill(bitMap.end()-100, bitMap.end(), 1);
+	// Results are summed so no call can be left out
+	int64_t checkSum = 0;
+	DataKernels::setLevel(level);
+	for (int k=0;k<numKernels;k++){
+		kernelTimes[k] = 0;
+		for (int run=0;run<throughputRuns;run++){
+			if (k == 0){
+				// The entries are cleared by the previous run
+				entries = source;
+			}
+			chrono::steady_clock::time_point start = chrono::steady_clock::now();
+			switch (k){
+				case 0:
+					checkSum += DataKernels::fillEmpty(entries.data(), throughputEntries);
+					break;
+				case 1:
+					checkSum += DataKernels::compactData(source.data(), throughputEntries, values.data());
+					break;
+				case 2:
+					checkSum += DataKernels::countData(source.data(), throughputEntries);
+					break;
+				default:
+					checkSum += DataKernels::findFreeRun(bitMap.data(), throughputBlocks, 8);
+			}
+			double runTime = chrono::duration<double>(chrono::steady_clock::now()-start).count();
+			if (run == 0 || runTime < kernelTimes[k]){
+				kernelTimes[k] = runTime;
+			}
+		}
+		// Entries per second, and bytes of entries or of the bit map per second
+		double numItems = k == 3 ? throughputBlocks : throughputEntries;
+		double numBytes = k == 3 ? numItems*sizeof(int) : numItems*sizeof(Data);
+		cout << "\t> " << DataKernels::getName() << " " << kernelNames[k] << ": " << numItems/kernelTimes[k]/1e6 << " M entries/s, " << numBytes/kernelTimes[k]/1e9 << " GB/s";
+		if (scalarTimes){
+			cout << " (" << scalarTimes[k]/kernelTimes[k] << "x scalar)";
+		}
+		cout << endl;
+	}
+	if (checkSum == 0){
+		cout << "\t> No entry was counted" << endl;
+	}
+}
+
+
+/* Main function definition
+ *	Returns '0' when every comparison passes, '1' otherwise.
+ */
+int main(int argc, char* argv[]){
+	bool throughput = argc > 1 && std::string(argv[1]) == "-throughput";
+	int supportedLevel = DataKernels::getLevel();
+	int numFailed = 0;
+	double scalarTimes[numKernels];
+	double kernelTimes[numKernels];
+	if (throughput){
+		cout << fixed << setprecision(2);
+		cout << "Throughput (fastest of " << throughputRuns << " runs):" << endl;
+		measureLevel(kernelScalar, NULL, scalarTimes);
+	}
+	for (int level=kernelSSE2;level<=kernelAVX2;level++){
+		if (level > supportedLevel){
+			cout << "SKIP " << (level == kernelAVX2 ? "AVX2" : "SSE2") << ": not supported by the processor" << endl;
+			continue;
+		}
+		numFailed += testLevel(level);
+		if (throughput){
+			measureLevel(level, scalarTimes, kernelTimes);
+		}
+	}
+	DataKernels::setLevel(supportedLevel);
+	cout << (numFailed == 0 ? "All comparisons passed." : "Some comparisons failed.") << endl;
+	return numFailed == 0 ? 0 : 1;
+}